@@ -0,0 +1,9 @@
+#include "CliMain.h"
+
+/**
+* Flight Data Recorder Command Line Interface entry
+*/
+int main(int argc, char* argv[]) {
+	CliMain cli;
+	return cli.Run(argc, argv);
+}
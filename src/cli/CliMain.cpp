@@ -0,0 +1,957 @@
+#include "CliMain.h"
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <climits>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Processor.h"
+#include "ProcessorCom.h"
+#include "Track.h"
+#include "FDRFile.h"
+#include "FTDISFile.h"
+#include "FDRDeviationStruct.h"
+#include "FDRRecorderStatsStruct.h"
+#include "LocalSimLink.h"
+#include "FrameProfiler.h"
+#include "SimMessagePump.h"
+#include "SimConnectLink.h"
+
+/**
+* Returns true, if the file name has the .fdr extension (case insensitive)
+*/
+static bool IsFDRFile(const std::string& fileName) {
+	if (fileName.size() < 4)
+		return false;
+	std::string ext = fileName.substr(fileName.size() - 4);
+	std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+	return ext == ".fdr";
+}
+
+
+/**
+* Returns the size (in bytes) of a file on disk, -1 if it can't be opened
+*/
+static long long GetFileBytes(const std::string& fileName) {
+	std::ifstream is(fileName, std::ios::binary | std::ios::ate);
+	return is ? (long long)is.tellg() : -1;
+}
+
+
+/**
+* Reference of the Com handler benchmark: the controls and options shared by one mutex, i.e. every getter locks
+*/
+class MutexCom {
+	std::mutex m;
+	int cursorPos = 0;
+	float replayRate = 1.0F;
+	bool simConnect = true;
+	std::shared_ptr<const OptionsStruct> options = std::make_shared<const OptionsStruct>(OptionsStruct{ 320,false,false,false,false,0,0,0,0,"",0,0,0,0 });
+
+public:
+	void SetCursorPos(int num) { std::lock_guard<std::mutex> lockGuard(m); cursorPos = num; }
+	int GetCursorPos() { std::lock_guard<std::mutex> lockGuard(m); return cursorPos; }
+	void SetReplayRate(float num) { std::lock_guard<std::mutex> lockGuard(m); replayRate = num; }
+	float GetReplayRate() { std::lock_guard<std::mutex> lockGuard(m); return replayRate; }
+	bool GetSimConnect() { std::lock_guard<std::mutex> lockGuard(m); return simConnect; }
+	void SetOptions(OptionsStruct newOptions) { auto snapshot = std::make_shared<const OptionsStruct>(std::move(newOptions)); std::lock_guard<std::mutex> lockGuard(m); options = snapshot; }
+	std::shared_ptr<const OptionsStruct> GetOptions() { std::lock_guard<std::mutex> lockGuard(m); return options; }
+	bool GetHalfRate() { std::lock_guard<std::mutex> lockGuard(m); return options->halfRate; }
+	bool GetCustomSound() { std::lock_guard<std::mutex> lockGuard(m); return options->customSound; }
+	bool GetBeepStartEnd() { std::lock_guard<std::mutex> lockGuard(m); return options->beepStartEnd; }
+};
+
+
+/**
+* Runs the reads of a track per frame on the reader threads, while a writer thread sets the cursor and the rate
+* and reads the options (GUI, REST API) and saves the options every 100000 rounds. Returns the mean time of a
+* round of reads in ns
+*/
+template<typename Com> static double RunComReaders(Com& com, int readers, int rounds) {
+	std::atomic<bool> start{ false }, stop{ false };
+	std::atomic<int> sink{ 0 };
+	vector<double> readerNs(readers, 0.0);
+	vector<std::thread> threads;
+
+	for (int n = 0; n < readers; n++) {
+		threads.emplace_back([&com, &start, &sink, &readerNs, n, rounds]() {
+			while (!start.load(std::memory_order_acquire))
+				std::this_thread::yield();
+
+			int sum = 0;
+			auto startTime = std::chrono::steady_clock::now();
+			for (int round = 0; round < rounds; round++) {
+				// Reads of a track per frame, see ReplayEngine
+				sum += com.GetReplayRate() == 0.0F;
+				sum += com.GetHalfRate();
+				sum += com.GetReplayRate() != 0.5F;
+				sum += com.GetCustomSound();
+				sum += com.GetBeepStartEnd();
+				sum += com.GetCursorPos() & 1;
+				sum += com.GetSimConnect();
+				sum += com.GetReplayRate() > 1.0F;
+			}
+			readerNs[n] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / rounds;
+			sink.fetch_add(sum, std::memory_order_relaxed);
+		});
+	}
+
+	std::thread writer([&com, &start, &stop, &sink]() {
+		OptionsStruct options = *com.GetOptions();
+		int round = 0;
+		while (!start.load(std::memory_order_acquire))
+			std::this_thread::yield();
+
+		while (!stop.load(std::memory_order_acquire)) {
+			com.SetCursorPos(round);
+			com.SetReplayRate(round % 2 ? 1.0F : 2.0F);
+			sink.fetch_add((int)com.GetOptions()->destName.size(), std::memory_order_relaxed);
+			if (++round % 100000 == 0) {
+				options.destName = "EDDF " + std::to_string(round);
+				com.SetOptions(options);
+			}
+		}
+	});
+
+	start.store(true, std::memory_order_release);
+	for (auto& thread : threads)
+		thread.join();
+	stop.store(true, std::memory_order_release);
+	writer.join();
+
+	double sumNs = 0;
+	for (double ns : readerNs)
+		sumNs += ns;
+	return readers > 0 ? sumNs / readers : 0.0;
+}
+
+
+/**
+* Constructor / Destructor
+*/
+CliMain::CliMain() {
+	cpuCom = new ProcessorCom();
+}
+
+CliMain::~CliMain() {
+	for (auto& track : tracks)
+		delete track;
+	for (auto& file : fdrFiles)
+		delete file;
+	for (auto& file : ftdisFiles)
+		delete file;
+	delete cpuCom;
+}
+
+
+/**
+* Runs the command given on the command line
+*/
+int CliMain::Run(int argc, char* argv[]) {
+	if (!this->ParseArgs(argc, argv)) {
+		this->PrintUsage();
+		return usageError;
+	}
+	cpuCom->SetPumpPolicy(pumpMode == "poll" ? SimMessagePump::polling : pumpMode == "spin" ? SimMessagePump::spinning : SimMessagePump::eventDriven, pumpInterval);
+
+	int exitCode = ok;
+	if (command == "inspect")
+		exitCode = this->Inspect();
+	else if (command == "convert")
+		exitCode = this->Convert();
+	else if (command == "record")
+		exitCode = this->Record();
+	else if (command == "replay")
+		exitCode = this->Replay(false);
+	else if (command == "bench")
+		exitCode = this->Replay(true);
+	else if (command == "bench-dispatch")
+		exitCode = this->BenchDispatch();
+	else if (command == "bench-com")
+		exitCode = this->BenchCom();
+
+	this->Add("exitCode", exitCode);
+	this->Print();
+	return exitCode;
+}
+
+
+/**
+* Parses the command line
+*/
+bool CliMain::ParseArgs(int argc, char* argv[]) {
+	if (argc < 2)
+		return false;
+
+	command = argv[1];
+	if (command != "inspect" && command != "convert" && command != "record" && command != "replay" && command != "bench" && command != "bench-dispatch" && command != "bench-com")
+		return false;
+
+	try {
+		for (int n = 2; n < argc; n++) {
+			std::string arg = argv[n];
+
+			// Options without value
+			if (arg == "--realtime") {
+				realTime = true;
+				continue;
+			}
+			if (arg == "--no-lod") {
+				trafficLod = false;
+				continue;
+			}
+			if (arg == "--profile") {
+				profile = true;
+				continue;
+			}
+			if (arg.rfind("--", 0) != 0) {
+				files.push_back(arg);
+				continue;
+			}
+
+			// Options with value
+			if (n + 1 >= argc)
+				return false;
+			std::string value = argv[++n];
+
+			if (arg == "--format")
+				outputFormat = value;
+			else if (arg == "--link")
+				linkType = value;
+			else if (arg == "--codec")
+				codecName = value;
+			else if (arg == "--clock")
+				clockMode = value;
+			else if (arg == "--source")
+				sourceFile = value;
+			else if (arg == "--sweep")
+				sweep = value;
+			else if (arg == "--rate")
+				frameRate = std::stod(value);
+			else if (arg == "--frames")
+				maxFrames = std::stoi(value);
+			else if (arg == "--tracks")
+				trackCount = std::stoi(value);
+			else if (arg == "--warmup")
+				warmupFrames = std::stoi(value);
+			else if (arg == "--sim-api")
+				simApi = std::stoi(value);
+			else if (arg == "--threads")
+				computeThreads = std::stoi(value);
+			else if (arg == "--lead")
+				leadTimeSec = std::stod(value);
+			else if (arg == "--stagger")
+				staggerSec = std::stod(value);
+			else if (arg == "--pool")
+				aiPoolSize = std::stoi(value);
+			else if (arg == "--seek")
+				seekSec = std::stod(value);
+			else if (arg == "--keyframes")
+				keyframeSec = std::stod(value);
+			else if (arg == "--pump") {
+				size_t separator = value.find(':');
+				pumpMode = value.substr(0, separator);
+				if (separator != std::string::npos)
+					pumpInterval = std::stoi(value.substr(separator + 1));
+			}
+			else
+				return false;
+		}
+	}
+	catch (const std::exception& e) {
+		std::cerr << "fdr-cli: invalid argument: " << e.what() << std::endl;
+		return false;
+	}
+
+	if (outputFormat != "text" && outputFormat != "json")
+		return false;
+	if (linkType != "local" && linkType != "simconnect")
+		return false;
+	if (codecName != "raw" && codecName != "lossless" && codecName != "quantized")
+		return false;
+	if (clockMode != "sim" && clockMode != "wall" && clockMode != "fixed")
+		return false;
+	if (pumpMode != "event" && pumpMode != "poll" && pumpMode != "spin")
+		return false;
+	if (frameRate <= 0.0 || maxFrames < 0 || trackCount < 0 || warmupFrames < 0 || computeThreads < 0 || leadTimeSec < 0 || aiPoolSize < 0 || keyframeSec <= 0 || pumpInterval <= 0)
+		return false;
+
+	// Number of files per command
+	if (command == "convert")
+		return files.size() == 2;
+	if (command == "inspect" || command == "record")
+		return files.size() == 1;
+	if (command == "bench-dispatch" || command == "bench-com")
+		return files.empty();
+	return files.size() >= 1;
+}
+
+
+/**
+* Prints the usage of the command line interface
+*/
+void CliMain::PrintUsage() {
+	std::cerr <<
+		"Usage: fdr-cli <command> [options] <file>...\n"
+		"\n"
+		"Commands:\n"
+		"  inspect <file>              Prints the header and statistics of a .fdr or FTDIS file\n"
+		"  convert <in.fdr> <out.fdr>  Saves a .fdr file with another codec (--codec)\n"
+		"  record <out.fdr>            Records from the sim (--link simconnect) or replays --source through the local link\n"
+		"  replay <file>...            Replays the files (first: user aircraft, others: AI) until the user track ends\n"
+		"  bench <file>...             Replays --tracks tracks for --frames frames and reports the cost per frame\n"
+		"  bench-dispatch              Reports the cost per frame of routing the data responses of --sweep sim objects\n"
+		"  bench-com                   Reports the cost of the reads of the Com handler per track and frame on --sweep threads\n"
+		"\n"
+		"Options:\n"
+		"  --link local|simconnect     Link to the sim (default: local)\n"
+		"  --rate <Hz>                 Frame rate of the local link (default: 60)\n"
+		"  --realtime                  Paces the local link in real time, instead of as fast as possible\n"
+		"  --frames <n>                Max. number of frames (bench default: 1000)\n"
+		"  --warmup <n>                Frames excluded from the bench timing (default: 60)\n"
+		"  --tracks <n>                Number of tracks, input files are repeated round robin\n"
+		"  --sweep <n>,<n>...          Numbers of sim objects of the dispatch benchmark (default: 1,10,25,50,100) or\n"
+		"                              of reader threads of the Com handler benchmark (default: 1,2,4,8)\n"
+		"  --threads <n>               Threads computing the frames of the tracks (default: 0, i.e. number of cores)\n"
+		"  --lead <s>                  Spawns the AI object of a track the lead time before its first record (default: 10)\n"
+		"  --stagger <s>               Time offset between the AI tracks, i.e. AI track n starts n * stagger s later (default: 0)\n"
+		"  --pool <n>                  AI objects per aircraft model created ahead of the replay and reused (default: 4)\n"
+		"  --seek <s>                  Seeks to the replay time after the warm up, i.e. restores the tracks from their keyframes\n"
+		"  --keyframes <s>             Time between two keyframes of a track, i.e. max. time fast-forwarded by a seek (default: 30)\n"
+		"  --no-lod                    Updates all AI tracks every frame, i.e. no level of detail by distance to the user aircraft\n"
+		"  --profile                   Times the stages of the frames and counts the SimConnect calls per frame (replay, bench)\n"
+		"  --pump event|poll|spin[:ms] Message pump of paced runs (--realtime, --link simconnect): waits for the sim, polls every ms\n"
+		"                              or spins. ms: max. wait or poll interval (default: event:50)\n"
+		"  --clock sim|wall|fixed      Replay clock: sim frame rate, wall clock or fixed step of 1/rate, i.e. bit-reproducible (default: sim)\n"
+		"  --sim-api <id>              Sim model of the tracks, e.g. 320, 332, 343, 388, 787 (default: 320)\n"
+		"  --source <file.fdr>         Canned frames of the local link (record)\n"
+		"  --codec raw|lossless|quantized   Codec of the saved file (default: raw)\n"
+		"  --format text|json          Output format (default: text)\n"
+		"\n"
+		"Exit codes: 0 ok, 1 usage error, 2 file error, 3 sim link error, 4 run error (e.g. frames lost)\n";
+}
+
+
+/**
+* Prints the header and statistics of a .fdr or FTDIS file
+*/
+int CliMain::Inspect() {
+	std::string fileName = files.at(0);
+	this->Add("file", fileName);
+	this->Add("bytes", (double)GetFileBytes(fileName));
+
+	if (IsFDRFile(fileName)) {
+		FDRFile* fdrFile = new FDRFile();
+		fdrFiles.push_back(fdrFile);
+		if (!fdrFile->LoadFile(fileName)) {
+			std::cerr << "fdr-cli: can't load " << fileName << std::endl;
+			return fileError;
+		}
+
+		this->Add("type", "fdr");
+		this->Add("formatVersion", fdrFile->GetFormatVersion());
+		this->Add("records", fdrFile->GetSize());
+		this->Add("flightTime", fdrFile->GetFlightTime());
+		this->Add("sampleRate", fdrFile->GetSampleRate());
+		this->Add("startZulu", fdrFile->GetStartZulu());
+		this->Add("simApi", fdrFile->GetSimApi());
+	}
+	else {
+		FTDISFile* ftdisFile = new FTDISFile();
+		ftdisFiles.push_back(ftdisFile);
+		if (!ftdisFile->LoadFile(fileName)) {
+			std::cerr << "fdr-cli: can't load " << fileName << std::endl;
+			return fileError;
+		}
+
+		this->Add("type", "ftdis");
+		this->Add("records", (double)ftdisFile->GetRecords().size());
+	}
+	return ok;
+}
+
+
+/**
+* Saves a .fdr file with another codec. Archived (quantized) files are verified against their error budget
+*/
+int CliMain::Convert() {
+	std::string inFile = files.at(0), outFile = files.at(1);
+	FDRFileFormat::Codec codec = codecName == "lossless" ? FDRFileFormat::lossless : codecName == "quantized" ? FDRFileFormat::quantized : FDRFileFormat::raw;
+
+	if (!IsFDRFile(inFile)) {
+		std::cerr << "fdr-cli: convert requires a .fdr input file" << std::endl;
+		return usageError;
+	}
+
+	FDRFile* fdrFile = new FDRFile();
+	fdrFiles.push_back(fdrFile);
+
+	auto tStart = std::chrono::steady_clock::now();
+	if (!fdrFile->LoadFile(inFile)) {
+		std::cerr << "fdr-cli: can't load " << inFile << std::endl;
+		return fileError;
+	}
+	auto tLoaded = std::chrono::steady_clock::now();
+	if (!fdrFile->SaveFile(outFile, codec)) {
+		std::cerr << "fdr-cli: can't save " << outFile << std::endl;
+		return fileError;
+	}
+	auto tSaved = std::chrono::steady_clock::now();
+
+	this->Add("input", inFile);
+	this->Add("output", outFile);
+	this->Add("codec", codecName);
+	this->Add("records", fdrFile->GetSize());
+	this->Add("inputBytes", (double)GetFileBytes(inFile));
+	this->Add("outputBytes", (double)GetFileBytes(outFile));
+	this->Add("loadMs", std::chrono::duration<double, std::milli>(tLoaded - tStart).count());
+	this->Add("saveMs", std::chrono::duration<double, std::milli>(tSaved - tLoaded).count());
+
+	// Verify max. replay deviation of archived file against error budget
+	if (codec == FDRFileFormat::quantized) {
+		std::vector<FDRDeviationStruct> deviations;
+		bool verified = fdrFile->VerifyFile(outFile, deviations);
+		for (auto& deviation : deviations)
+			this->Add("maxDeviation." + std::string(deviation.field), deviation.maxDeviation);
+		this->Add("verified", verified ? "true" : "false", false);
+		if (!verified)
+			return runError;
+	}
+	return ok;
+}
+
+
+/**
+* Records from the sim, or replays canned frames through the local link, and saves the recording
+*/
+int CliMain::Record() {
+	std::string outFile = files.at(0);
+	FDRFileFormat::Codec codec = codecName == "lossless" ? FDRFileFormat::lossless : codecName == "quantized" ? FDRFileFormat::quantized : FDRFileFormat::raw;
+	int frames = maxFrames > 0 ? maxFrames : INT_MAX;
+
+	LocalSimLink* localLink = nullptr;
+	ISimLink* simLink = this->CreateSimLink(localLink);
+
+	// The local link replays the canned frames as user aircraft, i.e. sends a quit message after the last frame
+	if (localLink) {
+		if (sourceFile.empty()) {
+			delete simLink;
+			std::cerr << "fdr-cli: record via the local link requires --source" << std::endl;
+			return usageError;
+		}
+
+		FDRFile* sourceFdrFile = new FDRFile();
+		fdrFiles.push_back(sourceFdrFile);
+		if (!sourceFdrFile->LoadFile(sourceFile)) {
+			delete simLink;
+			std::cerr << "fdr-cli: can't load " << sourceFile << std::endl;
+			return fileError;
+		}
+
+		RecordSpan<FDRFileStruct> records = sourceFdrFile->GetRecords();
+		localLink->SetFrames(std::vector<FDRFileStruct>(records.data(), records.data() + records.size()));
+		if (sourceFdrFile->GetStartZulu() > 0.0)
+			localLink->SetStartZulu(sourceFdrFile->GetStartZulu());
+	}
+
+	FDRFile* fdrFile = new FDRFile();
+	fdrFiles.push_back(fdrFile);
+
+	Processor* processor = new Processor(nullptr, cpuCom, fdrFile);
+	processor->SetSimLink(simLink);
+	cpuCom->SetProcessorState(ProcessorCom::ProcessorState::record);
+
+	if (!processor->OpenSimLink()) {
+		delete processor;
+		std::cerr << "fdr-cli: can't connect to the sim" << std::endl;
+		return linkError;
+	}
+
+	// Record until the sim quits or the max. number of frames is reached
+	vector<double> frameTimes;
+	auto tStart = std::chrono::steady_clock::now();
+	bool received = this->RunFrames(processor, realTime ? nullptr : localLink, frames, 0, frameTimes);
+	double wallTimeSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+	// Write outstanding records
+	processor->Shutdown();
+	FDRRecorderStatsStruct stats = cpuCom->GetRecorderStats();
+	delete processor;
+
+	if (!fdrFile->SaveFile(outFile, codec)) {
+		std::cerr << "fdr-cli: can't save " << outFile << std::endl;
+		return fileError;
+	}
+
+	this->Add("output", outFile);
+	this->Add("codec", codecName);
+	this->Add("link", linkType);
+	this->Add("records", fdrFile->GetSize());
+	this->Add("published", (double)stats.published);
+	this->Add("written", (double)stats.written);
+	this->Add("dropped", (double)stats.dropped);
+	this->Add("failed", (double)stats.failed);
+	this->AddTiming(frameTimes, wallTimeSec);
+
+	if (!received)
+		return linkError;
+	return stats.dropped + stats.failed > 0 ? runError : ok;
+}
+
+
+/**
+* Replays the tracks. Replay runs until the user track ends, bench runs a fixed number of frames after a warm up
+*/
+int CliMain::Replay(bool bench) {
+	if (!this->LoadTracks())
+		return fileError;
+
+	// End of the user track, i.e. cursor position of the last record
+	int endPos = 0, frames = maxFrames;
+	Track* userTrack = tracks.at(0);
+	if (userTrack->GetFileType() == Track::FileType::FDR) {
+		endPos = userTrack->GetFDRFile()->GetSize();
+		if (frames == 0)
+			frames = (int)(userTrack->GetFDRFile()->GetFlightTime() * frameRate) + (int)(frameRate * 10);
+	}
+	else {
+		endPos = (int)userTrack->GetFTDISFile()->GetRecords().size();
+		if (frames == 0)
+			frames = (int)(endPos * frameRate);
+	}
+
+	if (bench) {
+		endPos = 0;
+		frames = maxFrames > 0 ? maxFrames : 1000;
+	}
+
+	LocalSimLink* localLink = nullptr;
+	Processor* processor = new Processor(nullptr, cpuCom, tracks);
+	processor->SetSimLink(this->CreateSimLink(localLink));
+	processor->SetComputeThreads((unsigned)computeThreads);
+	processor->SetTrafficLod(trafficLod);
+	processor->SetActivationLeadTime(leadTimeSec);
+	processor->SetAiPoolSize((unsigned)aiPoolSize);
+	processor->SetKeyframeInterval(keyframeSec);
+	if (clockMode == "wall")
+		processor->replayClock.SetMode(ReplayClock::Mode::wall);
+	else if (clockMode == "fixed") {
+		processor->replayClock.SetMode(ReplayClock::Mode::fixedStep);
+		processor->replayClock.SetFixedStep(1.0 / frameRate);
+	}
+	processor->frameProfiler.SetFrameBudget((int64_t)(1.0e9 / frameRate));
+	cpuCom->SetProfiling(profile);
+	cpuCom->SetProcessorState(ProcessorCom::ProcessorState::replay);
+	cpuCom->SetReplayRate(1.0F);
+
+	if (!processor->OpenSimLink()) {
+		delete processor;
+		std::cerr << "fdr-cli: can't connect to the sim" << std::endl;
+		return linkError;
+	}
+
+	// Warm up, i.e. creation of co-processors and AI objects isn't part of the timing
+	vector<double> frameTimes;
+	bool received = true;
+	if (bench || seekSec >= 0)
+		received = this->RunFrames(processor, realTime ? nullptr : localLink, warmupFrames, 0, frameTimes);
+	frameTimes.clear();
+	processor->writeStats = SimDataBatch::Stats();
+	processor->trafficLod.stats = TrafficLodScheduler::Stats();
+	processor->keyframeStats = TrackKeyframes::Stats();
+	processor->frameProfiler.Reset();
+
+	// Seek with the first frame timed, i.e. the tracks of the warm up are placed in the sim
+	if (seekSec >= 0)
+		cpuCom->RequestSeek(seekSec);
+
+	auto tStart = std::chrono::steady_clock::now();
+	if (received)
+		received = this->RunFrames(processor, realTime ? nullptr : localLink, frames, endPos, frameTimes);
+	double wallTimeSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+	int cursorPos = cpuCom->GetCursorPos();
+	uint64_t setDataCount = localLink ? localLink->GetSetDataCount() : 0;
+	SimDataBatch::Stats writeStats = processor->writeStats;
+	TrafficLodScheduler::Stats lodStats = processor->trafficLod.stats;
+	TrackActivationScheduler::Stats activationStats = processor->trackActivation.stats;
+	AiObjectPool::Stats poolStats = processor->GetAiPoolStats();
+	TrackKeyframes::Stats keyframeStats = processor->keyframeStats;
+	ReplayClock::Stats clockStats = processor->replayClock.stats;
+	double replayTimeSec = processor->replayClock.GetTime();
+	FrameProfiler profiler = processor->frameProfiler;
+	processor->Shutdown();
+	delete processor;
+
+	this->Add("command", command);
+	this->Add("link", linkType);
+	this->Add("tracks", (double)tracks.size());
+	this->Add("simApi", simApi);
+	this->Add("threads", computeThreads);
+	this->Add("rate", frameRate);
+	this->Add("cursorPos", cursorPos);
+	this->Add("endPos", endPos);
+	if (localLink)
+		this->Add("setDataCalls", (double)setDataCount);
+	this->Add("writes.fields", (double)writeStats.fieldWrites);
+	this->Add("writes.suppressed", (double)writeStats.suppressedWrites);
+	this->Add("writes.events", (double)writeStats.eventWrites);
+	this->Add("writes.suppressedEvents", (double)writeStats.suppressedEvents);
+	this->Add("writes.batchCalls", (double)writeStats.setDataCalls);
+	this->Add("writes.callsSavedPerFrame", frameTimes.empty() ? 0.0 : (double)writeStats.GetCallsSaved() / frameTimes.size());
+	this->Add("ai.activated", (double)activationStats.activated);
+	this->Add("ai.retired", (double)activationStats.retired);
+	this->Add("ai.peakActive", (double)activationStats.peakActive);
+	this->Add("ai.created", (double)poolStats.created);
+	this->Add("ai.prewarmed", (double)poolStats.prewarmed);
+	this->Add("ai.reused", (double)poolStats.reused);
+	this->Add("ai.removed", (double)poolStats.removed);
+	if (seekSec >= 0) {
+		this->Add("seek", seekSec);
+		this->Add("seek.frameMs", frameTimes.empty() ? 0.0 : frameTimes.front());
+		this->Add("keyframes", (double)keyframeStats.keyframes);
+		this->Add("keyframes.builds", (double)keyframeStats.builds);
+		this->Add("keyframes.restores", (double)keyframeStats.restores);
+		this->Add("keyframes.steps", (double)keyframeStats.steps);
+	}
+	this->Add("clock", clockMode);
+	this->Add("clock.replayTimeSec", replayTimeSec);
+	this->Add("clock.corrections", (double)clockStats.corrections);
+	this->Add("clock.resyncs", (double)clockStats.resyncs);
+	this->Add("clock.maxDriftMs", clockStats.maxDriftSec * 1000);
+	this->Add("lod", trafficLod ? "on" : "off");
+	this->Add("lod.full", (double)lodStats.full);
+	this->Add("lod.position", (double)lodStats.position);
+	this->Add("lod.skipped", (double)lodStats.skipped);
+	this->AddTiming(frameTimes, wallTimeSec);
+	if (profile)
+		this->AddProfile(profiler);
+
+	if (!received)
+		return linkError;
+	return ok;
+}
+
+
+/**
+* Measures the cost of routing the data responses (position, system and sim data per sim object) for a sweep of
+* sim object counts. The processor is stopped, i.e. the frames only run the dispatch of the responses
+*/
+int CliMain::BenchDispatch() {
+	int frames = maxFrames > 0 ? maxFrames : 1000;
+	std::stringstream sweepList(sweep.empty() ? "1,10,25,50,100" : sweep);
+	std::string item;
+
+	while (std::getline(sweepList, item, ',')) {
+		int objectCount = 0;
+		try {
+			objectCount = std::stoi(item);
+		}
+		catch (const std::exception&) {
+			objectCount = 0;
+		}
+		if (objectCount <= 0 || objectCount > 4096) {
+			std::cerr << "fdr-cli: invalid number of sim objects " << item << " (1..4096)" << std::endl;
+			return usageError;
+		}
+
+		FDRFile* fdrFile = new FDRFile();
+		fdrFiles.push_back(fdrFile);
+
+		LocalSimLink* localLink = new LocalSimLink(frameRate, false);
+		Processor* processor = new Processor(nullptr, cpuCom, fdrFile);
+		processor->SetSimLink(localLink);
+		cpuCom->SetProcessorState(ProcessorCom::ProcessorState::stop);
+
+		if (!processor->OpenSimLink()) {
+			delete processor;
+			return linkError;
+		}
+		for (int n = 0; n < objectCount; n++)
+			processor->RequestRecordData(processor->AddRequestSlot(), SIMCONNECT_OBJECT_ID_USER);
+
+		vector<double> frameTimes;
+		bool received = this->RunFrames(processor, localLink, warmupFrames, 0, frameTimes);
+		frameTimes.clear();
+		if (received)
+			received = this->RunFrames(processor, localLink, frames, 0, frameTimes);
+
+		processor->Shutdown();
+		delete processor;
+		if (!received)
+			return linkError;
+
+		// Per frame: 3 data responses per sim object and the frame event
+		double sum = 0.0;
+		for (double frameTime : frameTimes)
+			sum += frameTime;
+		std::sort(frameTimes.begin(), frameTimes.end());
+
+		size_t count = frameTimes.size();
+		double meanMs = count > 0 ? sum / count : 0.0;
+		std::string key = "dispatch." + std::to_string(objectCount) + ".";
+		this->Add(key + "frameMeanUs", meanMs * 1000.0);
+		this->Add(key + "frameP99Us", count > 0 ? frameTimes[(size_t)(count * 0.99) < count ? (size_t)(count * 0.99) : count - 1] * 1000.0 : 0.0);
+		this->Add(key + "messageNs", meanMs * 1.0e6 / (objectCount * 3 + 1));
+	}
+
+	this->Add("frames", frames);
+	return ok;
+}
+
+/**
+* Measures the cost of the reads of the Com handler per track and frame for a sweep of reader threads, i.e.
+* compute threads, while the GUI / REST API writes. Reports the lock-free Com handler and, as reference, the same
+* reads guarded by one mutex
+*/
+int CliMain::BenchCom() {
+	int rounds = maxFrames > 0 ? maxFrames : 1000000;
+	std::stringstream sweepList(sweep.empty() ? "1,2,4,8" : sweep);
+	std::string item;
+
+	while (std::getline(sweepList, item, ',')) {
+		int readers = 0;
+		try {
+			readers = std::stoi(item);
+		}
+		catch (const std::exception&) {
+			readers = 0;
+		}
+		if (readers <= 0 || readers > 256) {
+			std::cerr << "fdr-cli: invalid number of threads " << item << " (1..256)" << std::endl;
+			return usageError;
+		}
+
+		ProcessorCom com;
+		com.SetReplayRate(1.0F);
+		com.SetSimConnect(true);
+		MutexCom mutexCom;
+
+		double roundNs = RunComReaders(com, readers, rounds);
+		double mutexRoundNs = RunComReaders(mutexCom, readers, rounds);
+
+		std::string key = "com." + std::to_string(readers) + ".";
+		this->Add(key + "roundNs", roundNs);
+		this->Add(key + "mutexRoundNs", mutexRoundNs);
+		this->Add(key + "speedup", roundNs > 0 ? mutexRoundNs / roundNs : 0.0);
+	}
+
+	this->Add("rounds", rounds);
+	return ok;
+}
+
+/**
+* Loads the input files as tracks
+*/
+bool CliMain::LoadTracks() {
+	size_t count = trackCount > 0 ? (size_t)trackCount : files.size();
+	vector<FDRFile*> loadedFdr(files.size(), nullptr);
+	vector<FTDISFile*> loadedFtdis(files.size(), nullptr);
+
+	for (size_t n = 0; n < files.size(); n++) {
+		if (IsFDRFile(files.at(n))) {
+			loadedFdr[n] = new FDRFile();
+			fdrFiles.push_back(loadedFdr[n]);
+			if (!loadedFdr[n]->LoadFile(files.at(n))) {
+				std::cerr << "fdr-cli: can't load " << files.at(n) << std::endl;
+				return false;
+			}
+		}
+		else {
+			loadedFtdis[n] = new FTDISFile();
+			ftdisFiles.push_back(loadedFtdis[n]);
+			if (!loadedFtdis[n]->LoadFile(files.at(n))) {
+				std::cerr << "fdr-cli: can't load " << files.at(n) << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// Tracks share the loaded files (read-only during replay)
+	for (size_t n = 0; n < count; n++) {
+		Track* track = new Track(n == 0 ? Track::TrackType::USER : Track::TrackType::AI);
+		size_t fileNum = n % files.size();
+
+		track->SetTrackId((int)n);
+		track->SetFileName(files.at(fileNum));
+		track->SetSimApi(simApi);
+		track->SetTimeOffset(-staggerSec * n);
+		if (loadedFdr[fileNum]) {
+			track->SetFileType(Track::FileType::FDR);
+			track->SetFile(loadedFdr[fileNum]);
+		}
+		else {
+			track->SetFileType(Track::FileType::FTDIS);
+			track->SetFile(loadedFtdis[fileNum]);
+		}
+		tracks.push_back(track);
+	}
+	return true;
+}
+
+
+/**
+* Creates the link to the sim as per command line
+*/
+ISimLink* CliMain::CreateSimLink(LocalSimLink*& localLink) {
+	if (linkType == "simconnect") {
+		localLink = nullptr;
+		return new SimConnectLink();
+	}
+
+	localLink = new LocalSimLink(frameRate, realTime);
+	return localLink;
+}
+
+
+/**
+* Runs the processor frame by frame and measures the dispatch time of each frame
+*/
+bool CliMain::RunFrames(Processor* processor, LocalSimLink* localLink, int frames, int endPos, vector<double>& frameTimes) {
+	SimMessageSource* source = processor->simLink->GetMessageSource();
+	SimMessagePump pump(source, cpuCom->GetPumpMode(), cpuCom->GetPumpInterval());
+	int frame = 0;
+	auto tLastFrame = std::chrono::steady_clock::now();
+
+	while (frame < frames && cpuCom->GetSimConnect()) {
+		// Unpaced: emit the next frame right away. Paced: wait for the link as per pump policy, i.e. the wait isn't part of the timing
+		if (localLink)
+			localLink->Step(1);
+
+		if (!(localLink ? source->WaitForMessages(0) : pump.Wait())) {
+			// No frames from the sim for 5s
+			if (std::chrono::steady_clock::now() - tLastFrame > std::chrono::seconds(5))
+				return false;
+			continue;
+		}
+		tLastFrame = std::chrono::steady_clock::now();
+
+		auto tStart = std::chrono::steady_clock::now();
+		source->DispatchMessages();
+		frameTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tStart).count());
+		frame++;
+
+		if (endPos > 0 && cpuCom->GetCursorPos() >= endPos)
+			break;
+	}
+	return true;
+}
+
+
+/**
+* Adds the timing statistics of the frames to the output
+*/
+void CliMain::AddTiming(vector<double> frameTimes, double wallTimeSec) {
+	double sum = 0.0;
+	for (double frameTime : frameTimes)
+		sum += frameTime;
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	size_t count = frameTimes.size();
+	this->Add("frames", (double)count);
+	this->Add("wallTimeSec", wallTimeSec);
+	this->Add("frameMeanMs", count > 0 ? sum / count : 0.0);
+	this->Add("frameP50Ms", count > 0 ? frameTimes[count / 2] : 0.0);
+	this->Add("frameP99Ms", count > 0 ? frameTimes[(size_t)(count * 0.99) < count ? (size_t)(count * 0.99) : count - 1] : 0.0);
+	this->Add("frameMaxMs", count > 0 ? frameTimes[count - 1] : 0.0);
+	this->Add("framesPerSec", wallTimeSec > 0.0 ? count / wallTimeSec : 0.0);
+}
+
+
+/**
+* Adds the profile of the frames to the output
+*/
+void CliMain::AddProfile(const FrameProfiler& profiler) {
+	this->Add("profile.frames", (double)profiler.GetFrames());
+	this->Add("profile.overBudgetFrames", (double)profiler.GetOverBudgetFrames());
+	for (int n = 0; n < FrameProfiler::stageCount; n++) {
+		std::string key = std::string("profile.") + FrameProfiler::GetStageName((FrameProfiler::Stage)n);
+		const HdrHistogram& stage = profiler.GetStage((FrameProfiler::Stage)n);
+		this->Add(key + ".p50Us", stage.GetPercentile(50) / 1000.0);
+		this->Add(key + ".p99Us", stage.GetPercentile(99) / 1000.0);
+		this->Add(key + ".maxUs", stage.GetMax() / 1000.0);
+	}
+
+	const HdrHistogram& simCalls = profiler.GetSimCalls();
+	this->Add("profile.simCalls.p50", (double)simCalls.GetPercentile(50));
+	this->Add("profile.simCalls.p99", (double)simCalls.GetPercentile(99));
+	this->Add("profile.simCalls.max", (double)simCalls.GetMax());
+	this->Add("profile.simCalls.mean", simCalls.GetMean());
+
+	// Cost of a track per frame by sim model
+	for (auto& model : profiler.GetModels()) {
+		std::string key = "profile.simApi." + std::to_string(model.first);
+		this->Add(key + ".p99Us", model.second.GetPercentile(99) / 1000.0);
+		this->Add(key + ".maxUs", model.second.GetMax() / 1000.0);
+	}
+
+	// Most expensive tracks, by max. cost per frame
+	const vector<FrameProfiler::TrackCost>& trackCosts = profiler.GetTracks();
+	vector<size_t> top;
+	for (size_t n = 0; n < trackCosts.size(); n++)
+		if (trackCosts[n].frames > 0)
+			top.push_back(n);
+	std::sort(top.begin(), top.end(), [&trackCosts](size_t a, size_t b) { return trackCosts[a].maxNs > trackCosts[b].maxNs; });
+
+	for (size_t n = 0; n < top.size() && n < 5; n++) {
+		const FrameProfiler::TrackCost& trackCost = trackCosts[top[n]];
+		std::string key = "profile.top." + std::to_string(n);
+		this->Add(key + ".track", (double)top[n]);
+		this->Add(key + ".simApi", trackCost.simApi);
+		this->Add(key + ".maxUs", trackCost.maxNs / 1000.0);
+		this->Add(key + ".meanUs", trackCost.totalNs / 1000.0 / trackCost.frames);
+	}
+}
+
+
+/**
+* Adds a value to the output
+*/
+void CliMain::Add(const std::string& key, const std::string& value, bool quoted) {
+	fields.push_back({ key, value, quoted });
+}
+
+void CliMain::Add(const std::string& key, double value) {
+	std::ostringstream os;
+	os << value;
+	fields.push_back({ key, os.str(), false });
+}
+
+
+/**
+* Prints the output
+*/
+void CliMain::Print() {
+	if (outputFormat == "text") {
+		for (auto& field : fields)
+			std::cout << field.key << "=" << field.value << "\n";
+		std::cout.flush();
+		return;
+	}
+
+	std::cout << "{";
+	for (size_t n = 0; n < fields.size(); n++) {
+		std::cout << (n > 0 ? "," : "") << "\"" << fields[n].key << "\":";
+		if (!fields[n].quoted) {
+			std::cout << fields[n].value;
+			continue;
+		}
+
+		// Escape string values, e.g. Windows paths
+		std::cout << "\"";
+		for (char c : fields[n].value) {
+			if (c == '"' || c == '\\')
+				std::cout << '\\' << c;
+			else if ((unsigned char)c < 0x20)
+				std::cout << ' ';
+			else
+				std::cout << c;
+		}
+		std::cout << "\"";
+	}
+	std::cout << "}" << std::endl;
+}
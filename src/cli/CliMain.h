@@ -0,0 +1,151 @@
+#ifndef CliMain_H
+#define CliMain_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Forward declarations to avoid circular include.
+class Processor; // #include "Processor.h" in .cpp file
+class ProcessorCom; // #include "ProcessorCom.h" in .cpp file
+class Track; // #include "Track.h" in .cpp file
+class FDRFile; // #include "FDRFile.h" in .cpp file
+class FTDISFile; // #include "FTDISFile.h" in .cpp file
+class ISimLink; // #include "ISimLink.h" in .cpp file
+class LocalSimLink; // #include "LocalSimLink.h" in .cpp file
+class FrameProfiler; // #include "FrameProfiler.h" in .cpp file
+
+/**
+* Flight Data Recorder Command Line Interface
+*
+* Headless driver of the processor, i.e. records, replays, converts and inspects flight data
+* files without the GUI. Replays run against the local sim link (deterministic, unpaced by
+* default) or against the sim via SimConnect, and report the cost per frame. The dispatch benchmark
+* measures the routing of data responses for a sweep of sim object counts, the Com handler benchmark
+* the reads of the shared controls and options under contention. All results are
+* printed as key=value lines or as a single JSON object (--format json)
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class CliMain {
+
+public:
+	CliMain();
+	~CliMain();
+
+	enum ExitCode {
+		ok = 0,
+		usageError = 1,
+		fileError = 2,
+		linkError = 3,
+		runError = 4
+	};
+
+private:
+	struct Field {
+		std::string key;
+		std::string value;
+		bool quoted;
+	};
+
+	ProcessorCom* cpuCom = nullptr;
+	vector<Track*> tracks;
+	vector<FDRFile*> fdrFiles;
+	vector<FTDISFile*> ftdisFiles;
+	vector<Field> fields;
+
+	// Command line
+	std::string command, outputFormat = "text", linkType = "local", codecName = "raw", clockMode = "sim", pumpMode = "event", sourceFile, sweep;
+	vector<std::string> files;
+	double frameRate = 60.0, leadTimeSec = 10.0, staggerSec = 0, seekSec = -1, keyframeSec = 30.0;
+	bool realTime = false, trafficLod = true, profile = false;
+	int maxFrames = 0, trackCount = 0, warmupFrames = 60, simApi = 320, computeThreads = 0, aiPoolSize = 4, pumpInterval = 50;
+
+	/**
+	* Parses the command line
+	*
+	* @param	argc		Number of arguments
+	* @param	argv		Arguments
+	* @return	bool		False, if the command line is invalid
+	*/
+	bool ParseArgs(int argc, char* argv[]);
+
+	/**
+	* Prints the usage of the command line interface
+	*/
+	void PrintUsage();
+
+	/**
+	* Commands
+	*
+	* @return	int			Exit code
+	*/
+	int Inspect();
+	int Convert();
+	int Record();
+	int Replay(bool bench);
+	int BenchDispatch();
+	int BenchCom();
+
+	/**
+	* Loads the input files as tracks. The first track is the user aircraft, the following are AI tracks.
+	* Tracks are repeated round robin up to the requested number of tracks (--tracks)
+	*
+	* @return	bool		False, if a file can't be loaded
+	*/
+	bool LoadTracks();
+
+	/**
+	* Creates the link to the sim as per command line
+	*
+	* @param	localLink	Receives the local link, nullptr if the link is SimConnect
+	* @return	ISimLink	Link, passed to the processor
+	*/
+	ISimLink* CreateSimLink(LocalSimLink*& localLink);
+
+	/**
+	* Runs the processor frame by frame and measures the dispatch time of each frame
+	*
+	* @param	processor	Processor, link opened
+	* @param	localLink	Local link to step (unpaced), nullptr if paced by the link
+	* @param	frames		Max. number of frames
+	* @param	endPos		Stops as soon as the cursor of the user track reaches this position (0 -> never)
+	* @param	frameTimes	Receives the dispatch time of each frame (in ms)
+	* @return	bool		False, if the sim didn't send any frames
+	*/
+	bool RunFrames(Processor* processor, LocalSimLink* localLink, int frames, int endPos, vector<double>& frameTimes);
+
+	/**
+	* Adds the timing statistics of the frames (mean, p50, p99, max in ms) to the output
+	*/
+	void AddTiming(vector<double> frameTimes, double wallTimeSec);
+
+	/**
+	* Adds the profile of the frames to the output, i.e. the stages (p50, p99, max in us), the SimConnect
+	* calls per frame, the cost of a track by sim model and the most expensive tracks (--profile)
+	*/
+	void AddProfile(const FrameProfiler& profiler);
+
+	/**
+	* Adds a value to the output
+	*/
+	void Add(const std::string& key, const std::string& value, bool quoted = true);
+	void Add(const std::string& key, double value);
+
+	/**
+	* Prints the output, i.e. key=value lines or a JSON object
+	*/
+	void Print();
+
+public:
+	/**
+	* Runs the command given on the command line
+	*
+	* @param	argc		Number of arguments
+	* @param	argv		Arguments
+	* @return	int			Exit code
+	*/
+	int Run(int argc, char* argv[]);
+};
+#endif
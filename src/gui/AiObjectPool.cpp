@@ -0,0 +1,202 @@
+#include "AiObjectPool.h"
+#include "ISimLink.h"
+#include <algorithm>
+
+/**
+* Constructor / Destructor
+*/
+AiObjectPool::AiObjectPool(ISimLink* link, SIMCONNECT_DATA_REQUEST_ID requestIdBase, SIMCONNECT_CLIENT_EVENT_ID freezeEventBase, UINT requestIdCount) {
+	this->simLink = link;
+	this->requestIdBase = requestIdBase;
+	this->requestIdCount = requestIdCount > 0 ? requestIdCount : 1;
+	this->freezeEventBase = freezeEventBase;
+
+	simLink->MapClientEventToSimEvent(freezeEventBase, "FREEZE_LATITUDE_LONGITUDE_SET");
+	simLink->MapClientEventToSimEvent(freezeEventBase + 1, "FREEZE_ALTITUDE_SET");
+	simLink->MapClientEventToSimEvent(freezeEventBase + 2, "FREEZE_ATTITUDE_SET");
+}
+
+AiObjectPool::~AiObjectPool() {
+
+}
+
+
+/**
+* Requests a new object from the sim
+*/
+HRESULT AiObjectPool::Create(const std::string& simCfgUuid, const SIMCONNECT_DATA_INITPOSITION& initPos, UINT owner, bool pooled) {
+	// Request IDs are reused round robin, i.e. in flight requests are limited to the number of IDs reserved
+	SIMCONNECT_DATA_REQUEST_ID requestId = requestIdBase + nextRequest;
+	if (requests.find(requestId) != requests.end())
+		return E_FAIL;
+	nextRequest = (nextRequest + 1) % requestIdCount;
+
+	HRESULT hr = simLink->AICreateNonATCAircraft(simCfgUuid.c_str(), "AI999", initPos, requestId);
+	if (FAILED(hr))
+		return hr;
+
+	requests[requestId] = { simCfgUuid, owner, pooled };
+	if (pooled)
+		pendingPooled[simCfgUuid].push_back(requestId);
+	stats.created++;
+	return hr;
+}
+
+
+/**
+* Freezes (1) or unfreezes (0) position and attitudes of an object
+*/
+HRESULT AiObjectPool::Freeze(DWORD objectId, DWORD freeze) {
+	HRESULT hr = S_OK;
+	for (SIMCONNECT_CLIENT_EVENT_ID eventId = freezeEventBase; eventId < freezeEventBase + 3; eventId++) {
+		HRESULT eventHr = simLink->TransmitClientEvent(objectId, eventId, freeze, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+		if (FAILED(eventHr))
+			hr = eventHr;
+	}
+	return hr;
+}
+
+
+/**
+* Unfreezes an object and removes it from the sim
+*/
+HRESULT AiObjectPool::Remove(DWORD objectId) {
+	this->Freeze(objectId, 0);
+	objects.erase(objectId);
+	stats.removed++;
+	return simLink->AIRemoveObject(objectId, 0);
+}
+
+
+/**
+* Sets the max. number of idle objects per sim model config
+*/
+void AiObjectPool::SetMaxIdle(size_t maxIdle) {
+	this->maxIdle = maxIdle;
+}
+
+
+/**
+* Returns the max. number of idle objects per sim model config
+*/
+size_t AiObjectPool::GetMaxIdle() const {
+	return maxIdle;
+}
+
+
+/**
+* Requests objects ahead of time, up to the given number of idle and pending objects of the sim model config
+*/
+HRESULT AiObjectPool::Prewarm(const std::string& simCfgUuid, const std::vector<SIMCONNECT_DATA_INITPOSITION>& initPos) {
+	HRESULT hr = S_OK;
+	size_t available = idle[simCfgUuid].size() + pendingPooled[simCfgUuid].size();
+
+	for (size_t i = available; i < initPos.size(); i++) {
+		hr = this->Create(simCfgUuid, initPos[i], 0, true);
+		if (FAILED(hr))
+			break;
+		stats.prewarmed++;
+	}
+	return hr;
+}
+
+
+/**
+* Requests an object for a track
+*/
+HRESULT AiObjectPool::Acquire(const std::string& simCfgUuid, const SIMCONNECT_DATA_INITPOSITION& initPos, UINT owner) {
+	// Idle object, handed over right away
+	auto idleObjects = idle.find(simCfgUuid);
+	if (idleObjects != idle.end() && !idleObjects->second.empty()) {
+		handovers.push_back({ owner, idleObjects->second.back() });
+		idleObjects->second.pop_back();
+		stats.reused++;
+		return S_OK;
+	}
+
+	// Pending prewarmed object, handed over once assigned (oldest request first)
+	auto pending = pendingPooled.find(simCfgUuid);
+	if (pending != pendingPooled.end() && !pending->second.empty()) {
+		Request& request = requests[pending->second.front()];
+		request.owner = owner;
+		request.pooled = false;
+		pending->second.pop_front();
+		stats.reused++;
+		return S_OK;
+	}
+
+	return this->Create(simCfgUuid, initPos, owner, false);
+}
+
+
+/**
+* Handles the object ID assigned by the sim to a creation request
+*/
+bool AiObjectPool::OnAssignedObjectId(SIMCONNECT_DATA_REQUEST_ID requestId, DWORD objectId) {
+	auto it = requests.find(requestId);
+	if (it == requests.end())
+		return false;
+
+	Request& request = it->second;
+	objects[objectId] = request.simCfgUuid;
+
+	if (request.pooled) {
+		std::deque<DWORD>& pending = pendingPooled[request.simCfgUuid];
+		pending.erase(std::remove(pending.begin(), pending.end(), requestId), pending.end());
+		idle[request.simCfgUuid].push_back(objectId);
+		this->Freeze(objectId, 1);
+	}
+	else
+		handovers.push_back({ request.owner, objectId });
+
+	requests.erase(it);
+	return true;
+}
+
+
+/**
+* Returns the next object to hand to a track
+*/
+bool AiObjectPool::NextHandover(UINT& owner, DWORD& objectId) {
+	if (handovers.empty())
+		return false;
+
+	owner = handovers.front().first;
+	objectId = handovers.front().second;
+	handovers.pop_front();
+	return true;
+}
+
+
+/**
+* Releases the object of a track
+*/
+HRESULT AiObjectPool::Release(DWORD objectId) {
+	auto object = objects.find(objectId);
+	if (object == objects.end())
+		return E_FAIL;
+
+	std::vector<DWORD>& idleObjects = idle[object->second];
+	if (std::find(idleObjects.begin(), idleObjects.end(), objectId) != idleObjects.end())
+		return S_FALSE;
+
+	if (idleObjects.size() >= maxIdle)
+		return this->Remove(objectId);
+
+	idleObjects.push_back(objectId);
+	stats.recycled++;
+	this->Freeze(objectId, 1);
+	return S_OK;
+}
+
+
+/**
+* Removes all idle objects from the sim
+*/
+void AiObjectPool::Clear() {
+	for (auto& idleObjects : idle) {
+		for (DWORD objectId : idleObjects.second)
+			this->Remove(objectId);
+	}
+	idle.clear();
+}
@@ -0,0 +1,159 @@
+#ifndef AiObjectPool_H
+#define AiObjectPool_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SimConnect.h"
+
+// Forward declarations to avoid circular include.
+class ISimLink; // #include "ISimLink.h" in .cpp file
+
+/**
+* Pool of the AI objects of the replay, keyed by the sim model config (SimCfgUuid)
+*
+* Objects are created ahead of time (Prewarm) and handed to the tracks as they become active. An object
+* released at the end of a track stays in the sim, idle, and is handed to the next track of the same sim
+* model config, i.e. creating an object, which is slow and asynchronous, mostly happens before the replay
+* starts. Every creation request gets a request ID of its own, i.e. the object IDs assigned by the sim
+* (SIMCONNECT_RECV_ID_ASSIGNED_OBJECT_ID) are matched by request ID rather than by arrival order.
+*
+* Objects are handed over via NextHandover, i.e. an object requested by a track is handed over once
+* assigned, an idle object with the next call
+*
+* Idle objects are frozen (position and attitudes), i.e. they don't fly off under the AI physics of the sim.
+* An object stays frozen while handed over and is unfrozen only when removed from the sim
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class AiObjectPool {
+
+public:
+	struct Stats {
+		uint64_t created = 0;		// Objects requested from the sim
+		uint64_t prewarmed = 0;		// Objects requested ahead of time
+		uint64_t reused = 0;		// Objects handed to a track from the pool, incl. pending prewarmed objects
+		uint64_t recycled = 0;		// Objects released to the pool
+		uint64_t removed = 0;		// Objects removed from the sim
+	};
+
+	/**
+	* Constructor
+	*
+	* @param	link			Link to the sim
+	* @param	requestIdBase	First request ID of the creation requests, e.g. Processor::REQ_AI_AC
+	* @param	freezeEventBase	First of the 3 client event IDs to freeze the idle objects, e.g. Processor::KEY_FREEZE_POOLED_AI
+	* @param	requestIdCount	Number of request IDs reserved for the creation requests
+	*/
+	AiObjectPool(ISimLink* link, SIMCONNECT_DATA_REQUEST_ID requestIdBase, SIMCONNECT_CLIENT_EVENT_ID freezeEventBase, UINT requestIdCount = 0x1000);
+	~AiObjectPool();
+
+private:
+	struct Request {
+		std::string simCfgUuid;
+		UINT owner;
+		bool pooled;
+	};
+
+	ISimLink* simLink = nullptr;
+	SIMCONNECT_DATA_REQUEST_ID requestIdBase = 0;
+	UINT requestIdCount = 0, nextRequest = 0;
+	SIMCONNECT_CLIENT_EVENT_ID freezeEventBase = 0;
+	size_t maxIdle = 4;
+
+	std::unordered_map<DWORD, Request> requests;
+	std::unordered_map<std::string, std::deque<DWORD>> pendingPooled;
+	std::unordered_map<DWORD, std::string> objects;
+	std::unordered_map<std::string, std::vector<DWORD>> idle;
+	std::deque<std::pair<UINT, DWORD>> handovers;
+
+	/**
+	* Requests a new object from the sim
+	*/
+	HRESULT Create(const std::string& simCfgUuid, const SIMCONNECT_DATA_INITPOSITION& initPos, UINT owner, bool pooled);
+
+	/**
+	* Freezes (1) or unfreezes (0) position and attitudes of an object
+	*/
+	HRESULT Freeze(DWORD objectId, DWORD freeze);
+
+	/**
+	* Unfreezes an object and removes it from the sim
+	*/
+	HRESULT Remove(DWORD objectId);
+
+public:
+	Stats stats;
+
+	/**
+	* Sets the max. number of idle objects per sim model config. Objects released beyond are removed from the sim
+	*
+	* @param	maxIdle		Max. number of idle objects (default: 4)
+	* @return	void
+	*/
+	void SetMaxIdle(size_t maxIdle);
+
+	/**
+	* Returns the max. number of idle objects per sim model config
+	*/
+	size_t GetMaxIdle() const;
+
+	/**
+	* Requests objects ahead of time, up to the given number of idle and pending objects of the sim model config
+	*
+	* @param	simCfgUuid	Sim model config
+	* @param	initPos		Initial positions, one per object
+	* @return	HRESULT
+	*/
+	HRESULT Prewarm(const std::string& simCfgUuid, const std::vector<SIMCONNECT_DATA_INITPOSITION>& initPos);
+
+	/**
+	* Requests an object for a track. An idle object of the sim model config is reused, otherwise
+	* a pending prewarmed object is claimed or a new object is requested
+	*
+	* @param	simCfgUuid	Sim model config
+	* @param	initPos		Initial position, if a new object is requested
+	* @param	owner		Track (index) the object is handed to
+	* @return	HRESULT
+	*/
+	HRESULT Acquire(const std::string& simCfgUuid, const SIMCONNECT_DATA_INITPOSITION& initPos, UINT owner);
+
+	/**
+	* Handles the object ID assigned by the sim to a creation request
+	*
+	* @param	requestId	Request ID of the creation request
+	* @param	objectId	Object ID assigned
+	* @return	bool		False, if the request isn't a request of the pool
+	*/
+	bool OnAssignedObjectId(SIMCONNECT_DATA_REQUEST_ID requestId, DWORD objectId);
+
+	/**
+	* Returns the next object to hand to a track
+	*
+	* @param	owner		Track (index) (out)
+	* @param	objectId	Object ID (out)
+	* @return	bool		False, if there is no object to hand over
+	*/
+	bool NextHandover(UINT& owner, DWORD& objectId);
+
+	/**
+	* Releases the object of a track, i.e. the object idles (frozen) in the pool or is removed from the sim
+	*
+	* @param	objectId	Object ID
+	* @return	HRESULT		E_FAIL, if the object isn't an object of the pool, S_FALSE if already idle
+	*/
+	HRESULT Release(DWORD objectId);
+
+	/**
+	* Removes all idle objects from the sim
+	*
+	* @param	void
+	* @return	void
+	*/
+	void Clear();
+};
+#endif
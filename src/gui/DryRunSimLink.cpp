@@ -0,0 +1,95 @@
+#include "DryRunSimLink.h"
+
+/**
+* Constructor / Destructor
+*/
+DryRunSimLink::DryRunSimLink() {
+
+}
+
+DryRunSimLink::~DryRunSimLink() {
+
+}
+
+
+/**
+* Returns the number of calls discarded
+*/
+uint64_t DryRunSimLink::GetDiscardCount() const {
+	return discardCount;
+}
+
+
+/**
+* Connection, i.e. there is nothing to connect to
+*/
+bool DryRunSimLink::Open(const char* name, DispatchProc dispatchProc, void* context) {
+	return true;
+}
+
+HRESULT DryRunSimLink::Close() {
+	return S_OK;
+}
+
+SimMessageSource* DryRunSimLink::GetMessageSource() {
+	return nullptr;
+}
+
+
+/**
+* SimConnect API, all calls are discarded
+*/
+HRESULT DryRunSimLink::AddToDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId, const char* datumName, const char* unitsName, SIMCONNECT_DATATYPE datumType, float epsilon, DWORD datumId) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::ClearDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::RequestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID requestId, SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags, DWORD origin, DWORD interval, DWORD limit) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::SetDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_SET_FLAG flags, DWORD arrayCount, DWORD unitSize, void* dataSet) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::SubscribeToSystemEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* systemEventName) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::MapClientEventToSimEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* eventName) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::TransmitClientEvent(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data, SIMCONNECT_NOTIFICATION_GROUP_ID groupId, SIMCONNECT_EVENT_FLAG flags) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::AICreateNonATCAircraft(const char* containerTitle, const char* tailNumber, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::AICreateSimulatedObject(const char* containerTitle, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::AIReleaseControl(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	discardCount++;
+	return S_OK;
+}
+
+HRESULT DryRunSimLink::AIRemoveObject(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	discardCount++;
+	return S_OK;
+}
@@ -0,0 +1,51 @@
+#ifndef DryRunSimLink_H
+#define DryRunSimLink_H
+#define _WINSOCKAPI_ 
+
+#include <windows.h>
+#include <cstdint>
+#include "SimConnect.h"
+#include "ISimLink.h"
+
+/**
+* Dry run sim link
+*
+* Discards all calls, i.e. the sim models run their procedures without reaching the sim. Used by the
+* processor while the co-processors build the keyframes of their tracks and fast-forward after a seek
+* (see Processor::BeginDryRun). Calls succeed, but no responses are delivered
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class DryRunSimLink : public ISimLink
+{
+
+public:
+	DryRunSimLink();
+	~DryRunSimLink();
+
+private:
+	uint64_t discardCount = 0;
+
+public:
+	/**
+	* Returns the number of calls discarded
+	*/
+	uint64_t GetDiscardCount() const;
+
+	bool Open(const char* name, DispatchProc dispatchProc, void* context);
+	HRESULT Close();
+	SimMessageSource* GetMessageSource();
+
+	HRESULT AddToDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId, const char* datumName, const char* unitsName, SIMCONNECT_DATATYPE datumType = SIMCONNECT_DATATYPE_FLOAT64, float epsilon = 0, DWORD datumId = SIMCONNECT_UNUSED);
+	HRESULT ClearDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId);
+	HRESULT RequestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID requestId, SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags = 0, DWORD origin = 0, DWORD interval = 0, DWORD limit = 0);
+	HRESULT SetDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_SET_FLAG flags, DWORD arrayCount, DWORD unitSize, void* dataSet);
+	HRESULT SubscribeToSystemEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* systemEventName);
+	HRESULT MapClientEventToSimEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* eventName = "");
+	HRESULT TransmitClientEvent(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data, SIMCONNECT_NOTIFICATION_GROUP_ID groupId, SIMCONNECT_EVENT_FLAG flags);
+	HRESULT AICreateNonATCAircraft(const char* containerTitle, const char* tailNumber, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AICreateSimulatedObject(const char* containerTitle, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AIReleaseControl(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AIRemoveObject(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId);
+};
+#endif
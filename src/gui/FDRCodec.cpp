@@ -0,0 +1,499 @@
+#include "FDRCodec.h"
+#include "FDRFileFormat.h"
+#include <cstring>
+#include <cmath>
+
+namespace FDRCodec
+{
+	/**
+	* Writes values of up to 64 bits to a byte stream, most significant bit first
+	*/
+	class BitWriter {
+	public:
+		BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+		void Write(uint64_t value, int bits) {
+			while (bits > 0) {
+				int space = 8 - curBits;
+				int take = bits < space ? bits : space;
+				uint8_t chunk = (uint8_t)((value >> (bits - take)) & ((1u << take) - 1));
+				cur |= (uint8_t)(chunk << (space - take));
+				curBits += take;
+				bits -= take;
+				if (curBits == 8) {
+					out.push_back(cur);
+					cur = 0;
+					curBits = 0;
+				}
+			}
+		}
+
+		void WriteVarint(uint64_t value) {
+			while (value >= 0x80) {
+				this->Write((value & 0x7F) | 0x80, 8);
+				value >>= 7;
+			}
+			this->Write(value, 8);
+		}
+
+		// Pads the stream to the next byte boundary
+		void Flush() {
+			if (curBits > 0) {
+				out.push_back(cur);
+				cur = 0;
+				curBits = 0;
+			}
+		}
+
+	private:
+		std::vector<uint8_t>& out;
+		uint8_t cur = 0;
+		int curBits = 0;
+	};
+
+
+	/**
+	* Reads values of up to 64 bits from a byte stream, most significant bit first
+	*/
+	class BitReader {
+	public:
+		BitReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+		uint64_t Read(int bits) {
+			uint64_t value = 0;
+			while (bits > 0) {
+				if (pos >= size) {
+					error = true;
+					return 0;
+				}
+				int avail = 8 - curBits;
+				int take = bits < avail ? bits : avail;
+				uint64_t chunk = (data[pos] >> (avail - take)) & ((1u << take) - 1);
+				value = (value << take) | chunk;
+				curBits += take;
+				bits -= take;
+				if (curBits == 8) {
+					pos++;
+					curBits = 0;
+				}
+			}
+			return value;
+		}
+
+		uint64_t ReadVarint() {
+			uint64_t value = 0;
+			for (int shift = 0; shift < 64; shift += 7) {
+				uint64_t byte = this->Read(8);
+				value |= (byte & 0x7F) << shift;
+				if (!(byte & 0x80) || error)
+					return value;
+			}
+			error = true;
+			return value;
+		}
+
+		// Skips to the next byte boundary
+		void Align() {
+			if (curBits > 0) {
+				pos++;
+				curBits = 0;
+			}
+		}
+
+		bool error = false;
+
+	private:
+		const uint8_t* data;
+		size_t size, pos = 0;
+		int curBits = 0;
+	};
+
+
+	static int countLeadingZeros(uint64_t x) {
+		if (x == 0)
+			return 64;
+		int n = 0;
+		if (!(x & 0xFFFFFFFF00000000ull)) { n += 32; x <<= 32; }
+		if (!(x & 0xFFFF000000000000ull)) { n += 16; x <<= 16; }
+		if (!(x & 0xFF00000000000000ull)) { n += 8; x <<= 8; }
+		if (!(x & 0xF000000000000000ull)) { n += 4; x <<= 4; }
+		if (!(x & 0xC000000000000000ull)) { n += 2; x <<= 2; }
+		if (!(x & 0x8000000000000000ull)) { n += 1; }
+		return n;
+	}
+
+	static int countTrailingZeros(uint64_t x) {
+		if (x == 0)
+			return 64;
+		int n = 0;
+		while (!(x & 1)) {
+			x >>= 1;
+			n++;
+		}
+		return n;
+	}
+
+	static uint64_t zigZag(int64_t value) {
+		return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+	}
+
+	static int64_t unZigZag(uint64_t value) {
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	}
+
+	static uint64_t loadBits(const char* p, int width) {
+		if (width == 64) {
+			uint64_t value;
+			memcpy(&value, p, sizeof(value));
+			return value;
+		}
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static void storeBits(char* p, uint64_t value, int width) {
+		if (width == 64) {
+			memcpy(p, &value, sizeof(value));
+		}
+		else {
+			uint32_t value32 = (uint32_t)value;
+			memcpy(p, &value32, sizeof(value32));
+		}
+	}
+
+
+	/**
+	* XOR compression of floating point values (64 or 32 bit)
+	*/
+	static void encodeXor(BitWriter& bw, const char* field, uint32_t stride, uint32_t count, int width) {
+		uint64_t prev = loadBits(field, width);
+		bw.Write(prev, width);
+
+		int prevLead = -1, prevTrail = 0;
+		for (uint32_t n = 1; n < count; n++) {
+			uint64_t value = loadBits(field + (size_t)n * stride, width);
+			uint64_t x = value ^ prev;
+			prev = value;
+
+			if (x == 0) {
+				bw.Write(0, 1);
+				continue;
+			}
+
+			int lead = countLeadingZeros(x) - (64 - width);
+			int trail = countTrailingZeros(x);
+
+			// Reuse the previous window of meaningful bits, if the value fits into it
+			if (prevLead >= 0 && lead >= prevLead && trail >= prevTrail) {
+				bw.Write(2, 2);
+				bw.Write(x >> prevTrail, width - prevLead - prevTrail);
+			}
+			else {
+				int meaningful = width - lead - trail;
+				bw.Write(3, 2);
+				bw.Write(lead, 6);
+				bw.Write(meaningful - 1, 6);
+				bw.Write(x >> trail, meaningful);
+				prevLead = lead;
+				prevTrail = trail;
+			}
+		}
+	}
+
+	static bool decodeXor(BitReader& br, char* field, uint32_t stride, uint32_t count, int width) {
+		uint64_t prev = br.Read(width);
+		storeBits(field, prev, width);
+
+		int prevLead = -1, prevTrail = 0;
+		for (uint32_t n = 1; n < count && !br.error; n++) {
+			if (br.Read(1) != 0) {
+				uint64_t x;
+				if (br.Read(1) == 0) {
+					if (prevLead < 0)
+						return false;
+					x = br.Read(width - prevLead - prevTrail) << prevTrail;
+				}
+				else {
+					int lead = (int)br.Read(6);
+					int meaningful = (int)br.Read(6) + 1;
+					int trail = width - lead - meaningful;
+					if (trail < 0)
+						return false;
+					x = br.Read(meaningful) << trail;
+					prevLead = lead;
+					prevTrail = trail;
+				}
+				prev ^= x;
+			}
+			storeBits(field + (size_t)n * stride, prev, width);
+		}
+		return !br.error;
+	}
+
+
+	/**
+	* Returns true, if all values are multiples of 0.01, i.e. time stamps of the recorder
+	*/
+	static bool isHundredths(const char* field, uint32_t stride, uint32_t count) {
+		for (uint32_t n = 0; n < count; n++) {
+			float value;
+			memcpy(&value, field + (size_t)n * stride, sizeof(value));
+			if (!std::isfinite(value) || std::fabs(value) > 1e7f)
+				return false;
+			int64_t k = (int64_t)std::llround((double)value * 100.0);
+			float restored = (float)(k / 100.0);
+			if (memcmp(&restored, &value, sizeof(value)) != 0)
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	* Delta-of-delta compression of integer sequences
+	*/
+	static void encodeDeltaOfDelta(BitWriter& bw, const std::vector<int64_t>& values) {
+		int64_t prev = 0, prevDelta = 0;
+		for (size_t n = 0; n < values.size(); n++) {
+			int64_t k = values[n];
+
+			if (n == 0) {
+				bw.Write(zigZag(k), 64);
+			}
+			else {
+				int64_t delta = k - prev;
+				uint64_t dod = zigZag(delta - prevDelta);
+				if (dod == 0)
+					bw.Write(0, 1);
+				else if (dod < (1 << 7)) {
+					bw.Write(2, 2);
+					bw.Write(dod, 7);
+				}
+				else if (dod < (1 << 12)) {
+					bw.Write(6, 3);
+					bw.Write(dod, 12);
+				}
+				else {
+					bw.Write(7, 3);
+					bw.Write(dod, 64);
+				}
+				prevDelta = delta;
+			}
+			prev = k;
+		}
+	}
+
+	static bool decodeDeltaOfDelta(BitReader& br, std::vector<int64_t>& values, uint32_t count) {
+		values.resize(count);
+		int64_t prev = 0, prevDelta = 0;
+		for (uint32_t n = 0; n < count && !br.error; n++) {
+			int64_t k;
+			if (n == 0) {
+				k = unZigZag(br.Read(64));
+			}
+			else {
+				uint64_t dod = 0;
+				if (br.Read(1) != 0) {
+					if (br.Read(1) == 0)
+						dod = br.Read(7);
+					else if (br.Read(1) == 0)
+						dod = br.Read(12);
+					else
+						dod = br.Read(64);
+				}
+				prevDelta += unZigZag(dod);
+				k = prev + prevDelta;
+			}
+			values[n] = k;
+			prev = k;
+		}
+		return !br.error;
+	}
+
+
+	/**
+	* Delta-of-delta compression of time stamps (hundredths of a second)
+	*/
+	static void encodeHundredths(BitWriter& bw, const char* field, uint32_t stride, uint32_t count) {
+		std::vector<int64_t> values(count);
+		for (uint32_t n = 0; n < count; n++) {
+			float value;
+			memcpy(&value, field + (size_t)n * stride, sizeof(value));
+			values[n] = (int64_t)std::llround((double)value * 100.0);
+		}
+		encodeDeltaOfDelta(bw, values);
+	}
+
+	static bool decodeHundredths(BitReader& br, char* field, uint32_t stride, uint32_t count) {
+		std::vector<int64_t> values;
+		if (!decodeDeltaOfDelta(br, values, count))
+			return false;
+
+		for (uint32_t n = 0; n < count; n++) {
+			float value = (float)(values[n] / 100.0);
+			memcpy(field + (size_t)n * stride, &value, sizeof(value));
+		}
+		return true;
+	}
+
+
+	/**
+	* Returns true, if all values can be quantized to integer multiples of step
+	*/
+	static bool isQuantizable(const char* field, uint32_t stride, uint32_t count, double step) {
+		if (!(step > 0))
+			return false;
+
+		for (uint32_t n = 0; n < count; n++) {
+			double value;
+			memcpy(&value, field + (size_t)n * stride, sizeof(value));
+			if (!std::isfinite(value) || std::fabs(value / step) > 4.5e15)
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	* Quantization of floating point values to integer multiples of step (lossy), delta-of-delta compressed
+	*/
+	static void encodeQuantized(BitWriter& bw, const char* field, uint32_t stride, uint32_t count, double step) {
+		std::vector<int64_t> values(count);
+		for (uint32_t n = 0; n < count; n++) {
+			double value;
+			memcpy(&value, field + (size_t)n * stride, sizeof(value));
+			values[n] = (int64_t)std::llround(value / step);
+		}
+		encodeDeltaOfDelta(bw, values);
+	}
+
+	static bool decodeQuantized(BitReader& br, char* field, uint32_t stride, uint32_t count, double step) {
+		std::vector<int64_t> values;
+		if (!decodeDeltaOfDelta(br, values, count))
+			return false;
+
+		for (uint32_t n = 0; n < count; n++) {
+			double value = values[n] * step;
+			memcpy(field + (size_t)n * stride, &value, sizeof(value));
+		}
+		return true;
+	}
+
+
+	/**
+	* Run-length compression of discrete values
+	*/
+	static void encodeRunLength(BitWriter& bw, const char* field, uint32_t stride, uint32_t count) {
+		uint32_t n = 0;
+		while (n < count) {
+			int32_t value;
+			memcpy(&value, field + (size_t)n * stride, sizeof(value));
+
+			uint32_t run = 1;
+			while (n + run < count && memcmp(field + (size_t)(n + run) * stride, &value, sizeof(value)) == 0)
+				run++;
+
+			bw.WriteVarint(zigZag(value));
+			bw.WriteVarint(run);
+			n += run;
+		}
+	}
+
+	static bool decodeRunLength(BitReader& br, char* field, uint32_t stride, uint32_t count) {
+		uint32_t n = 0;
+		while (n < count && !br.error) {
+			int32_t value = (int32_t)unZigZag(br.ReadVarint());
+			uint64_t run = br.ReadVarint();
+			if (run == 0 || run > count - n)
+				return false;
+			for (uint64_t r = 0; r < run; r++, n++)
+				memcpy(field + (size_t)n * stride, &value, sizeof(value));
+		}
+		return !br.error;
+	}
+
+
+	/**
+	* Compresses a chunk of records
+	*/
+	void encodeChunk(const char* records, uint32_t recordSize, uint32_t recordCount, const std::vector<FDRFieldStruct>& schema, std::vector<uint8_t>& out, const std::vector<FDRQuantStruct>* quantTable) {
+		if (recordCount == 0)
+			return;
+
+		BitWriter bw(out);
+		for (size_t f = 0; f < schema.size(); f++) {
+			const FDRFieldStruct& field = schema[f];
+			const char* first = records + field.offset;
+
+			if (field.type == FDRFileFormat::float64 && field.size == 8) {
+				// Quantized codec: Fields without error budget (or out of range) remain lossless
+				if (quantTable) {
+					double step = f < quantTable->size() ? (*quantTable)[f].step : 0.0;
+					bool quantized = isQuantizable(first, recordSize, recordCount, step);
+					bw.Write(quantized ? 2 : 0, 8);
+					if (quantized) {
+						encodeQuantized(bw, first, recordSize, recordCount, step);
+						bw.Flush();
+						continue;
+					}
+				}
+				encodeXor(bw, first, recordSize, recordCount, 64);
+			}
+			else if (field.type == FDRFileFormat::float32 && field.size == 4) {
+				bool hundredths = isHundredths(first, recordSize, recordCount);
+				bw.Write(hundredths ? 1 : 0, 8);
+				if (hundredths)
+					encodeHundredths(bw, first, recordSize, recordCount);
+				else
+					encodeXor(bw, first, recordSize, recordCount, 32);
+			}
+			else if (field.type == FDRFileFormat::int32 && field.size == 4) {
+				encodeRunLength(bw, first, recordSize, recordCount);
+			}
+
+			// Each field starts at a byte boundary
+			bw.Flush();
+		}
+	}
+
+
+	/**
+	* Decompresses a chunk of records
+	*/
+	bool decodeChunk(const char* data, size_t size, uint32_t recordSize, uint32_t recordCount, const std::vector<FDRFieldStruct>& schema, char* records, const std::vector<FDRQuantStruct>* quantTable) {
+		if (recordCount == 0)
+			return true;
+
+		BitReader br(reinterpret_cast<const uint8_t*>(data), size);
+		for (size_t f = 0; f < schema.size(); f++) {
+			const FDRFieldStruct& field = schema[f];
+			if ((uint64_t)field.offset + field.size > recordSize)
+				return false;
+
+			char* first = records + field.offset;
+			bool result = true;
+
+			if (field.type == FDRFileFormat::float64 && field.size == 8) {
+				if (quantTable && br.Read(8) != 0) {
+					double step = f < quantTable->size() ? (*quantTable)[f].step : 0.0;
+					result = step > 0 && decodeQuantized(br, first, recordSize, recordCount, step);
+				}
+				else
+					result = decodeXor(br, first, recordSize, recordCount, 64);
+			}
+			else if (field.type == FDRFileFormat::float32 && field.size == 4) {
+				if (br.Read(8) != 0)
+					result = decodeHundredths(br, first, recordSize, recordCount);
+				else
+					result = decodeXor(br, first, recordSize, recordCount, 32);
+			}
+			else if (field.type == FDRFileFormat::int32 && field.size == 4) {
+				result = decodeRunLength(br, first, recordSize, recordCount);
+			}
+
+			if (!result || br.error)
+				return false;
+			br.Align();
+		}
+		return true;
+	}
+}
@@ -0,0 +1,51 @@
+#ifndef FDRCodec_H
+#define FDRCodec_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "FDRFileHeader.h"
+
+/**
+* Custom defined name space to collect the functions of the .fdr compression codecs
+*
+* Records are compressed in chunks. Within a chunk, each field of the record schema is stored as
+* a separate bit stream:
+* (1) float64 -> XOR with the previous value, only the meaningful bits are stored
+* (2) float32 -> delta-of-delta of hundredths, if all values are multiples of 0.01 (time stamps), XOR otherwise
+* (3) int32   -> run-length encoded
+* With a quantization table (lossy), float64 fields with an error budget are stored as integer
+* multiples of the quantization step, delta-of-delta compressed. Chunks are independent, i.e. any chunk can be decoded without decoding the preceding chunks
+*
+* @author muppetlabs@fswindowseat.com
+*/
+namespace FDRCodec
+{
+	/**
+	* Compresses a chunk of records
+	*
+	* @param	records			Pointer to the first record
+	* @param	recordSize		Size of a record in bytes
+	* @param	recordCount		Number of records
+	* @param	schema			Record schema
+	* @param	out				Vector of type uint8_t the compressed chunk is appended to
+	* @param	quantTable		Quantization steps per schema field (lossy), nullptr for lossless compression
+	* @return	void
+	*/
+	void encodeChunk(const char* records, uint32_t recordSize, uint32_t recordCount, const std::vector<FDRFieldStruct>& schema, std::vector<uint8_t>& out, const std::vector<FDRQuantStruct>* quantTable = nullptr);
+
+	/**
+	* Decompresses a chunk of records
+	*
+	* @param	data			Pointer to the compressed chunk
+	* @param	size			Size of the compressed chunk in bytes
+	* @param	recordSize		Size of a record in bytes
+	* @param	recordCount		Number of records
+	* @param	schema			Record schema
+	* @param	records			Pointer to memory for recordCount records. Fields not in the schema remain unchanged
+	* @param	quantTable		Quantization steps per schema field (lossy), nullptr for lossless compression
+	* @return	bool			False, if the chunk is corrupt
+	*/
+	bool decodeChunk(const char* data, size_t size, uint32_t recordSize, uint32_t recordCount, const std::vector<FDRFieldStruct>& schema, char* records, const std::vector<FDRQuantStruct>* quantTable = nullptr);
+}
+#endif
@@ -0,0 +1,15 @@
+#ifndef FDRDEVIATIONSTRUCT_H
+#define FDRDEVIATIONSTRUCT_H
+
+#include <string>
+
+struct FDRDeviationStruct
+{
+	std::string field;
+	double maxDeviation;
+	double maxError;
+	size_t record;
+	bool exceeded;		// Deviation exceeds the error budget (beyond floating point rounding of the restored value)
+};
+
+#endif
@@ -1,24 +1,92 @@
 #include "FDRFile.h"
+#include "FDRFileFormat.h"
+#include <filesystem>
+#include <cstring>
 
 FDRFile::FDRFile() {
 	size = 0;
 	flightTime = 0.0;
+	header = FDRFileFormat::createHeader();
 }
 
 FDRFile::~FDRFile() {
+	// Close open stream and clean up temporary recording file
+	if (streamWriter) {
+		streamWriter->Finalize();
+		delete streamWriter;
+	}
+
+	mappedFile.reset();
 
+	if (!streamFileName.empty()) {
+		std::error_code ec;
+		std::filesystem::remove(streamFileName, ec);
+	}
 }
 
 
 /**
-* Reads a vector of type FDRFileStruct to the input stream
+* Reads the .fdr file (v2 or legacy v1) to the file vector
 */
-void FDRFile::ReadVecFields(std::istream& inputStream, std::vector<FDRFileStruct>& vec)
+bool FDRFile::ReadFile(std::string fileName)
 {
-	typename std::vector<FDRFileStruct>::size_type size = 0;
-	inputStream.read(reinterpret_cast<char*>(&size), sizeof(size));
-	vec.resize((int)size);
-	inputStream.read(reinterpret_cast<char*>(&vec[0]), vec.size() * sizeof(vec[0]));
+	std::ifstream inputStream(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!inputStream.is_open())
+		return false;
+
+	std::vector<char> buffer((size_t)inputStream.tellg());
+	inputStream.seekg(0, std::ios::beg);
+	if (buffer.empty() || !inputStream.read(&buffer[0], buffer.size()))
+		return false;
+
+	const FDRFileStruct* records = nullptr;
+	if (!FDRFileFormat::parse(&buffer[0], buffer.size(), header, records, fileData))
+		return false;
+	quantProfile = FDRFileFormat::getQuantProfile(&buffer[0], buffer.size(), header);
+	fileIndex = FDRFileFormat::getIndex(&buffer[0], buffer.size(), header);
+
+	if (records)
+		fileData.assign(records, records + header.recordCount);
+
+	return true;
+}
+
+
+/**
+* Maps the .fdr file into memory (read-only, zero-copy)
+*/
+bool FDRFile::MapFile(std::string fileName) {
+	std::shared_ptr<MappedFile> mapping = MappedFile::Open(fileName);
+	if (!mapping)
+		return false;
+
+	const FDRFileStruct* records = nullptr;
+	if (!FDRFileFormat::parse(mapping->GetData(), mapping->GetSize(), header, records, fileData))
+		return false;
+	quantProfile = FDRFileFormat::getQuantProfile(mapping->GetData(), mapping->GetSize(), header);
+	fileIndex = FDRFileFormat::getIndex(mapping->GetData(), mapping->GetSize(), header);
+
+	// Records in a different layout have been converted to the file vector, the mapping isn't required
+	if (records) {
+		mappedFile = mapping;
+		mappedRecords = RecordSpan<FDRFileStruct>(records, header.recordCount);
+		fileData.clear();
+		fileData.shrink_to_fit();
+	}
+
+	return true;
+}
+
+
+/**
+* Copies the records of a memory mapped file to the file vector and releases the mapping
+*/
+void FDRFile::Detach() {
+	if (mappedFile) {
+		fileData.assign(mappedRecords.begin(), mappedRecords.end());
+		mappedRecords = RecordSpan<FDRFileStruct>();
+		mappedFile.reset();
+	}
 }
 
 
@@ -26,14 +94,21 @@ void FDRFile::ReadVecFields(std::istream& inputStream, std::vector<FDRFileStruct
 * Loads the .ftd file (FDR format) from a local directory
 */
 bool FDRFile::LoadFile(std::string fileName) {
+	mappedFile.reset();
+	mappedRecords = RecordSpan<FDRFileStruct>();
 
-	// Read input file to memory
-	std::ifstream in(fileName, std::ios::in | std::ios::binary);
-	ReadVecFields(in, fileData);
-	in.close();
+	// Map input file to memory. Fall back to reading the file, if it can't be mapped
+	columnsValid = false;
+	if (!this->MapFile(fileName) && !this->ReadFile(fileName)) {
+		header = FDRFileFormat::createHeader();
+		quantProfile = FDRQuantProfile();
+		fileIndex.clear();
+		fileData.clear();
+		return false;
+	}
 
 	// Confirm load and initialize process variables
-	if (fileData.size() > 0) {
+	if (this->GetRecords().size() > 0) {
 		this->type = saveFile;
 		return true;
 	}
@@ -45,17 +120,81 @@ bool FDRFile::LoadFile(std::string fileName) {
 /**
 * Saves the .fdr file to a local directory
 */
-bool FDRFile::SaveFile(std::string fileName) {
-	try {
-		std::ofstream outputStream(fileName, std::ios::out | std::ios::binary);
-		size_t sz = fileData.size();
-		outputStream.write(reinterpret_cast<const char*>(&sz), sizeof(sz));
-		outputStream.write(reinterpret_cast<const char*>(&fileData[0]), fileData.size() * sizeof(fileData[0]));
-		return true;
+bool FDRFile::SaveFile(std::string fileName, FDRFileFormat::Codec codec, const FDRQuantProfile* profile, std::vector<FDRDeviationStruct>* deviations) {
+	// Finalize open recording stream
+	if (this->IsStreaming() && !this->CloseStream())
+		return false;
+
+	// Release own mapping before replacing the mapped file
+	std::error_code ec;
+	if (mappedFile && std::filesystem::weakly_canonical(mappedFile->GetFileName(), ec) == std::filesystem::weakly_canonical(fileName, ec))
+		this->Detach();
+
+	// Write to a temporary file and replace the target, i.e. other tracks mapping the target keep reading the
+	// previous file. A target that can't be replaced (e.g. mapped by another track on Windows) is left untouched
+	std::string tmpFileName = fileName + ".tmp";
+	bool written = false;
+
+	// Recording is already on disk. Copy file instead of re-writing all records
+	if (streamSynced && codec == FDRFileFormat::raw) {
+		std::filesystem::copy_file(streamFileName, tmpFileName, std::filesystem::copy_options::overwrite_existing, ec);
+		written = !ec;
 	}
-	catch (const std::exception& e) {
+	// Always save in the current format, i.e. legacy files are upgraded
+	else {
+		try {
+			RecordSpan<FDRFileStruct> records = this->GetRecords();
+			FDRFileHeader fileHeader = this->CreateHeader(records.size(), records.empty() ? 0.0 : records.back().fltTime);
+
+			std::ofstream outputStream(tmpFileName, std::ios::out | std::ios::binary);
+			written = FDRFileFormat::writeFile(outputStream, fileHeader, records, codec, profile);
+			outputStream.close();
+			written = written && !outputStream.fail();
+		}
+		catch (const std::exception& e) {
+			written = false;
+		}
+	}
+
+	// Verify the temporary file, i.e. a file exceeding the error budget never replaces the target
+	if (written && deviations) {
+		written = this->VerifyFile(tmpFileName, *deviations);
+		MappedFile::Invalidate(tmpFileName);
+	}
+
+	if (written) {
+		std::filesystem::rename(tmpFileName, fileName, ec);
+		written = !ec;
+	}
+	if (!written) {
+		std::filesystem::remove(tmpFileName, ec);
 		return false;
 	}
+
+	MappedFile::Invalidate(fileName);
+	return true;
+}
+
+
+/**
+* Compares a saved (e.g. quantized) .fdr file with the records of this file
+*/
+bool FDRFile::VerifyFile(std::string fileName, std::vector<FDRDeviationStruct>& deviations) {
+	FDRFile savedFile;
+	deviations.clear();
+
+	if (!savedFile.LoadFile(fileName))
+		return false;
+
+	return savedFile.GetQuantProfile().Verify(this->GetRecords(), savedFile.GetRecords(), deviations);
+}
+
+
+/**
+* Returns the error budget of the loaded file
+*/
+FDRQuantProfile FDRFile::GetQuantProfile() {
+	return this->quantProfile;
 }
 
 
@@ -64,7 +203,18 @@ bool FDRFile::SaveFile(std::string fileName) {
 */
 bool FDRFile::AddRecord(FDRFileStruct dataRec) {
 	try {
-		fileData.push_back(dataRec);
+		if (streamWriter) {
+			streamWriter->Append(dataRec);
+			streamSize++;
+			streamFlightTime = dataRec.fltTime;
+		}
+		else {
+			this->Detach();
+			fileData.push_back(dataRec);
+			fileIndex.clear();
+			streamSynced = false;
+			columnsValid = false;
+		}
 		return true;
 	}
 	catch (const std::exception& e) {
@@ -73,12 +223,154 @@ bool FDRFile::AddRecord(FDRFileStruct dataRec) {
 }
 
 
+/**
+* Opens a stream to record data directly to an .fdr file on disk
+*/
+bool FDRFile::OpenStream(std::string fileName, bool keepRecords) {
+	if (streamWriter)
+		return false;
+
+	header = this->CreateHeader(0, 0.0);
+
+	streamWriter = new FDRStreamWriter();
+	if (!streamWriter->Open(fileName, header)) {
+		delete streamWriter;
+		streamWriter = nullptr;
+		return false;
+	}
+
+	// Continued recording: write the kept records first, before the previous file is released
+	RecordSpan<FDRFileStruct> records = keepRecords ? this->GetRecords() : RecordSpan<FDRFileStruct>();
+	for (const FDRFileStruct& record : records)
+		streamWriter->Append(record);
+
+	this->streamSize = (int)records.size();
+	this->streamFlightTime = records.empty() ? 0.0 : records.back().fltTime;
+	this->streamSynced = false;
+	this->type = tmpFile;
+	mappedFile.reset();
+	mappedRecords = RecordSpan<FDRFileStruct>();
+	fileData.clear();
+	fileData.shrink_to_fit();
+	fileIndex.clear();
+	columns.Clear();
+	timeIndex.Clear();
+	columnsValid = false;
+
+	// Remove previous temporary recording file
+	if (!streamFileName.empty() && streamFileName != fileName) {
+		std::error_code ec;
+		std::filesystem::remove(streamFileName, ec);
+	}
+	this->streamFileName = fileName;
+
+	return true;
+}
+
+
+/**
+* Finalizes the stream and loads the recorded data for replay
+*/
+bool FDRFile::CloseStream() {
+	if (!streamWriter)
+		return false;
+
+	streamWriter->SetHeader(this->CreateHeader(streamSize, streamFlightTime));
+	bool result = streamWriter->Finalize();
+	delete streamWriter;
+	streamWriter = nullptr;
+
+	// Load recording for replay. File type remains tmpFile
+	if (!this->MapFile(streamFileName) && !this->ReadFile(streamFileName)) {
+		fileData.clear();
+		fileIndex.clear();
+	}
+
+	columnsValid = false;
+	streamSynced = result && this->GetRecords().size() == (size_t)streamSize;
+	return result;
+}
+
+
+/**
+* Returns true, if a recording stream is open
+*/
+bool FDRFile::IsStreaming() {
+	return streamWriter != nullptr;
+}
+
+
+/**
+* Returns the number of records added to the open stream that couldn't be written to disk
+*/
+uint64_t FDRFile::GetStreamFailedCount() {
+	return streamWriter ? streamWriter->GetFailedCount() : 0;
+}
+
+
+/**
+* Cuts the recording at the given number of records
+*/
+void FDRFile::Truncate(int size) {
+	if (size < 0 || (size_t)size >= this->GetRecords().size())
+		return;
+
+	// Shrink the view of a memory mapped file, no need to copy any records
+	if (mappedFile)
+		mappedRecords = RecordSpan<FDRFileStruct>(mappedRecords.data(), size);
+	else
+		fileData.resize(size);
+
+	fileIndex.clear();
+	streamSynced = false;
+	columnsValid = false;
+}
+
+
+/**
+* Returns the records of the .fdr file
+*/
+RecordSpan<FDRFileStruct> FDRFile::GetRecords() {
+	if (mappedFile)
+		return mappedRecords;
+	else
+		return RecordSpan<FDRFileStruct>(fileData.data(), fileData.size());
+}
+
+
+/**
+* Returns the columnar representation of the .fdr file
+*/
+FDRTrackColumns* FDRFile::GetColumns() {
+	if (!columnsValid) {
+		columns.Build(this->GetRecords());
+
+		// Use the time index stored in the file, build it if there is none (e.g. legacy file)
+		if (!timeIndex.Assign(columns.GetTimes(), fileIndex, header.indexStride))
+			timeIndex.Build(columns.GetTimes());
+		columnsValid = true;
+	}
+	return &columns;
+}
+
+
+/**
+* Returns the time index of the .fdr file
+*/
+FDRTimeIndex* FDRFile::GetTimeIndex() {
+	this->GetColumns();
+	return &timeIndex;
+}
+
+
 /**
 * Returns the number of records of the .fdr file
 */
 int FDRFile::GetSize() {
-	if (fileData.size() > 0)
-		return static_cast<int>(fileData.size()) - 1;
+	if (streamWriter)
+		return streamSize > 0 ? streamSize - 1 : 0;
+	else if (this->GetRecords().size() > 0)
+		return static_cast<int>(this->GetRecords().size()) - 1;
 	else
 		return 0;
 }
@@ -87,8 +379,10 @@ int FDRFile::GetSize() {
 * Returns the total time (in s) of the flight tracked in the .fdr file
 */
 double FDRFile::GetFlightTime() {
-	if (fileData.size() > 0)
-		return fileData.back().fltTime;
+	if (streamWriter)
+		return streamFlightTime;
+	else if (this->GetRecords().size() > 0)
+		return this->GetRecords().back().fltTime;
 	else
 		return 0;
 }
@@ -101,3 +395,72 @@ double FDRFile::GetFlightTime() {
 FDRFile::FileType FDRFile::GetFileType() {
 	return this->type;
 }
+
+
+
+/**
+* Returns a v2 header with the metadata of the recording
+*/
+FDRFileHeader FDRFile::CreateHeader(size_t recordCount, double flightTime) {
+	FDRFileHeader fileHeader = FDRFileFormat::createHeader();
+	fileHeader.recordCount = recordCount;
+	fileHeader.sampleRate = FDRFileFormat::getSampleRate(recordCount, flightTime);
+	fileHeader.startZulu = header.startZulu;
+	memcpy(fileHeader.simApi, header.simApi, sizeof(fileHeader.simApi));
+
+	return fileHeader;
+}
+
+
+/**
+* Sets the zulu time (in s) of the first record
+*/
+void FDRFile::SetStartZulu(double startZulu) {
+	header.startZulu = startZulu;
+
+	if (streamWriter)
+		streamWriter->SetHeader(header);
+}
+
+
+/**
+* Returns the zulu time (in s) of the first record
+*/
+double FDRFile::GetStartZulu() {
+	return header.startZulu;
+}
+
+
+/**
+* Sets the name of the sim API the recording is made with
+*/
+void FDRFile::SetSimApi(std::string simApi) {
+	FDRFileFormat::setSimApi(header, simApi);
+
+	if (streamWriter)
+		streamWriter->SetHeader(header);
+}
+
+
+/**
+* Returns the name of the sim API the recording was made with
+*/
+std::string FDRFile::GetSimApi() {
+	return std::string(header.simApi, strnlen(header.simApi, sizeof(header.simApi)));
+}
+
+
+/**
+* Returns the mean sample rate (in Hz) of the recording
+*/
+double FDRFile::GetSampleRate() {
+	return FDRFileFormat::getSampleRate(this->GetRecords().size(), this->GetFlightTime());
+}
+
+
+/**
+* Returns the format version of the loaded file (1 = legacy)
+*/
+int FDRFile::GetFormatVersion() {
+	return (int)header.version;
+}
\ No newline at end of file
@@ -3,15 +3,20 @@
 
 #include "fstream"
 #include "vector"
+#include "memory"
 #include "FDRFileStruct.h"
+#include "FDRFileFormat.h"
+#include "FDRStreamWriter.h"
+#include "MappedFile.h"
+#include "RecordSpan.h"
+#include "FDRTrackColumns.h"
+#include "FDRTimeIndex.h"
 
 class FDRFile {
 
 public:
 	FDRFile();
 	~FDRFile();
-
-	std::vector<FDRFileStruct> fileData;
 	
 	enum FileType {
 		saveFile,
@@ -23,13 +28,50 @@ private:
 	double flightTime;
 
 	FileType type = tmpFile;
+	FDRFileHeader header;
+	FDRQuantProfile quantProfile;
+
+	std::vector<FDRFileStruct> fileData;
+	std::shared_ptr<MappedFile> mappedFile;
+	RecordSpan<FDRFileStruct> mappedRecords;
+	FDRTrackColumns columns;
+	FDRTimeIndex timeIndex;
+	std::vector<FDRIndexStruct> fileIndex;
+	bool columnsValid = false;
+
+	FDRStreamWriter* streamWriter = nullptr;
+	std::string streamFileName;
+	int streamSize = 0;
+	double streamFlightTime = 0.0;
+	bool streamSynced = false;
 
 	/**
-	* Reads a vector of type FDRFileStruct to the input stream
-	* @param	is			Address of input stream
-	* @param	vec			Address of vector of type FDRFileStruct
+	* Reads the .fdr file (v2 or legacy v1) to the file vector
+	* @param	fileName	Path and name of file
+	* @return	bool
 	*/
-	void ReadVecFields(std::istream& is, std::vector<FDRFileStruct>& vec);
+	bool ReadFile(std::string fileName);
+
+	/**
+	* Maps the .fdr file into memory (read-only, zero-copy)
+	* @param	fileName	Path and name of file
+	* @return	bool
+	*/
+	bool MapFile(std::string fileName);
+
+	/**
+	* Copies the records of a memory mapped file to the file vector and releases the
+	* mapping. Required before records are added to a file loaded from disk
+	*/
+	void Detach();
+
+	/**
+	* Returns a v2 header with the metadata of the recording
+	* @param	recordCount		Number of records
+	* @param	flightTime		Time stamp of the last record (in s)
+	* @return	FDRFileHeader
+	*/
+	FDRFileHeader CreateHeader(size_t recordCount, double flightTime);
 
 public:
 	/**
@@ -42,17 +84,86 @@ public:
 	/**
 	* Saves the .fdr file to a local directory
 	* @param	fileName		Path and name of file
+	* @param	codec			Raw records (default), lossless compression or quantized (lossy)
+	* @param	profile			Error budget per field (quantized only), nullptr -> archive profile
+	* @param	deviations		Receives the max. deviation per field of the saved file, nullptr -> not verified. The
+	*							file isn't saved, if a deviation exceeds the error budget
 	* @return   bool
 	*/
-	bool SaveFile(std::string fileName);
+	bool SaveFile(std::string fileName, FDRFileFormat::Codec codec = FDRFileFormat::raw, const FDRQuantProfile* profile = nullptr, std::vector<FDRDeviationStruct>* deviations = nullptr);
 
 	/**
-	* Loads the .fdr file from a local directory
+	* Compares a saved (e.g. quantized) .fdr file with the records of this file
+	* @param	fileName		Path and name of file
+	* @param	deviations		Vector of type FDRDeviationStruct, receives the max. deviation per field
+	* @return   bool			False, if the file can't be loaded or a deviation exceeds the error budget of the file
+	*/
+	bool VerifyFile(std::string fileName, std::vector<FDRDeviationStruct>& deviations);
+
+	/**
+	* Returns the error budget of the loaded file. Empty profile, if the file is lossless
+	*/
+	FDRQuantProfile GetQuantProfile();
+
+	/**
+	* Add data record to .fdr file vector or, if a stream is open, to the .fdr file on disk
 	* @param	dataRec		Data record
 	* @return   bool
 	*/
 	bool AddRecord(FDRFileStruct dataRec);
 
+	/**
+	* Opens a stream to record data directly to an .fdr file on disk. Records added 
+	* while the stream is open are written by a background thread and are not kept in memory
+	* @param	fileName		Path and name of (temporary) file
+	* @param	keepRecords		True -> the current records are written to the stream first, i.e. a truncated
+	*							recording is continued on disk
+	* @return   bool
+	*/
+	bool OpenStream(std::string fileName, bool keepRecords = false);
+
+	/**
+	* Finalizes the stream and loads the recorded data for replay
+	* @return   bool
+	*/
+	bool CloseStream();
+
+	/**
+	* Returns true, if a recording stream is open
+	*/
+	bool IsStreaming();
+
+	/**
+	* Returns the number of records added to the open stream that couldn't be written to disk
+	*/
+	uint64_t GetStreamFailedCount();
+
+	/**
+	* Cuts the recording at the given number of records
+	* @param	size		Number of records to keep
+	* @return   void
+	*/
+	void Truncate(int size);
+
+	/**
+	* Returns the records of the .fdr file. The view is invalidated by AddRecord, Truncate and LoadFile
+	* @return	RecordSpan	Read-only view of records
+	*/
+	RecordSpan<FDRFileStruct> GetRecords();
+
+	/**
+	* Returns the columnar representation of the .fdr file. Built with the first call, i.e. on the first replay
+	* access rather than on load, rebuilt if records have changed since. Not thread-safe, called by the processor
+	* @return	FDRTrackColumns		Pointer remains valid for the lifetime of the file
+	*/
+	FDRTrackColumns* GetColumns();
+
+	/**
+	* Returns the time index of the .fdr file, i.e. maps a time stamp to a record number in O(log n)
+	* @return	FDRTimeIndex		Pointer remains valid for the lifetime of the file
+	*/
+	FDRTimeIndex* GetTimeIndex();
+
 	/**
 	* Returns the number of records of the .fdr file
 	*/
@@ -69,5 +180,39 @@ public:
 	* (2) tmpFile -> tmp file for recording in progress
 	*/
 	FileType GetFileType();
+
+	/**
+	* Sets the zulu time (in s) of the first record
+	* @param	startZulu	Zulu time in s
+	* @return	void
+	*/
+	void SetStartZulu(double startZulu);
+
+	/**
+	* Returns the zulu time (in s) of the first record, 0 if unknown
+	*/
+	double GetStartZulu();
+
+	/**
+	* Sets the name of the sim API the recording is made with
+	* @param	simApi		Name of sim API
+	* @return	void
+	*/
+	void SetSimApi(std::string simApi);
+
+	/**
+	* Returns the name of the sim API the recording was made with, empty if unknown
+	*/
+	std::string GetSimApi();
+
+	/**
+	* Returns the mean sample rate (in Hz) of the recording
+	*/
+	double GetSampleRate();
+
+	/**
+	* Returns the format version of the loaded file. Legacy files (version 1) are saved as version 2
+	*/
+	int GetFormatVersion();
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,482 @@
+#include "FDRFileFormat.h"
+#include "FDRCodec.h"
+#include "FDRTimeIndex.h"
+#include <cstring>
+#include <cstddef>
+
+namespace FDRFileFormat
+{
+	// Record schema entries for fields of FDRFileStruct
+	#define FDR_FIELD(field, fieldType) { #field, (uint16_t)fieldType, (uint16_t)sizeof(FDRFileStruct::field), (uint32_t)offsetof(FDRFileStruct, field) }
+
+
+	/**
+	* Returns the schema of the native record layout (FDRFileStruct)
+	*/
+	const std::vector<FDRFieldStruct>& getSchema() {
+		static const std::vector<FDRFieldStruct> schema = {
+			FDR_FIELD(lat, float64),
+			FDR_FIELD(lon, float64),
+			FDR_FIELD(alt, float64),
+			FDR_FIELD(spd, float64),
+			FDR_FIELD(hdg, float64),
+			FDR_FIELD(pitch, float64),
+			FDR_FIELD(bank, float64),
+			FDR_FIELD(thr1, float64),
+			FDR_FIELD(thr2, float64),
+			FDR_FIELD(thr3, float64),
+			FDR_FIELD(thr4, float64),
+			FDR_FIELD(engN1E1, float64),
+			FDR_FIELD(engN1E2, float64),
+			FDR_FIELD(engN1E3, float64),
+			FDR_FIELD(engN1E4, float64),
+			FDR_FIELD(alr, float64),
+			FDR_FIELD(elev, float64),
+			FDR_FIELD(rudder, float64),
+			FDR_FIELD(flaps, float64),
+			FDR_FIELD(splr, float64),
+			FDR_FIELD(gearPos, float64),
+			FDR_FIELD(gearAngle, float64),
+			FDR_FIELD(fuelCtr, float64),
+			FDR_FIELD(fuelLeft, float64),
+			FDR_FIELD(fuelRight, float64),
+			FDR_FIELD(navL, int32),
+			FDR_FIELD(logoL, int32),
+			FDR_FIELD(beacL, int32),
+			FDR_FIELD(strbL, int32),
+			FDR_FIELD(taxiL, int32),
+			FDR_FIELD(rwyTurnL, int32),
+			FDR_FIELD(wngL, int32),
+			FDR_FIELD(lndgL, int32),
+			FDR_FIELD(fltTime, float32)
+		};
+		return schema;
+	}
+
+
+	/**
+	* Returns an initialized v2 header for the native record layout
+	*/
+	FDRFileHeader createHeader() {
+		FDRFileHeader header = {};
+		memcpy(header.magic, magic, sizeof(header.magic));
+		header.version = version;
+		header.headerSize = sizeof(FDRFileHeader);
+		header.recordSize = sizeof(FDRFileStruct);
+		header.fieldCount = (uint32_t)getSchema().size();
+		header.schemaOffset = sizeof(FDRFileHeader);
+
+		// Align records to 8 bytes, i.e. records of a memory mapped file can be accessed in place
+		header.dataOffset = (header.schemaOffset + header.fieldCount * sizeof(FDRFieldStruct) + 7) & ~(uint64_t)7;
+		setSimApi(header, "SimConnect");
+
+		return header;
+	}
+
+
+	/**
+	* Sets the name of the sim API the recording was made with
+	*/
+	void setSimApi(FDRFileHeader& header, std::string simApi) {
+		memset(header.simApi, 0, sizeof(header.simApi));
+		memcpy(header.simApi, simApi.c_str(), simApi.size() < sizeof(header.simApi) ? simApi.size() : sizeof(header.simApi) - 1);
+	}
+
+
+	/**
+	* Returns the mean sample rate (in Hz) of a recording
+	*/
+	double getSampleRate(uint64_t recordCount, double flightTime) {
+		if (recordCount < 2 || flightTime <= 0)
+			return 0;
+		return (recordCount - 1) / flightTime;
+	}
+
+
+	/**
+	* Writes header, schema and padding up to the first record
+	*/
+	bool writeHeader(std::ostream& os, const FDRFileHeader& header) {
+		const std::vector<FDRFieldStruct>& schema = getSchema();
+
+		os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		os.write(reinterpret_cast<const char*>(schema.data()), schema.size() * sizeof(FDRFieldStruct));
+
+		uint64_t pos = sizeof(header) + schema.size() * sizeof(FDRFieldStruct);
+		const char padding[8] = {};
+		if (header.dataOffset > pos)
+			os.write(padding, header.dataOffset - pos);
+
+		return os.good();
+	}
+
+
+	/**
+	* Reads a single field of a record as double
+	*/
+	static double readField(const char* rec, const FDRFieldStruct& field) {
+		if (field.type == float64 && field.size == sizeof(double)) {
+			double value;
+			memcpy(&value, rec + field.offset, sizeof(value));
+			return value;
+		}
+		else if (field.type == float32 && field.size == sizeof(float)) {
+			float value;
+			memcpy(&value, rec + field.offset, sizeof(value));
+			return value;
+		}
+		else if (field.type == int32 && field.size == sizeof(int32_t)) {
+			int32_t value;
+			memcpy(&value, rec + field.offset, sizeof(value));
+			return value;
+		}
+		return 0;
+	}
+
+
+	/**
+	* Writes a single field of a record from double
+	*/
+	static void writeField(char* rec, const FDRFieldStruct& field, double value) {
+		if (field.type == float64) {
+			memcpy(rec + field.offset, &value, sizeof(value));
+		}
+		else if (field.type == float32) {
+			float fValue = (float)value;
+			memcpy(rec + field.offset, &fValue, sizeof(fValue));
+		}
+		else if (field.type == int32) {
+			int32_t iValue = (int32_t)value;
+			memcpy(rec + field.offset, &iValue, sizeof(iValue));
+		}
+	}
+
+
+	/**
+	* Parses a legacy v1 .fdr file, i.e. record count followed by raw records
+	*/
+	static bool parseLegacy(const char* data, size_t size, FDRFileHeader& header, const FDRFileStruct*& records) {
+		if (size < sizeof(size_t))
+			return false;
+
+		size_t recordCount = 0;
+		memcpy(&recordCount, data, sizeof(recordCount));
+		if (recordCount > (size - sizeof(size_t)) / sizeof(FDRFileStruct))
+			return false;
+
+		header = createHeader();
+		header.version = 1;
+		header.recordCount = recordCount;
+		header.dataOffset = sizeof(size_t);
+		memset(header.simApi, 0, sizeof(header.simApi));
+
+		records = reinterpret_cast<const FDRFileStruct*>(data + sizeof(size_t));
+		if (recordCount > 0)
+			header.sampleRate = getSampleRate(recordCount, records[recordCount - 1].fltTime);
+
+		return true;
+	}
+
+
+	/**
+	* Reads the record schema stored in the file
+	*/
+	static std::vector<FDRFieldStruct> readSchema(const char* data, const FDRFileHeader& header) {
+		std::vector<FDRFieldStruct> fileSchema(header.fieldCount);
+		if (header.fieldCount > 0)
+			memcpy(&fileSchema[0], data + header.schemaOffset, header.fieldCount * sizeof(FDRFieldStruct));
+
+		for (FDRFieldStruct& field : fileSchema)
+			field.name[sizeof(field.name) - 1] = '\0';
+
+		return fileSchema;
+	}
+
+
+	/**
+	* Returns true, if the file schema matches the native record layout
+	*/
+	static bool isNative(const std::vector<FDRFieldStruct>& fileSchema, const FDRFileHeader& header) {
+		const std::vector<FDRFieldStruct>& schema = getSchema();
+		bool native = header.recordSize == sizeof(FDRFileStruct) && fileSchema.size() == schema.size();
+		for (size_t i = 0; native && i < schema.size(); i++) {
+			native = strncmp(fileSchema[i].name, schema[i].name, sizeof(schema[i].name)) == 0 && fileSchema[i].type == schema[i].type &&
+				fileSchema[i].size == schema[i].size && fileSchema[i].offset == schema[i].offset;
+		}
+		return native;
+	}
+
+
+	/**
+	* Converts records field by field (matched by name). Fields missing in the file remain zero
+	*/
+	static void convertRecords(const char* rec, size_t recordCount, const FDRFileHeader& header, const std::vector<FDRFieldStruct>& fileSchema, std::vector<FDRFileStruct>& converted) {
+		std::vector<std::pair<FDRFieldStruct, FDRFieldStruct>> fieldMap;
+		for (const FDRFieldStruct& field : getSchema()) {
+			for (const FDRFieldStruct& fileField : fileSchema) {
+				if (strcmp(fileField.name, field.name) == 0 && (uint64_t)fileField.offset + fileField.size <= header.recordSize) {
+					fieldMap.push_back(std::make_pair(fileField, field));
+					break;
+				}
+			}
+		}
+
+		converted.assign(recordCount, FDRFileStruct());
+		for (size_t n = 0; n < recordCount; n++, rec += header.recordSize) {
+			for (const auto& fields : fieldMap)
+				writeField(reinterpret_cast<char*>(&converted[n]), fields.second, readField(rec, fields.first));
+		}
+	}
+
+
+	/**
+	* Writes a complete .fdr file
+	*/
+	bool writeFile(std::ostream& os, FDRFileHeader header, RecordSpan<FDRFileStruct> records, Codec codec, const FDRQuantProfile* profile, uint32_t chunkRecords) {
+		header.codec = codec;
+		header.recordCount = records.size();
+		header.chunkRecords = 0;
+		header.chunkCount = 0;
+		header.chunkTableOffset = 0;
+		header.quantTableOffset = 0;
+
+		// Time index (skip table) is stored at the end of the file
+		std::vector<FDRIndexStruct> index;
+		if (records.size() > 0)
+			index = FDRTimeIndex::CreateEntries(&records.data()->fltTime, records.size(), sizeof(FDRFileStruct));
+		header.indexStride = FDRTimeIndex::defaultStride;
+		header.indexCount = index.size();
+
+		if (codec == raw) {
+			header.indexOffset = header.dataOffset + records.size() * sizeof(FDRFileStruct);
+			writeHeader(os, header);
+			if (records.size() > 0)
+				os.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FDRFileStruct));
+			if (!index.empty())
+				os.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(FDRIndexStruct));
+			return os.good();
+		}
+
+		// Compress chunks in memory first, i.e. the header can be written in one go
+		if (chunkRecords == 0)
+			chunkRecords = defaultChunkRecords;
+
+		std::vector<FDRQuantStruct> quantTable;
+		if (codec == quantized)
+			quantTable = (profile ? *profile : FDRQuantProfile::GetArchiveProfile()).CreateTable(getSchema());
+
+		std::vector<uint8_t> chunkData;
+		std::vector<FDRChunkStruct> chunkTable;
+		for (size_t first = 0; first < records.size(); first += chunkRecords) {
+			uint32_t count = (uint32_t)(records.size() - first < chunkRecords ? records.size() - first : chunkRecords);
+
+			FDRChunkStruct chunk = {};
+			chunk.offset = header.dataOffset + chunkData.size();
+			chunk.recordCount = count;
+			chunk.firstTime = records[first].fltTime;
+			chunk.lastTime = records[first + count - 1].fltTime;
+
+			FDRCodec::encodeChunk(reinterpret_cast<const char*>(records.data() + first), sizeof(FDRFileStruct), count, getSchema(), chunkData, codec == quantized ? &quantTable : nullptr);
+			chunk.size = (uint32_t)(header.dataOffset + chunkData.size() - chunk.offset);
+			chunkTable.push_back(chunk);
+		}
+
+		header.chunkRecords = chunkRecords;
+		header.chunkCount = chunkTable.size();
+		header.chunkTableOffset = header.dataOffset + chunkData.size();
+		if (codec == quantized)
+			header.quantTableOffset = header.chunkTableOffset + chunkTable.size() * sizeof(FDRChunkStruct);
+		header.indexOffset = header.chunkTableOffset + chunkTable.size() * sizeof(FDRChunkStruct) + quantTable.size() * sizeof(FDRQuantStruct);
+
+		writeHeader(os, header);
+		if (!chunkData.empty())
+			os.write(reinterpret_cast<const char*>(chunkData.data()), chunkData.size());
+		if (!chunkTable.empty())
+			os.write(reinterpret_cast<const char*>(chunkTable.data()), chunkTable.size() * sizeof(FDRChunkStruct));
+		if (!quantTable.empty())
+			os.write(reinterpret_cast<const char*>(quantTable.data()), quantTable.size() * sizeof(FDRQuantStruct));
+		if (!index.empty())
+			os.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(FDRIndexStruct));
+
+		return os.good();
+	}
+
+
+	/**
+	* Returns the chunk table of a compressed .fdr file
+	*/
+	std::vector<FDRChunkStruct> getChunkTable(const char* data, size_t size, const FDRFileHeader& header) {
+		std::vector<FDRChunkStruct> chunkTable;
+		if (header.codec == raw || header.chunkTableOffset > size || header.chunkCount > (size - header.chunkTableOffset) / sizeof(FDRChunkStruct))
+			return chunkTable;
+
+		chunkTable.resize((size_t)header.chunkCount);
+		if (!chunkTable.empty())
+			memcpy(&chunkTable[0], data + header.chunkTableOffset, chunkTable.size() * sizeof(FDRChunkStruct));
+
+		// Validate chunks against file size and record count
+		uint64_t recordCount = 0;
+		for (const FDRChunkStruct& chunk : chunkTable) {
+			if (chunk.offset > size || chunk.size > size - chunk.offset || chunk.recordCount == 0 || chunk.recordCount > header.chunkRecords) {
+				chunkTable.clear();
+				return chunkTable;
+			}
+			recordCount += chunk.recordCount;
+		}
+		if (recordCount != header.recordCount)
+			chunkTable.clear();
+
+		return chunkTable;
+	}
+
+
+	/**
+	* Returns the time index (skip table) of an .fdr file
+	*/
+	std::vector<FDRIndexStruct> getIndex(const char* data, size_t size, const FDRFileHeader& header) {
+		std::vector<FDRIndexStruct> index;
+		if (header.indexOffset == 0 || header.indexStride == 0 || header.indexOffset > size || header.indexCount > (size - header.indexOffset) / sizeof(FDRIndexStruct))
+			return index;
+
+		index.resize((size_t)header.indexCount);
+		if (!index.empty())
+			memcpy(&index[0], data + header.indexOffset, index.size() * sizeof(FDRIndexStruct));
+		return index;
+	}
+
+
+	/**
+	* Reads the quantization table of a quantized .fdr file, one entry per schema field
+	*/
+	static bool readQuantTable(const char* data, size_t size, const FDRFileHeader& header, std::vector<FDRQuantStruct>& quantTable) {
+		quantTable.clear();
+		if (header.codec != quantized)
+			return true;
+		if (header.quantTableOffset > size || header.fieldCount > (size - header.quantTableOffset) / sizeof(FDRQuantStruct))
+			return false;
+
+		quantTable.resize(header.fieldCount);
+		if (!quantTable.empty())
+			memcpy(&quantTable[0], data + header.quantTableOffset, quantTable.size() * sizeof(FDRQuantStruct));
+		return true;
+	}
+
+
+	/**
+	* Returns the error budget recorded in a quantized .fdr file
+	*/
+	FDRQuantProfile getQuantProfile(const char* data, size_t size, const FDRFileHeader& header) {
+		std::vector<FDRQuantStruct> quantTable;
+		if (header.codec != quantized || !readQuantTable(data, size, header, quantTable))
+			return FDRQuantProfile();
+
+		return FDRQuantProfile::CreateFromTable(readSchema(data, header), quantTable);
+	}
+
+
+	/**
+	* Decompresses chunks into a buffer of records in the layout of the file
+	*/
+	static bool decodeChunks(const char* data, size_t size, const FDRFileHeader& header, const std::vector<FDRFieldStruct>& fileSchema, const std::vector<FDRChunkStruct>& chunkTable, size_t firstChunk, size_t lastChunk, char* records) {
+		std::vector<FDRQuantStruct> quantTable;
+		if (header.codec == raw || !readQuantTable(data, size, header, quantTable))
+			return false;
+
+		for (size_t c = firstChunk; c <= lastChunk; c++) {
+			const FDRChunkStruct& chunk = chunkTable[c];
+			if (!FDRCodec::decodeChunk(data + chunk.offset, chunk.size, header.recordSize, chunk.recordCount, fileSchema, records, header.codec == quantized ? &quantTable : nullptr))
+				return false;
+			records += (size_t)chunk.recordCount * header.recordSize;
+		}
+		return true;
+	}
+
+
+	/**
+	* Decompresses a single chunk of a compressed .fdr file
+	*/
+	bool readChunk(const char* data, size_t size, const FDRFileHeader& header, uint64_t chunk, std::vector<FDRFileStruct>& records) {
+		std::vector<FDRChunkStruct> chunkTable = getChunkTable(data, size, header);
+		if (chunk >= chunkTable.size())
+			return false;
+
+		std::vector<FDRFieldStruct> fileSchema = readSchema(data, header);
+		if (isNative(fileSchema, header)) {
+			records.assign(chunkTable[chunk].recordCount, FDRFileStruct());
+			return decodeChunks(data, size, header, fileSchema, chunkTable, (size_t)chunk, (size_t)chunk, reinterpret_cast<char*>(records.data()));
+		}
+
+		std::vector<char> buffer((size_t)chunkTable[chunk].recordCount * header.recordSize);
+		if (!decodeChunks(data, size, header, fileSchema, chunkTable, (size_t)chunk, (size_t)chunk, buffer.data()))
+			return false;
+
+		convertRecords(buffer.data(), chunkTable[chunk].recordCount, header, fileSchema, records);
+		return true;
+	}
+
+
+	/**
+	* Parses an .fdr file (v2 or legacy v1) in memory
+	*/
+	bool parse(const char* data, size_t size, FDRFileHeader& header, const FDRFileStruct*& records, std::vector<FDRFileStruct>& converted) {
+		records = nullptr;
+		converted.clear();
+
+		if (size < sizeof(FDRFileHeader) || memcmp(data, magic, sizeof(magic)) != 0)
+			return parseLegacy(data, size, header, records);
+
+		memcpy(&header, data, sizeof(header));
+
+		// Validate header
+		if (header.version < 2 || header.version > version || header.headerSize < sizeof(FDRFileHeader) || header.recordSize == 0)
+			return false;
+		if (header.schemaOffset > size || header.fieldCount > (size - header.schemaOffset) / sizeof(FDRFieldStruct))
+			return false;
+		if (header.dataOffset > size || header.codec > quantized)
+			return false;
+		if (header.codec == raw && header.recordCount > (size - header.dataOffset) / header.recordSize)
+			return false;
+		if (header.indexOffset > size) {
+			header.indexOffset = 0;
+			header.indexCount = 0;
+		}
+		header.simApi[sizeof(header.simApi) - 1] = '\0';
+
+		std::vector<FDRFieldStruct> fileSchema = readSchema(data, header);
+		bool native = isNative(fileSchema, header);
+
+		// Uncompressed records in native layout can be used in place
+		if (header.codec == raw) {
+			if (native && header.dataOffset % alignof(FDRFileStruct) == 0) {
+				records = reinterpret_cast<const FDRFileStruct*>(data + header.dataOffset);
+				return true;
+			}
+
+			convertRecords(data + header.dataOffset, (size_t)header.recordCount, header, fileSchema, converted);
+			return true;
+		}
+
+		// Decompress all chunks
+		std::vector<FDRChunkStruct> chunkTable = getChunkTable(data, size, header);
+		if (chunkTable.size() != header.chunkCount)
+			return false;
+		if (chunkTable.empty())
+			return true;
+
+		if (native) {
+			converted.assign((size_t)header.recordCount, FDRFileStruct());
+			if (!decodeChunks(data, size, header, fileSchema, chunkTable, 0, chunkTable.size() - 1, reinterpret_cast<char*>(converted.data()))) {
+				converted.clear();
+				return false;
+			}
+			return true;
+		}
+
+		std::vector<char> buffer((size_t)header.recordCount * header.recordSize);
+		if (!decodeChunks(data, size, header, fileSchema, chunkTable, 0, chunkTable.size() - 1, buffer.data()))
+			return false;
+
+		convertRecords(buffer.data(), (size_t)header.recordCount, header, fileSchema, converted);
+		return true;
+	}
+}
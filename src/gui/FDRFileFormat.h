@@ -0,0 +1,153 @@
+#ifndef FDRFileFormat_H
+#define FDRFileFormat_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include "FDRFileStruct.h"
+#include "FDRFileHeader.h"
+#include "RecordSpan.h"
+#include "FDRQuantProfile.h"
+
+/**
+* Custom defined name space to collect the functions required to read and write the .fdr file format
+*
+* v2 container: FDRFileHeader | schema (FDRFieldStruct[]) | padding | records
+* v2 compressed: FDRFileHeader | schema (FDRFieldStruct[]) | padding | chunks | chunk table (FDRChunkStruct[])
+* v2 quantized:  as compressed, followed by the error budget per field (FDRQuantStruct[])
+* v2 (all):      followed by the time index (FDRIndexStruct[]), if indexOffset is set
+* v1 (legacy):  size_t record count | records
+*
+* Records are stored in the native layout of FDRFileStruct. The schema describes each field, so
+* files written with a different record layout are converted field by field (matched by name)
+*
+* @author muppetlabs@fswindowseat.com
+*/
+namespace FDRFileFormat
+{
+	const char magic[8] = { 'S', 'C', 'F', 'D', 'R', '\r', '\n', '\x1A' };
+	const uint32_t version = 2;
+
+	enum Codec {
+		raw = 0,
+		lossless = 1,
+		quantized = 2
+	};
+
+	const uint32_t defaultChunkRecords = 4096;
+
+	enum FieldType {
+		float64 = 1,
+		float32 = 2,
+		int32 = 3
+	};
+
+	/**
+	* Returns the schema of the native record layout (FDRFileStruct)
+	*
+	* @return	vector		Vector of type FDRFieldStruct
+	*/
+	const std::vector<FDRFieldStruct>& getSchema();
+
+	/**
+	* Returns an initialized v2 header for the native record layout, with zero records
+	*
+	* @return	FDRFileHeader
+	*/
+	FDRFileHeader createHeader();
+
+	/**
+	* Sets the name of the sim API the recording was made with (truncated to 31 characters)
+	*
+	* @param	header		Address of header
+	* @param	simApi		Name of sim API, e.g. SimConnect and sim version
+	* @return	void
+	*/
+	void setSimApi(FDRFileHeader& header, std::string simApi);
+
+	/**
+	* Returns the mean sample rate (in Hz) of a recording
+	*
+	* @param	recordCount		Number of records
+	* @param	flightTime		Time stamp of the last record (in s)
+	* @return	double			Sample rate in Hz, 0 if unknown
+	*/
+	double getSampleRate(uint64_t recordCount, double flightTime);
+
+	/**
+	* Writes header, schema and padding up to the first record
+	*
+	* @param	os			Address of output stream, positioned at the start of the file
+	* @param	header		Address of header
+	* @return	bool
+	*/
+	bool writeHeader(std::ostream& os, const FDRFileHeader& header);
+
+	/**
+	* Writes a complete .fdr file
+	*
+	* @param	os				Address of output stream
+	* @param	header			Header incl. metadata of the recording. Codec and record count are set by the function
+	* @param	records			Records of type FDRFileStruct
+	* @param	codec			Codec, e.g. lossless compression
+	* @param	profile			Error budget per field (quantized files only), nullptr -> archive profile
+	* @param	chunkRecords	Number of records per chunk (compressed files only)
+	* @return	bool
+	*/
+	bool writeFile(std::ostream& os, FDRFileHeader header, RecordSpan<FDRFileStruct> records, Codec codec, const FDRQuantProfile* profile = nullptr, uint32_t chunkRecords = defaultChunkRecords);
+
+	/**
+	* Returns the chunk table of a compressed .fdr file, e.g. to find the chunk of a time stamp
+	*
+	* @param	data		Pointer to the start of the file
+	* @param	size		Size of the file in bytes
+	* @param	header		Address of (parsed) header
+	* @return	vector		Vector of type FDRChunkStruct, empty if the file isn't compressed or the table is corrupt
+	*/
+	std::vector<FDRChunkStruct> getChunkTable(const char* data, size_t size, const FDRFileHeader& header);
+
+	/**
+	* Returns the time index (skip table) of an .fdr file
+	*
+	* @param	data		Pointer to the start of the file
+	* @param	size		Size of the file in bytes
+	* @param	header		Address of (parsed) header
+	* @return	vector		Vector of type FDRIndexStruct, empty if the file has no index
+	*/
+	std::vector<FDRIndexStruct> getIndex(const char* data, size_t size, const FDRFileHeader& header);
+
+	/**
+	* Returns the error budget recorded in a quantized .fdr file
+	*
+	* @param	data		Pointer to the start of the file
+	* @param	size		Size of the file in bytes
+	* @param	header		Address of (parsed) header
+	* @return	FDRQuantProfile		Empty profile (lossless), if the file isn't quantized
+	*/
+	FDRQuantProfile getQuantProfile(const char* data, size_t size, const FDRFileHeader& header);
+
+	/**
+	* Decompresses a single chunk of a compressed .fdr file (random access)
+	*
+	* @param	data		Pointer to the start of the file
+	* @param	size		Size of the file in bytes
+	* @param	header		Address of (parsed) header
+	* @param	chunk		Chunk number
+	* @param	records		Vector of type FDRFileStruct, receives the records of the chunk
+	* @return	bool
+	*/
+	bool readChunk(const char* data, size_t size, const FDRFileHeader& header, uint64_t chunk, std::vector<FDRFileStruct>& records);
+
+	/**
+	* Parses an .fdr file (v2 or legacy v1) in memory
+	*
+	* @param	data		Pointer to the start of the file
+	* @param	size		Size of the file in bytes
+	* @param	header		Address of header. v1 files return a v2 header with version 1
+	* @param	records		Set to the first record, if the records match the native layout (zero-copy)
+	* @param	converted	Vector of type FDRFileStruct. Filled if records are in a different layout
+	* @return	bool		False, if the file isn't a valid .fdr file
+	*/
+	bool parse(const char* data, size_t size, FDRFileHeader& header, const FDRFileStruct*& records, std::vector<FDRFileStruct>& converted);
+}
+#endif
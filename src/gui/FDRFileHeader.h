@@ -0,0 +1,84 @@
+#ifndef FDRFILEHEADER_H
+#define FDRFILEHEADER_H
+
+#include <cstdint>
+
+#pragma pack(push, 1)
+
+/**
+* Header of an .fdr file (v2 container). Followed by the record schema (fieldCount x FDRFieldStruct)
+* and the records at dataOffset. Compressed files (codec != 0) store chunks of records at dataOffset
+* and a chunk table (chunkCount x FDRChunkStruct) at chunkTableOffset. Quantized files (lossy) store the error
+* budget of each field (fieldCount x FDRQuantStruct) at quantTableOffset. The time index (indexCount x FDRIndexStruct,
+* one entry every indexStride records) is stored at indexOffset. All offsets in bytes from the start of the file
+*/
+struct FDRFileHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint32_t recordSize;
+	uint32_t fieldCount;
+	uint64_t schemaOffset;
+	uint64_t dataOffset;
+	uint64_t recordCount;
+	uint64_t indexOffset;
+	double sampleRate;
+	double startZulu;
+	char simApi[32];
+	uint32_t codec;
+	uint32_t chunkRecords;
+	uint64_t chunkCount;
+	uint64_t chunkTableOffset;
+	uint64_t quantTableOffset;
+	uint32_t indexStride;
+	uint32_t indexReserved;
+	uint64_t indexCount;
+	uint8_t reserved[104];
+};
+
+/**
+* Description of a single record field, i.e. name, data type and offset within the record
+*/
+struct FDRFieldStruct
+{
+	char name[24];
+	uint16_t type;
+	uint16_t size;
+	uint32_t offset;
+};
+
+/**
+* Entry of the chunk table of a compressed .fdr file
+*/
+struct FDRChunkStruct
+{
+	uint64_t offset;
+	uint32_t size;
+	uint32_t recordCount;
+	float firstTime;
+	float lastTime;
+};
+
+/**
+* Error budget of a record field of a quantized .fdr file. Step 0 -> field is stored lossless
+*/
+struct FDRQuantStruct
+{
+	double maxError;
+	double step;
+};
+
+/**
+* Entry of the time index (sparse skip table), i.e. time stamp of every indexStride-th record
+*/
+struct FDRIndexStruct
+{
+	uint64_t record;
+	float time;
+	uint32_t reserved;
+};
+
+#pragma pack(pop)
+
+#endif
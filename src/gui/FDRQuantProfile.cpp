@@ -0,0 +1,156 @@
+#include "FDRQuantProfile.h"
+#include "FDRFileFormat.h"
+#include <cfloat>
+#include <cstring>
+#include <cmath>
+
+/**
+* Constructor / Destructor
+*/
+FDRQuantProfile::FDRQuantProfile() {
+
+}
+
+FDRQuantProfile::~FDRQuantProfile() {
+
+}
+
+
+/**
+* Returns the default profile for archived recordings
+*/
+FDRQuantProfile FDRQuantProfile::GetArchiveProfile() {
+	FDRQuantProfile profile;
+
+	// Position: 1 cm (lat/lon in degrees, alt in metres)
+	profile.SetMaxError("lat", 0.01 / 111320.0);
+	profile.SetMaxError("lon", 0.01 / 111320.0);
+	profile.SetMaxError("alt", 0.01);
+	profile.SetMaxError("spd", 0.01);
+
+	// Attitude: 0.01 degrees
+	profile.SetMaxError("hdg", 0.01);
+	profile.SetMaxError("pitch", 0.01);
+	profile.SetMaxError("bank", 0.01);
+
+	// Propulsion (percent)
+	for (std::string field : { "thr1", "thr2", "thr3", "thr4", "engN1E1", "engN1E2", "engN1E3", "engN1E4" })
+		profile.SetMaxError(field, 0.01);
+
+	// Flight controls and gear (position)
+	for (std::string field : { "alr", "elev", "rudder", "splr", "gearPos", "gearAngle", "flaps" })
+		profile.SetMaxError(field, 0.0005);
+
+	// Fuel (gallons)
+	for (std::string field : { "fuelCtr", "fuelLeft", "fuelRight" })
+		profile.SetMaxError(field, 0.01);
+
+	return profile;
+}
+
+
+/**
+* Returns the profile recorded in a quantization table
+*/
+FDRQuantProfile FDRQuantProfile::CreateFromTable(const std::vector<FDRFieldStruct>& schema, const std::vector<FDRQuantStruct>& quantTable) {
+	FDRQuantProfile profile;
+	for (size_t f = 0; f < schema.size() && f < quantTable.size(); f++) {
+		if (quantTable[f].step > 0)
+			profile.SetMaxError(std::string(schema[f].name, strnlen(schema[f].name, sizeof(schema[f].name))), quantTable[f].maxError);
+	}
+	return profile;
+}
+
+
+/**
+* Sets the error budget of a field
+*/
+void FDRQuantProfile::SetMaxError(std::string field, double maxError) {
+	if (maxError > 0)
+		maxErrors[field] = maxError;
+	else
+		maxErrors.erase(field);
+}
+
+
+/**
+* Returns the error budget of a field
+*/
+double FDRQuantProfile::GetMaxError(std::string field) const {
+	auto iterator = maxErrors.find(field);
+	return iterator != maxErrors.end() ? iterator->second : 0.0;
+}
+
+
+/**
+* Returns the quantization table for a record schema. Only float64 fields are quantized
+*/
+std::vector<FDRQuantStruct> FDRQuantProfile::CreateTable(const std::vector<FDRFieldStruct>& schema) const {
+	std::vector<FDRQuantStruct> quantTable(schema.size(), FDRQuantStruct());
+	for (size_t f = 0; f < schema.size(); f++) {
+		double maxError = this->GetMaxError(schema[f].name);
+		if (schema[f].type == FDRFileFormat::float64 && maxError > 0) {
+			quantTable[f].maxError = maxError;
+			quantTable[f].step = 2.0 * maxError;
+		}
+	}
+	return quantTable;
+}
+
+
+/**
+* Compares restored records with the original records
+*/
+bool FDRQuantProfile::Verify(RecordSpan<FDRFileStruct> original, RecordSpan<FDRFileStruct> restored, std::vector<FDRDeviationStruct>& deviations) const {
+	const std::vector<FDRFieldStruct>& schema = FDRFileFormat::getSchema();
+	deviations.clear();
+
+	bool result = original.size() == restored.size();
+	size_t count = original.size() < restored.size() ? original.size() : restored.size();
+
+	for (const FDRFieldStruct& field : schema) {
+		FDRDeviationStruct deviation = { field.name, 0.0, this->GetMaxError(field.name), 0, false };
+
+		for (size_t n = 0; n < count; n++) {
+			const char* a = reinterpret_cast<const char*>(&original[n]) + field.offset;
+			const char* b = reinterpret_cast<const char*>(&restored[n]) + field.offset;
+			double diff = 0.0, magnitude = 0.0;
+
+			if (field.type == FDRFileFormat::float64) {
+				double va, vb;
+				memcpy(&va, a, sizeof(va));
+				memcpy(&vb, b, sizeof(vb));
+				diff = std::isnan(va) && std::isnan(vb) ? 0.0 : std::fabs(va - vb);
+				magnitude = std::fmax(std::fabs(va), std::fabs(vb));
+			}
+			else if (field.type == FDRFileFormat::float32) {
+				float va, vb;
+				memcpy(&va, a, sizeof(va));
+				memcpy(&vb, b, sizeof(vb));
+				diff = std::isnan(va) && std::isnan(vb) ? 0.0 : std::fabs((double)va - (double)vb);
+			}
+			else if (field.type == FDRFileFormat::int32) {
+				int32_t va, vb;
+				memcpy(&va, a, sizeof(va));
+				memcpy(&vb, b, sizeof(vb));
+				diff = std::fabs((double)va - (double)vb);
+			}
+
+			if (diff > deviation.maxDeviation || std::isnan(diff)) {
+				deviation.maxDeviation = diff;
+				deviation.record = n;
+			}
+
+			// Allow for floating point rounding of the restored value, i.e. a few ulp of the value itself
+			if (!(diff <= deviation.maxError + 4.0 * DBL_EPSILON * magnitude))
+				deviation.exceeded = true;
+		}
+
+		if (deviation.exceeded)
+			result = false;
+
+		deviations.push_back(deviation);
+	}
+
+	return result;
+}
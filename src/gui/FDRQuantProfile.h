@@ -0,0 +1,82 @@
+#ifndef FDRQuantProfile_H
+#define FDRQuantProfile_H
+
+#include <string>
+#include <map>
+#include <vector>
+#include "FDRFileStruct.h"
+#include "FDRFileHeader.h"
+#include "FDRDeviationStruct.h"
+#include "RecordSpan.h"
+
+/**
+* Lossy quantization profile for archived .fdr files
+*
+* Declares the error budget (max. absolute error) per record field, e.g. lat/lon to 1 cm or 
+* attitude to 0.01 degrees. Fields are quantized to integer multiples of twice their budget, i.e. 
+* rounding never exceeds the budget. Fields without a budget are stored lossless
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class FDRQuantProfile {
+
+public:
+	FDRQuantProfile();
+	~FDRQuantProfile();
+
+private:
+	std::map<std::string, double> maxErrors;
+
+public:
+	/**
+	* Returns the default profile for archived recordings
+	*
+	* @return	FDRQuantProfile
+	*/
+	static FDRQuantProfile GetArchiveProfile();
+
+	/**
+	* Returns the profile recorded in a quantization table
+	*
+	* @param	schema			Record schema of the file
+	* @param	quantTable		Quantization table, one entry per schema field
+	* @return	FDRQuantProfile
+	*/
+	static FDRQuantProfile CreateFromTable(const std::vector<FDRFieldStruct>& schema, const std::vector<FDRQuantStruct>& quantTable);
+
+	/**
+	* Sets the error budget of a field
+	*
+	* @param	field		Field name, e.g. lat
+	* @param	maxError	Max. absolute error in units of the field, 0 -> lossless
+	* @return	void
+	*/
+	void SetMaxError(std::string field, double maxError);
+
+	/**
+	* Returns the error budget of a field, 0 if the field is stored lossless
+	*
+	* @param	field		Field name, e.g. lat
+	* @return	double
+	*/
+	double GetMaxError(std::string field) const;
+
+	/**
+	* Returns the quantization table for a record schema
+	*
+	* @param	schema		Record schema
+	* @return	vector		Vector of type FDRQuantStruct, one entry per schema field
+	*/
+	std::vector<FDRQuantStruct> CreateTable(const std::vector<FDRFieldStruct>& schema) const;
+
+	/**
+	* Compares restored records (e.g. of an archived file) with the original records
+	*
+	* @param	original		Original records
+	* @param	restored		Restored records
+	* @param	deviations		Vector of type FDRDeviationStruct, receives the max. deviation per field
+	* @return	bool			False, if any deviation exceeds its budget or the number of records differs
+	*/
+	bool Verify(RecordSpan<FDRFileStruct> original, RecordSpan<FDRFileStruct> restored, std::vector<FDRDeviationStruct>& deviations) const;
+};
+#endif
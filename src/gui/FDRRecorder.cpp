@@ -0,0 +1,126 @@
+#include "FDRRecorder.h"
+#include <chrono>
+
+/**
+* Constructor / Destructor
+*/
+FDRRecorder::FDRRecorder(size_t capacity) : buffer(capacity) {
+
+}
+
+FDRRecorder::~FDRRecorder() {
+	this->Stop();
+}
+
+
+/**
+* Starts the consumer thread
+*/
+bool FDRRecorder::Start(FDRFile* file) {
+	if (active || !file)
+		return false;
+
+	this->fdrFile = file;
+	fileSize.store(file->GetSize());
+	stopRequest.store(false);
+	consumerThread = std::thread(&FDRRecorder::Run, this);
+	active = true;
+
+	return true;
+}
+
+
+/**
+* Publishes a record (producer, wait-free)
+*/
+bool FDRRecorder::Publish(const FDRFileStruct& dataRec) {
+	return buffer.TryPush(dataRec);
+}
+
+
+/**
+* Sets the zulu time (in s) of the first record
+*/
+void FDRRecorder::SetStartZulu(double zulu) {
+	startZulu.store(zulu, std::memory_order_relaxed);
+}
+
+
+/**
+* Consumer thread entry
+*/
+void FDRRecorder::Run() {
+	while (!stopRequest.load(std::memory_order_acquire)) {
+		this->Drain();
+
+		// Sim frames arrive every ~16 ms, i.e. polling doesn't add noticeable latency and keeps the producer free of any signalling
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+
+	// Records published before the stop request
+	this->Drain();
+}
+
+
+/**
+* Appends all records in the buffer to the .fdr file
+*/
+void FDRRecorder::Drain() {
+	FDRFileStruct dataRec;
+
+	while (buffer.TryPop(dataRec)) {
+		double zulu = startZulu.exchange(0.0, std::memory_order_relaxed);
+		if (zulu != 0.0 && fdrFile->GetStartZulu() == 0.0)
+			fdrFile->SetStartZulu(zulu);
+
+		if (fdrFile->AddRecord(dataRec))
+			writtenCount.fetch_add(1, std::memory_order_relaxed);
+		else
+			failedCount.fetch_add(1, std::memory_order_relaxed);
+
+		fileSize.store(fdrFile->GetSize(), std::memory_order_relaxed);
+	}
+
+	// Records appended to the stream, but not written to disk by its writer thread (e.g. disk full)
+	streamFailedCount.store(fdrFile->GetStreamFailedCount(), std::memory_order_relaxed);
+}
+
+
+/**
+* Appends all outstanding records and stops the consumer thread
+*/
+void FDRRecorder::Stop() {
+	if (!active)
+		return;
+
+	stopRequest.store(true, std::memory_order_release);
+	if (consumerThread.joinable())
+		consumerThread.join();
+
+	active = false;
+}
+
+
+/**
+* Returns the size of the .fdr file, as of the last record appended
+*/
+int FDRRecorder::GetFileSize() {
+	return fileSize.load(std::memory_order_relaxed);
+}
+
+
+/**
+* Returns the counters of the recorder queue
+*/
+FDRRecorderStatsStruct FDRRecorder::GetStats() {
+	FDRRecorderStatsStruct stats = {};
+	stats.dropped = buffer.GetOverflowCount();
+	stats.published = buffer.GetPushCount() + stats.dropped;
+	uint64_t streamFailed = streamFailedCount.load(std::memory_order_relaxed);
+	uint64_t written = writtenCount.load(std::memory_order_relaxed);
+	stats.written = written > streamFailed ? written - streamFailed : 0;
+	stats.failed = failedCount.load(std::memory_order_relaxed) + streamFailed;
+	stats.capacity = buffer.GetCapacity();
+	stats.highWaterMark = buffer.GetHighWaterMark();
+	return stats;
+}
@@ -0,0 +1,86 @@
+#ifndef FDRRecorder_H
+#define FDRRecorder_H
+
+#include <thread>
+#include <atomic>
+#include "FDRFile.h"
+#include "FDRFileStruct.h"
+#include "FDRRecorderStatsStruct.h"
+#include "RecordRingBuffer.h"
+
+/**
+* Decouples the recording of flight data records from the SimConnect dispatch
+*
+* The dispatch thread publishes records to a lock-free ring buffer and returns immediately. A
+* consumer thread owns the .fdr file, i.e. appending, compression and disk I/O never delay the
+* dispatch loop. Records that don't fit into the buffer are counted, not silently lost
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class FDRRecorder {
+
+public:
+	FDRRecorder(size_t capacity = 4096);
+	~FDRRecorder();
+
+private:
+	FDRFile* fdrFile = nullptr;
+	RecordRingBuffer<FDRFileStruct> buffer;
+	std::thread consumerThread;
+	std::atomic<bool> stopRequest{ false };
+	std::atomic<uint64_t> writtenCount{ 0 }, failedCount{ 0 }, streamFailedCount{ 0 };
+	std::atomic<int> fileSize{ 0 };
+	std::atomic<double> startZulu{ 0.0 };
+	bool active = false;
+
+	/**
+	* Consumer thread entry. Appends published records to the .fdr file until a stop request is received
+	*/
+	void Run();
+
+	/**
+	* Appends all records in the buffer to the .fdr file
+	*/
+	void Drain();
+
+public:
+	/**
+	* Starts the consumer thread. The file must not be accessed by other threads until Stop() returns
+	*
+	* @param	file		.fdr file the records are appended to
+	* @return	bool
+	*/
+	bool Start(FDRFile* file);
+
+	/**
+	* Publishes a record (producer, wait-free)
+	*
+	* @param	dataRec		Data record
+	* @return	bool		False, if the buffer is full and the record has been dropped
+	*/
+	bool Publish(const FDRFileStruct& dataRec);
+
+	/**
+	* Sets the zulu time (in s) of the first record. Applied by the consumer thread, if the file has no start time yet
+	*
+	* @param	zulu		Zulu time in s
+	* @return	void
+	*/
+	void SetStartZulu(double zulu);
+
+	/**
+	* Appends all outstanding records and stops the consumer thread
+	*/
+	void Stop();
+
+	/**
+	* Returns the size of the .fdr file (see FDRFile::GetSize), as of the last record appended
+	*/
+	int GetFileSize();
+
+	/**
+	* Returns the counters of the recorder queue
+	*/
+	FDRRecorderStatsStruct GetStats();
+};
+#endif
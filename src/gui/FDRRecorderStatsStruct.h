@@ -0,0 +1,21 @@
+#ifndef FDRRECORDERSTATSSTRUCT_H
+#define FDRRECORDERSTATSSTRUCT_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+* Counters of the recorder queue, i.e. published = written + dropped + failed, if no frames are lost.
+* Failed includes the records a recording stream couldn't write to disk
+*/
+struct FDRRecorderStatsStruct
+{
+	uint64_t published;
+	uint64_t written;
+	uint64_t dropped;
+	uint64_t failed;
+	size_t capacity;
+	size_t highWaterMark;
+};
+
+#endif
@@ -0,0 +1,268 @@
+#include "FDRStreamWriter.h"
+#include "FDRFileFormat.h"
+#include "FDRTimeIndex.h"
+
+/**
+* Constructor / Destructor
+*/
+FDRStreamWriter::FDRStreamWriter(size_t chunkSize, size_t maxPendingChunks) {
+	this->chunkSize = chunkSize > 0 ? chunkSize : 1;
+	this->maxPendingChunks = maxPendingChunks > 0 ? maxPendingChunks : 1;
+}
+
+FDRStreamWriter::~FDRStreamWriter() {
+	if (active)
+		this->Finalize();
+}
+
+
+/**
+* Creates the output file and starts the writer thread
+*/
+bool FDRStreamWriter::Open(std::string fileName, const FDRFileHeader& header) {
+	if (active)
+		return false;
+
+	this->fileName = fileName;
+	this->header = header;
+	this->header.recordCount = 0;
+	outputStream.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!outputStream.is_open())
+		return false;
+
+	// Write header and schema, i.e. valid .fdr file with zero records
+	if (!FDRFileFormat::writeHeader(outputStream, this->header)) {
+		outputStream.close();
+		return false;
+	}
+	outputStream.flush();
+
+	recordCount = 0;
+	index.clear();
+	indexOffset = 0;
+	stopRequest = false;
+	writeError = false;
+	failedCount.store(0, std::memory_order_relaxed);
+	activeChunk.reserve(chunkSize);
+
+	writerThread = std::thread(&FDRStreamWriter::Run, this);
+	active = true;
+
+	return true;
+}
+
+
+/**
+* Updates the metadata of the file header
+*/
+void FDRStreamWriter::SetHeader(const FDRFileHeader& header) {
+	std::lock_guard<std::mutex> lockGuard(m);
+	this->header = header;
+}
+
+
+/**
+* Appends a data record to the output file (asynchronously)
+*/
+void FDRStreamWriter::Append(const FDRFileStruct& dataRec) {
+	if (!active)
+		return;
+
+	activeChunk.push_back(dataRec);
+
+	if (activeChunk.size() >= chunkSize)
+		this->SubmitActiveChunk();
+}
+
+
+/**
+* Hands the active chunk over to the writer thread
+*/
+void FDRStreamWriter::SubmitActiveChunk() {
+	std::unique_lock<std::mutex> lock(m);
+
+	// Apply back pressure, in case the disk can't keep up
+	cv.wait(lock, [&] { return pendingChunks.size() < maxPendingChunks; });
+	pendingChunks.push_back(std::move(activeChunk));
+
+	// Reuse previously written chunks to avoid reallocations
+	if (!spareChunks.empty()) {
+		activeChunk = std::move(spareChunks.back());
+		spareChunks.pop_back();
+	}
+	else {
+		activeChunk = std::vector<FDRFileStruct>();
+		activeChunk.reserve(chunkSize);
+	}
+
+	lock.unlock();
+	cv.notify_all();
+}
+
+
+/**
+* Writer thread entry
+*/
+void FDRStreamWriter::Run() {
+	std::vector<FDRFileStruct> chunk;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m);
+			cv.wait(lock, [&] { return stopRequest || !pendingChunks.empty(); });
+
+			if (pendingChunks.empty() && stopRequest)
+				break;
+
+			chunk = std::move(pendingChunks.front());
+			pendingChunks.pop_front();
+		}
+		cv.notify_all();
+
+		// Write to disk outside of the lock
+		if (!this->WriteChunk(chunk)) {
+			writeError = true;
+			failedCount.fetch_add(chunk.size(), std::memory_order_relaxed);
+		}
+
+		chunk.clear();
+		{
+			std::lock_guard<std::mutex> lockGuard(m);
+			if (spareChunks.size() < maxPendingChunks)
+				spareChunks.push_back(std::move(chunk));
+		}
+		chunk = std::vector<FDRFileStruct>();
+	}
+}
+
+
+/**
+* Appends a chunk of records to the output file and updates the record count in the file header
+*/
+bool FDRStreamWriter::WriteChunk(const std::vector<FDRFileStruct>& chunk) {
+	if (chunk.empty())
+		return true;
+
+	outputStream.write(reinterpret_cast<const char*>(&chunk[0]), chunk.size() * sizeof(chunk[0]));
+	outputStream.flush();
+
+	if (!outputStream.good())
+		return false;
+
+	// Collect time index entries of the chunk, i.e. every stride-th record of the file
+	uint32_t stride = FDRTimeIndex::defaultStride;
+	for (size_t n = (stride - recordCount % stride) % stride; n < chunk.size(); n += stride) {
+		FDRIndexStruct entry = {};
+		entry.record = recordCount + n;
+		entry.time = chunk[n].fltTime;
+		index.push_back(entry);
+	}
+
+	// Only commit the new record count after the records themselves are on disk
+	recordCount += chunk.size();
+
+	return this->WriteHeader();
+}
+
+
+/**
+* Rewrites the file header with the current record count
+*/
+bool FDRStreamWriter::WriteHeader() {
+	FDRFileHeader fileHeader;
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		fileHeader = this->header;
+	}
+	fileHeader.recordCount = recordCount;
+	if (indexOffset > 0) {
+		fileHeader.indexOffset = indexOffset;
+		fileHeader.indexStride = FDRTimeIndex::defaultStride;
+		fileHeader.indexCount = index.size();
+	}
+
+	outputStream.seekp(0, std::ios::beg);
+	outputStream.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+	outputStream.seekp(0, std::ios::end);
+	outputStream.flush();
+
+	return outputStream.good();
+}
+
+
+/**
+* Appends the time index (skip table) to the output file
+*/
+bool FDRStreamWriter::WriteIndex() {
+	if (index.empty())
+		return true;
+
+	outputStream.seekp(0, std::ios::end);
+	indexOffset = (uint64_t)outputStream.tellp();
+	outputStream.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(FDRIndexStruct));
+	outputStream.flush();
+
+	if (!outputStream.good()) {
+		indexOffset = 0;
+		return false;
+	}
+	return true;
+}
+
+
+/**
+* Writes all outstanding records, stops the writer thread and closes the output file
+*/
+bool FDRStreamWriter::Finalize() {
+	if (!active)
+		return false;
+
+	if (!activeChunk.empty())
+		this->SubmitActiveChunk();
+
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		stopRequest = true;
+	}
+	cv.notify_all();
+
+	if (writerThread.joinable())
+		writerThread.join();
+
+	// Header metadata may have changed after the last chunk
+	if (!writeError && (!this->WriteIndex() || !this->WriteHeader()))
+		writeError = true;
+
+	outputStream.close();
+	pendingChunks.clear();
+	spareChunks.clear();
+	activeChunk.clear();
+	active = false;
+
+	return !writeError;
+}
+
+
+/**
+* Returns the number of records that couldn't be written to disk
+*/
+uint64_t FDRStreamWriter::GetFailedCount() {
+	return failedCount.load(std::memory_order_relaxed);
+}
+
+
+/**
+* Returns true, if the writer is open and accepts new records
+*/
+bool FDRStreamWriter::IsActive() {
+	return this->active;
+}
+
+
+/**
+* Returns the path and name of the output file
+*/
+std::string FDRStreamWriter::GetFileName() {
+	return this->fileName;
+}
@@ -0,0 +1,132 @@
+#ifndef FDRStreamWriter_H
+#define FDRStreamWriter_H
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "FDRFileStruct.h"
+#include "FDRFileHeader.h"
+
+/**
+* Streaming writer for .fdr files
+*
+* Appends flight data records to an .fdr file on disk while a recording is in progress.
+* Records are collected in fixed size chunks, which are handed over to a background thread
+* that writes them to disk. The file header (incl. record count) is updated after each chunk,
+* i.e. the file on disk is a valid .fdr file at any time and survives a crash of the application.
+* The time index is collected while writing and appended to the file on finalize
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class FDRStreamWriter {
+
+public:
+	FDRStreamWriter(size_t chunkSize = 256, size_t maxPendingChunks = 16);
+	~FDRStreamWriter();
+
+private:
+	std::string fileName;
+	std::ofstream outputStream;
+	FDRFileHeader header = {};
+	std::thread writerThread;
+	std::mutex m;
+	std::condition_variable cv;
+
+	std::vector<FDRFileStruct> activeChunk;
+	std::deque<std::vector<FDRFileStruct>> pendingChunks;
+	std::vector<std::vector<FDRFileStruct>> spareChunks;
+	std::vector<FDRIndexStruct> index;
+	uint64_t indexOffset = 0;
+
+	size_t chunkSize = 0, maxPendingChunks = 0, recordCount = 0;
+	bool active = false, stopRequest = false, writeError = false;
+	std::atomic<uint64_t> failedCount{ 0 };
+
+	/**
+	* Writer thread entry. Writes pending chunks to disk until a stop request is received
+	*/
+	void Run();
+
+	/**
+	* Appends a chunk of records to the output file and updates the record count in the file header
+	*
+	* @param	chunk		Vector of type FDRFileStruct
+	* @return	bool
+	*/
+	bool WriteChunk(const std::vector<FDRFileStruct>& chunk);
+
+	/**
+	* Rewrites the file header with the current record count
+	*
+	* @return	bool
+	*/
+	bool WriteHeader();
+
+	/**
+	* Appends the time index (skip table) to the output file. No records must be written afterwards
+	*
+	* @return	bool
+	*/
+	bool WriteIndex();
+
+	/**
+	* Hands the active chunk over to the writer thread. Blocks, if the maximum number of
+	* pending chunks has been reached, i.e. memory use is bounded to (maxPendingChunks + 2) * chunkSize records
+	*/
+	void SubmitActiveChunk();
+
+public:
+	/**
+	* Creates the output file and starts the writer thread
+	*
+	* @param	fileName	Path and name of file
+	* @param	header		File header (v2 container). The record count is maintained by the writer
+	* @return	bool
+	*/
+	bool Open(std::string fileName, const FDRFileHeader& header);
+
+	/**
+	* Updates the metadata of the file header, e.g. start zulu time. Written with the next chunk
+	*
+	* @param	header		File header
+	* @return	void
+	*/
+	void SetHeader(const FDRFileHeader& header);
+
+	/**
+	* Appends a data record to the output file (asynchronously)
+	*
+	* @param	dataRec		Data record
+	* @return	void
+	*/
+	void Append(const FDRFileStruct& dataRec);
+
+	/**
+	* Writes all outstanding records, stops the writer thread and closes the output file
+	*
+	* @param	void
+	* @return	bool		False, if any of the records couldn't be written to disk
+	*/
+	bool Finalize();
+
+	/**
+	* Returns the number of records that couldn't be written to disk (updated by the writer thread)
+	*/
+	uint64_t GetFailedCount();
+
+	/**
+	* Returns true, if the writer is open and accepts new records
+	*/
+	bool IsActive();
+
+	/**
+	* Returns the path and name of the output file
+	*/
+	std::string GetFileName();
+};
+#endif
@@ -0,0 +1,114 @@
+#include "FDRTimeIndex.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+* Constructor / Destructor
+*/
+FDRTimeIndex::FDRTimeIndex() {
+
+}
+
+FDRTimeIndex::~FDRTimeIndex() {
+
+}
+
+
+/**
+* Builds the skip table from the time column of a track
+*/
+void FDRTimeIndex::Build(const std::vector<float>& times, uint32_t stride) {
+	this->times = &times;
+	this->stride = stride > 0 ? stride : defaultStride;
+	this->entries = CreateEntries(times.data(), times.size(), sizeof(float), this->stride);
+}
+
+
+/**
+* Assigns a skip table read from an .fdr file
+*/
+bool FDRTimeIndex::Assign(const std::vector<float>& times, const std::vector<FDRIndexStruct>& entries, uint32_t stride) {
+	// Entries must point to every stride-th record of the track, i.e. lookups never leave the time column, and
+	// hold the time stamp of that record, i.e. a stale or corrupt skip table is rebuilt rather than misleading a search
+	if (stride == 0 || entries.size() != (times.size() + stride - 1) / stride)
+		return false;
+
+	for (size_t k = 0; k < entries.size(); k++) {
+		if (entries[k].record != (uint64_t)k * stride || entries[k].time != times[(size_t)entries[k].record] || (k > 0 && entries[k].time < entries[k - 1].time))
+			return false;
+	}
+
+	this->times = &times;
+	this->stride = stride;
+	this->entries = entries;
+	return true;
+}
+
+
+/**
+* Releases the skip table
+*/
+void FDRTimeIndex::Clear() {
+	times = nullptr;
+	entries.clear();
+	entries.shrink_to_fit();
+}
+
+
+/**
+* Returns the first record with a time stamp greater than (upper) or greater/equal (lower) the given time
+*/
+size_t FDRTimeIndex::Search(double seconds, bool upper) const {
+	if (!times || times->empty())
+		return 0;
+
+	auto before = [&](float time) { return upper ? time <= seconds : time < seconds; };
+
+	// Skip table: first entry past the given time. The record is in the block of the previous entry
+	auto entry = std::partition_point(entries.begin(), entries.end(), [&](const FDRIndexStruct& e) { return before(e.time); });
+	if (entry == entries.begin())
+		return 0;
+
+	size_t first = (size_t)(entry - 1)->record + 1;
+	size_t last = entry != entries.end() ? (size_t)entry->record : times->size();
+
+	// Time column: binary search within the block
+	return std::partition_point(times->begin() + first, times->begin() + last, before) - times->begin();
+}
+
+
+/**
+* Returns the first record at or after the given time
+*/
+size_t FDRTimeIndex::LowerBound(double seconds) const {
+	return this->Search(seconds, false);
+}
+
+
+/**
+* Returns the last record at or before the given time
+*/
+size_t FDRTimeIndex::Floor(double seconds) const {
+	size_t pos = this->Search(seconds, true);
+	return pos > 0 ? pos - 1 : 0;
+}
+
+
+/**
+* Creates the skip table entries for the given time stamps
+*/
+std::vector<FDRIndexStruct> FDRTimeIndex::CreateEntries(const float* times, size_t count, size_t step, uint32_t stride) {
+	std::vector<FDRIndexStruct> entries;
+	if (stride == 0)
+		return entries;
+
+	entries.reserve((count + stride - 1) / stride);
+	const char* time = reinterpret_cast<const char*>(times);
+	for (size_t n = 0; n < count; n += stride) {
+		FDRIndexStruct entry = {};
+		entry.record = n;
+		memcpy(&entry.time, time + n * step, sizeof(entry.time));
+		entries.push_back(entry);
+	}
+	return entries;
+}
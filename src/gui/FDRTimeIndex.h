@@ -0,0 +1,103 @@
+#ifndef FDRTimeIndex_H
+#define FDRTimeIndex_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "FDRFileHeader.h"
+
+/**
+* Time index of an .fdr track
+*
+* Maps a time stamp (in s) to a record number. A sparse skip table holds the time stamp of every
+* n-th record (stride), i.e. a lookup is a binary search over the (small) skip table followed by a
+* binary search over a single block of the time column. Seeks are independent of the cursor position
+* and cost the same anywhere on a 10 hour flight. The skip table is persisted in the .fdr file
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class FDRTimeIndex {
+
+public:
+	FDRTimeIndex();
+	~FDRTimeIndex();
+
+	static const uint32_t defaultStride = 1024;
+
+private:
+	const std::vector<float>* times = nullptr;
+	std::vector<FDRIndexStruct> entries;
+	uint32_t stride = defaultStride;
+
+	/**
+	* Returns the first record with a time stamp greater than (upper) or greater/equal (lower) the given time
+	*
+	* @param	seconds		Time stamp in s
+	* @param	upper		Upper bound (true) / lower bound (false)
+	* @return	size_t		Record number, number of records if there is none
+	*/
+	size_t Search(double seconds, bool upper) const;
+
+public:
+	/**
+	* Builds the skip table from the time column of a track
+	*
+	* @param	times		Time stamps (in s) of all records. Must remain valid while the index is in use
+	* @param	stride		Number of records per skip table entry
+	* @return	void
+	*/
+	void Build(const std::vector<float>& times, uint32_t stride = defaultStride);
+
+	/**
+	* Assigns a skip table read from an .fdr file
+	*
+	* @param	times		Time stamps (in s) of all records. Must remain valid while the index is in use
+	* @param	entries		Vector of type FDRIndexStruct
+	* @param	stride		Number of records per skip table entry
+	* @return	bool		False, if the skip table doesn't match the track, i.e. its records or time stamps (index remains unchanged)
+	*/
+	bool Assign(const std::vector<float>& times, const std::vector<FDRIndexStruct>& entries, uint32_t stride);
+
+	/**
+	* Releases the skip table
+	*/
+	void Clear();
+
+	/**
+	* Returns the first record at or after the given time, number of records if the time is past the end of the track
+	*
+	* @param	seconds		Time stamp in s
+	* @return	size_t
+	*/
+	size_t LowerBound(double seconds) const;
+
+	/**
+	* Returns the last record at or before the given time, 0 if the time is before the start of the track
+	*
+	* @param	seconds		Time stamp in s
+	* @return	size_t
+	*/
+	size_t Floor(double seconds) const;
+
+	/**
+	* Returns the entries of the skip table
+	*/
+	const std::vector<FDRIndexStruct>& GetEntries() const { return entries; }
+
+	/**
+	* Returns the number of records per skip table entry
+	*/
+	uint32_t GetStride() const { return stride; }
+
+	/**
+	* Creates the skip table entries for the given time stamps
+	*
+	* @param	times		Pointer to the first time stamp
+	* @param	count		Number of time stamps
+	* @param	step		Distance (in bytes) between two time stamps, e.g. record size
+	* @param	stride		Number of records per skip table entry
+	* @return	vector		Vector of type FDRIndexStruct
+	*/
+	static std::vector<FDRIndexStruct> CreateEntries(const float* times, size_t count, size_t step, uint32_t stride = defaultStride);
+};
+#endif
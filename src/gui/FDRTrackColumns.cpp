@@ -0,0 +1,71 @@
+#include "FDRTrackColumns.h"
+
+// Record fields of the channels, in order of FDRTrackColumns::Channel
+static double FDRFileStruct::* const channelFields[FDRTrackColumns::channelCount] = {
+	&FDRFileStruct::lat, &FDRFileStruct::lon, &FDRFileStruct::alt, &FDRFileStruct::spd, &FDRFileStruct::hdg, &FDRFileStruct::pitch, &FDRFileStruct::bank,
+	&FDRFileStruct::thr1, &FDRFileStruct::thr2, &FDRFileStruct::thr3, &FDRFileStruct::thr4,
+	&FDRFileStruct::engN1E1, &FDRFileStruct::engN1E2, &FDRFileStruct::engN1E3, &FDRFileStruct::engN1E4,
+	&FDRFileStruct::alr, &FDRFileStruct::elev, &FDRFileStruct::rudder, &FDRFileStruct::flaps, &FDRFileStruct::splr, &FDRFileStruct::gearPos, &FDRFileStruct::gearAngle,
+	&FDRFileStruct::fuelCtr, &FDRFileStruct::fuelLeft, &FDRFileStruct::fuelRight
+};
+
+// Record fields of the lights, in order of FDRTrackColumns::Light
+static int FDRFileStruct::* const lightFields[FDRTrackColumns::lightCount] = {
+	&FDRFileStruct::navL, &FDRFileStruct::logoL, &FDRFileStruct::beacL, &FDRFileStruct::strbL,
+	&FDRFileStruct::taxiL, &FDRFileStruct::rwyTurnL, &FDRFileStruct::wngL, &FDRFileStruct::lndgL
+};
+
+/**
+* Constructor / Destructor
+*/
+FDRTrackColumns::FDRTrackColumns() {
+
+}
+
+FDRTrackColumns::~FDRTrackColumns() {
+
+}
+
+
+/**
+* Builds the columns from the records of an .fdr file
+*/
+void FDRTrackColumns::Build(RecordSpan<FDRFileStruct> records) {
+	this->size = records.size();
+
+	fltTime.resize(size);
+	for (size_t n = 0; n < size; n++)
+		fltTime[n] = records[n].fltTime;
+
+	// Fill one column at a time, i.e. writes are sequential
+	for (int c = 0; c < channelCount; c++) {
+		std::vector<double>& column = channels[c];
+		column.resize(size);
+		for (size_t n = 0; n < size; n++)
+			column[n] = records[n].*channelFields[c];
+	}
+
+	for (int l = 0; l < lightCount; l++) {
+		std::vector<uint64_t>& column = lights[l];
+		column.assign((size + 63) / 64, 0);
+		for (size_t n = 0; n < size; n++) {
+			if (records[n].*lightFields[l] != 0)
+				column[n >> 6] |= (uint64_t)1 << (n & 63);
+		}
+	}
+}
+
+
+/**
+* Releases all columns
+*/
+void FDRTrackColumns::Clear() {
+	this->size = 0;
+	fltTime = std::vector<float>();
+
+	for (int c = 0; c < channelCount; c++)
+		channels[c] = std::vector<double>();
+
+	for (int l = 0; l < lightCount; l++)
+		lights[l] = std::vector<uint64_t>();
+}
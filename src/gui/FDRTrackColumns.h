@@ -0,0 +1,102 @@
+#ifndef FDRTrackColumns_H
+#define FDRTrackColumns_H
+
+#include <vector>
+#include <cstdint>
+#include "FDRFileStruct.h"
+#include "RecordSpan.h"
+
+/**
+* Columnar (structure-of-arrays) representation of an .fdr track
+*
+* Stores one contiguous array per channel instead of an array of FDRFileStruct records, i.e. 
+* scans over a single channel (e.g. time or position) only touch the memory of that channel and
+* can be vectorized by the compiler. Lights are packed as bitsets, one bit per record
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class FDRTrackColumns {
+
+public:
+	FDRTrackColumns();
+	~FDRTrackColumns();
+
+	enum Channel {
+		lat, lon, alt, spd, hdg, pitch, bank,
+		thr1, thr2, thr3, thr4,
+		engN1E1, engN1E2, engN1E3, engN1E4,
+		alr, elev, rudder, flaps, splr, gearPos, gearAngle,
+		fuelCtr, fuelLeft, fuelRight,
+		channelCount
+	};
+
+	enum Light {
+		navL, logoL, beacL, strbL, taxiL, rwyTurnL, wngL, lndgL,
+		lightCount
+	};
+
+private:
+	size_t size = 0;
+	std::vector<float> fltTime;
+	std::vector<double> channels[channelCount];
+	std::vector<uint64_t> lights[lightCount];
+
+public:
+	/**
+	* Builds the columns from the records of an .fdr file
+	*
+	* @param	records		Records of type FDRFileStruct
+	* @return	void
+	*/
+	void Build(RecordSpan<FDRFileStruct> records);
+
+	/**
+	* Releases all columns
+	*/
+	void Clear();
+
+	/**
+	* Returns the number of records
+	*/
+	size_t GetSize() const { return size; }
+
+	/**
+	* Returns the time stamp (in s) of a record
+	*
+	* @param	pos			Record number
+	* @return	float
+	*/
+	float GetTime(size_t pos) const { return fltTime[pos]; }
+
+	/**
+	* Returns the time stamps (in s) of all records
+	*/
+	const std::vector<float>& GetTimes() const { return fltTime; }
+
+	/**
+	* Returns the value of a channel for a record
+	*
+	* @param	channel		Channel, e.g. lat
+	* @param	pos			Record number
+	* @return	double
+	*/
+	double Get(Channel channel, size_t pos) const { return channels[channel][pos]; }
+
+	/**
+	* Returns the values of a channel for all records
+	*
+	* @param	channel		Channel, e.g. lat
+	* @return	vector		Vector of type double
+	*/
+	const std::vector<double>& GetChannel(Channel channel) const { return channels[channel]; }
+
+	/**
+	* Returns the state of a light for a record
+	*
+	* @param	light		Light, e.g. navL
+	* @param	pos			Record number
+	* @return	int			1 (on) / 0 (off)
+	*/
+	int GetLight(Light light, size_t pos) const { return (int)((lights[light][pos >> 6] >> (pos & 63)) & 1); }
+};
+#endif
@@ -1,4 +1,5 @@
 #include "FTDISFile.h"
+#include <cstring>
 
 FTDISFile::FTDISFile() {
 
@@ -16,31 +17,75 @@ void FTDISFile::ReadVecFields(std::istream& is, std::vector<FTDISFileStruct>& ve
 {
 	typename std::vector<FTDISFileStruct>::size_type size = 0;
 	is.read((char*)&size, sizeof(size));
+	if (!is.good() || size == 0) {
+		vec.clear();
+		return;
+	}
 	vec.resize((int)size);
 	is.read((char*)&vec[0], vec.size() * sizeof(FTDISFileStruct));
 }
 
 
+/**
+* Maps the .ftd file into memory (read-only, zero-copy)
+*/
+bool FTDISFile::MapFile(std::string fileName) {
+	std::shared_ptr<MappedFile> mapping = MappedFile::Open(fileName);
+	if (!mapping || mapping->GetSize() < sizeof(size_t))
+		return false;
+
+	// Validate record count against file size
+	size_t sz = 0;
+	memcpy(&sz, mapping->GetData(), sizeof(sz));
+	if (sz > (mapping->GetSize() - sizeof(size_t)) / sizeof(FTDISFileStruct))
+		return false;
+
+	mappedFile = mapping;
+	mappedRecords = RecordSpan<FTDISFileStruct>(reinterpret_cast<const FTDISFileStruct*>(mapping->GetData() + sizeof(size_t)), sz);
+	fileData.clear();
+	fileData.shrink_to_fit();
+
+	return true;
+}
+
+
 /**
 * Loads the .ftd file (FTDIS format) from a local directory
 */
 bool FTDISFile::LoadFile(std::string loadFileName) {
+	mappedFile.reset();
+	mappedRecords = RecordSpan<FTDISFileStruct>();
+
+	// Map input file to memory. Fall back to reading the file, if it can't be mapped
+	if (!this->MapFile(loadFileName)) {
+		std::ifstream in(loadFileName, std::ios::in | std::ios::binary);
+		ReadVecFields(in, fileData);
+		in.close();
+	}
 
-	// Read input file to memory
-	std::ifstream in(loadFileName, std::ios::in | std::ios::binary);
-	ReadVecFields(in, fileData);
-	in.close();
+	RecordSpan<FTDISFileStruct> records = this->GetRecords();
 
 	// Confirm load and initialize process variables
-	if (fileData.size() > 0) {
+	if (records.size() > 0) {
 
-		size = static_cast<int>(fileData.size()) - 1;
-		depElev = fileData.front().alt;
-		destElev = fileData.back().alt;
-		flightTime = fileData.back().fltTime;
+		size = static_cast<int>(records.size()) - 1;
+		depElev = records.front().alt;
+		destElev = records.back().alt;
+		flightTime = records.back().fltTime;
 
 		return true;
 	}
 	else
 		return false;
+}
+
+
+/**
+* Returns the records of the .ftd file
+*/
+RecordSpan<FTDISFileStruct> FTDISFile::GetRecords() {
+	if (mappedFile)
+		return mappedRecords;
+	else
+		return RecordSpan<FTDISFileStruct>(fileData.data(), fileData.size());
 }
\ No newline at end of file
@@ -3,7 +3,10 @@
 
 #include <fstream>
 #include <vector>
+#include <memory>
 #include "FTDISFileStruct.h"
+#include "MappedFile.h"
+#include "RecordSpan.h"
 
 class FTDISFile {
 
@@ -13,10 +16,12 @@ public:
 
 	int size;
 	double depElev, destElev, flightElevAdj, flightTime;
-	
-	std::vector<FTDISFileStruct> fileData;
 
 private:
+	std::vector<FTDISFileStruct> fileData;
+	std::shared_ptr<MappedFile> mappedFile;
+	RecordSpan<FTDISFileStruct> mappedRecords;
+
 	/**
 	* Reads a vector of type FTDISFileStruct to the input stream
 	* @param	is			Address of input stream
@@ -24,11 +29,24 @@ private:
 	*/
 	void ReadVecFields(std::istream& is, std::vector<FTDISFileStruct>& vec);
 
+	/**
+	* Maps the .ftd file into memory (read-only, zero-copy)
+	* @param	fileName	Path and name of file
+	* @return	bool
+	*/
+	bool MapFile(std::string fileName);
+
 public:
 	/**
 	* Loads the .ftd file from a local directory
 	* @return   bool
 	*/
 	bool LoadFile(std::string loadFileName);
+
+	/**
+	* Returns the records of the .ftd file
+	* @return	RecordSpan	Read-only view of records
+	*/
+	RecordSpan<FTDISFileStruct> GetRecords();
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "FrameProfiler.h"
+#include <chrono>
+
+/**
+* Constructor / Destructor
+*/
+FrameProfiler::FrameProfiler() {
+
+}
+
+FrameProfiler::~FrameProfiler() {
+
+}
+
+
+/**
+* Returns the time of the steady clock in ns
+*/
+int64_t FrameProfiler::Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+* Returns the name of a stage
+*/
+const char* FrameProfiler::GetStageName(Stage stage) {
+	switch (stage) {
+	case dispatch:
+		return "dispatch";
+	case cursor:
+		return "cursor";
+	case model:
+		return "model";
+	case submit:
+		return "submit";
+	case sound:
+		return "sound";
+	case camShake:
+		return "camShake";
+	default:
+		return "";
+	}
+}
+
+
+/**
+* Enables/disables the profiler
+*/
+void FrameProfiler::SetEnabled(bool enabled) {
+	this->enabled = enabled;
+}
+
+bool FrameProfiler::IsEnabled() const {
+	return enabled;
+}
+
+
+/**
+* Sets the budget of a frame
+*/
+void FrameProfiler::SetFrameBudget(int64_t budgetNs) {
+	if (budgetNs > 0)
+		this->frameBudgetNs = budgetNs;
+}
+
+int64_t FrameProfiler::GetFrameBudget() const {
+	return frameBudgetNs;
+}
+
+
+/**
+* Adds the stages of a track to the current frame
+*/
+void FrameProfiler::AddTrack(unsigned track, int simApi, const TrackTimes& times) {
+	frameStageNs[cursor] += times.cursorNs;
+	frameStageNs[model] += times.modelNs;
+	frameStageNs[submit] += times.submitNs;
+	frameStageNs[sound] += times.soundNs;
+
+	int64_t costNs = times.cursorNs + times.modelNs + times.submitNs + times.soundNs;
+	models[simApi].Record(costNs);
+
+	if (track >= tracks.size())
+		tracks.resize(track + 1);
+	TrackCost& trackCost = tracks[track];
+	trackCost.simApi = simApi;
+	trackCost.frames++;
+	trackCost.totalNs += costNs;
+	if (costNs > trackCost.maxNs)
+		trackCost.maxNs = costNs;
+}
+
+
+/**
+* Adds the time of a stage to the current frame
+*/
+void FrameProfiler::AddStage(Stage stage, int64_t ns) {
+	if (stage >= 0 && stage < stageCount)
+		frameStageNs[stage] += ns;
+}
+
+
+/**
+* Counts the current frame and starts the next
+*/
+void FrameProfiler::EndFrame(int64_t dispatchNs, uint64_t calls) {
+	frameStageNs[dispatch] = dispatchNs;
+	for (int n = 0; n < stageCount; n++) {
+		stages[n].Record(frameStageNs[n]);
+		frameStageNs[n] = 0;
+	}
+
+	simCalls.Record((int64_t)calls);
+	simCallCount += calls;
+	frames++;
+	if (dispatchNs > frameBudgetNs)
+		overBudgetFrames++;
+}
+
+
+/**
+* Removes all counts
+*/
+void FrameProfiler::Reset() {
+	for (int n = 0; n < stageCount; n++) {
+		stages[n].Reset();
+		frameStageNs[n] = 0;
+	}
+	simCalls.Reset();
+	models.clear();
+	tracks.clear();
+	frames = 0;
+	overBudgetFrames = 0;
+	simCallCount = 0;
+}
+
+
+/**
+* Returns the histogram of a stage in ns per frame
+*/
+const HdrHistogram& FrameProfiler::GetStage(Stage stage) const {
+	return stages[stage];
+}
+
+
+/**
+* Returns the histogram of the SimConnect calls per frame
+*/
+const HdrHistogram& FrameProfiler::GetSimCalls() const {
+	return simCalls;
+}
+
+
+/**
+* Returns the histograms of the cost of a track per frame, by sim model
+*/
+const std::map<int, HdrHistogram>& FrameProfiler::GetModels() const {
+	return models;
+}
+
+
+/**
+* Returns the cost of the tracks
+*/
+const std::vector<FrameProfiler::TrackCost>& FrameProfiler::GetTracks() const {
+	return tracks;
+}
+
+
+/**
+* Returns the number of frames counted, and of those over budget
+*/
+uint64_t FrameProfiler::GetFrames() const {
+	return frames;
+}
+
+uint64_t FrameProfiler::GetOverBudgetFrames() const {
+	return overBudgetFrames;
+}
+
+
+/**
+* Returns the number of SimConnect calls of all frames
+*/
+uint64_t FrameProfiler::GetSimCallCount() const {
+	return simCallCount;
+}
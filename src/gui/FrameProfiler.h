@@ -0,0 +1,176 @@
+#ifndef FrameProfiler_H
+#define FrameProfiler_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "HdrHistogram.h"
+
+/**
+* Profiler of the replay frames
+*
+* Times the stages of a frame and counts the SimConnect calls per frame, into histograms (see HdrHistogram):
+* (1) dispatch -> the frame event as a whole, i.e. wall time of the frame
+* (2) cursor -> search of the cursor position on the time line (see ReplayEngine::SetCursorPos)
+* (3) model -> interpolation of the position and update of the sim model, i.e. procedures and systems
+* (4) submit -> submission of the position and the systems to the sim (SimConnect)
+* (5) sound -> sound stage of the user aircraft
+* (6) camShake -> camera head shake of the user aircraft
+* The stages (2) to (5) are timed per track by its co-processor (see TrackTimes) and counted per frame
+* as the sum over all tracks, i.e. CPU time, computed in parallel. The cost of a track per frame is also
+* counted by sim model, and its max. by track, i.e. tracks and models blowing the frame budget stand out.
+* Runs on the processor's thread, disabled by default (no timers read)
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class FrameProfiler {
+
+public:
+	FrameProfiler();
+	~FrameProfiler();
+
+	enum Stage {
+		dispatch,
+		cursor,
+		model,
+		submit,
+		sound,
+		camShake,
+		stageCount
+	};
+
+	/**
+	* Stages of a track in the current frame in ns, timed by its co-processor
+	*/
+	struct TrackTimes {
+		int64_t cursorNs = 0;
+		int64_t modelNs = 0;
+		int64_t submitNs = 0;
+		int64_t soundNs = 0;
+	};
+
+	/**
+	* Cost of a track over all frames
+	*/
+	struct TrackCost {
+		int simApi = 0;				// Sim model of the track
+		uint64_t frames = 0;		// Frames replayed
+		int64_t totalNs = 0;		// Sum of the stages of all frames
+		int64_t maxNs = 0;			// Max. sum of the stages of a frame
+	};
+
+	/**
+	* Adds the time elapsed in its scope to a stage (no timer read, if the target is nullptr)
+	*/
+	class ScopeTimer {
+	public:
+		ScopeTimer(int64_t* targetNs) : targetNs(targetNs), startNs(targetNs ? FrameProfiler::Now() : 0) {}
+		~ScopeTimer() { if (targetNs) *targetNs += FrameProfiler::Now() - startNs; }
+	private:
+		int64_t* targetNs;
+		int64_t startNs;
+	};
+
+private:
+	bool enabled = false;
+	int64_t frameBudgetNs = 16666667;
+	HdrHistogram stages[stageCount];
+	HdrHistogram simCalls;
+	std::map<int, HdrHistogram> models;
+	std::vector<TrackCost> tracks;
+	int64_t frameStageNs[stageCount] = {};
+	uint64_t frames = 0, overBudgetFrames = 0, simCallCount = 0;
+
+public:
+	/**
+	* Returns the time of the steady clock in ns
+	*/
+	static int64_t Now();
+
+	/**
+	* Returns the name of a stage, e.g. for the export of the metrics
+	*/
+	static const char* GetStageName(Stage stage);
+
+	/**
+	* Enables/disables the profiler
+	*/
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const;
+
+	/**
+	* Sets the budget of a frame, i.e. frames taking longer are counted as over budget (default: 1/60 s)
+	*
+	* @param	budgetNs	Budget in ns
+	* @return	void
+	*/
+	void SetFrameBudget(int64_t budgetNs);
+	int64_t GetFrameBudget() const;
+
+	/**
+	* Adds the stages of a track to the current frame
+	*
+	* @param	track		Index of the track
+	* @param	simApi		Sim model of the track
+	* @param	times		Stages of the track in the current frame
+	* @return	void
+	*/
+	void AddTrack(unsigned track, int simApi, const TrackTimes& times);
+
+	/**
+	* Adds the time of a stage to the current frame, e.g. camera head shake
+	*
+	* @param	stage		Stage
+	* @param	ns			Time in ns
+	* @return	void
+	*/
+	void AddStage(Stage stage, int64_t ns);
+
+	/**
+	* Counts the current frame, i.e. its stages, and starts the next
+	*
+	* @param	dispatchNs	Wall time of the frame in ns
+	* @param	calls		SimConnect calls since the last frame
+	* @return	void
+	*/
+	void EndFrame(int64_t dispatchNs, uint64_t calls);
+
+	/**
+	* Removes all counts
+	*/
+	void Reset();
+
+	/**
+	* Returns the histogram of a stage in ns per frame
+	*/
+	const HdrHistogram& GetStage(Stage stage) const;
+
+	/**
+	* Returns the histogram of the SimConnect calls per frame
+	*/
+	const HdrHistogram& GetSimCalls() const;
+
+	/**
+	* Returns the histograms of the cost of a track per frame in ns, by sim model
+	*/
+	const std::map<int, HdrHistogram>& GetModels() const;
+
+	/**
+	* Returns the cost of the tracks, by index of the track
+	*/
+	const std::vector<TrackCost>& GetTracks() const;
+
+	/**
+	* Returns the number of frames counted, and of those over budget
+	*/
+	uint64_t GetFrames() const;
+	uint64_t GetOverBudgetFrames() const;
+
+	/**
+	* Returns the number of SimConnect calls of all frames
+	*/
+	uint64_t GetSimCallCount() const;
+};
+#endif
@@ -14,6 +14,7 @@ wxBEGIN_EVENT_TABLE(GuiMain, wxFrame)
 	// Menu Items
 	EVT_MENU(wxID_OPEN, GuiMain::LoadInputFile)
 	EVT_MENU(wxID_REFRESH, GuiMain::MenuResetProcessor)
+	EVT_MENU(wxID_JUMP_TO, GuiMain::MenuSeekInputFile)
 	EVT_MENU(wxID_EXIT, GuiMain::QuitApp)
 	EVT_MENU(wxID_NETWORK, GuiMain::MenuShowTrafficDialog)
 	EVT_MENU(wxID_INDEX, GuiMain::MenuShowOverlayDialog)
@@ -29,8 +30,8 @@ wxBEGIN_EVENT_TABLE(GuiMain, wxFrame)
 	EVT_BUTTON(wxID_STATIC, GuiMain::ButtonPauseInputFile)
 	EVT_BUTTON(wxID_NEW, GuiMain::ButtonRecordOutputFile)
 
-	// Catch events from processor/worker thread
-	EVT_COMMAND(wxID_ANY, wxEVT_COMMAND_TEXT_UPDATED, GuiMain::OnThreadUpdate)
+	// Pull status of processor/worker thread
+	EVT_TIMER(wxID_ANY, GuiMain::OnStatusTimer)
 
 wxEND_EVENT_TABLE()
 
@@ -53,6 +54,7 @@ GuiMain::GuiMain() : wxFrame(nullptr, wxID_ANY, "Flight Data Recorder", wxDefaul
 	file = new wxMenu;
 	file->Append(wxID_OPEN, wxT("&Open"), wxT(""));
 	file->Append(wxID_REFRESH, wxT("&Reset Recorder"), wxT(""));
+	file->Append(wxID_JUMP_TO, wxT("&Go To Time..."), wxT(""));
 	file->AppendSeparator();
 	file->Append(wxID_EXIT, wxT("&Quit"));
 	menuBar->Append(file, wxT("&File"));
@@ -97,6 +99,10 @@ GuiMain::GuiMain() : wxFrame(nullptr, wxID_ANY, "Flight Data Recorder", wxDefaul
 
 	// Reset UI
 	this->ResetUI("Not connected to sim!");
+
+	// Refresh timer of the processor status
+	statusTimer.SetOwner(this);
+	statusTimer.Start(cpuCom->GetStatusRefresh());
 }
 
 
@@ -104,6 +110,7 @@ GuiMain::GuiMain() : wxFrame(nullptr, wxID_ANY, "Flight Data Recorder", wxDefaul
 * Destructor
 */
 GuiMain::~GuiMain() {
+	statusTimer.Stop();
 	this->StopProcessor(cpuThread, cpuThreadCS);
 	Destroy();
 	
@@ -176,9 +183,24 @@ bool GuiMain::StopProcessor(Processor* cpuHandler, wxCriticalSection& critSectio
 		t++;
 	}
 
+	// Finalize recording stream, once the processor has stopped adding records
+	bool streamError = false;
+	if (fdrFile && fdrFile->IsStreaming() && !fdrFile->CloseStream()) {
+		streamError = true;
+		wxLogError("Can't write the recording to disk! Frames have been lost (disk full?)");
+	}
+
+	// Report frames lost by the recorder (queue overflow or write error)
+	FDRRecorderStatsStruct recorderStats = cpuCom->GetRecorderStats();
+	cpuCom->SetRecorderStats(FDRRecorderStatsStruct());
+	uint64_t lostFrames = recorderStats.dropped + recorderStats.failed;
+
 	// Reset cursor position and UI
 	cpuCom->SetCursorPos(0);
-	this->ResetUI("");
+	if (lostFrames > 0)
+		this->ResetUI("Recording incomplete: " + std::to_string(lostFrames) + " frames lost");
+	else
+		this->ResetUI(streamError ? "Recording incomplete: write error" : "");
 
 	return true;
 }
@@ -206,22 +228,47 @@ bool GuiMain::ResetProcessor(Processor *cpuHandler, wxCriticalSection& critSecti
 
 
 /**
-* Handles processor / worker thread updates
+* Shows the latest status of the processor / worker thread
 */
-void GuiMain::OnThreadUpdate(wxCommandEvent& evt) {
-	// Update "Frame" label
-	text->SetLabel(std::to_string(cpuCom->GetCursorPos()));
+void GuiMain::OnStatusTimer(wxTimerEvent& evt) {
+	// Refresh interval changed
+	if (statusTimer.GetInterval() != cpuCom->GetStatusRefresh())
+		statusTimer.Start(cpuCom->GetStatusRefresh());
+
+	ProcessorStatusStruct status = {};
+	if (!cpuCom->PullStatus(status))
+		return;
 
-	// Update: Frame rate label
-	statusBarTxt->SetLabelText(wxT("x" + std::to_string(cpuCom->GetReplayRate())));
+	// Status of a processor stopped in the meantime
+	{
+		wxCriticalSectionLocker enter(cpuThreadCS);
+		if (!cpuThread)
+			return;
+	}
 
 	// Check connectivity. Close thread and reset status in case SimConnect cannot connect
-	if (!cpuCom->GetSimConnect()) {
+	if (!status.simConnect) {
 		// Stop processor
 		this->StopProcessor(cpuThread, cpuThreadCS);
 		// Reset  UI
 		this->ResetUI("");
+		return;
 	}
+
+	// Update "Frame" label
+	wxString frameLabel = std::to_string(status.cursorPos);
+	if (text->GetLabel() != frameLabel)
+		text->SetLabel(frameLabel);
+
+	// Update: Frame rate label, incl. the AI tracks replayed and the processing time per frame
+	wxString statusLabel = wxT("x" + std::to_string(status.replayRate));
+	if (status.processorState == ProcessorCom::ProcessorState::replay) {
+		if (status.tracks > 1)
+			statusLabel << wxString::Format(wxT("   Tracks %u/%u"), status.activeTracks, status.tracks);
+		statusLabel << wxString::Format(wxT("   %.1f ms"), status.frameMs);
+	}
+	if (statusBarTxt->GetLabelText() != statusLabel)
+		statusBarTxt->SetLabelText(statusLabel);
 }
 
 
@@ -258,6 +305,47 @@ void GuiMain::ResetUI(std::string msg) {
 }
 
 
+/**
+* Opens the "save file" dialog and saves the recording in the selected format
+*/
+void GuiMain::SaveRecording() {
+	// Create a "save file" dialog
+	wxFileDialog* SaveDialog = new wxFileDialog(
+		this, wxT("Save As"), wxEmptyString, wxEmptyString,
+		wxT("Flight Data Recorder File (*.fdr)|*.fdr|Compressed Flight Data Recorder File (*.fdr)|*.fdr|Archived Flight Data Recorder File, lossy (*.fdr)|*.fdr"),
+		wxFD_SAVE | wxFD_OVERWRITE_PROMPT, wxDefaultPosition);
+
+	// If the user clicks "Save" instead of "Cancel"
+	if (SaveDialog->ShowModal() == wxID_OK) {
+		std::string fileName = (std::string)SaveDialog->GetPath();
+
+		// Save file, format as per selected file type
+		switch (SaveDialog->GetFilterIndex()) {
+		case 1:
+			fdrFile->SaveFile(fileName, FDRFileFormat::lossless);
+			break;
+		case 2: {
+			// Verify max. replay deviation of archived file against error budget, before it replaces the selected file
+			std::vector<FDRDeviationStruct> deviations;
+			if (!fdrFile->SaveFile(fileName, FDRFileFormat::quantized, nullptr, &deviations)) {
+				wxString msg;
+				for (auto& deviation : deviations) {
+					if (deviation.exceeded)
+						msg << "\n" << deviation.field << ": " << deviation.maxDeviation << " (max. " << deviation.maxError << ")";
+				}
+				msg = msg.IsEmpty() ? _("Can't save the archived recording!") : _("Archived recording exceeds the error budget, not saved:") + msg;
+				wxMessageDialog* dial = new wxMessageDialog(NULL, msg, _("Save Archive"), wxOK_DEFAULT | wxICON_ERROR);
+				dial->ShowModal();
+			}
+			break;
+		}
+		default:
+			fdrFile->SaveFile(fileName);
+		}
+	}
+}
+
+
 /** 
 * Response to load file menu option 
 */
@@ -273,17 +361,8 @@ void GuiMain::LoadInputFile(wxCommandEvent &evt) {
 		// Stop processor
 		this->StopProcessor(cpuThread, cpuThreadCS);
 		
-		// Create a "save file" dialog
-		wxFileDialog* SaveDialog = new wxFileDialog(
-			this, wxT("Save As"), wxEmptyString, wxEmptyString,
-			wxT("Flight Data Recorder File (*.fdr)|*.fdr"),
-			wxFD_SAVE | wxFD_OVERWRITE_PROMPT, wxDefaultPosition);
-
-		// If the user clicks "Save" instead of "Cancel"
-		if (SaveDialog->ShowModal() == wxID_OK) {
-			// Save file
-			fdrFile->SaveFile((std::string)SaveDialog->GetPath());
-		}
+		// Save recording
+		this->SaveRecording();
 	}
 	
 	// Create a "open file" dialog
@@ -305,7 +384,7 @@ void GuiMain::LoadInputFile(wxCommandEvent &evt) {
 				// Update status and amend title to show file name
 				SetTitle(wxString("Flight Data Recorder - ") << OpenDialog->GetFilename());
 
-				if (fdrFile->fileData.size() > 0) {
+				if (fdrFile->GetRecords().size() > 0) {
 					cpuCom->SetCursorPos(0);
 					statusBarTxt->SetLabelText(wxT("FDR input file loaded!"));
 				}
@@ -331,7 +410,7 @@ void GuiMain::LoadInputFile(wxCommandEvent &evt) {
 				// Update status and amend title to show file name
 				SetTitle(wxString("Flight Data Recorder - ") << OpenDialog->GetFilename());
 
-				if(ftdisFile->fileData.size() > 0){
+				if(ftdisFile->GetRecords().size() > 0){
 					cpuCom->SetCursorPos(0);
 					statusBarTxt->SetLabelText(wxT("FTD input file loaded!"));
 				}
@@ -453,6 +532,36 @@ void GuiMain::MenuResetProcessor(wxCommandEvent& evt) {
 }
 
 
+/**
+* Response to Go To Time menu option
+*/
+void GuiMain::MenuSeekInputFile(wxCommandEvent& evt) {
+
+	// Seek is only available during replay
+	if (!cpuThread || !cpuCom->GetSimConnect() || cpuCom->GetProcessorState() != ProcessorCom::ProcessorState::replay)
+		return;
+
+	wxTextEntryDialog seekDialog(this, _("Replay time (hh:mm:ss or seconds)"), _("Go To Time"), wxT("00:00:00"));
+	if (seekDialog.ShowModal() != wxID_OK)
+		return;
+
+	// Parse hh:mm:ss, mm:ss or ss
+	double seekTimeSec = 0;
+	wxStringTokenizer tokenizer(seekDialog.GetValue(), wxT(":"));
+	while (tokenizer.HasMoreTokens()) {
+		double value = 0;
+		if (!tokenizer.GetNextToken().Trim().Trim(false).ToDouble(&value) || value < 0) {
+			wxMessageDialog* dial = new wxMessageDialog(NULL, _("Invalid replay time. Please enter hh:mm:ss or seconds."), _("Go To Time"), wxOK_DEFAULT | wxICON_ERROR);
+			dial->ShowModal();
+			return;
+		}
+		seekTimeSec = seekTimeSec * 60 + value;
+	}
+
+	cpuCom->RequestSeek(seekTimeSec);
+}
+
+
 /**
 * Response to Traffic menu option
 */
@@ -501,7 +610,7 @@ void GuiMain::ButtonRecordOutputFile(wxCommandEvent& evt) {
 			newRecording = false;
 
 			// Cut temp recording file at current position, to allow seamless continuation of recording
-			fdrFile->fileData.resize(cpuCom->GetCursorPos());
+			fdrFile->Truncate(cpuCom->GetCursorPos());
 		}
 		
 		// Active Recording: Stop processor (end recording) and open save file dialog 
@@ -510,23 +619,20 @@ void GuiMain::ButtonRecordOutputFile(wxCommandEvent& evt) {
 			this->StopProcessor(cpuThread, cpuThreadCS);
 			newRecording = true;
 
-			// Create a "open file" dialog
-			wxFileDialog* SaveDialog = new wxFileDialog(
-				this, wxT("Save As"), wxEmptyString, wxEmptyString,
-				wxT("Flight Data Recorder File (*.fdr)|*.fdr"),
-				wxFD_SAVE | wxFD_OVERWRITE_PROMPT, wxDefaultPosition);
-
-			// If the user clicks "Save" instead of "Cancel"
-			if (SaveDialog->ShowModal() == wxID_OK) {
-				// Save file
-				fdrFile->SaveFile((std::string)SaveDialog->GetPath());
-			}
+			// Save recording
+			this->SaveRecording();
 		}
 		// Start Recording: Initialize and start new processor and update status
 		else if (!cpuThread && !cpuCom->GetSimConnect() && cpuCom->GetProcessorState() == ProcessorCom::ProcessorState::stop) {
-			// Initialize new processor
-			if(newRecording)
+			// Initialize new processor and stream recordings straight to a temporary file on disk. A continued
+			// recording is streamed to a new temporary file, starting with the records kept after truncation
+			if (newRecording) {
 				fdrFile = new FDRFile();
+				fdrFile->OpenStream((std::string)wxFileName::CreateTempFileName(wxT("FDR")));
+			}
+			else if (!fdrFile->IsStreaming())
+				fdrFile->OpenStream((std::string)wxFileName::CreateTempFileName(wxT("FDR")), true);
+			cpuCom->ClearStatus();
 			cpuThread = new Processor(this, cpuCom, fdrFile);
 
 			// Start processor
@@ -560,6 +666,7 @@ void GuiMain::ButtonPlayInputFile(wxCommandEvent &evt) {
 		if(this->tracks.size() > 0 && !cpuThread && !cpuCom->GetSimConnect() && cpuCom->GetProcessorState() == ProcessorCom::ProcessorState::stop){
 
 			// Initialize new processor in separate thread
+			cpuCom->ClearStatus();
 			cpuThread = new Processor(this, cpuCom, tracks);
 
 			// Start processor
@@ -629,17 +736,8 @@ void GuiMain::ButtonStopInputFile(wxCommandEvent &evt) {
 
 		// Check for tmp recording file and enable option to save it
 		if (cpuCom->GetCursorPos() > 0 && fdrFile && fdrFile->GetFileType() == FDRFile::FileType::tmpFile) {
-			// Create a "open file" dialog
-			wxFileDialog* SaveDialog = new wxFileDialog(
-				this, wxT("Save As"), wxEmptyString, wxEmptyString,
-				wxT("Flight Data Recorder File (*.fdr)|*.fdr"),
-				wxFD_SAVE | wxFD_OVERWRITE_PROMPT, wxDefaultPosition);
-
-			// If the user clicks "Save" instead of "Cancel"
-			if (SaveDialog->ShowModal() == wxID_OK) {
-				// Save file
-				fdrFile->SaveFile((std::string)SaveDialog->GetPath());
-			}
+			// Save recording
+			this->SaveRecording();
 		}
 
 		// Stop processor
@@ -652,17 +750,8 @@ void GuiMain::ButtonStopInputFile(wxCommandEvent &evt) {
 		this->ResetProcessor(cpuThread, cpuThreadCS);
 		newRecording = true;
 
-		// Create a "open file" dialog
-		wxFileDialog* SaveDialog = new wxFileDialog(
-			this, wxT("Save As"), wxEmptyString, wxEmptyString,
-			wxT("Flight Data Recorder File (*.fdr)|*.fdr"),
-			wxFD_SAVE | wxFD_OVERWRITE_PROMPT, wxDefaultPosition);
-
-		// If the user clicks "Save" instead of "Cancel"
-		if (SaveDialog->ShowModal() == wxID_OK) {
-			// Save file
-			fdrFile->SaveFile((std::string)SaveDialog->GetPath());
-		}
+		// Save recording
+		this->SaveRecording();
 	}
 
 	// Event has been handled, skip checking parents
@@ -720,6 +809,7 @@ void GuiMain::ButtonRewindInputFile(wxCommandEvent& evt) {
 			this->StopProcessor(cpuThread, cpuThreadCS);
 
 			// Initialize new processor
+			cpuCom->ClearStatus();
 			cpuThread = new Processor(this, cpuCom, fdrFile);
 		
 			// Start processor
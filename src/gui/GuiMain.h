@@ -9,6 +9,7 @@
 #include <wx/help.h>
 #include <wx/stdpaths.h>
 #include <wx/filename.h>
+#include <wx/tokenzr.h>
 #include "GuiOverlayDialog.h"
 #include "GuiOptionsDialog.h"
 #include "GuiTrafficDialog.h"
@@ -80,6 +81,7 @@ private:
 	wxStaticText *label = nullptr;
 	wxStaticText* statusBarTxt = nullptr;
 	wxCHMHelpController *helpCtrl = nullptr;
+	wxTimer statusTimer;
 
 	// Gui Dialogs
 	GuiOverlayDialog* overlayDialog = nullptr;
@@ -126,12 +128,13 @@ public:
 	bool ResetProcessor(Processor* cpuHandler, wxCriticalSection& critSection);
 
 	/**
-	* Handles processor / worker thread updates
+	* Shows the latest status of the processor / worker thread. Runs at the refresh rate of the GUI,
+	* i.e. status updates in between are coalesced (see ProcessorCom::PullStatus)
 	* 
-	* @param	Address of wxCommandEvent
+	* @param	Address of wxTimerEvent
 	* @return	void
 	*/
-	void OnThreadUpdate(wxCommandEvent& evt);
+	void OnStatusTimer(wxTimerEvent& evt);
 
 	/**
 	* Resets User Interface
@@ -140,6 +143,14 @@ public:
 	*/
 	void ResetUI(std::string statusText);
 
+	/**
+	* Opens the "save file" dialog and saves the recording in the selected format
+	*
+	* @param	void
+	* @return	void
+	*/
+	void SaveRecording();
+
 	/** 
 	* Response to load file menu option
 	* 
@@ -251,6 +262,14 @@ public:
 	*/
 	void MenuResetProcessor(wxCommandEvent& evt);
 
+	/**
+	* Response to Go To Time menu option. Seeks the active replay to the entered time
+	*
+	* @param	Address of wxCommandEvent
+	* @return	void
+	*/
+	void MenuSeekInputFile(wxCommandEvent& evt);
+
 	/**
 	* Response to AI Traffic menu option
 	* 
@@ -14,7 +14,7 @@ wxEND_EVENT_TABLE()
 /**
 * Constructor. Defines and initializes GUI components.
 */
-GuiOptionsDialog::GuiOptionsDialog(GuiMain* guiMain, ProcessorCom* com) : wxDialog(NULL, -1, wxT("Preferences"), wxDefaultPosition, wxSize(350, 265)) {
+GuiOptionsDialog::GuiOptionsDialog(GuiMain* guiMain, ProcessorCom* com) : wxDialog(NULL, -1, wxT("Preferences"), wxDefaultPosition, wxSize(350, 295)) {
     // Set handler / references
     this->guiMain = guiMain;
     this->cpuCom = com;
@@ -25,7 +25,7 @@ GuiOptionsDialog::GuiOptionsDialog(GuiMain* guiMain, ProcessorCom* com) : wxDial
     panel->SetForegroundColour(wxColour(221, 221, 221));
 
     // Box: Replay Options
-    wxStaticBox* replay = new wxStaticBox(panel, -1, wxT("Replay"), wxPoint(5, 5), wxSize(325, 173));
+    wxStaticBox* replay = new wxStaticBox(panel, -1, wxT("Replay"), wxPoint(5, 5), wxSize(325, 203));
     headingFont = replay->GetFont();
     headingFont.SetWeight(wxFONTWEIGHT_BOLD);
     replay->SetFont(headingFont);
@@ -50,8 +50,14 @@ GuiOptionsDialog::GuiOptionsDialog(GuiMain* guiMain, ProcessorCom* com) : wxDial
 
     wxStaticText* cbCamShakeTxt = new wxStaticText(panel, -1, "Enable Camera Shake", wxPoint(15, 150));
     cbCamShake = new wxCheckBox(panel, -1, wxT(""), wxPoint(170, 150), wxDefaultSize);
+
+    // Refresh interval of the status shown in the main window, in ms
+    wxStaticText* scStatusRefreshTxt = new wxStaticText(panel, -1, "Status Refresh (ms)", wxPoint(15, 180));
+    scStatusRefresh = new wxSpinCtrl(panel, -1, wxEmptyString, wxPoint(170, 176), wxSize(70, -1), wxSP_ARROW_KEYS, 20, 1000, statusRefresh);
+    scStatusRefresh->SetBackgroundColour(wxColour(31, 31, 31));
+    scStatusRefresh->SetForegroundColour(wxColour(255, 255, 255));
    
-    wxButton* saveButton = new wxButton(panel, wxID_SAVE, wxT("Save"), wxPoint(140, 187), wxSize(70, 30));
+    wxButton* saveButton = new wxButton(panel, wxID_SAVE, wxT("Save"), wxPoint(140, 217), wxSize(70, 30));
     saveButton->SetBackgroundColour(wxColour(48, 48, 48));
     saveButton->SetForegroundColour(wxColour(221, 221, 221));
 
@@ -64,7 +70,7 @@ GuiOptionsDialog::GuiOptionsDialog(GuiMain* guiMain, ProcessorCom* com) : wxDial
 * Response to save button press.
 */
 void GuiOptionsDialog::ButtonSaveOptions(wxCommandEvent& evt) {
-    OptionsStruct options = cpuCom->GetOptions();
+    OptionsStruct options = *cpuCom->GetOptions();
     
     options.simApi = wxAtoi(selectSimApi->GetValue());
     options.halfRate = cbHalfRate->GetValue();
@@ -72,6 +78,7 @@ void GuiOptionsDialog::ButtonSaveOptions(wxCommandEvent& evt) {
     options.beepStartEnd = cbBeebSound->GetValue();
     options.camShake = cbCamShake->GetValue();
     cpuCom->SetOptions(options);
+    cpuCom->SetStatusRefresh(scStatusRefresh->GetValue());
 
     this->SaveOptionsDialogConfig();
     
@@ -86,7 +93,7 @@ void GuiOptionsDialog::LoadOptionsDialogConfig() {
     sqlite3* dbCon = nullptr;
     sqlite3_stmt* stmt = nullptr;
     std::string appPathFile = this->guiMain->GetExePathUTF8() + "config.db";
-    OptionsStruct options = cpuCom->GetOptions();
+    OptionsStruct options = *cpuCom->GetOptions();
 
     if (sqlite3_open(appPathFile.c_str(), &dbCon) == SQLITE_OK) {
 
@@ -123,6 +130,10 @@ void GuiOptionsDialog::LoadOptionsDialogConfig() {
                     camShake = sqlite3_column_int(stmt, 2);
                     break;
                 }
+                case statusRefreshId: {
+                    statusRefresh = sqlite3_column_int(stmt, 2);
+                    break;
+                }
                 break;
             }
         }
@@ -157,6 +168,11 @@ void GuiOptionsDialog::LoadOptionsDialogConfig() {
         options.camShake = cbCamShake->GetValue();
     }
 
+    if (scStatusRefresh != nullptr) {
+        scStatusRefresh->SetValue(statusRefresh);
+        cpuCom->SetStatusRefresh(scStatusRefresh->GetValue());
+    }
+
     cpuCom->SetOptions(options);
 }
 
@@ -204,6 +220,15 @@ void GuiOptionsDialog::SaveOptionsDialogConfig() {
         rc = sqlite3_bind_int(stmt, 2, camShakeId);
         rc = sqlite3_step(stmt);
         rc = sqlite3_reset(stmt);
+        sqlite3_finalize(stmt);
+
+        // Upsert: Status refresh, i.e. config databases of older versions don't have it
+        sql = "INSERT OR REPLACE INTO option (id, type, val) VALUES (?2, 'statusRefresh', ?1);";
+        rc = sqlite3_prepare_v3(dbCon, sql, -1, 0, &stmt, NULL);
+        rc = sqlite3_bind_int(stmt, 1, scStatusRefresh->GetValue());
+        rc = sqlite3_bind_int(stmt, 2, statusRefreshId);
+        rc = sqlite3_step(stmt);
+        rc = sqlite3_reset(stmt);
 
         // Close connection
         sqlite3_finalize(stmt);
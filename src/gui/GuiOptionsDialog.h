@@ -2,6 +2,7 @@
 #define GuiOptionsDialog_H
 
 #include <wx/wx.h>
+#include <wx/spinctrl.h>
 #include <sqlite3.h>
 #include "OptionsStruct.h"
 
@@ -35,9 +36,10 @@ private:
 	wxCheckBox* cbCustSound = nullptr;
 	wxCheckBox* cbBeebSound = nullptr;
 	wxCheckBox* cbCamShake = nullptr;
+	wxSpinCtrl* scStatusRefresh = nullptr;
 	wxArrayString simApiList;
 	wxFont headingFont;
-	int defApi = 0, halfRate = 0, custSound = 0, notification = 0, camShake = 0;
+	int defApi = 0, halfRate = 0, custSound = 0, notification = 0, camShake = 0, statusRefresh = 100;
 
 	struct SimApi {
 		int recId;
@@ -51,7 +53,8 @@ private:
 		halfRateId = 2,
 		custSoundId = 3,
 		notificationId = 4,
-		camShakeId = 5
+		camShakeId = 5,
+		statusRefreshId = 6
 	};
 
 public:
@@ -154,7 +154,7 @@ GuiOverlayDialog::GuiOverlayDialog(GuiMain* guiMain, ProcessorCom* com) : wxDial
 * Response to save button press
 */
 void GuiOverlayDialog::ButtonSaveOptions(wxCommandEvent& evt) {
-    OptionsStruct options = cpuCom->GetOptions();
+    OptionsStruct options = *cpuCom->GetOptions();
     options.depHH = depTime->GetValue().GetHour();
     options.depMM = depTime->GetValue().GetMinute();
 
@@ -279,7 +279,7 @@ void GuiTrafficDialog::LoadTrack(int trackId) {
 					SetTitle(wxString("AI Traffic - Added ") << OpenDialog->GetFilename());
 
 					// Create new track, assign file (address) and add track (address) to vector
-					if (fdrFile->fileData.size() > 0) {
+					if (fdrFile->GetRecords().size() > 0) {
 						track->SetFileName(OpenDialog->GetFilename().ToStdString());
 						track->SetFileType(Track::FileType::FDR);
 						track->SetFile(fdrFile);
@@ -296,7 +296,7 @@ void GuiTrafficDialog::LoadTrack(int trackId) {
 					SetTitle(wxString("AI Traffic - Added ") << OpenDialog->GetFilename());
 
 					// Create new track, assign file (address) and add track (address) to vector
-					if (ftdisFile->fileData.size() > 0) {
+					if (ftdisFile->GetRecords().size() > 0) {
 						track->SetFileName(OpenDialog->GetFilename().ToStdString());
 						track->SetFileType(Track::FileType::FTDIS);
 						track->SetFile(ftdisFile);
@@ -304,7 +304,7 @@ void GuiTrafficDialog::LoadTrack(int trackId) {
 				}
 			}
 			// Add new track
-			if (trackId == 0 && ((fdrFile && fdrFile->fileData.size() > 0) || (ftdisFile && ftdisFile->fileData.size() > 0))) {
+			if (trackId == 0 && ((fdrFile && fdrFile->GetRecords().size() > 0) || (ftdisFile && ftdisFile->GetRecords().size() > 0))) {
 				// Amend new track data
 				track->SetSimApi(std::stod(this->selectSimApi->GetValue().ToStdString()));
 				track->SetSimTypeLivery(this->selectSimObject->GetValue().ToStdString());
@@ -0,0 +1,134 @@
+#include "HdrHistogram.h"
+
+/**
+* Constructor / Destructor
+*/
+HdrHistogram::HdrHistogram() {
+
+}
+
+HdrHistogram::~HdrHistogram() {
+
+}
+
+
+/**
+* Returns the bucket of a value
+*/
+int HdrHistogram::GetBucket(uint64_t value) {
+	if (value < (1ULL << linearBits))
+		return (int)value;
+
+	// Position of the highest bit, i.e. the power of two, and the next sub bits below it
+	int msb = 63;
+	while (!(value >> msb))
+		msb--;
+	if (msb >= maxBits)
+		return bucketCount - 1;
+
+	int shift = msb - subBits;
+	int sub = (int)(value >> shift) - (1 << subBits);
+	return (1 << linearBits) + (msb - linearBits) * (1 << subBits) + sub;
+}
+
+
+/**
+* Returns the highest value counted in a bucket
+*/
+uint64_t HdrHistogram::GetBucketValue(int bucket) {
+	if (bucket < (1 << linearBits))
+		return (uint64_t)bucket;
+
+	int msb = linearBits + (bucket - (1 << linearBits)) / (1 << subBits);
+	int sub = (bucket - (1 << linearBits)) % (1 << subBits) + (1 << subBits);
+	int shift = msb - subBits;
+	return (((uint64_t)sub + 1) << shift) - 1;
+}
+
+
+/**
+* Counts a value
+*/
+void HdrHistogram::Record(int64_t value) {
+	uint64_t v = value > 0 ? (uint64_t)value : 0;
+	counts[GetBucket(v)]++;
+	count++;
+	total += v;
+	if (v > max)
+		max = v;
+}
+
+
+/**
+* Adds the values counted by another histogram
+*/
+void HdrHistogram::Add(const HdrHistogram& other) {
+	for (int n = 0; n < bucketCount; n++)
+		counts[n] += other.counts[n];
+	count += other.count;
+	total += other.total;
+	if (other.max > max)
+		max = other.max;
+}
+
+
+/**
+* Removes all values
+*/
+void HdrHistogram::Reset() {
+	for (int n = 0; n < bucketCount; n++)
+		counts[n] = 0;
+	count = 0;
+	total = 0;
+	max = 0;
+}
+
+
+/**
+* Returns the value below or at which the given percentage of the values are
+*/
+uint64_t HdrHistogram::GetPercentile(double percentile) const {
+	if (count == 0)
+		return 0;
+
+	// Rank of the value, at least the first
+	uint64_t rank = (uint64_t)(percentile / 100.0 * count + 0.5);
+	if (rank < 1)
+		rank = 1;
+	if (rank >= count)
+		return max;
+
+	uint64_t seen = 0;
+	for (int n = 0; n < bucketCount; n++) {
+		seen += counts[n];
+		if (seen >= rank) {
+			uint64_t value = GetBucketValue(n);
+			return value < max ? value : max;
+		}
+	}
+	return max;
+}
+
+
+/**
+* Returns the number of values counted
+*/
+uint64_t HdrHistogram::GetCount() const {
+	return count;
+}
+
+
+/**
+* Returns the mean of the values counted
+*/
+double HdrHistogram::GetMean() const {
+	return count > 0 ? (double)total / count : 0.0;
+}
+
+
+/**
+* Returns the largest value counted
+*/
+uint64_t HdrHistogram::GetMax() const {
+	return max;
+}
@@ -0,0 +1,84 @@
+#ifndef HdrHistogram_H
+#define HdrHistogram_H
+
+#include <cstdint>
+
+/**
+* High dynamic range histogram of non-negative integer values, e.g. durations in ns or calls per frame
+*
+* Log-linear buckets: values below 64 are counted exactly, above each power of two is split into 32
+* buckets, i.e. a percentile is off by less than 1/32 (~3%) of its value over the whole range (up to
+* 2^41, i.e. ~36 min in ns, larger values are counted in the last bucket). Count, mean and max are exact.
+* Recording is a few instructions without allocation, i.e. cheap enough for the per-frame path
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class HdrHistogram {
+
+public:
+	HdrHistogram();
+	~HdrHistogram();
+
+private:
+	static constexpr int linearBits = 6;
+	static constexpr int subBits = linearBits - 1;
+	static constexpr int maxBits = 41;
+	static constexpr int bucketCount = (1 << linearBits) + (maxBits - linearBits) * (1 << subBits);
+
+	uint64_t counts[bucketCount] = {};
+	uint64_t count = 0, total = 0, max = 0;
+
+	/**
+	* Returns the bucket of a value
+	*/
+	static int GetBucket(uint64_t value);
+
+	/**
+	* Returns the highest value counted in a bucket
+	*/
+	static uint64_t GetBucketValue(int bucket);
+
+public:
+	/**
+	* Counts a value, negative values are counted as 0
+	*
+	* @param	value		Value, e.g. duration in ns
+	* @return	void
+	*/
+	void Record(int64_t value);
+
+	/**
+	* Adds the values counted by another histogram
+	*/
+	void Add(const HdrHistogram& other);
+
+	/**
+	* Removes all values
+	*/
+	void Reset();
+
+	/**
+	* Returns the value below or at which the given percentage of the values are, i.e. the highest value of
+	* its bucket (0 if empty)
+	*
+	* @param	percentile	Percentile, 0..100
+	* @return	uint64_t	Value
+	*/
+	uint64_t GetPercentile(double percentile) const;
+
+	/**
+	* Returns the number of values counted
+	*/
+	uint64_t GetCount() const;
+
+	/**
+	* Returns the mean of the values counted (0 if empty)
+	*/
+	double GetMean() const;
+
+	/**
+	* Returns the largest value counted
+	*/
+	uint64_t GetMax() const;
+};
+#endif
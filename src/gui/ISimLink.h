@@ -0,0 +1,68 @@
+#ifndef ISimLink_H
+#define ISimLink_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include "SimConnect.h"
+#include "SimMessageSource.h"
+
+/**
+* Link to the sim
+*
+* Definition of the subset of the SimConnect API used by the processor, co-processors and sim
+* models, i.e. data definitions, data requests, set-data and (client) events. The methods mirror
+* the SimConnect_* functions of the same name, without the connection handle. Responses are
+* delivered through the message source of the link, to the dispatch callback passed to Open.
+* Implemented by the SimConnect connection and by a deterministic in-process stand-in, which
+* allows to run the processor without a sim
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class ISimLink
+{
+
+protected:
+	uint64_t callCount = 0;
+
+public:
+	virtual ~ISimLink() {}
+
+	/**
+	* Returns the number of calls of the SimConnect functions, i.e. excl. Open, Close and the message source
+	*/
+	uint64_t GetCallCount() const { return callCount; }
+
+	/**
+	* Opens the connection to the sim
+	*
+	* @param	name			Name of the client
+	* @param	dispatchProc	Callback handling the responses of the sim
+	* @param	context			Context passed to the callback
+	* @return	bool
+	*/
+	virtual bool Open(const char* name, DispatchProc dispatchProc, void* context) = 0;
+
+	/**
+	* Closes the connection to the sim
+	*/
+	virtual HRESULT Close() = 0;
+
+	/**
+	* Returns the message source delivering the responses of the sim, i.e. to be pumped by the processor loop
+	*/
+	virtual SimMessageSource* GetMessageSource() = 0;
+
+	virtual HRESULT AddToDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId, const char* datumName, const char* unitsName, SIMCONNECT_DATATYPE datumType = SIMCONNECT_DATATYPE_FLOAT64, float epsilon = 0, DWORD datumId = SIMCONNECT_UNUSED) = 0;
+	virtual HRESULT ClearDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId) = 0;
+	virtual HRESULT RequestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID requestId, SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags = 0, DWORD origin = 0, DWORD interval = 0, DWORD limit = 0) = 0;
+	virtual HRESULT SetDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_SET_FLAG flags, DWORD arrayCount, DWORD unitSize, void* dataSet) = 0;
+	virtual HRESULT SubscribeToSystemEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* systemEventName) = 0;
+	virtual HRESULT MapClientEventToSimEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* eventName = "") = 0;
+	virtual HRESULT TransmitClientEvent(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data, SIMCONNECT_NOTIFICATION_GROUP_ID groupId, SIMCONNECT_EVENT_FLAG flags) = 0;
+	virtual HRESULT AICreateNonATCAircraft(const char* containerTitle, const char* tailNumber, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) = 0;
+	virtual HRESULT AICreateSimulatedObject(const char* containerTitle, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) = 0;
+	virtual HRESULT AIReleaseControl(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) = 0;
+	virtual HRESULT AIRemoveObject(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) = 0;
+};
+#endif
@@ -0,0 +1,72 @@
+#include "LocalMessageSource.h"
+#include <chrono>
+
+/**
+* Constructor / Destructor
+*/
+LocalMessageSource::LocalMessageSource() {
+
+}
+
+LocalMessageSource::~LocalMessageSource() {
+
+}
+
+
+/**
+* Posts a message
+*/
+void LocalMessageSource::Post(std::function<void()> message) {
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		messages.push_back(std::move(message));
+	}
+	cv.notify_one();
+}
+
+
+/**
+* Returns the number of pending messages
+*/
+size_t LocalMessageSource::GetPendingCount() {
+	std::lock_guard<std::mutex> lockGuard(m);
+	return messages.size();
+}
+
+
+/**
+* Blocks until messages are pending, the source is woken up or the timeout expires
+*/
+bool LocalMessageSource::WaitForMessages(uint32_t timeoutMs) {
+	std::unique_lock<std::mutex> lock(m);
+	bool signaled = cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] { return woken || !messages.empty(); });
+	woken = false;
+	return signaled;
+}
+
+
+/**
+* Handles all pending messages, in order. Messages may post further messages
+*/
+void LocalMessageSource::DispatchMessages() {
+	std::deque<std::function<void()>> pending;
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		pending.swap(messages);
+	}
+
+	for (auto& message : pending)
+		message();
+}
+
+
+/**
+* Interrupts a pending WaitForMessages call
+*/
+void LocalMessageSource::Wake() {
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		woken = true;
+	}
+	cv.notify_one();
+}
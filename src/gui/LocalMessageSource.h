@@ -0,0 +1,50 @@
+#ifndef LocalMessageSource_H
+#define LocalMessageSource_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include "SimMessageSource.h"
+
+/**
+* Local (stand-in) message source
+*
+* Portable message source without a sim. Messages are posted as callables from any thread and
+* handled by the thread running the message pump, in order. Allows to drive the processor loop
+* deterministically, e.g. in a headless build
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class LocalMessageSource : public SimMessageSource
+{
+
+public:
+	LocalMessageSource();
+	~LocalMessageSource();
+
+private:
+	std::mutex m;
+	std::condition_variable cv;
+	std::deque<std::function<void()>> messages;
+	bool woken = false;
+
+public:
+	/**
+	* Posts a message, i.e. a callable executed by DispatchMessages
+	*
+	* @param	message		Callable
+	* @return	void
+	*/
+	void Post(std::function<void()> message);
+
+	/**
+	* Returns the number of pending messages
+	*/
+	size_t GetPendingCount();
+
+	bool WaitForMessages(uint32_t timeoutMs);
+	void DispatchMessages();
+	void Wake();
+};
+#endif
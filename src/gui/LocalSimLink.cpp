@@ -0,0 +1,559 @@
+#include "LocalSimLink.h"
+#include <chrono>
+#include <cstring>
+
+/**
+* Sim variables of the user aircraft, replayed from the canned frames
+*/
+static const struct {
+	const char* name;
+	double FDRFileStruct::* field;
+} frameVars[] = {
+	{ "PLANE LATITUDE", &FDRFileStruct::lat },
+	{ "PLANE LONGITUDE", &FDRFileStruct::lon },
+	{ "PLANE ALTITUDE", &FDRFileStruct::alt },
+	{ "PLANE HEADING DEGREES TRUE", &FDRFileStruct::hdg },
+	{ "PLANE PITCH DEGREES", &FDRFileStruct::pitch },
+	{ "PLANE BANK DEGREES", &FDRFileStruct::bank },
+	{ "AIRSPEED INDICATED", &FDRFileStruct::spd },
+	{ "GENERAL ENG THROTTLE LEVER POSITION:1", &FDRFileStruct::thr1 },
+	{ "GENERAL ENG THROTTLE LEVER POSITION:2", &FDRFileStruct::thr2 },
+	{ "GENERAL ENG THROTTLE LEVER POSITION:3", &FDRFileStruct::thr3 },
+	{ "GENERAL ENG THROTTLE LEVER POSITION:4", &FDRFileStruct::thr4 },
+	{ "ENG N1 RPM:1", &FDRFileStruct::engN1E1 },
+	{ "ENG N1 RPM:2", &FDRFileStruct::engN1E2 },
+	{ "ENG N1 RPM:3", &FDRFileStruct::engN1E3 },
+	{ "ENG N1 RPM:4", &FDRFileStruct::engN1E4 },
+	{ "AILERON POSITION", &FDRFileStruct::alr },
+	{ "ELEVATOR POSITION", &FDRFileStruct::elev },
+	{ "RUDDER POSITION", &FDRFileStruct::rudder },
+	{ "FLAPS HANDLE INDEX", &FDRFileStruct::flaps },
+	{ "SPOILERS HANDLE POSITION", &FDRFileStruct::splr },
+	{ "GEAR HANDLE POSITION", &FDRFileStruct::gearPos },
+	{ "GEAR CENTER STEER ANGLE", &FDRFileStruct::gearAngle },
+	{ "FUEL TANK CENTER QUANTITY", &FDRFileStruct::fuelCtr },
+	{ "FUEL TANK LEFT MAIN QUANTITY", &FDRFileStruct::fuelLeft },
+	{ "FUEL TANK RIGHT MAIN QUANTITY", &FDRFileStruct::fuelRight }
+};
+
+static const struct {
+	const char* name;
+	int FDRFileStruct::* field;
+} frameLights[] = {
+	{ "LIGHT NAV", &FDRFileStruct::navL },
+	{ "LIGHT LOGO", &FDRFileStruct::logoL },
+	{ "LIGHT BEACON", &FDRFileStruct::beacL },
+	{ "LIGHT STROBE", &FDRFileStruct::strbL },
+	{ "LIGHT TAXI", &FDRFileStruct::taxiL },
+	{ "LIGHT WING", &FDRFileStruct::wngL },
+	{ "LIGHT LANDING", &FDRFileStruct::lndgL }
+};
+
+
+/**
+* Constructor / Destructor
+*/
+LocalSimLink::LocalSimLink(double frameRate, bool paced) {
+	this->frameRate = frameRate > 0.0 ? frameRate : 60.0;
+	this->paced = paced && frameRate > 0.0;
+}
+
+LocalSimLink::~LocalSimLink() {
+	this->Close();
+}
+
+
+/**
+* Opens the connection, i.e. sends the open message and starts the frame timer
+*/
+bool LocalSimLink::Open(const char* name, DispatchProc dispatchProc, void* context) {
+	if (open || !dispatchProc)
+		return false;
+
+	this->dispatchProc = dispatchProc;
+	this->context = context;
+	this->open = true;
+	this->quitSent = false;
+	objects[SIMCONNECT_OBJECT_ID_USER];
+
+	messageSource.Post([this] {
+		SIMCONNECT_RECV_OPEN msg = {};
+		msg.dwSize = sizeof(msg);
+		msg.dwVersion = SIMCONNECT_RECV_ID_OPEN;
+		msg.dwID = SIMCONNECT_RECV_ID_OPEN;
+		strncpy(msg.szApplicationName, "LocalSimLink", sizeof(msg.szApplicationName) - 1);
+		msg.dwApplicationVersionMajor = 1;
+		this->Send(&msg, sizeof(msg));
+	});
+
+	if (paced) {
+		{
+			std::lock_guard<std::mutex> lockGuard(m);
+			stopRequest = false;
+		}
+		frameThread = std::thread(&LocalSimLink::RunFrames, this);
+	}
+	return true;
+}
+
+
+/**
+* Closes the connection, i.e. stops the frame timer. Messages still pending are ignored
+*/
+HRESULT LocalSimLink::Close() {
+	if (!open)
+		return S_OK;
+
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		stopRequest = true;
+	}
+	cv.notify_all();
+	if (frameThread.joinable())
+		frameThread.join();
+
+	open = false;
+	return S_OK;
+}
+
+
+/**
+* Returns the message source delivering the responses
+*/
+SimMessageSource* LocalSimLink::GetMessageSource() {
+	return &this->messageSource;
+}
+
+
+/**
+* Frame timer thread entry. Posts a frame every 1/frameRate s, without accumulating drift
+*/
+void LocalSimLink::RunFrames() {
+	auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / frameRate));
+	auto next = std::chrono::steady_clock::now();
+
+	std::unique_lock<std::mutex> lock(m);
+	while (!stopRequest) {
+		next += period;
+		if (cv.wait_until(lock, next, [this] { return stopRequest; }))
+			break;
+		messageSource.Post([this] { this->EmitFrame(); });
+	}
+}
+
+
+/**
+* Emits sim frames independent of the frame timer
+*/
+void LocalSimLink::Step(int count) {
+	for (int n = 0; n < count; n++)
+		messageSource.Post([this] { this->EmitFrame(); });
+}
+
+
+/**
+* Sends a quit message
+*/
+void LocalSimLink::Quit() {
+	messageSource.Post([this] {
+		SIMCONNECT_RECV_QUIT msg = {};
+		msg.dwSize = sizeof(msg);
+		msg.dwVersion = SIMCONNECT_RECV_ID_QUIT;
+		msg.dwID = SIMCONNECT_RECV_ID_QUIT;
+		this->Send(&msg, sizeof(msg));
+	});
+}
+
+
+/**
+* Emits one sim frame
+*/
+void LocalSimLink::EmitFrame() {
+	if (!open || quitSent)
+		return;
+
+	uint64_t frame = frameCount.load(std::memory_order_relaxed);
+
+	// Replay canned frame as user aircraft
+	if (!frames.empty()) {
+		if (frame >= frames.size() && !loop) {
+			quitSent = true;
+			this->Quit();
+			return;
+		}
+
+		const FDRFileStruct& rec = frames[frame % frames.size()];
+		std::map<std::string, double>& user = objects[SIMCONNECT_OBJECT_ID_USER];
+		for (const auto& var : frameVars)
+			user[var.name] = rec.*var.field;
+		for (const auto& var : frameLights)
+			user[var.name] = rec.*var.field;
+	}
+	objects[SIMCONNECT_OBJECT_ID_USER]["ZULU TIME"] = zulu;
+
+	// Periodic data first, i.e. the frame event sees the data of the same frame. Handlers may add requests
+	size_t requestCount = requests.size();
+	for (size_t n = 0; n < requestCount && n < requests.size(); n++) {
+		DataRequest request = requests[n];
+
+		switch (request.period) {
+		case SIMCONNECT_PERIOD_ONCE:
+			requests.erase(requests.begin() + n);
+			requestCount--;
+			n--;
+			this->SendData(request);
+			break;
+		case SIMCONNECT_PERIOD_VISUAL_FRAME:
+		case SIMCONNECT_PERIOD_SIM_FRAME:
+			this->SendData(request);
+			break;
+		case SIMCONNECT_PERIOD_SECOND:
+			if (frame % (uint64_t)(frameRate + 0.5) == 0)
+				this->SendData(request);
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (size_t n = 0; n < frameEvents.size(); n++) {
+		SIMCONNECT_RECV_EVENT_FRAME msg = {};
+		msg.dwSize = sizeof(msg);
+		msg.dwVersion = SIMCONNECT_RECV_ID_EVENT_FRAME;
+		msg.dwID = SIMCONNECT_RECV_ID_EVENT_FRAME;
+		msg.uGroupID = SIMCONNECT_RECV_EVENT::UNKNOWN_GROUP;
+		msg.uEventID = frameEvents[n];
+		msg.fFrameRate = (float)frameRate;
+		msg.fSimSpeed = simSpeed;
+		this->Send(&msg, sizeof(msg));
+	}
+
+	zulu += simSpeed / frameRate;
+	frameCount.store(frame + 1, std::memory_order_relaxed);
+}
+
+
+/**
+* Dispatches the data of a request, in the order of the data definition
+*/
+void LocalSimLink::SendData(const DataRequest& request) {
+	auto object = objects.find(request.objectId);
+	auto definition = definitions.find(request.defineId);
+	if (object == objects.end() || definition == definitions.end())
+		return;
+
+	size_t headerSize = sizeof(SIMCONNECT_RECV_SIMOBJECT_DATA) - sizeof(DWORD), dataSize = 0;
+	for (const Datum& datum : definition->second)
+		dataSize += GetDatumSize(datum.type);
+
+	// Buffer of doubles, i.e. the data following the header is 8 byte aligned
+	std::vector<double> buffer((headerSize + dataSize + sizeof(double) - 1) / sizeof(double) + 1, 0.0);
+	SIMCONNECT_RECV_SIMOBJECT_DATA* msg = (SIMCONNECT_RECV_SIMOBJECT_DATA*)buffer.data();
+	msg->dwSize = (DWORD)(headerSize + dataSize);
+	msg->dwVersion = SIMCONNECT_RECV_ID_SIMOBJECT_DATA;
+	msg->dwID = SIMCONNECT_RECV_ID_SIMOBJECT_DATA;
+	msg->dwRequestID = request.requestId;
+	msg->dwObjectID = request.objectId;
+	msg->dwDefineID = request.defineId;
+	msg->dwentrynumber = 1;
+	msg->dwoutof = 1;
+	msg->dwDefineCount = (DWORD)definition->second.size();
+
+	uint8_t* data = (uint8_t*)buffer.data() + headerSize;
+	for (const Datum& datum : definition->second) {
+		auto var = object->second.find(datum.name);
+		double value = var != object->second.end() ? var->second : 0.0;
+
+		switch (datum.type) {
+		case SIMCONNECT_DATATYPE_INT32: { int32_t v = (int32_t)value; memcpy(data, &v, sizeof(v)); break; }
+		case SIMCONNECT_DATATYPE_INT64: { int64_t v = (int64_t)value; memcpy(data, &v, sizeof(v)); break; }
+		case SIMCONNECT_DATATYPE_FLOAT32: { float v = (float)value; memcpy(data, &v, sizeof(v)); break; }
+		case SIMCONNECT_DATATYPE_FLOAT64: memcpy(data, &value, sizeof(value)); break;
+		default: break;
+		}
+		data += GetDatumSize(datum.type);
+	}
+
+	this->Send(msg, msg->dwSize);
+}
+
+
+/**
+* Dispatches a message to the callback passed to Open
+*/
+void LocalSimLink::Send(SIMCONNECT_RECV* data, DWORD size) {
+	if (open && dispatchProc)
+		dispatchProc(data, size, context);
+}
+
+
+/**
+* Returns the size (in bytes) of a datum type
+*/
+size_t LocalSimLink::GetDatumSize(SIMCONNECT_DATATYPE type) {
+	switch (type) {
+	case SIMCONNECT_DATATYPE_INT32: return 4;
+	case SIMCONNECT_DATATYPE_INT64: return 8;
+	case SIMCONNECT_DATATYPE_FLOAT32: return 4;
+	case SIMCONNECT_DATATYPE_FLOAT64: return 8;
+	case SIMCONNECT_DATATYPE_STRING8: return 8;
+	case SIMCONNECT_DATATYPE_STRING32: return 32;
+	case SIMCONNECT_DATATYPE_STRING64: return 64;
+	case SIMCONNECT_DATATYPE_STRING128: return 128;
+	case SIMCONNECT_DATATYPE_STRING256: return 256;
+	case SIMCONNECT_DATATYPE_STRING260: return 260;
+	default: return 0;
+	}
+}
+
+
+/**
+* Sets the canned frames replayed as the user aircraft
+*/
+void LocalSimLink::SetFrames(const std::vector<FDRFileStruct>& frames, bool loop) {
+	this->frames = frames;
+	this->loop = loop;
+}
+
+
+/**
+* Sets the zulu time (in s) of the first frame
+*/
+void LocalSimLink::SetStartZulu(double zulu) {
+	this->zulu = zulu;
+}
+
+
+/**
+* Counters / state
+*/
+uint64_t LocalSimLink::GetFrameCount() {
+	return frameCount.load(std::memory_order_relaxed);
+}
+
+uint64_t LocalSimLink::GetSetDataCount() {
+	return this->setDataCount;
+}
+
+uint64_t LocalSimLink::GetTransmitCount() {
+	return this->transmitCount;
+}
+
+size_t LocalSimLink::GetObjectCount() {
+	return objects.size();
+}
+
+size_t LocalSimLink::GetDefinitionCount() {
+	return definitions.size();
+}
+
+double LocalSimLink::GetValue(SIMCONNECT_OBJECT_ID objectId, const std::string& datumName) {
+	auto object = objects.find(objectId);
+	if (object == objects.end())
+		return 0.0;
+	auto var = object->second.find(datumName);
+	return var != object->second.end() ? var->second : 0.0;
+}
+
+
+/**
+* Adds a sim variable to a data definition. Variable length and structured types are not supported
+*/
+HRESULT LocalSimLink::AddToDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId, const char* datumName, const char* unitsName, SIMCONNECT_DATATYPE datumType, float epsilon, DWORD datumId) {
+	callCount++;
+	if (!datumName || GetDatumSize(datumType) == 0)
+		return E_FAIL;
+
+	definitions[defineId].push_back({ datumName, datumType, datumId });
+	return S_OK;
+}
+
+
+/**
+* Removes all data of a definition
+*/
+HRESULT LocalSimLink::ClearDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId) {
+	callCount++;
+	definitions.erase(defineId);
+	return S_OK;
+}
+
+
+/**
+* Requests the data of an object. A request ID replaces the previous request with the same ID
+*/
+HRESULT LocalSimLink::RequestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID requestId, SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags, DWORD origin, DWORD interval, DWORD limit) {
+	callCount++;
+	if (definitions.find(defineId) == definitions.end())
+		return E_FAIL;
+
+	for (auto it = requests.begin(); it != requests.end(); ++it) {
+		if (it->requestId == requestId) {
+			requests.erase(it);
+			break;
+		}
+	}
+
+	if (period != SIMCONNECT_PERIOD_NEVER)
+		requests.push_back({ requestId, defineId, objectId, period });
+	return S_OK;
+}
+
+
+/**
+* Writes the sim variables of a data definition, in the order of the definition or, in tagged
+* format, as pairs of datum ID and value
+*/
+HRESULT LocalSimLink::SetDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_SET_FLAG flags, DWORD arrayCount, DWORD unitSize, void* dataSet) {
+	callCount++;
+	auto object = objects.find(objectId);
+	auto definition = definitions.find(defineId);
+	if (object == objects.end() || definition == definitions.end() || !dataSet)
+		return E_FAIL;
+
+	size_t size = (size_t)(arrayCount > 0 ? arrayCount : 1) * unitSize, pos = 0;
+	const uint8_t* data = (const uint8_t*)dataSet;
+	bool tagged = (flags & SIMCONNECT_DATA_SET_FLAG_TAGGED) != 0;
+	size_t datumCrsr = 0;
+
+	while (pos < size) {
+		const Datum* datum = nullptr;
+
+		if (tagged) {
+			DWORD datumId;
+			if (pos + sizeof(datumId) > size)
+				return E_FAIL;
+			memcpy(&datumId, data + pos, sizeof(datumId));
+			pos += sizeof(datumId);
+
+			for (const Datum& definitionDatum : definition->second) {
+				if (definitionDatum.datumId == datumId) {
+					datum = &definitionDatum;
+					break;
+				}
+			}
+			if (!datum)
+				return E_FAIL;
+		}
+		else if (datumCrsr < definition->second.size())
+			datum = &definition->second[datumCrsr++];
+		else
+			break;
+
+		size_t datumSize = GetDatumSize(datum->type);
+		if (pos + datumSize > size)
+			break;
+
+		switch (datum->type) {
+		case SIMCONNECT_DATATYPE_INT32: { int32_t v; memcpy(&v, data + pos, sizeof(v)); object->second[datum->name] = v; break; }
+		case SIMCONNECT_DATATYPE_INT64: { int64_t v; memcpy(&v, data + pos, sizeof(v)); object->second[datum->name] = (double)v; break; }
+		case SIMCONNECT_DATATYPE_FLOAT32: { float v; memcpy(&v, data + pos, sizeof(v)); object->second[datum->name] = v; break; }
+		case SIMCONNECT_DATATYPE_FLOAT64: { double v; memcpy(&v, data + pos, sizeof(v)); object->second[datum->name] = v; break; }
+		default: break;
+		}
+		pos += datumSize;
+	}
+
+	setDataCount++;
+	return S_OK;
+}
+
+
+/**
+* Subscribes to a system event. Only the "frame" event is emitted
+*/
+HRESULT LocalSimLink::SubscribeToSystemEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* systemEventName) {
+	callCount++;
+	if (systemEventName && strcmp(systemEventName, "frame") == 0)
+		frameEvents.push_back(eventId);
+	return S_OK;
+}
+
+
+/**
+* Maps a client event to a sim event
+*/
+HRESULT LocalSimLink::MapClientEventToSimEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* eventName) {
+	callCount++;
+	clientEvents[eventId] = eventName ? eventName : "";
+	return S_OK;
+}
+
+
+/**
+* Transmits a client event. The sim rate events change the sim speed reported by the frame event (1/4x to 16x)
+*/
+HRESULT LocalSimLink::TransmitClientEvent(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data, SIMCONNECT_NOTIFICATION_GROUP_ID groupId, SIMCONNECT_EVENT_FLAG flags) {
+	callCount++;
+	auto clientEvent = clientEvents.find(eventId);
+	if (clientEvent == clientEvents.end())
+		return E_FAIL;
+
+	if (clientEvent->second == "SIM_RATE_INCR" && simSpeed < 16.0f)
+		simSpeed *= 2.0f;
+	else if (clientEvent->second == "SIM_RATE_DECR" && simSpeed > 0.25f)
+		simSpeed /= 2.0f;
+
+	transmitCount++;
+	return S_OK;
+}
+
+
+/**
+* Creates an AI aircraft at the initial position. The object ID is assigned with the next message
+*/
+HRESULT LocalSimLink::AICreateNonATCAircraft(const char* containerTitle, const char* tailNumber, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	return this->AICreateSimulatedObject(containerTitle, initPos, requestId);
+}
+
+HRESULT LocalSimLink::AICreateSimulatedObject(const char* containerTitle, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	callCount++;
+	SIMCONNECT_OBJECT_ID objectId = nextObjectId++;
+
+	std::map<std::string, double>& object = objects[objectId];
+	object["PLANE LATITUDE"] = initPos.Latitude;
+	object["PLANE LONGITUDE"] = initPos.Longitude;
+	object["PLANE ALTITUDE"] = initPos.Altitude;
+	object["PLANE HEADING DEGREES TRUE"] = initPos.Heading;
+	object["PLANE PITCH DEGREES"] = initPos.Pitch;
+	object["PLANE BANK DEGREES"] = initPos.Bank;
+	object["AIRSPEED INDICATED"] = initPos.Airspeed;
+
+	messageSource.Post([this, objectId, requestId] {
+		SIMCONNECT_RECV_ASSIGNED_OBJECT_ID msg = {};
+		msg.dwSize = sizeof(msg);
+		msg.dwVersion = SIMCONNECT_RECV_ID_ASSIGNED_OBJECT_ID;
+		msg.dwID = SIMCONNECT_RECV_ID_ASSIGNED_OBJECT_ID;
+		msg.dwRequestID = requestId;
+		msg.dwObjectID = objectId;
+		this->Send(&msg, sizeof(msg));
+	});
+	return S_OK;
+}
+
+
+/**
+* Releases the AI control of an object
+*/
+HRESULT LocalSimLink::AIReleaseControl(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	callCount++;
+	return objects.find(objectId) != objects.end() ? S_OK : E_FAIL;
+}
+
+
+/**
+* Removes an AI object and all requests on the object
+*/
+HRESULT LocalSimLink::AIRemoveObject(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	callCount++;
+	if (objectId == SIMCONNECT_OBJECT_ID_USER || objects.erase(objectId) == 0)
+		return E_FAIL;
+
+	for (auto it = requests.begin(); it != requests.end();) {
+		if (it->objectId == objectId)
+			it = requests.erase(it);
+		else
+			++it;
+	}
+	return S_OK;
+}
@@ -0,0 +1,186 @@
+#ifndef LocalSimLink_H
+#define LocalSimLink_H
+#define _WINSOCKAPI_ 
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "SimConnect.h"
+#include "ISimLink.h"
+#include "LocalMessageSource.h"
+#include "FDRFileStruct.h"
+
+/**
+* Local (stand-in) sim link
+*
+* Deterministic in-process simulator without SimConnect. Emits sim frames at a configurable rate,
+* i.e. the "frame" system event and the data of all periodic requests, and replays canned frames
+* as the user aircraft. Data definitions, set-data calls, AI objects and the sim rate events are
+* simulated, values are stored as passed (no unit conversion). The content of every message only
+* depends on the frame count, not on wall time, i.e. two runs with the same input produce the same
+* responses. Frames are paced by a timer thread or stepped explicitly (see Step)
+*
+* All methods but Step and Quit have to be called by the thread pumping the messages
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class LocalSimLink : public ISimLink
+{
+
+public:
+	/**
+	* @param	frameRate		Sim frames per second (reported by the frame event and used to advance the zulu time)
+	* @param	paced			True -> frames are emitted in real time at frameRate, false -> frames are emitted by Step only
+	*/
+	LocalSimLink(double frameRate = 60.0, bool paced = true);
+	~LocalSimLink();
+
+private:
+	struct Datum {
+		std::string name;
+		SIMCONNECT_DATATYPE type;
+		DWORD datumId;
+	};
+
+	struct DataRequest {
+		SIMCONNECT_DATA_REQUEST_ID requestId;
+		SIMCONNECT_DATA_DEFINITION_ID defineId;
+		SIMCONNECT_OBJECT_ID objectId;
+		SIMCONNECT_PERIOD period;
+	};
+
+	LocalMessageSource messageSource;
+	DispatchProc dispatchProc = nullptr;
+	void* context = nullptr;
+	double frameRate = 60.0;
+	bool paced = true, open = false;
+
+	// Frame timer
+	std::thread frameThread;
+	std::mutex m;
+	std::condition_variable cv;
+	bool stopRequest = false;
+
+	// Sim state, only accessed by the thread pumping the messages
+	std::vector<FDRFileStruct> frames;
+	bool loop = false, quitSent = false;
+	double zulu = 43200.0;
+	float simSpeed = 1.0f;
+	std::map<SIMCONNECT_DATA_DEFINITION_ID, std::vector<Datum>> definitions;
+	std::vector<DataRequest> requests;
+	std::map<SIMCONNECT_OBJECT_ID, std::map<std::string, double>> objects;
+	std::map<SIMCONNECT_CLIENT_EVENT_ID, std::string> clientEvents;
+	std::vector<SIMCONNECT_CLIENT_EVENT_ID> frameEvents;
+	SIMCONNECT_OBJECT_ID nextObjectId = 1;
+	std::atomic<uint64_t> frameCount{ 0 };
+	uint64_t setDataCount = 0, transmitCount = 0;
+
+	/**
+	* Frame timer thread entry
+	*/
+	void RunFrames();
+
+	/**
+	* Emits one sim frame, i.e. applies the next canned frame and dispatches the periodic data and the frame event
+	*/
+	void EmitFrame();
+
+	/**
+	* Dispatches the data of a request
+	*/
+	void SendData(const DataRequest& request);
+
+	/**
+	* Dispatches a message to the callback passed to Open
+	*/
+	void Send(SIMCONNECT_RECV* data, DWORD size);
+
+	/**
+	* Returns the size (in bytes) of a datum type, 0 if not supported
+	*/
+	static size_t GetDatumSize(SIMCONNECT_DATATYPE type);
+
+public:
+	/**
+	* Sets the canned frames replayed as the user aircraft, one per sim frame. Has to be called before Open
+	*
+	* @param	frames		Flight data records
+	* @param	loop		True -> restart after the last frame, false -> send a quit message after the last frame
+	* @return	void
+	*/
+	void SetFrames(const std::vector<FDRFileStruct>& frames, bool loop = false);
+
+	/**
+	* Sets the zulu time (in s) of the first frame. Has to be called before Open
+	*/
+	void SetStartZulu(double zulu);
+
+	/**
+	* Emits sim frames independent of the frame timer (thread-safe)
+	*
+	* @param	count		Number of frames
+	* @return	void
+	*/
+	void Step(int count = 1);
+
+	/**
+	* Sends a quit message, i.e. the sim closes the connection (thread-safe)
+	*/
+	void Quit();
+
+	/**
+	* Returns the number of sim frames emitted
+	*/
+	uint64_t GetFrameCount();
+
+	/**
+	* Returns the number of set-data calls
+	*/
+	uint64_t GetSetDataCount();
+
+	/**
+	* Returns the number of client events transmitted
+	*/
+	uint64_t GetTransmitCount();
+
+	/**
+	* Returns the number of sim objects, incl. the user aircraft
+	*/
+	size_t GetObjectCount();
+
+	/**
+	* Returns the number of data definitions
+	*/
+	size_t GetDefinitionCount();
+
+	/**
+	* Returns the current value of a sim variable of an object (0 if unknown)
+	*
+	* @param	objectId	Object ID
+	* @param	datumName	Name of the sim variable, e.g. "PLANE LATITUDE"
+	* @return	double
+	*/
+	double GetValue(SIMCONNECT_OBJECT_ID objectId, const std::string& datumName);
+
+	bool Open(const char* name, DispatchProc dispatchProc, void* context);
+	HRESULT Close();
+	SimMessageSource* GetMessageSource();
+
+	HRESULT AddToDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId, const char* datumName, const char* unitsName, SIMCONNECT_DATATYPE datumType = SIMCONNECT_DATATYPE_FLOAT64, float epsilon = 0, DWORD datumId = SIMCONNECT_UNUSED);
+	HRESULT ClearDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId);
+	HRESULT RequestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID requestId, SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags = 0, DWORD origin = 0, DWORD interval = 0, DWORD limit = 0);
+	HRESULT SetDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_SET_FLAG flags, DWORD arrayCount, DWORD unitSize, void* dataSet);
+	HRESULT SubscribeToSystemEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* systemEventName);
+	HRESULT MapClientEventToSimEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* eventName = "");
+	HRESULT TransmitClientEvent(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data, SIMCONNECT_NOTIFICATION_GROUP_ID groupId, SIMCONNECT_EVENT_FLAG flags);
+	HRESULT AICreateNonATCAircraft(const char* containerTitle, const char* tailNumber, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AICreateSimulatedObject(const char* containerTitle, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AIReleaseControl(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AIRemoveObject(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId);
+};
+#endif
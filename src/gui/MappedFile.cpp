@@ -0,0 +1,170 @@
+#include "MappedFile.h"
+#include <filesystem>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+std::mutex MappedFile::registryMutex;
+std::map<std::string, std::weak_ptr<MappedFile>> MappedFile::registry;
+
+/**
+* Constructor / Destructor
+*/
+MappedFile::MappedFile() {
+
+}
+
+MappedFile::~MappedFile() {
+	this->Unmap();
+}
+
+
+/**
+* Returns a (shared) read-only mapping of the file
+*/
+std::shared_ptr<MappedFile> MappedFile::Open(std::string fileName) {
+	std::error_code ec;
+	std::string key = std::filesystem::weakly_canonical(fileName, ec).string();
+	if (ec)
+		key = fileName;
+
+	std::lock_guard<std::mutex> lockGuard(registryMutex);
+
+	// Reuse existing mapping
+	auto iterator = registry.find(key);
+	if (iterator != registry.end()) {
+		std::shared_ptr<MappedFile> mappedFile = iterator->second.lock();
+		if (mappedFile)
+			return mappedFile;
+		registry.erase(iterator);
+	}
+
+	// Create new mapping
+	std::shared_ptr<MappedFile> mappedFile(new MappedFile());
+	if (!mappedFile->Map(fileName))
+		return std::shared_ptr<MappedFile>();
+
+	registry[key] = mappedFile;
+	return mappedFile;
+}
+
+
+/**
+* Removes the file from the registry
+*/
+void MappedFile::Invalidate(std::string fileName) {
+	std::error_code ec;
+	std::string key = std::filesystem::weakly_canonical(fileName, ec).string();
+	if (ec)
+		key = fileName;
+
+	std::lock_guard<std::mutex> lockGuard(registryMutex);
+	registry.erase(key);
+}
+
+
+/**
+* Maps the file into memory
+*/
+bool MappedFile::Map(std::string fileName) {
+	this->fileName = fileName;
+
+#ifdef _WIN32
+	hFile = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0) {
+		this->Unmap();
+		return false;
+	}
+
+	hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping == NULL) {
+		this->Unmap();
+		return false;
+	}
+
+	data = static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) {
+		this->Unmap();
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+#else
+	fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		this->Unmap();
+		return false;
+	}
+
+	void* ptr = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (ptr == MAP_FAILED) {
+		this->Unmap();
+		return false;
+	}
+	data = static_cast<const char*>(ptr);
+	size = (size_t)fileStat.st_size;
+#endif
+
+	return true;
+}
+
+
+/**
+* Releases the mapping and closes the file
+*/
+void MappedFile::Unmap() {
+#ifdef _WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (hMapping != NULL)
+		CloseHandle(hMapping);
+	if (hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(hFile);
+
+	hMapping = NULL;
+	hFile = INVALID_HANDLE_VALUE;
+#else
+	if (data)
+		munmap(const_cast<char*>(data), size);
+	if (fd >= 0)
+		close(fd);
+
+	fd = -1;
+#endif
+	data = nullptr;
+	size = 0;
+}
+
+
+/**
+* Returns a pointer to the start of the mapped file
+*/
+const char* MappedFile::GetData() {
+	return this->data;
+}
+
+
+/**
+* Returns the size of the mapped file in bytes
+*/
+size_t MappedFile::GetSize() {
+	return this->size;
+}
+
+
+/**
+* Returns the path and name of the mapped file
+*/
+std::string MappedFile::GetFileName() {
+	return this->fileName;
+}
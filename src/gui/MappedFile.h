@@ -0,0 +1,90 @@
+#ifndef MappedFile_H
+#define MappedFile_H
+#define _WINSOCKAPI_ 
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/**
+* Read-only memory mapped file
+*
+* Maps a file into the address space of the process. Mappings are shared, i.e. opening 
+* the same file several times (e.g. several tracks referencing the same recording) 
+* returns the same mapping and the same pages in memory
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class MappedFile {
+
+public:
+	~MappedFile();
+
+private:
+	MappedFile();
+
+	std::string fileName;
+	const char* data = nullptr;
+	size_t size = 0;
+
+#ifdef _WIN32
+	HANDLE hFile = INVALID_HANDLE_VALUE;
+	HANDLE hMapping = NULL;
+#else
+	int fd = -1;
+#endif
+
+	static std::mutex registryMutex;
+	static std::map<std::string, std::weak_ptr<MappedFile>> registry;
+
+	/**
+	* Maps the file into memory
+	*
+	* @param	fileName	Path and name of file
+	* @return	bool
+	*/
+	bool Map(std::string fileName);
+
+	/**
+	* Releases the mapping and closes the file
+	*/
+	void Unmap();
+
+public:
+	/**
+	* Returns a (shared) read-only mapping of the file
+	*
+	* @param	fileName		Path and name of file
+	* @return	MappedFile		Shared pointer, empty if the file couldn't be mapped
+	*/
+	static std::shared_ptr<MappedFile> Open(std::string fileName);
+
+	/**
+	* Removes the file from the registry, e.g. after it has been replaced on disk, i.e. the next Open maps
+	* the file again. Existing mappings remain valid and keep the previous content
+	*
+	* @param	fileName		Path and name of file
+	* @return	void
+	*/
+	static void Invalidate(std::string fileName);
+
+	/**
+	* Returns a pointer to the start of the mapped file
+	*/
+	const char* GetData();
+
+	/**
+	* Returns the size of the mapped file in bytes
+	*/
+	size_t GetSize();
+
+	/**
+	* Returns the path and name of the mapped file
+	*/
+	std::string GetFileName();
+};
+#endif
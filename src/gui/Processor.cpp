@@ -2,29 +2,43 @@
 #include "ProcessorCom.h"
 #include "CoprocessorFDR.h"
 #include "CoprocessorFTDIS.h"
+#ifndef FDR_HEADLESS
 #include "GuiMain.h"
+#endif
 #include "Track.h"
 #include "FDRFile.h"
 #include "FTDISFile.h"
+#include "FDRRecorder.h"
+#include "SimConnectLink.h"
+#include "SimMessagePump.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <map>
 
 /**
 * Constructor / Destructor
 */
-Processor::Processor(GuiMain* handler, ProcessorCom* com, vector<Track*> tracks) : wxThread(wxTHREAD_DETACHED) {
+Processor::Processor(GuiMain* handler, ProcessorCom* com, vector<Track*> tracks) {
 	this->guiMainHandler = handler;
 	this->cpuCom = com;
 	this->tracks = tracks;
+	this->cpusFDR.resize(tracks.size(), nullptr);
+	this->cpusFTDIS.resize(tracks.size(), nullptr);
+#ifndef FDR_HEADLESS
 	this->headCam = new CamShake(handler);
+#endif
 
 	// ----------------------------------------------------------------------------------
 	// @todo Review and rework
 	// ----------------------------------------------------------------------------------
 	// Update flight time in case of continuation of existing recording
 	//if (fdrFile->GetSize() > 0)
-	//	this->fdrRec.fltTime = fdrFile->fileData[fdrFile->GetSize()].fltTime;
+	//	this->fdrRec.fltTime = fdrFile->GetRecords()[fdrFile->GetSize()].fltTime;
 }
 // Deprecated
-Processor::Processor(GuiMain *handler, ProcessorCom *com, FDRFile *file) : wxThread(wxTHREAD_DETACHED) {
+Processor::Processor(GuiMain *handler, ProcessorCom *com, FDRFile *file) {
 	guiMainHandler = handler;
 	cpuCom = com;
 	fdrFile = file;
@@ -32,10 +46,10 @@ Processor::Processor(GuiMain *handler, ProcessorCom *com, FDRFile *file) : wxThr
 
 	// Update flight time in case of continuation of existing recording
 	if (fdrFile->GetSize() > 0)
-		this->fdrRec.fltTime = fdrFile->fileData[fdrFile->GetSize()].fltTime;
+		this->fdrRec.fltTime = fdrFile->GetRecords()[fdrFile->GetSize()].fltTime;
 }
 // Deprecated
-Processor::Processor(GuiMain *handler, ProcessorCom *com, FTDISFile *file) : wxThread(wxTHREAD_DETACHED) {
+Processor::Processor(GuiMain *handler, ProcessorCom *com, FTDISFile *file) {
 	guiMainHandler = handler;
 	cpuCom = com;
 	ftdisFile = file;
@@ -45,6 +59,9 @@ Processor::Processor(GuiMain *handler, ProcessorCom *com, FTDISFile *file) : wxT
 
 Processor::~Processor() {
 	
+	// Close recorder
+	delete recorder;
+
 	// Close co-processors
 	for (auto& cpu : cpusFDR)
 		delete cpu;
@@ -53,7 +70,20 @@ Processor::~Processor() {
 	for (auto& cpu : cpusFTDIS)
 		delete cpu;
 	cpusFTDIS.clear();
+
+	// Remove idle AI objects, after the co-processors (sim models release their AI objects to the pool)
+	if (aiPool)
+		aiPool->Clear();
+	delete aiPool;
+
+	// Close compute threads
+	delete computePool;
+
+	// Close message pump and link to sim, after the co-processors (sim models remove their AI objects via the link)
+	delete messagePump;
+	delete simLink;
 	
+#ifndef FDR_HEADLESS
 	// Close thread
 	wxCriticalSectionLocker enter(guiMainHandler->cpuThreadCS);
 	guiMainHandler->cpuThread = NULL;
@@ -62,9 +92,11 @@ Processor::~Processor() {
 	if(listener)
 		listener->close();
 	delete listener;
+#endif
 }
 
 
+#ifndef FDR_HEADLESS
 /**
 * Thread entry
 */
@@ -82,11 +114,27 @@ wxThread::ExitCode Processor::Entry() {
 */
 wxThread::ExitCode Processor::Exit() {
 	
+	this->Shutdown();
+
+	return (wxThread::ExitCode)0;     // success
+}
+#endif
+
+
+/**
+* Writes outstanding records and signals the Com handler that the processor stops
+*/
+void Processor::Shutdown() {
+
+	// Write outstanding records, before the GUI takes over the .fdr file again
+	if (recorder) {
+		recorder->Stop();
+		cpuCom->SetRecorderStats(recorder->GetStats());
+	}
+
 	// Signal the Com handler that this thread is going to be destroyed and update status
 	cpuCom->SetSimConnect(false);
 	cpuCom->SetProcessorState(ProcessorCom::ProcessorState::stop);
-
-	return (wxThread::ExitCode)0;     // success
 }
 
 
@@ -121,70 +169,20 @@ void Processor::DispatchProc(SIMCONNECT_RECV* pData, DWORD cbData) {
 	case SIMCONNECT_RECV_ID_SIMOBJECT_DATA: {
 		SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData = (SIMCONNECT_RECV_SIMOBJECT_DATA*)pData;
 
-		for (UINT n = 0; n < this->reqIndex; n++) {
-
-			if (pObjData->dwRequestID == (UINT)REQ_POS_DATA + n) {
-				DWORD ObjectID = pObjData->dwObjectID;
-				posSet = (PosDataSet*)&pObjData->dwData;
-
-				this->fdrRecords[n].lat = posSet->lat;
-				this->fdrRecords[n].lon = posSet->lon;
-				this->fdrRecords[n].alt = posSet->alt - this->staticCGAlt[n];
-				this->fdrRecords[n].hdg = posSet->hdg;
-				this->fdrRecords[n].pitch = posSet->pitch - this->staticCGPitch[n];
-				this->fdrRecords[n].bank = posSet->bank;
-				this->fdrRecords[n].spd = posSet->spd;
-			}
-			else if (pObjData->dwRequestID == (UINT)REQ_SYS_DATA + n) {
-				DWORD ObjectID = pObjData->dwObjectID;
-				sysSet = (SysDataSet*)&pObjData->dwData;
-
-				this->fdrRecords[n].thr1 = sysSet->thr1;
-				this->fdrRecords[n].thr2 = sysSet->thr2;
-				this->fdrRecords[n].thr3 = sysSet->thr3;
-				this->fdrRecords[n].thr4 = sysSet->thr4;
-				this->fdrRecords[n].engN1E1 = sysSet->engN1E1;
-				this->fdrRecords[n].engN1E2 = sysSet->engN1E2;
-				this->fdrRecords[n].engN1E3 = sysSet->engN1E3;
-				this->fdrRecords[n].engN1E4 = sysSet->engN1E4;
-				this->fdrRecords[n].alr = sysSet->alr;
-				this->fdrRecords[n].elev = sysSet->elev;
-				this->fdrRecords[n].rudder = sysSet->rudder;
-				this->fdrRecords[n].flaps = sysSet->flaps;
-				this->fdrRecords[n].splr = sysSet->splr;
-				this->fdrRecords[n].gearPos = sysSet->gearPos;
-				this->fdrRecords[n].gearAngle = sysSet->gearAngle;
-				this->fdrRecords[n].fuelCtr = sysSet->fuelCtr;
-				this->fdrRecords[n].fuelLeft = sysSet->fuelLeft;
-				this->fdrRecords[n].fuelRight = sysSet->fuelRight;
-				this->fdrRecords[n].navL = sysSet->navL;
-				this->fdrRecords[n].logoL = sysSet->logoL;
-				this->fdrRecords[n].beacL = sysSet->beacL;
-				this->fdrRecords[n].strbL = sysSet->strbL;
-				this->fdrRecords[n].taxiL = sysSet->taxiL;
-				this->fdrRecords[n].wngL = sysSet->wngL;
-				this->fdrRecords[n].lndgL = sysSet->lndgL;
-			}
-			else if (pObjData->dwRequestID == (UINT)REQ_SIM_DATA + n) {
-				DWORD ObjectID = pObjData->dwObjectID;
-				simSet = (SimDataSet*)&pObjData->dwData;
-
-				this->altGround[n] = simSet->groundAlt;
-				this->absAltGround[n] = simSet->absGroundAlt;
-				this->staticCGAlt[n] = simSet->staticCGAlt;
-				this->staticCGPitch[n] = simSet->staticCGPitch;
-				this->flapsLeadingPrc[n] = simSet->flapsLeadingPrc;
-				this->flapsTrailingPrc[n] = simSet->flapsTrailingPrc;
-				this->zulu = simSet->zulu;
-				this->headCamData.fltTime = simSet->zulu;
-				this->headCamData.simCamPosX = simSet->simCamPosX;
-				this->headCamData.simCamPosY = simSet->simCamPosY;
-
-				if (zuluStartFrame == 0)
-					zuluStartFrame = simSet->zulu;
-
-				this->fdrRecords[n].fltTime = (std::floor(((simSet->zulu - zuluStartFrame) * 100) + .5) / 100);
-			}
+		// Route the response directly to the handler and slot of the request
+		SimRequestRouter::Route route = this->requestRouter.Find(pObjData->dwRequestID);
+		switch (route.handler) {
+		case SimRequestRouter::posData:
+			this->OnPosData(route.slot, (PosDataSet*)&pObjData->dwData);
+			break;
+		case SimRequestRouter::sysData:
+			this->OnSysData(route.slot, (SysDataSet*)&pObjData->dwData);
+			break;
+		case SimRequestRouter::simData:
+			this->OnSimData(route.slot, (SimDataSet*)&pObjData->dwData);
+			break;
+		default:
+			break;
 		}
 		break;
 	}
@@ -212,84 +210,228 @@ void Processor::DispatchProc(SIMCONNECT_RECV* pData, DWORD cbData) {
 							//this->fdrRecords[this->simRequestId].fltTime = std::floor(((this->fdrRecords[this->simRequestId].fltTime + simFrameTimeSec) * 100) + .5) / 100;
 							
 
-							// Add record to .fdr file
-							if(this->fdrRecords[this->simRequestId].lat != 0.0)
-								fdrFile->AddRecord(this->fdrRecords[this->simRequestId]);
+							// Publish record to the recorder thread (wait-free), which adds it to the .fdr file
+							const FDRFileStruct& userRecord = this->simObjects.Get(this->simRequestId).record;
+							if (userRecord.lat != 0.0) {
+								recorder->SetStartZulu(zuluStartFrame);
+								recorder->Publish(userRecord);
+							}
 							
-							cpuCom->SetCursorPos(fdrFile->GetSize());
+							cpuCom->SetCursorPos(recorder->GetFileSize());
 							break;
 						}
 						// ------------------------------------------------------------------------
 						// Replay 
 						case ProcessorCom::ProcessorState::replay: {
+							auto frameStart = std::chrono::steady_clock::now();
+							int64_t camShakeNs = 0;
+							frameProfiler.SetEnabled(cpuCom->GetProfiling());
+							uint64_t frameSimCalls = (liveLink ? liveLink : simLink)->GetCallCount();
 							
 							// Determine sim rate
 							simFrameTimeSec = (1.0f / evt->fFrameRate);
 							simRate = evt->fSimSpeed; 
 
+							// Advance the time line of the replay, read by all co-processors, phase-locked to the zulu time of the user aircraft (see ReplayClock)
+							if (userSlot >= 0 && simObjects.Get(userSlot).zulu > 0)
+								replayClock.SetZuluTime(simObjects.Get(userSlot).zulu);
+							replayClock.Tick(simFrameTimeSec, simRate, cpuCom->GetReplayRate());
+
 							// Adjust FS sim rate to selected replay rate
 							if (abs(cpuCom->GetReplayRate()) > simRate)
-								SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_SIM_RATE_INCR, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+								simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_SIM_RATE_INCR, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 							else if(abs(cpuCom->GetReplayRate()) < simRate)
-								SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_SIM_RATE_DECR, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+								simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_SIM_RATE_DECR, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 							
-							// Loop through track(s), create individual co-processors for each track and update sim object information
+							// Seek requested via GUI/REST: move all tracks to the same moment on the time line
+							double seekTimeSec = 0;
+							if (cpuCom->GetSeekRequest(seekTimeSec)) {
+								replayClock.Seek(seekTimeSec);
+								for (CoprocessorFDR* cpuFDR : cpusFDR)
+									if (cpuFDR)
+										cpuFDR->Seek(seekTimeSec);
+								for (CoprocessorFTDIS* cpuFTDIS : cpusFTDIS)
+									if (cpuFTDIS)
+										cpuFTDIS->Seek(seekTimeSec);
+							}
+
+							// Retire AI tracks past their last record and activate AI tracks due within the lead time (see TrackActivationScheduler)
+							if (trackActivation.GetSize() != tracks.size()) {
+								trackActivation.Reset(tracks);
+								this->PrewarmAiObjects();
+							}
+							trackActivation.Update(replayClock.GetTime(), retireTracks, activateTracks);
+
+							for (UINT retireTrack : retireTracks) {
+								// Sim model removes the AI object
+								delete cpusFDR.at(retireTrack);
+								cpusFDR.at(retireTrack) = nullptr;
+								delete cpusFTDIS.at(retireTrack);
+								cpusFTDIS.at(retireTrack) = nullptr;
+							}
+
+							// Loop through track(s), create individual co-processors for each track and collect the active ones
 							Track* track = nullptr;
-							int cpusFDRCrsr = 0, cpusFTDISCrsr = 0;
+							frameCpus.clear();
+							waitingTracks = 0;
 							
 							for (vector<int>::size_type tracksCrsr = 0; tracksCrsr != tracks.size(); tracksCrsr++) {
 								track = tracks.at(tracksCrsr);
 								
+								// Dormant AI track, i.e. no co-processor and no AI object
+								bool activeTrack = track->GetTrackType() == Track::TrackType::USER || trackActivation.IsActive((UINT)tracksCrsr);
+								
 								if (track->GetFileType() == Track::FileType::FDR) {
-									if (cpusFDRCrsr >= cpusFDR.size())
+									if (!cpusFDR.at(tracksCrsr)) {
 										// Create new processor
-										cpusFDR.push_back(new CoprocessorFDR(this, track));
+										if (activeTrack)
+											cpusFDR.at(tracksCrsr) = new CoprocessorFDR(this, track);
+									}
+									else if (cpusFDR.at(tracksCrsr)->GetSimObjectID() != -1) {
+										frameCpus.push_back({ cpusFDR.at(tracksCrsr), nullptr, (UINT)tracksCrsr });
+										if (track->GetTrackType() == Track::TrackType::USER)
+											userSlot = cpusFDR.at(tracksCrsr)->GetSimRequestID();
+									}
 									else {
-										// Run processor
-										if(cpusFDR.at(cpusFDRCrsr)->GetSimObjectID() != -1) {
-											cpusFDR.at(cpusFDRCrsr)->SetAircraftPos();
-											cpusFDR.at(cpusFDRCrsr)->SetAircraftSystems();
-											cpusFDR.at(cpusFDRCrsr)->SetSoundStage();
-										}
+										// Keep in sync with the replay, while waiting for the AI object
+										cpusFDR.at(tracksCrsr)->Seek(replayClock.GetTime());
+										waitingTracks++;
 									}
-									cpusFDRCrsr++;
 								}
 								else if (track->GetFileType() == Track::FileType::FTDIS) {
-									if (cpusFTDISCrsr >= cpusFTDIS.size())
+									if (!cpusFTDIS.at(tracksCrsr)) {
 										// Create new processor
-										cpusFTDIS.push_back(new CoprocessorFTDIS(this, track));
+										if (activeTrack)
+											cpusFTDIS.at(tracksCrsr) = new CoprocessorFTDIS(this, track);
+									}
+									else if (cpusFTDIS.at(tracksCrsr)->GetSimObjectID() != -1) {
+										frameCpus.push_back({ nullptr, cpusFTDIS.at(tracksCrsr), (UINT)tracksCrsr });
+										if (track->GetTrackType() == Track::TrackType::USER)
+											userSlot = cpusFTDIS.at(tracksCrsr)->GetSimRequestID();
+									}
 									else {
-										// Run processor
-										if (cpusFTDIS.at(cpusFTDISCrsr)->GetSimObjectID() != -1) {
-											cpusFTDIS.at(cpusFTDISCrsr)->SetCursorPos();
-											cpusFTDIS.at(cpusFTDISCrsr)->SetAircraftPos();
-											cpusFTDIS.at(cpusFTDISCrsr)->SetAircraftSystems();
-											cpusFTDIS.at(cpusFTDISCrsr)->SetSoundStage();
-										}
+										// Keep in sync with the replay, while waiting for the AI object
+										cpusFTDIS.at(tracksCrsr)->Seek(replayClock.GetTime());
+										waitingTracks++;
 									}
-									cpusFTDISCrsr++;
 								}	
 							}
+
+							// Hand the AI objects assigned by the sim or taken from the pool to their tracks, computed with the next frame
+							UINT aiTrack = 0;
+							DWORD aiObjectId = 0;
+							while (aiPool && aiPool->NextHandover(aiTrack, aiObjectId)) {
+								if (cpusFDR.at(aiTrack) && cpusFDR.at(aiTrack)->GetSimObjectID() == -1)
+									cpusFDR.at(aiTrack)->SetSimObjectId(aiObjectId);
+								else if (cpusFTDIS.at(aiTrack) && cpusFTDIS.at(aiTrack)->GetSimObjectID() == -1)
+									cpusFTDIS.at(aiTrack)->SetSimObjectId(aiObjectId);
+								else
+									// Track retired (and activated again) before its AI object has been assigned
+									aiPool->Release(aiObjectId);
+							}
+
+							// Compute the frames of all tracks in parallel (cursor, interpolation, derived state)
+							if (!computePool)
+								computePool = new WorkStealingPool(computeThreads);
+
+							computePool->ParallelFor(frameCpus.size(), 16, [this](size_t i) {
+								if (frameCpus[i].fdr)
+									frameCpus[i].fdr->ComputeFrame();
+								else
+									frameCpus[i].ftdis->ComputeFrame();
+							});
+
+							// Level of detail of the AI traffic, relative to the user aircraft. Without a user track, all tracks are updated every frame
+							bool trafficLodActive = false;
+							if (trafficLodEnabled) {
+								if (trafficLod.GetSize() != tracks.size())
+									trafficLod.Reset(tracks.size());
+
+								const PosDataSet* userPos = nullptr;
+								for (auto& frameCpu : frameCpus) {
+									const PosDataSet& pos = frameCpu.fdr ? frameCpu.fdr->GetPosition() : frameCpu.ftdis->GetPosition();
+									if (tracks.at(frameCpu.track)->GetTrackType() == Track::TrackType::USER)
+										userPos = &pos;
+									else
+										trafficLod.SetPosition(frameCpu.track, pos.lat, pos.lon);
+								}
+
+								if (userPos) {
+									trafficLod.Classify(userPos->lat, userPos->lon, userPos->hdg, simFrameTimeSec);
+									trafficLodActive = true;
+								}
+							}
+
+							// Submit the frames to the sim, in track order on the processor's thread. AI tracks not due are skipped,
+							// i.e. the sim keeps the last position set. Computation above still runs every frame, the tracks stay in sync
+							for (auto& frameCpu : frameCpus) {
+								TrafficLodScheduler::Update update = TrafficLodScheduler::full;
+								if (trafficLodActive && tracks.at(frameCpu.track)->GetTrackType() == Track::TrackType::AI)
+									update = trafficLod.Schedule(frameCpu.track);
+
+								if (update == TrafficLodScheduler::skip)
+									continue;
+
+								if (frameCpu.fdr) {
+									frameCpu.fdr->SetAircraftPos();
+									if (update == TrafficLodScheduler::full) {
+										frameCpu.fdr->SetAircraftSystems();
+										frameCpu.fdr->SetSoundStage();
+									}
+								}
+								else {
+									frameCpu.ftdis->SetAircraftPos();
+									if (update == TrafficLodScheduler::full) {
+										frameCpu.ftdis->SetAircraftSystems();
+										frameCpu.ftdis->SetSoundStage();
+									}
+								}
+							}
 							
+#ifndef FDR_HEADLESS
 							// Camera head shake processing for main/user track
 							if(cpuCom->GetCamShake() && tracks.at(0)->GetTrackType() == Track::TrackType::USER){
+								FrameProfiler::ScopeTimer timer(frameProfiler.IsEnabled() ? &camShakeNs : nullptr);
+
 								// Prepare camera data set
-								this->headCamData.thr = (float) this->fdrRecords[0].thr1;
-								this->headCamData.flaps = (float) this->flapsTrailingPrc[0];
-								this->headCamData.splr = (float) this->fdrRecords[0].splr;
-								this->headCamData.gearPos = (float) this->fdrRecords[0].gearPos;
-								this->headCamData.absGroundAlt = (float) this->absAltGround[0];
-								this->headCamData.spd = (float) this->fdrRecords[0].spd;
+								const SimObjectStruct& userObject = this->simObjects.Get(0);
+								this->headCamData.thr = (float) userObject.record.thr1;
+								this->headCamData.flaps = (float) userObject.flapsTrailingPrc;
+								this->headCamData.splr = (float) userObject.record.splr;
+								this->headCamData.gearPos = (float) userObject.record.gearPos;
+								this->headCamData.absGroundAlt = (float) userObject.absAltGround;
+								this->headCamData.spd = (float) userObject.record.spd;
 								this->headCamData.simReplayRate = this->cpuCom->GetReplayRate();
 
 								// Update camera position via mouse input
 								headCam->SetCameraPos(this->headCamData, camX, camY, camZ);
 								
 								// @note As of SDK 0.16.0 Camera Events are not(!) supported
-								// this->hr = SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_AXIS_PAN_PITCH, (DWORD)camX, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-								// this->hr = SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_AXIS_PAN_HEADING, (DWORD)camY, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+								// this->hr = simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_AXIS_PAN_PITCH, (DWORD)camX, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+								// this->hr = simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_AXIS_PAN_HEADING, (DWORD)camY, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+							}
+#endif
+
+							// Processing time of the frame, incl. the submission to the sim
+							activeTracks = (UINT)frameCpus.size();
+							int64_t frameNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - frameStart).count();
+							frameMs = frameNs / 1.0e6;
+							if (frameMs > maxFrameMs)
+								maxFrameMs = frameMs;
+
+							// Profile of the frame by stage, track and sim model, incl. the SimConnect calls of the frame (see FrameProfiler)
+							if (frameProfiler.IsEnabled()) {
+								for (auto& frameCpu : frameCpus)
+									frameProfiler.AddTrack(frameCpu.track, tracks.at(frameCpu.track)->GetSimApi(), frameCpu.fdr ? frameCpu.fdr->GetFrameTimes() : frameCpu.ftdis->GetFrameTimes());
+								frameProfiler.AddStage(FrameProfiler::camShake, camShakeNs);
+								frameProfiler.EndFrame(frameNs, (liveLink ? liveLink : simLink)->GetCallCount() - frameSimCalls);
+
+								// Snapshot for the metrics endpoint, about once per second
+								if (frameProfiler.GetFrames() % 60 == 1) {
+									std::lock_guard<std::mutex> lockGuard(profileMutex);
+									profileSnapshot = frameProfiler;
+								}
 							}
-
 							break;
 						}
 					}
@@ -305,40 +447,28 @@ void Processor::DispatchProc(SIMCONNECT_RECV* pData, DWORD cbData) {
 	// Receive Object ID for requested AI object and assign to corresponding processor
 	case SIMCONNECT_RECV_ID_ASSIGNED_OBJECT_ID: {
 		SIMCONNECT_RECV_ASSIGNED_OBJECT_ID* pObjData = (SIMCONNECT_RECV_ASSIGNED_OBJECT_ID*)pData;
-		this->aiID.push_back((DWORD)pObjData->dwObjectID);
-
-		int aiTrackCrsr = 0, aiFDRTrackCrsr = 0, aiFTDISTrackCrsr = 0;
-		for (auto& track : tracks) {
-			if (track->GetTrackType() == Track::TrackType::AI) {
-				if (track->GetFileType() == Track::FileType::FDR) {
-					if (this->aiID.size() - 1 == aiTrackCrsr) {
-						// Assign object ID
-						cpusFDR.at(aiFDRTrackCrsr)->SetSimObjectId((DWORD)pObjData->dwObjectID);
-						// Release AI control
-						this->hr = SimConnect_AIReleaseControl(this->hSimConnect, pObjData->dwObjectID, AI_RELEASEATC); // (UINT)REQ_AI_AC + cpusFDR.at(aiFDRTrackCrsr)->GetSimRequestID());
-					}
-					aiFDRTrackCrsr++;
-				}
-				else if (track->GetFileType() == Track::FileType::FTDIS) {
-					if (this->aiID.size() - 1 == aiTrackCrsr) {
-						// Assign object ID
-						cpusFTDIS.at(aiFTDISTrackCrsr)->SetSimObjectId((DWORD)pObjData->dwObjectID);
-						// Release AI control
-						this->hr = SimConnect_AIReleaseControl(this->hSimConnect, pObjData->dwObjectID, AI_RELEASEATC); //(UINT)REQ_AI_AC + cpusFDR.at(aiFDRTrackCrsr)->GetSimRequestID());
 
-					}
-					aiFTDISTrackCrsr++;
-				}
-				aiTrackCrsr++;
-			}
-		}
+		// Release AI control
+		this->hr = this->simLink->AIReleaseControl(pObjData->dwObjectID, AI_RELEASEATC);
+
+		// Match the object ID by the request ID of its creation request, handed to the track with the next frame
+		if (aiPool)
+			aiPool->OnAssignedObjectId(pObjData->dwRequestID, (DWORD)pObjData->dwObjectID);
+		break;
+	}
+	// ------------------------------------------------------------------------
+	// Identify sim, e.g. for the metadata of recordings
+	case SIMCONNECT_RECV_ID_OPEN:
+	{
+		SIMCONNECT_RECV_OPEN* pOpen = (SIMCONNECT_RECV_OPEN*)pData;
+		this->simApi = "SimConnect " + std::string(pOpen->szApplicationName) + " " + std::to_string(pOpen->dwApplicationVersionMajor) + "." + std::to_string(pOpen->dwApplicationVersionMinor);
 		break;
 	}
 	// ------------------------------------------------------------------------
 	// Handle close connection request
 	case SIMCONNECT_RECV_ID_QUIT:
 	{
-		hr = SimConnect_Close(hSimConnect);
+		hr = simLink->Close();
 		cpuCom->SetSimConnect(false);
 		break;
 	}
@@ -348,49 +478,342 @@ void Processor::DispatchProc(SIMCONNECT_RECV* pData, DWORD cbData) {
 	}
 }
 
+/**
+* Handles the position data of a sim object
+*/
+void Processor::OnPosData(UINT slot, PosDataSet* posSet) {
+	SimObjectStruct& state = this->simObjects.Get(slot);
+
+	state.record.lat = posSet->lat;
+	state.record.lon = posSet->lon;
+	state.record.alt = posSet->alt - state.staticCGAlt;
+	state.record.hdg = posSet->hdg;
+	state.record.pitch = posSet->pitch - state.staticCGPitch;
+	state.record.bank = posSet->bank;
+	state.record.spd = posSet->spd;
+}
+
+
+/**
+* Handles the system data of a sim object
+*/
+void Processor::OnSysData(UINT slot, SysDataSet* sysSet) {
+	SimObjectStruct& state = this->simObjects.Get(slot);
+
+	state.record.thr1 = sysSet->thr1;
+	state.record.thr2 = sysSet->thr2;
+	state.record.thr3 = sysSet->thr3;
+	state.record.thr4 = sysSet->thr4;
+	state.record.engN1E1 = sysSet->engN1E1;
+	state.record.engN1E2 = sysSet->engN1E2;
+	state.record.engN1E3 = sysSet->engN1E3;
+	state.record.engN1E4 = sysSet->engN1E4;
+	state.record.alr = sysSet->alr;
+	state.record.elev = sysSet->elev;
+	state.record.rudder = sysSet->rudder;
+	state.record.flaps = sysSet->flaps;
+	state.record.splr = sysSet->splr;
+	state.record.gearPos = sysSet->gearPos;
+	state.record.gearAngle = sysSet->gearAngle;
+	state.record.fuelCtr = sysSet->fuelCtr;
+	state.record.fuelLeft = sysSet->fuelLeft;
+	state.record.fuelRight = sysSet->fuelRight;
+	state.record.navL = sysSet->navL;
+	state.record.logoL = sysSet->logoL;
+	state.record.beacL = sysSet->beacL;
+	state.record.strbL = sysSet->strbL;
+	state.record.taxiL = sysSet->taxiL;
+	state.record.wngL = sysSet->wngL;
+	state.record.lndgL = sysSet->lndgL;
+}
+
+
+/**
+* Handles the sim data of a sim object
+*/
+void Processor::OnSimData(UINT slot, SimDataSet* simSet) {
+	SimObjectStruct& state = this->simObjects.Get(slot);
+
+	state.altGround = simSet->groundAlt;
+	state.absAltGround = simSet->absGroundAlt;
+	state.staticCGAlt = simSet->staticCGAlt;
+	state.staticCGPitch = simSet->staticCGPitch;
+	state.flapsLeadingPrc = simSet->flapsLeadingPrc;
+	state.flapsTrailingPrc = simSet->flapsTrailingPrc;
+	state.zulu = simSet->zulu;
+	this->zulu = simSet->zulu;
+	this->headCamData.fltTime = simSet->zulu;
+	this->headCamData.simCamPosX = simSet->simCamPosX;
+	this->headCamData.simCamPosY = simSet->simCamPosY;
+
+	if (zuluStartFrame == 0)
+		zuluStartFrame = simSet->zulu;
+
+	state.record.fltTime = (std::floor(((simSet->zulu - zuluStartFrame) * 100) + .5) / 100);
+}
+
+
+/**
+* Sets the link to the sim
+*/
+void Processor::SetSimLink(ISimLink* link) {
+	delete simLink;
+	simLink = link;
+}
+
+
+/**
+* Sets the number of threads computing the frames of the replayed tracks
+*/
+void Processor::SetComputeThreads(unsigned threads) {
+	delete computePool;
+	computePool = nullptr;
+	computeThreads = threads;
+}
+
+
+/**
+* Sets the time the AI object of a track is spawned before the first record of the track
+*/
+void Processor::SetActivationLeadTime(double leadTimeSec) {
+	trackActivation.SetLeadTime(leadTimeSec);
+}
+
+
+/**
+* Sets the number of AI objects per sim model config created ahead of the replay and kept idle for reuse
+*/
+void Processor::SetAiPoolSize(unsigned size) {
+	aiPoolSize = size;
+	if (aiPool)
+		aiPool->SetMaxIdle(size);
+}
+
+
+/**
+* Returns the counters of the AI object pool
+*/
+AiObjectPool::Stats Processor::GetAiPoolStats() {
+	return aiPool ? aiPool->stats : AiObjectPool::Stats();
+}
+
+
+/**
+* Sets the time between two keyframes of a track
+*/
+void Processor::SetKeyframeInterval(double intervalSec) {
+	if (intervalSec > 0)
+		keyframeIntervalSec = intervalSec;
+}
+
+
+/**
+* Returns the time between two keyframes of a track
+*/
+double Processor::GetKeyframeInterval() {
+	return keyframeIntervalSec;
+}
+
+
+/**
+* Starts a dry run, i.e. the calls of the sim models are discarded
+*/
+void Processor::BeginDryRun() {
+	if (liveLink)
+		return;
+
+	liveLink = simLink;
+	simLink = &dryRunLink;
+}
+
+
+/**
+* Ends the dry run
+*/
+void Processor::EndDryRun() {
+	if (!liveLink)
+		return;
+
+	simLink = liveLink;
+	liveLink = nullptr;
+}
+
+
+/**
+* Returns the pool of AI objects, created with the first request
+*/
+AiObjectPool* Processor::GetAiPool() {
+	if (!aiPool) {
+		aiPool = new AiObjectPool(simLink, (UINT)REQ_AI_AC, (UINT)KEY_FREEZE_POOLED_AI);
+		aiPool->SetMaxIdle(aiPoolSize);
+	}
+	return aiPool;
+}
+
+
+/**
+* Requests an AI object for a track from the pool
+*/
+HRESULT Processor::RequestAiObject(Track* track, const SIMCONNECT_DATA_INITPOSITION& initPos) {
+	auto owner = std::find(tracks.begin(), tracks.end(), track);
+	if (owner == tracks.end())
+		return E_FAIL;
+
+	return this->GetAiPool()->Acquire(track->GetSimCfgUuid(), initPos, (UINT)(owner - tracks.begin()));
+}
+
+
+/**
+* Releases the AI object of a track to the pool
+*/
+HRESULT Processor::ReleaseAiObject(DWORD objectId, UINT slot) {
+	if (!aiPool)
+		return E_FAIL;
+
+	HRESULT hr = aiPool->Release(objectId);
+
+	// Stop the data requests of the slot, i.e. a reused object is requested by the slot of its next track
+	if (hr == S_OK) {
+		this->simLink->RequestDataOnSimObject((UINT)this->REQ_POS_DATA + slot, (UINT)this->POS_DATA_SET + slot, objectId, SIMCONNECT_PERIOD_NEVER);
+		this->simLink->RequestDataOnSimObject((UINT)this->REQ_SYS_DATA + slot, (UINT)this->SYS_DATA_SET + slot, objectId, SIMCONNECT_PERIOD_NEVER);
+		this->simLink->RequestDataOnSimObject((UINT)this->REQ_SIM_DATA + slot, (UINT)this->SIM_DATA_SET + slot, objectId, SIMCONNECT_PERIOD_NEVER);
+	}
+	return hr;
+}
+
+
+/**
+* Requests the AI objects of the replay ahead of time
+*/
+void Processor::PrewarmAiObjects() {
+	// AI tracks by sim model config
+	std::map<std::string, vector<Track*>> aiTracks;
+	for (Track* track : tracks)
+		if (track->GetTrackType() == Track::TrackType::AI)
+			aiTracks[track->GetSimCfgUuid()].push_back(track);
+
+	double leadTimeSec = trackActivation.GetLeadTime();
+	for (auto& cfgTracks : aiTracks) {
+		vector<Track*>& cfg = cfgTracks.second;
+		std::sort(cfg.begin(), cfg.end(), [](Track* a, Track* b) { return a->GetStartTime() < b->GetStartTime(); });
+
+		// Peak number of tracks active at the same time, i.e. from the lead time before the first record to the last record
+		vector<std::pair<double, int>> events;
+		for (Track* track : cfg) {
+			events.push_back({ track->GetStartTime() - leadTimeSec, 1 });
+			events.push_back({ track->GetEndTime(), -1 });
+		}
+		std::sort(events.begin(), events.end());
+
+		int activeCount = 0, peakCount = 0;
+		for (auto& event : events) {
+			activeCount += event.second;
+			peakCount = std::max(peakCount, activeCount);
+		}
+
+		// Objects at the initial positions of the tracks starting first, i.e. the tracks claiming them
+		vector<SIMCONNECT_DATA_INITPOSITION> initPos;
+		for (size_t i = 0; i < cfg.size() && i < (size_t)peakCount && i < aiPoolSize; i++)
+			initPos.push_back(GetAiInitPosition(cfg[i]));
+
+		this->GetAiPool()->Prewarm(cfgTracks.first, initPos);
+	}
+}
+
+
+/**
+* Returns the initial position of the AI object of a track
+*/
+SIMCONNECT_DATA_INITPOSITION Processor::GetAiInitPosition(Track* track) {
+	SIMCONNECT_DATA_INITPOSITION initPos = {};
+
+	if (track->GetFileType() == Track::FileType::FDR && track->GetFDRFile()->GetRecords().size() > 0) {
+		initPos.Altitude = track->GetFDRFile()->GetRecords().front().alt;
+		initPos.Latitude = track->GetFDRFile()->GetRecords().front().lat;
+		initPos.Longitude = track->GetFDRFile()->GetRecords().front().lon;
+		initPos.Heading = track->GetFDRFile()->GetRecords().front().hdg;
+	}
+	else if (track->GetFileType() == Track::FileType::FTDIS && track->GetFTDISFile()->GetRecords().size() > 0) {
+		initPos.Altitude = track->GetFTDISFile()->GetRecords().front().alt;
+		initPos.Latitude = track->GetFTDISFile()->GetRecords().front().lat;
+		initPos.Longitude = track->GetFTDISFile()->GetRecords().front().lon;
+		initPos.Heading = track->GetFTDISFile()->GetRecords().front().hdg;
+	}
+
+	// Default position and attitude vars (see sim models)
+	initPos.Pitch = 0.0;
+	initPos.Bank = 0.0;
+	initPos.OnGround = 1;
+	initPos.Airspeed = 1;
+	return initPos;
+}
+
+
+/**
+* Enables or disables the level of detail of the AI traffic
+*/
+void Processor::SetTrafficLod(bool enabled) {
+	trafficLodEnabled = enabled;
+}
+
 
 /** 
-* Initializes the connection to the sim (using SimConnect API)
+* Initializes the connection to the sim (using SimConnect API, unless another link has been set) and runs the message loop
 */
 bool Processor::InitSimConnect() {
 
-	// Try to connect to sim via Sim Connect API
-	if (SUCCEEDED(SimConnect_Open(&hSimConnect, "MainProcessorInterface", NULL, 0, 0, 0)))
+	// Connectivity to sim not established
+	if (!this->OpenSimLink())
+		return false;
+
+#ifndef FDR_HEADLESS
+	// While thread is active / delete request hasn't been sent
+	while (!TestDestroy()) {
+		// Wait for SimConnect messages and dispatch them. Wait times out regularly to check for delete requests
+		if (this->Pump())
+			// Publish status, pulled by the main thread at its refresh rate
+			this->PublishStatus();
+	}
+		
+	// Exit thread upon delete request from main thread
+	if (TestDestroy()) {
+		this->Exit();
+	}
+#endif
+	return true;
+}
+
+
+/** 
+* Opens the link to the sim
+*/
+bool Processor::OpenSimLink() {
+
+	// Try to connect to sim via Sim Connect API. The link signals its message source on new messages
+	if (!simLink)
+		simLink = new SimConnectLink();
+
+	if (simLink->Open("MainProcessorInterface", MyDispatchProcRD, this))
 	{
+		messagePump = new SimMessagePump(simLink->GetMessageSource(), cpuCom->GetPumpMode(), cpuCom->GetPumpInterval());
+
 		// Subscribe to system events
-		this->hr = SimConnect_SubscribeToSystemEvent(hSimConnect, EVENT_RECUR_FRAME, "frame");
+		this->hr = simLink->SubscribeToSystemEvent(EVENT_RECUR_FRAME, "frame");
 
 		// Map global client / sim events
-		this->hr = SimConnect_MapClientEventToSimEvent(hSimConnect, KEY_SIM_RATE_DECR, "SIM_RATE_DECR");
-		this->hr = SimConnect_MapClientEventToSimEvent(hSimConnect, KEY_SIM_RATE_INCR, "SIM_RATE_INCR");
+		this->hr = simLink->MapClientEventToSimEvent(KEY_SIM_RATE_DECR, "SIM_RATE_DECR");
+		this->hr = simLink->MapClientEventToSimEvent(KEY_SIM_RATE_INCR, "SIM_RATE_INCR");
 
 		// Map camera controls
 		// @note As of SDK 0.16.0 Camera Events are not(!) supported
-		// this->hr = SimConnect_MapClientEventToSimEvent(hSimConnect, (UINT) KEY_AXIS_PAN_PITCH, "AXIS_PAN_PITCH");
-		// this->hr = SimConnect_MapClientEventToSimEvent(hSimConnect, (UINT) KEY_AXIS_PAN_HEADING, "AXIS_PAN_HEADING");
-		// this->hr = SimConnect_MapClientEventToSimEvent(hSimConnect, (UINT) KEY_AXIS_PAN_TILT, "AXIS_PAN_TILT");
-		// this->hr = SimConnect_MapClientEventToSimEvent(hSimConnect, (UINT) KEY_AXIS_ZOOM_IN_FINE, "ZOOM_IN_FINE");
-		// this->hr = SimConnect_MapClientEventToSimEvent(hSimConnect, (UINT) KEY_AXIS_ZOOM_OUT_FINE, "ZOOM_OUT_FINE");
+		// this->hr = simLink->MapClientEventToSimEvent((UINT) KEY_AXIS_PAN_PITCH, "AXIS_PAN_PITCH");
+		// this->hr = simLink->MapClientEventToSimEvent((UINT) KEY_AXIS_PAN_HEADING, "AXIS_PAN_HEADING");
+		// this->hr = simLink->MapClientEventToSimEvent((UINT) KEY_AXIS_PAN_TILT, "AXIS_PAN_TILT");
+		// this->hr = simLink->MapClientEventToSimEvent((UINT) KEY_AXIS_ZOOM_IN_FINE, "ZOOM_IN_FINE");
+		// this->hr = simLink->MapClientEventToSimEvent((UINT) KEY_AXIS_ZOOM_OUT_FINE, "ZOOM_OUT_FINE");
 
 		// Set progress flags
 		cpuCom->SetSimConnect(true);
-
-		// While thread is active / delete request hasn't been sent
-		while (!TestDestroy()) {
-			// Call dispatch and Sim Connect disptach 
-			SimConnect_CallDispatch(hSimConnect, MyDispatchProcRD, this);
-			
-			// Notify main thread
-			wxCommandEvent event(wxEVT_COMMAND_TEXT_UPDATED, wxID_ANY);
-			guiMainHandler->GetEventHandler()->AddPendingEvent(event);
-			
-			Sleep(1);
-		}
-		
-		// Exit thread upon delete request from main thread
-		if (TestDestroy()) {
-			this->Exit();
-		}
 		return true;
 	}
 	// Connectivity to sim via SimConnect not established
@@ -401,12 +824,54 @@ bool Processor::InitSimConnect() {
 }
 
 
+/**
+* Waits for messages of the sim and dispatches them
+*/
+bool Processor::Pump() {
+	return messagePump && messagePump->Pump();
+}
+
+
+/**
+* Returns a snapshot of the frame profiler
+*/
+FrameProfiler Processor::GetProfileSnapshot() {
+	std::lock_guard<std::mutex> lockGuard(profileMutex);
+	return profileSnapshot;
+}
+
+
+/**
+* Publishes the status of the processor to the GUI
+*/
+void Processor::PublishStatus() {
+	ProcessorStatusStruct status = {};
+	status.seq = ++statusSeq;
+	status.processorState = cpuCom->GetProcessorState();
+	status.simConnect = cpuCom->GetSimConnect();
+	status.cursorPos = cpuCom->GetCursorPos();
+	status.replayRate = cpuCom->GetReplayRate();
+	status.replayTimeSec = replayClock.GetTime();
+	status.tracks = (uint32_t)tracks.size();
+	status.activeTracks = activeTracks;
+	status.waitingTracks = waitingTracks;
+	status.simFrameMs = simFrameTimeSec * 1000.0;
+	status.frameMs = frameMs;
+	status.maxFrameMs = maxFrameMs;
+	cpuCom->PublishStatus(status);
+}
+
+
 /**
 * Initializes the REST API for the OBS Overlay
 * @return   bool
 */
 void Processor::InitRestApi() {
+	// Columnar track data, i.e. the request handler only touches the channels it reports
+	if (fileType == 0 && fdrFile)
+		fdrColumns = fdrFile->GetColumns();
 
+#ifndef FDR_HEADLESS
 	// Listen to and handle GET requests
 	try {
 		listener = new http_listener(U("http://127.0.0.1:1234"));
@@ -415,6 +880,17 @@ void Processor::InitRestApi() {
 		listener->open().wait();
 		listener->support(methods::GET, [&](http_request request) {
 
+			// Metrics of the frame profiler, e.g. GET http://127.0.0.1:1234/metrics. The first request enables the profiler
+			if (request.relative_uri().path() == U("/metrics")) {
+				cpuCom->SetProfiling(true);
+
+				http_response response(status_codes::OK);
+				response.headers().add(U("Access-Control-Allow-Origin"), U("*"));
+				response.set_body(this->GetMetricsJson());
+				request.reply(response);
+				return;
+			}
+
 			// Calc elapsed time (in sim) between requests		
 			if (this->prevZulu != 0 && this->zulu != 0 && this->zulu > this->prevZulu) {
 				tElapsed = this->zulu - this->prevZulu;
@@ -434,48 +910,48 @@ void Processor::InitRestApi() {
 					cursorPos = 1;
 				}
 
-				OptionsStruct options = cpuCom->GetOptions();
+				ProcessorCom::OptionsRef options = cpuCom->GetOptions();
 
 				// Add reference data
-				jsonResponse[L"depHH"] = json::value::number(options.depHH);
-				jsonResponse[L"depMM"] = json::value::number(options.depMM);
-				jsonResponse[L"depGMTHH"] = json::value::number(options.depGMTHH);
-				jsonResponse[L"depGMTMM"] = json::value::number(options.depGMTMM);
-				jsonResponse[L"destName"] = json::value::string(utility::conversions::to_string_t(options.destName));
-				jsonResponse[L"fltHH"] = json::value::number(options.fltHH);
-				jsonResponse[L"fltMM"] = json::value::number(options.fltMM);
-				jsonResponse[L"destGMTHH"] = json::value::number(options.destGMTHH);
-				jsonResponse[L"destGMTMM"] = json::value::number(options.destGMTMM);
+				jsonResponse[L"depHH"] = json::value::number(options->depHH);
+				jsonResponse[L"depMM"] = json::value::number(options->depMM);
+				jsonResponse[L"depGMTHH"] = json::value::number(options->depGMTHH);
+				jsonResponse[L"depGMTMM"] = json::value::number(options->depGMTMM);
+				jsonResponse[L"destName"] = json::value::string(utility::conversions::to_string_t(options->destName));
+				jsonResponse[L"fltHH"] = json::value::number(options->fltHH);
+				jsonResponse[L"fltMM"] = json::value::number(options->fltMM);
+				jsonResponse[L"destGMTHH"] = json::value::number(options->destGMTHH);
+				jsonResponse[L"destGMTMM"] = json::value::number(options->destGMTMM);
 			
 				// Add file specific data (.fdr / .ftd)
-				if (fileType == 0) {
-					jsonResponse[L"lat"] = json::value::number(fdrFile->fileData[cursorPos].lat);
-					jsonResponse[L"lon"] = json::value::number(fdrFile->fileData[cursorPos].lon);
+				if (fileType == 0 && fdrColumns && (size_t)cursorPos < fdrColumns->GetSize()) {
+					jsonResponse[L"lat"] = json::value::number(fdrColumns->Get(FDRTrackColumns::lat, cursorPos));
+					jsonResponse[L"lon"] = json::value::number(fdrColumns->Get(FDRTrackColumns::lon, cursorPos));
 
-					jsonResponse[L"alt"] = json::value::number(fdrFile->fileData[cursorPos].alt);
-					jsonResponse[L"hdg"] = json::value::number(fdrFile->fileData[cursorPos].hdg);
+					jsonResponse[L"alt"] = json::value::number(fdrColumns->Get(FDRTrackColumns::alt, cursorPos));
+					jsonResponse[L"hdg"] = json::value::number(fdrColumns->Get(FDRTrackColumns::hdg, cursorPos));
 
-					jsonResponse[L"spd"] = json::value::number(fdrFile->fileData[cursorPos].spd);
+					jsonResponse[L"spd"] = json::value::number(fdrColumns->Get(FDRTrackColumns::spd, cursorPos));
 
 					jsonResponse[L"zul"] = json::value::number(this->zulu);
 					jsonResponse[L"tEl"] = json::value::number(tFlt);
 
-					travelDist += (fdrFile->fileData[cursorPos].spd * 0.000319661) * tElapsed; //Knots to miles per second >> x * 0.000319661
+					travelDist += (fdrColumns->Get(FDRTrackColumns::spd, cursorPos) * 0.000319661) * tElapsed; //Knots to miles per second >> x * 0.000319661
 					jsonResponse[L"dst"] = json::value::number(travelDist);
 				}
 				else if(fileType == 1){
-					jsonResponse[L"lat"] = json::value::number(ftdisFile->fileData[cursorPos].lat);
-					jsonResponse[L"lon"] = json::value::number(ftdisFile->fileData[cursorPos].lon);
+					jsonResponse[L"lat"] = json::value::number(ftdisFile->GetRecords()[cursorPos].lat);
+					jsonResponse[L"lon"] = json::value::number(ftdisFile->GetRecords()[cursorPos].lon);
 
-					jsonResponse[L"alt"] = json::value::number(ftdisFile->fileData[cursorPos].alt);
-					jsonResponse[L"hdg"] = json::value::number(ftdisFile->fileData[cursorPos].hdg);
+					jsonResponse[L"alt"] = json::value::number(ftdisFile->GetRecords()[cursorPos].alt);
+					jsonResponse[L"hdg"] = json::value::number(ftdisFile->GetRecords()[cursorPos].hdg);
 
-					jsonResponse[L"spd"] = json::value::number(ftdisFile->fileData[cursorPos].spd);
+					jsonResponse[L"spd"] = json::value::number(ftdisFile->GetRecords()[cursorPos].spd);
 
 					jsonResponse[L"zul"] = json::value::number(this->zulu);
 					jsonResponse[L"tEl"] = json::value::number(tFlt);
 
-					travelDist += (ftdisFile->fileData[cursorPos].spd * 0.000319661) * tElapsed; //Knots to miles per second >> x * 0.000319661
+					travelDist += (ftdisFile->GetRecords()[cursorPos].spd * 0.000319661) * tElapsed; //Knots to miles per second >> x * 0.000319661
 					jsonResponse[L"dst"] = json::value::number(travelDist);
 				}
 	
@@ -487,6 +963,24 @@ void Processor::InitRestApi() {
 			}
 			this_thread::sleep_for(chrono::milliseconds(500));
 			});
+
+		// Seek replay to a position on the time line, e.g. POST http://127.0.0.1:1234/?t=3600 (in s)
+		listener->support(methods::POST, [&](http_request request) {
+			auto query = uri::split_query(request.request_uri().query());
+			auto seekTime = query.find(U("t"));
+
+			http_response response(status_codes::Accepted);
+			response.headers().add(U("Access-Control-Allow-Origin"), U("*"));
+			try {
+				if (seekTime == query.end())
+					throw std::invalid_argument("Missing seek time");
+				cpuCom->RequestSeek(std::stod(seekTime->second));
+			}
+			catch (const std::exception& e) {
+				response.set_status_code(status_codes::BadRequest);
+			}
+			request.reply(response);
+			});
 	}
 	catch (...) {
 		// Ellipsis exception handler to handle http listener / response exceptions
@@ -495,74 +989,183 @@ void Processor::InitRestApi() {
 		// Close listener and clean up
 
 	}
+#endif
+}
 
+
+#ifndef FDR_HEADLESS
+/**
+* Returns percentiles, mean and max of a histogram as JSON, scaled, e.g. from ns to us
+*/
+static json::value HistogramJson(const HdrHistogram& histogram, double scale) {
+	json::value result;
+	result[L"count"] = json::value::number(histogram.GetCount());
+	result[L"p50"] = json::value::number(histogram.GetPercentile(50) * scale);
+	result[L"p99"] = json::value::number(histogram.GetPercentile(99) * scale);
+	result[L"max"] = json::value::number(histogram.GetMax() * scale);
+	result[L"mean"] = json::value::number(histogram.GetMean() * scale);
+	return result;
 }
 
 
 /**
-* Initializes the data record set and SimConnect request dispatch for flight recording
-*
-* @param	void
-* @return   void
+* Returns the metrics of the frame profiler as JSON
 */
-void Processor::InitRecordDataSet() {
-	// Define dedicated SimConnect request ID for this simObject
-	this->simRequestId = this->reqIndex;
-	this->reqIndex++;
+json::value Processor::GetMetricsJson() {
+	FrameProfiler profile = this->GetProfileSnapshot();
+	json::value metrics;
+
+	metrics[L"frames"] = json::value::number(profile.GetFrames());
+	metrics[L"overBudgetFrames"] = json::value::number(profile.GetOverBudgetFrames());
+	metrics[L"frameBudgetUs"] = json::value::number(profile.GetFrameBudget() / 1000.0);
+
+	// Stages in us per frame
+	for (int stage = 0; stage < FrameProfiler::stageCount; stage++)
+		metrics[L"stagesUs"][utility::conversions::to_string_t(FrameProfiler::GetStageName((FrameProfiler::Stage)stage))] = HistogramJson(profile.GetStage((FrameProfiler::Stage)stage), 0.001);
+
+	metrics[L"simCalls"] = HistogramJson(profile.GetSimCalls(), 1.0);
+	metrics[L"simCalls"][L"total"] = json::value::number(profile.GetSimCallCount());
+
+	// Cost of a track per frame in us, by sim model
+	for (auto& model : profile.GetModels())
+		metrics[L"modelsUs"][utility::conversions::to_string_t(std::to_string(model.first))] = HistogramJson(model.second, 0.001);
+
+	// Most expensive tracks, by max. cost per frame
+	const vector<FrameProfiler::TrackCost>& trackCosts = profile.GetTracks();
+	vector<size_t> top;
+	for (size_t n = 0; n < trackCosts.size(); n++)
+		if (trackCosts[n].frames > 0)
+			top.push_back(n);
+	std::sort(top.begin(), top.end(), [&trackCosts](size_t a, size_t b) { return trackCosts[a].maxNs > trackCosts[b].maxNs; });
+
+	json::value topTracks = json::value::array();
+	for (size_t n = 0; n < top.size() && n < 10; n++) {
+		const FrameProfiler::TrackCost& trackCost = trackCosts[top[n]];
+		json::value track;
+		track[L"track"] = json::value::number((uint64_t)top[n]);
+		track[L"simApi"] = json::value::number(trackCost.simApi);
+		track[L"frames"] = json::value::number(trackCost.frames);
+		track[L"meanUs"] = json::value::number(trackCost.totalNs / 1000.0 / trackCost.frames);
+		track[L"maxUs"] = json::value::number(trackCost.maxNs / 1000.0);
+		topTracks[n] = track;
+	}
+	metrics[L"topTracks"] = topTracks;
+	return metrics;
+}
+#endif
+
+
+/**
+* Allocates the request slot of a sim object and routes its data requests to the slot
+*/
+UINT Processor::AddRequestSlot() {
+	UINT slot = this->simObjects.Add();
+	assert(slot < maxRequestSlots);
+	if (slot >= maxRequestSlots) {
+		this->simObjects.Remove(slot);
+		throw std::length_error("No free request slot");
+	}
+
+	this->requestRouter.Register((UINT)REQ_POS_DATA + slot, SimRequestRouter::posData, slot);
+	this->requestRouter.Register((UINT)REQ_SYS_DATA + slot, SimRequestRouter::sysData, slot);
+	this->requestRouter.Register((UINT)REQ_SIM_DATA + slot, SimRequestRouter::simData, slot);
+
+	return slot;
+}
+
+
+/**
+* Releases the request slot of a removed sim object
+*/
+void Processor::RemoveRequestSlot(UINT slot) {
+	this->simLink->RequestDataOnSimObject((UINT)this->REQ_POS_DATA + slot, (UINT)this->POS_DATA_SET + slot, SIMCONNECT_OBJECT_ID_USER, SIMCONNECT_PERIOD_NEVER);
+	this->simLink->RequestDataOnSimObject((UINT)this->REQ_SYS_DATA + slot, (UINT)this->SYS_DATA_SET + slot, SIMCONNECT_OBJECT_ID_USER, SIMCONNECT_PERIOD_NEVER);
+	this->simLink->RequestDataOnSimObject((UINT)this->REQ_SIM_DATA + slot, (UINT)this->SIM_DATA_SET + slot, SIMCONNECT_OBJECT_ID_USER, SIMCONNECT_PERIOD_NEVER);
+
+	// Data definitions of the slot (POS_DATA_SET ... SYS_WRITE_SET), i.e. the next sim object doesn't append to them
+	for (UINT defineId = (UINT)POS_DATA_SET; defineId <= (UINT)SYS_WRITE_SET; defineId += 0x1000)
+		this->simLink->ClearDataDefinition(defineId + slot);
+
+	this->simObjects.Remove(slot);
+}
 
+
+/**
+* Defines the position, system and sim data sets of a slot and requests them for every sim frame
+*/
+void Processor::RequestRecordData(UINT slot, DWORD objectId) {
 	// Assign flight postion and attitude vars to data definitions
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->POS_DATA_SET + this->simRequestId, "PLANE LATITUDE", "degree");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->POS_DATA_SET + this->simRequestId, "PLANE LONGITUDE", "degree");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->POS_DATA_SET + this->simRequestId, "PLANE ALTITUDE", "meter");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->POS_DATA_SET + this->simRequestId, "PLANE HEADING DEGREES TRUE", "degree");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->POS_DATA_SET + this->simRequestId, "PLANE PITCH DEGREES", "degree");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->POS_DATA_SET + this->simRequestId, "PLANE BANK DEGREES", "degree");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->POS_DATA_SET + this->simRequestId, "AIRSPEED INDICATED", "knot");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->POS_DATA_SET + slot, "PLANE LATITUDE", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->POS_DATA_SET + slot, "PLANE LONGITUDE", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->POS_DATA_SET + slot, "PLANE ALTITUDE", "meter");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->POS_DATA_SET + slot, "PLANE HEADING DEGREES TRUE", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->POS_DATA_SET + slot, "PLANE PITCH DEGREES", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->POS_DATA_SET + slot, "PLANE BANK DEGREES", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->POS_DATA_SET + slot, "AIRSPEED INDICATED", "knot");
 
 	// Assign simulation vars to data definitions
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:3", "percent");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:4", "percent");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:1", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:2", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:3", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:4", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "AILERON POSITION", "position");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "ELEVATOR POSITION", "position");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "RUDDER POSITION", "position");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "FLAPS HANDLE INDEX", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "GEAR HANDLE POSITION", "position");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "LIGHT NAV", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "LIGHT LOGO", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "LIGHT BEACON", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "LIGHT STROBE", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "LIGHT TAXI", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "LIGHT WING", "number");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SYS_DATA_SET + this->simRequestId, "LIGHT LANDING", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "GENERAL ENG THROTTLE LEVER POSITION:3", "percent");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "GENERAL ENG THROTTLE LEVER POSITION:4", "percent");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "ENG N1 RPM:1", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "ENG N1 RPM:2", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "ENG N1 RPM:3", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "ENG N1 RPM:4", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "AILERON POSITION", "position");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "ELEVATOR POSITION", "position");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "RUDDER POSITION", "position");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "FLAPS HANDLE INDEX", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "SPOILERS HANDLE POSITION", "position");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "GEAR HANDLE POSITION", "position");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "GEAR CENTER STEER ANGLE", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "FUEL TANK CENTER QUANTITY", "gallons");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "LIGHT NAV", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "LIGHT LOGO", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "LIGHT BEACON", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "LIGHT STROBE", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "LIGHT TAXI", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "LIGHT WING", "number");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SYS_DATA_SET + slot, "LIGHT LANDING", "number");
 
 	// Assign simulation vars to data definitions
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Z", "knot");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Y", "m/s");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "LEADING EDGE FLAPS RIGHT PERCENT", "percent");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "TRAILING EDGE FLAPS RIGHT PERCENT", "percent");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "ZULU TIME", "seconds");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "GROUND ALTITUDE", "meter");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "PLANE ALT ABOVE GROUND MINUS CG", "meter");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "STATIC CG TO GROUND", "meter");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "STATIC PITCH", "degree");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:1", "degree");
-	this->hr = SimConnect_AddToDataDefinition(this->hSimConnect, (UINT)this->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:0", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "VELOCITY BODY Z", "knot");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "VELOCITY BODY Y", "m/s");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "LEADING EDGE FLAPS RIGHT PERCENT", "percent");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "TRAILING EDGE FLAPS RIGHT PERCENT", "percent");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "ZULU TIME", "seconds");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "GROUND ALTITUDE", "meter");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "PLANE ALT ABOVE GROUND MINUS CG", "meter");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "STATIC CG TO GROUND", "meter");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "STATIC PITCH", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "CAMERA GAMEPLAY PITCH YAW:1", "degree");
+	this->hr = this->simLink->AddToDataDefinition((UINT)this->SIM_DATA_SET + slot, "CAMERA GAMEPLAY PITCH YAW:0", "degree");
 	
 	// Add object specific data requests to SimConnect Dispatch
-	this->hr = SimConnect_RequestDataOnSimObject(this->hSimConnect, (UINT)this->REQ_POS_DATA + this->simRequestId, (UINT)this->POS_DATA_SET + this->simRequestId, SIMCONNECT_OBJECT_ID_USER, SIMCONNECT_PERIOD_SIM_FRAME);
-	this->hr = SimConnect_RequestDataOnSimObject(this->hSimConnect, (UINT)this->REQ_SYS_DATA + this->simRequestId, (UINT)this->SYS_DATA_SET + this->simRequestId, SIMCONNECT_OBJECT_ID_USER, SIMCONNECT_PERIOD_SIM_FRAME);
-	this->hr = SimConnect_RequestDataOnSimObject(this->hSimConnect, (UINT)this->REQ_SIM_DATA + this->simRequestId, (UINT)this->SIM_DATA_SET + this->simRequestId, SIMCONNECT_OBJECT_ID_USER, SIMCONNECT_PERIOD_SIM_FRAME);
+	this->hr = this->simLink->RequestDataOnSimObject((UINT)this->REQ_POS_DATA + slot, (UINT)this->POS_DATA_SET + slot, objectId, SIMCONNECT_PERIOD_SIM_FRAME);
+	this->hr = this->simLink->RequestDataOnSimObject((UINT)this->REQ_SYS_DATA + slot, (UINT)this->SYS_DATA_SET + slot, objectId, SIMCONNECT_PERIOD_SIM_FRAME);
+	this->hr = this->simLink->RequestDataOnSimObject((UINT)this->REQ_SIM_DATA + slot, (UINT)this->SIM_DATA_SET + slot, objectId, SIMCONNECT_PERIOD_SIM_FRAME);
+}
+
+
+/**
+* Initializes the data record set and SimConnect request dispatch for flight recording
+*
+* @param	void
+* @return   void
+*/
+void Processor::InitRecordDataSet() {
+	fdrFile->SetSimApi(this->simApi);
+
+	// Define dedicated SimConnect request ID for this simObject
+	this->simRequestId = this->AddRequestSlot();
+	this->RequestRecordData(this->simRequestId, SIMCONNECT_OBJECT_ID_USER);
+
+	// Hand the .fdr file over to the recorder thread, i.e. the dispatch loop only publishes records
+	recorder = new FDRRecorder();
+	recorder->Start(fdrFile);
 
 	initRecordDataSet = true;
 }
@@ -573,5 +1176,5 @@ void Processor::InitRecordDataSet() {
 * @return	FDRFileStruct
 */
 FDRFileStruct Processor::GetSimDataRec(int pos) {
-	return this->fdrRecords[pos];
+	return this->simObjects.Get(pos).record;
 }
\ No newline at end of file
@@ -5,13 +5,16 @@
 #include <windows.h>
 #include <iostream>
 #include <string>
+#include <chrono>
+#include <mutex>
+#ifndef FDR_HEADLESS
 #include <cpprest/http_listener.h>
 #include <cpprest/uri.h>
 #include <cpprest/json.h>
-#include <chrono>
 #include <wx/wx.h>
 #include <wx/thread.h>
 #include <wx/msgqueue.h>
+#endif
 #include "PosDataSet.h"
 #include "SimDataSet.h"
 #include "SysDataSet.h"
@@ -20,11 +23,24 @@
 #include "CamShakeStruct.h"
 #include "ProcessorUtil.h"
 #include "SimConnect.h"
+#include "ISimLink.h"
+#include "SimRequestRouter.h"
+#include "SimObjectRegistry.h"
+#include "SimDataBatch.h"
+#include "TrafficLodScheduler.h"
+#include "TrackActivationScheduler.h"
+#include "AiObjectPool.h"
+#include "DryRunSimLink.h"
+#include "TrackKeyframes.h"
+#include "ReplayClock.h"
+#include "FrameProfiler.h"
 
 using namespace std;
+#ifndef FDR_HEADLESS
 using namespace web;
 using namespace web::http;
 using namespace web::http::experimental::listener;
+#endif
 
 // Forward declarations to avoid circular include.
 class GuiMain;  // #include "GuiMain.h" in .cpp file
@@ -34,6 +50,10 @@ class CoprocessorFTDIS; // #include "CoprocessorFTDIS.h" in cpp file
 class Track; // #include "Track.h" in .cpp file
 class FDRFile; // #include "FDRfile.h" in .cpp file
 class FTDISFile; // #include "FTDISfile.h" in .cpp file
+class FDRTrackColumns; // #include "FDRTrackColumns.h" in .cpp file
+class FDRRecorder; // #include "FDRRecorder.h" in .cpp file
+class SimMessagePump; // #include "SimMessagePump.h" in .cpp file
+class WorkStealingPool; // #include "WorkStealingPool.h" in .cpp file
 
 
 /** 
@@ -43,9 +63,16 @@ class FTDISFile; // #include "FTDISfile.h" in .cpp file
 * to handle the API's requests/responses and to orchestrate all of the request/responses to 
 * record and replay MS FS2020 flight data 
 *
+* Built headless (FDR_HEADLESS, i.e. without wxWidgets and the REST API), the processor doesn't run
+* a thread of its own: the host opens the link to the sim (see OpenSimLink) and pumps its messages
+*
 * @author muppetlabs@fswindowseat.com
 */
+#ifdef FDR_HEADLESS
+class Processor {
+#else
 class Processor : public wxThread {
+#endif
 public:
 	
 	Processor(GuiMain* handler, ProcessorCom* com, vector<Track*> tracks);
@@ -59,33 +86,57 @@ public:
 private:
 	GuiMain *guiMainHandler = nullptr;
 	vector<Track*> tracks;
+	// Co-processors by track, nullptr for dormant tracks and tracks of the other file type
 	vector<CoprocessorFDR*> cpusFDR;
 	vector<CoprocessorFTDIS*> cpusFTDIS;
+	struct FrameCpu {
+		CoprocessorFDR* fdr;
+		CoprocessorFTDIS* ftdis;
+		UINT track;
+	};
+	vector<FrameCpu> frameCpus;
+	vector<UINT> retireTracks, activateTracks;
+	AiObjectPool* aiPool = nullptr;
+	unsigned aiPoolSize = 4;
+	DryRunSimLink dryRunLink;
+	ISimLink* liveLink = nullptr;
+	double keyframeIntervalSec = 30.0;
+	int userSlot = -1;
+	uint64_t statusSeq = 0;
+	UINT activeTracks = 0, waitingTracks = 0;
+	double frameMs = 0, maxFrameMs = 0;
+	FrameProfiler profileSnapshot;
+	std::mutex profileMutex;
+	WorkStealingPool* computePool = nullptr;
+	unsigned computeThreads = 0;
+	bool trafficLodEnabled = true;
 	FDRFileStruct fdrRec = {};
-	FDRFileStruct fdrRecords[100] = {};
 	CamShake* headCam = nullptr;
 	CamShakeStruct headCamData; 
+#ifndef FDR_HEADLESS
 	http_listener* listener = nullptr;
+#endif
+	FDRTrackColumns* fdrColumns = nullptr;
+	FDRRecorder* recorder = nullptr;
+	SimMessagePump* messagePump = nullptr;
 	DWORD simObjectId = 0;
 	int simRequestId = 0, fileType = 0, zulu = 0, prevZulu = 0, tElapsed = 0, tFlt = 0, travelDist = 0;
 	float zuluStartFrame = 0.0f, camX = 0.0f, camY = 0.0f, camZ = 0.0f;
+	std::string simApi = "SimConnect";
 	bool initRecordDataSet = false;
 
 	struct returnDouble {
 		double returnVar;
 	};
 
-	PosDataSet* posSet;
-	SysDataSet* sysSet;
-	SimDataSet* simSet;
+	SimRequestRouter requestRouter = SimRequestRouter(REQ_POS_DATA);
 
 
 public:
 	FDRFile* fdrFile = nullptr;
 	FTDISFile* ftdisFile = nullptr;
 	ProcessorCom* cpuCom = nullptr;
-	vector<DWORD> aiID;
-	HANDLE  hSimConnect = NULL;
+	ISimLink* simLink = nullptr;
 	HRESULT hr;
 
 	enum EVENT_ID {
@@ -106,7 +157,7 @@ public:
 		KEY_LANDING_LIGHTS_SET = 0x0000F000,
 		KEY_TOGGLE_TAXI_LIGHTS = 0x00010000,
 		KEY_TOGGLE_WING_LIGHTS = 0x00011000,
-		KEY_GEAR_SET = 0x00001200,
+		KEY_GEAR_SET = 0x00012000,
 		KEY_TURBINE_IGNITION_SWITCH_TOGGLE = 0x00013000,
 		KEY_TOGGLE_STARTER1 = 0x00014000,
 		KEY_TOGGLE_STARTER2 = 0x00015000,
@@ -120,6 +171,7 @@ public:
 		KEY_TOGGLE_MASTER_BATTERY = 0x0001D000,
 		KEY_FLAPS_SET = 0x0001E000,
 		AI_RELEASEATC = 0x0001F000,
+		KEY_FREEZE_POOLED_AI = 0x00020000,
 		KEY_AXIS_PAN_PITCH = 0x00100000,
 		KEY_AXIS_PAN_HEADING = 0x00200000,
 		KEY_AXIS_PAN_TILT = 0x00300000,
@@ -156,9 +208,13 @@ public:
 		TAXI_LIGHT = 0x0001A000,
 		WING_LIGHT = 0x0001B000,
 		LNDG_LIGHT = 0x0001C000,
-		MASTER_BATTERY = 0x0001D000
+		MASTER_BATTERY = 0x0001D000,
+		SYS_WRITE_SET = 0x0001E000
 	};
 
+	// Request, data definition and client event IDs of a sim object are the base ID + slot, the bases are 0x1000 apart
+	static const UINT maxRequestSlots = 0x1000;
+
 	enum DATA_REQUEST_ID {
 		REQ_POS_DATA = 0x00001000,
 		REQ_SYS_DATA = 0x00002000,
@@ -166,13 +222,24 @@ public:
 		REQ_AI_AC = 0x00004000
 	};
 
-	UINT reqIndex = 0;
+	SimObjectRegistry simObjects;
+
+	SimDataBatch::Stats writeStats;
+
+	TrafficLodScheduler trafficLod;
+
+	TrackActivationScheduler trackActivation;
+
+	TrackKeyframes::Stats keyframeStats;
 
-	double altGround[100] = { 0.0 }, absAltGround[100] = { 0.0 }, staticCGAlt[100] = { 0.0 }, staticCGPitch[100] = { 0.0 }, flapsLeadingPrc[100] = { 0.0 }, flapsTrailingPrc[100] = { 0.0 };;
+	ReplayClock replayClock;
+
+	FrameProfiler frameProfiler;
 
 	double simFrameTimeSec = 0, simRate = 0, engN1 = 0; 
 
 private:
+#ifndef FDR_HEADLESS
 	/**
 	* Thread entry and exit
 	*
@@ -180,6 +247,7 @@ private:
 	*/
 	virtual ExitCode Entry();
 	virtual ExitCode Exit();
+#endif
 
 	/**
 	* Handles SimConnect server responses (Static method)
@@ -200,6 +268,17 @@ private:
 	*/
 	void DispatchProc(SIMCONNECT_RECV* pData, DWORD cbData);
 
+	/**
+	* Handles the data sets of a sim object, routed by request ID (see SimRequestRouter)
+	*
+	* @param	slot		Slot of the sim object, i.e. its request ID offset
+	* @param	dataSet		Data set of the response
+	* @return   void
+	*/
+	void OnPosData(UINT slot, PosDataSet* posSet);
+	void OnSysData(UINT slot, SysDataSet* sysSet);
+	void OnSimData(UINT slot, SimDataSet* simSet);
+
 	/**
 	* Handles the processing of SimConnect SIMCONNECT_RECV_ID_SIMOBJECT_DATA return messages
 	* and converts them to a basic type 
@@ -210,15 +289,181 @@ private:
 	double SimCoToDouble(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData);
 	double SimCoToInt(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData);
 
+	/**
+	* Returns the pool of AI objects, created with the first request
+	*/
+	AiObjectPool* GetAiPool();
+
+	/**
+	* Requests the AI objects of the replay ahead of time, per sim model config up to the number of
+	* tracks active at the same time (max. the pool size)
+	*
+	* @param	void
+	* @return	void
+	*/
+	void PrewarmAiObjects();
+
+	/**
+	* Returns the initial position of the AI object of a track, i.e. the first record of the track
+	*/
+	static SIMCONNECT_DATA_INITPOSITION GetAiInitPosition(Track* track);
+
 public:
 	/**
-	* Initializes the connection to the sim (using SimConnect API)
+	* Sets the link to the sim, e.g. the local stand-in (see LocalSimLink). Has to be called before the thread is run,
+	* the processor takes ownership. Defaults to the SimConnect API
+	* 
+	* @param	link	Link to the sim
+	* @return   void
+	*/
+	void SetSimLink(ISimLink* link);
+
+	/**
+	* Sets the number of threads computing the frames of the replayed tracks, incl. the processor's own thread.
+	* Has to be called before the replay starts. Submission to the sim remains on the processor's thread
+	* 
+	* @param	threads		Number of threads, 0 for the number of cores (default), 1 to compute on the processor's thread only
+	* @return   void
+	*/
+	void SetComputeThreads(unsigned threads);
+
+	/**
+	* Enables or disables the level of detail of the AI traffic (see TrafficLodScheduler). Disabled, all AI tracks
+	* are updated every frame incl. their systems
+	* 
+	* @param	enabled		Level of detail enabled (default)
+	* @return   void
+	*/
+	void SetTrafficLod(bool enabled);
+
+	/**
+	* Sets the time the AI object of a track is spawned before the first record of the track (see TrackActivationScheduler)
+	* 
+	* @param	leadTimeSec		Lead time in s (default: 10 s)
+	* @return   void
+	*/
+	void SetActivationLeadTime(double leadTimeSec);
+
+	/**
+	* Sets the number of AI objects per sim model config created ahead of the replay and kept idle for reuse
+	* after the end of a track (see AiObjectPool). Has to be called before the replay starts
+	* 
+	* @param	size	Pool size, 0 to create and remove the AI object of every track on demand (default: 4)
+	* @return   void
+	*/
+	void SetAiPoolSize(unsigned size);
+
+	/**
+	* Returns the counters of the AI object pool
+	* 
+	* @param	void
+	* @return   AiObjectPool::Stats		Counters
+	*/
+	AiObjectPool::Stats GetAiPoolStats();
+
+	/**
+	* Requests an AI object for a track from the pool (see AiObjectPool). The object is handed to the
+	* co-processor of the track (SetSimObjectId) once available
+	* 
+	* @param	track		Track
+	* @param	initPos		Initial position, if a new object is created
+	* @return   HRESULT
+	*/
+	HRESULT RequestAiObject(Track* track, const SIMCONNECT_DATA_INITPOSITION& initPos);
+
+	/**
+	* Releases the AI object of a track to the pool, i.e. stops the data requests of its slot. The object
+	* is reused by another track or removed from the sim
+	* 
+	* @param	objectId	SimConnect object ID
+	* @param	slot		Request slot of the sim object
+	* @return   HRESULT		E_FAIL, if not an AI object of the pool
+	*/
+	HRESULT ReleaseAiObject(DWORD objectId, UINT slot);
+
+	/**
+	* Sets the time between two keyframes of a track (see TrackKeyframes), i.e. the max. time fast-forwarded
+	* after a seek. Applies to the co-processors created afterwards
+	* 
+	* @param	intervalSec		Keyframe interval in s (default: 30 s)
+	* @return   void
+	*/
+	void SetKeyframeInterval(double intervalSec);
+
+	/**
+	* Returns the time between two keyframes of a track
+	*/
+	double GetKeyframeInterval();
+
+	/**
+	* Starts a dry run, i.e. the calls of the sim models are discarded rather than sent to the sim until
+	* EndDryRun. Co-processors build their keyframes and fast-forward after a seek with a dry run. Has to
+	* be called from the submission phase, i.e. while the co-processors don't compute in parallel
+	* 
+	* @param	void
+	* @return   void
+	*/
+	void BeginDryRun();
+
+	/**
+	* Ends the dry run, i.e. the calls of the sim models are sent to the sim again
+	* 
+	* @param	void
+	* @return   void
+	*/
+	void EndDryRun();
+
+	/**
+	* Initializes the connection to the sim (using SimConnect API, unless another link has been set) and
+	* runs the message loop until the thread is deleted
 	* 
 	* @param	void
 	* @return   bool
 	*/
 	bool InitSimConnect();
 
+	/**
+	* Opens the link to the sim, subscribes to the frame event and maps the global client events
+	* 
+	* @param	void
+	* @return   bool
+	*/
+	bool OpenSimLink();
+
+	/**
+	* Waits for messages of the sim and dispatches them (see SimMessagePump)
+	* 
+	* @param	void
+	* @return   bool	True, if messages have been dispatched
+	*/
+	bool Pump();
+
+	/**
+	* Returns a snapshot of the frame profiler, taken about once per second, i.e. safe to call from
+	* another thread, e.g. the REST API
+	* 
+	* @param	void
+	* @return   FrameProfiler	Snapshot
+	*/
+	FrameProfiler GetProfileSnapshot();
+
+	/**
+	* Publishes the status of the processor to the GUI, i.e. cursor, rate, track states and
+	* timings (see ProcessorCom::PublishStatus)
+	* 
+	* @param	void
+	* @return   void
+	*/
+	void PublishStatus();
+
+	/**
+	* Writes outstanding records and signals the Com handler that the processor stops
+	* 
+	* @param	void
+	* @return   void
+	*/
+	void Shutdown();
+
 	/**
 	* Initializes the REST API for the OBS.
 	* 
@@ -227,6 +472,46 @@ public:
 	*/
 	void InitRestApi();
 
+#ifndef FDR_HEADLESS
+	/**
+	* Returns the metrics of the frame profiler as JSON, i.e. the histograms of the stages (in us), the
+	* SimConnect calls per frame, the cost of a track by sim model and the most expensive tracks
+	* 
+	* @param	void
+	* @return   json::value		Metrics
+	*/
+	json::value GetMetricsJson();
+#endif
+
+	/**
+	* Allocates the request slot of a sim object, i.e. adds its state to the registry (simObjects), and routes
+	* the responses of its position, system and sim data requests (REQ_POS_DATA, REQ_SYS_DATA, REQ_SIM_DATA + slot)
+	* to the slot. Slots of removed sim objects are reused, up to maxRequestSlots sim objects are alive at a time.
+	* Throws std::length_error, if all slots are in use, i.e. the IDs of the slots would overlap
+	*
+	* @param	void
+	* @return   UINT	Slot, i.e. offset of the request, data definition and client event IDs of the sim object
+	*/
+	UINT AddRequestSlot();
+
+	/**
+	* Releases the request slot of a removed sim object, i.e. stops its data requests and clears its data
+	* definitions for the next sim object of the slot
+	*
+	* @param	slot	Slot of the sim object (see AddRequestSlot)
+	* @return   void
+	*/
+	void RemoveRequestSlot(UINT slot);
+
+	/**
+	* Defines the position, system and sim data sets of a slot and requests them for every sim frame
+	*
+	* @param	slot		Slot of the sim object (see AddRequestSlot)
+	* @param	objectId	Sim object
+	* @return   void
+	*/
+	void RequestRecordData(UINT slot, DWORD objectId);
+
 	/**
 	* Initializes the data record set and SimConnect request dispatch for flight recording
 	*
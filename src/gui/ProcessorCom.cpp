@@ -4,11 +4,13 @@
 * Constructor / Destructor
 */
 ProcessorCom::ProcessorCom() {
-
+	this->SetOptions({ 320,false,false,false,false,0,0,0,0,"",0,0,0,0 });
 }
 
 ProcessorCom::~ProcessorCom() {
-
+	for (const OptionsStruct* retired : retiredOptions)
+		delete retired;
+	delete options.load();
 }
 
 
@@ -17,13 +19,11 @@ ProcessorCom::~ProcessorCom() {
 */
 
 void ProcessorCom::SetProcessorState(ProcessorState state) {
-	std::lock_guard<std::mutex> lockGuard(m);
-	this->processorState = state;
+	this->processorState.store(state, std::memory_order_release);
 }
 
 ProcessorCom::ProcessorState ProcessorCom::GetProcessorState() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->processorState;
+	return this->processorState.load(std::memory_order_acquire);
 }
 
 
@@ -31,13 +31,11 @@ ProcessorCom::ProcessorState ProcessorCom::GetProcessorState() {
 * Get/Set: cursorPos
 */
 void ProcessorCom::SetCursorPos(int num) {
-	std::lock_guard<std::mutex> lockGuard(m);
-	this->cursorPos = num;
+	this->cursorPos.store(num, std::memory_order_relaxed);
 }
 
 int ProcessorCom::GetCursorPos() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->cursorPos;
+	return this->cursorPos.load(std::memory_order_relaxed);
 }
 
 
@@ -45,13 +43,101 @@ int ProcessorCom::GetCursorPos() {
 * Get/Set: replayRate
 */
 void ProcessorCom::SetReplayRate(float num) {
-	std::lock_guard<std::mutex> lockGuard(m);
-	replayRate = num;
+	replayRate.store(num, std::memory_order_relaxed);
 }
 
 float ProcessorCom::GetReplayRate() {
+	return replayRate.load(std::memory_order_relaxed);
+}
+
+
+/**
+* Get/Set: seek request
+*/
+void ProcessorCom::RequestSeek(double seconds) {
+	seekTimeSec.store(seconds > 0 ? seconds : 0, std::memory_order_relaxed);
+}
+
+bool ProcessorCom::GetSeekRequest(double& seconds) {
+	// Time and flag in one atomic, i.e. a request is taken exactly once. The latest request wins
+	if (seekTimeSec.load(std::memory_order_relaxed) < 0)
+		return false;
+
+	seconds = seekTimeSec.exchange(-1.0, std::memory_order_relaxed);
+	return seconds >= 0;
+}
+
+
+/**
+* Get/Set: recorder stats
+*/
+void ProcessorCom::SetRecorderStats(FDRRecorderStatsStruct stats) {
 	std::lock_guard<std::mutex> lockGuard(m);
-	return replayRate;
+	recorderStats = stats;
+}
+
+FDRRecorderStatsStruct ProcessorCom::GetRecorderStats() {
+	std::lock_guard<std::mutex> lockGuard(m);
+	return recorderStats;
+}
+
+
+/**
+* Get/Set: message pump policy
+*/
+void ProcessorCom::SetPumpPolicy(SimMessagePump::Mode mode, int intervalMs) {
+	pumpMode.store(mode, std::memory_order_relaxed);
+	pumpInterval.store(intervalMs, std::memory_order_relaxed);
+}
+
+SimMessagePump::Mode ProcessorCom::GetPumpMode() {
+	return pumpMode.load(std::memory_order_relaxed);
+}
+
+int ProcessorCom::GetPumpInterval() {
+	return pumpInterval.load(std::memory_order_relaxed);
+}
+
+
+/**
+* Publish/Pull: status of the processor (lock-free, see StatusSlot)
+*/
+void ProcessorCom::PublishStatus(const ProcessorStatusStruct& status) {
+	statusSlot.Publish(status);
+}
+
+bool ProcessorCom::PullStatus(ProcessorStatusStruct& status) {
+	return statusSlot.TryPull(status);
+}
+
+void ProcessorCom::ClearStatus() {
+	ProcessorStatusStruct status;
+	statusSlot.TryPull(status);
+}
+
+
+/**
+* Get/Set: GUI refresh interval
+*/
+void ProcessorCom::SetStatusRefresh(int intervalMs) {
+	if (intervalMs > 0)
+		statusRefresh.store(intervalMs, std::memory_order_relaxed);
+}
+
+int ProcessorCom::GetStatusRefresh() {
+	return statusRefresh.load(std::memory_order_relaxed);
+}
+
+
+/**
+* Get/Set: frame profiler
+*/
+void ProcessorCom::SetProfiling(bool enabled) {
+	profiling.store(enabled, std::memory_order_relaxed);
+}
+
+bool ProcessorCom::GetProfiling() {
+	return profiling.load(std::memory_order_relaxed);
 }
 
 
@@ -59,108 +145,89 @@ float ProcessorCom::GetReplayRate() {
 * Get/Set: simApi
 */
 void ProcessorCom::SetSimConnect(bool state) {
-	std::lock_guard<std::mutex> lockGuard(m);
-	simConnect = state;
+	simConnect.store(state, std::memory_order_release);
 }
 
 bool ProcessorCom::GetSimConnect() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return simConnect;
+	return simConnect.load(std::memory_order_acquire);
 }
 
 
 /**
-* Get/Set: Options
+* Get/Set: Options (RCU), i.e. a new snapshot is published, readers keep the snapshot they hold
 */
 void ProcessorCom::SetOptions(OptionsStruct newOptions) {
+	const OptionsStruct* snapshot = new OptionsStruct(std::move(newOptions));
 	std::lock_guard<std::mutex> lockGuard(m);
-	this->options.simApi = newOptions.simApi;
-	this->options.halfRate = newOptions.halfRate;
-	this->options.customSound = newOptions.customSound;
-	this->options.beepStartEnd = newOptions.beepStartEnd;
-	this->options.camShake = newOptions.camShake;
-	this->options.depHH = newOptions.depHH;
-	this->options.depMM = newOptions.depMM;
-	this->options.depGMTHH = newOptions.depGMTHH;
-	this->options.depGMTMM = newOptions.depGMTMM;
-	this->options.destName = newOptions.destName;
-	this->options.fltHH = newOptions.fltHH;
-	this->options.fltMM = newOptions.fltMM;
-	this->options.destGMTHH = newOptions.destGMTHH;
-	this->options.destGMTMM = newOptions.destGMTMM;
-}
-
-OptionsStruct ProcessorCom::GetOptions() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options;
+	const OptionsStruct* replaced = options.exchange(snapshot);
+	if (replaced != nullptr)
+		retiredOptions.push_back(replaced);
+
+	// A reader holding a retired snapshot counted itself before the exchange, i.e. no reader -> none is held
+	if (optionsReaders.load() == 0) {
+		for (const OptionsStruct* retired : retiredOptions)
+			delete retired;
+		retiredOptions.clear();
+	}
+}
+
+ProcessorCom::OptionsRef ProcessorCom::GetOptions() {
+	optionsReaders.fetch_add(1);
+	return OptionsRef(options.load(), &optionsReaders);
 }
 
 int ProcessorCom::GetSimApi() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.simApi;
+	return this->GetOptions()->simApi;
 }
 
 bool ProcessorCom::GetHalfRate() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.halfRate;
+	return this->GetOptions()->halfRate;
 }
 
 bool ProcessorCom::GetCustomSound() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.customSound;
+	return this->GetOptions()->customSound;
 }
 
 bool ProcessorCom::GetBeepStartEnd() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.beepStartEnd;
+	return this->GetOptions()->beepStartEnd;
 }
 
 bool ProcessorCom::GetCamShake() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.camShake;
+	return this->GetOptions()->camShake;
 }
 
 int ProcessorCom::GetDepHH() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.depHH;
+	return this->GetOptions()->depHH;
 }
 
 int ProcessorCom::GetDepMM() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.depMM;
+	return this->GetOptions()->depMM;
 }
 
 int ProcessorCom::GetDepGMTHH() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.depGMTHH;
+	return this->GetOptions()->depGMTHH;
 }
 
 int ProcessorCom::GetDepGMTMM() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.depGMTMM;
+	return this->GetOptions()->depGMTMM;
 }
 
 std::string ProcessorCom::GetDestName() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.destName;
+	return this->GetOptions()->destName;
 }
 
 int ProcessorCom::GetFltHH() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.fltHH;
+	return this->GetOptions()->fltHH;
 }
 
 int ProcessorCom::GetFltMM() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.fltMM;
+	return this->GetOptions()->fltMM;
 }
 
 int ProcessorCom::GetDestGMTHH() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.destGMTHH;
+	return this->GetOptions()->destGMTHH;
 }
 
 int ProcessorCom::GetDestGMTMM() {
-	std::lock_guard<std::mutex> lockGuard(m);
-	return this->options.destGMTMM;
+	return this->GetOptions()->destGMTMM;
 }
@@ -1,15 +1,26 @@
 #ifndef ProcessorCom_H
 #define ProcessorCom_H
 
+#include <atomic>
 #include <mutex>
 #include <string>
+#include <vector>
 #include "OptionsStruct.h"
+#include "FDRRecorderStatsStruct.h"
+#include "ProcessorStatusStruct.h"
+#include "StatusSlot.h"
+#include "SimMessagePump.h"
 
 /**
 * Communication Interface between GUI and Processor
 *
 * Allows to exchange information between main thread (GUI) and detached thread (Processor).
-* Includes safe guards to share properties between the two threads safely 
+* Includes safe guards to share properties between the two threads safely: the controls (state,
+* cursor, rate, seek request, ...) are atomics, the options are an immutable snapshot, replaced as
+* a whole (RCU), i.e. the getters called by the processor per track and frame, the REST API and the
+* GUI don't wait for the writer of the options and don't allocate. A reader announces itself in a
+* reader count while it holds a snapshot (see OptionsRef), replaced snapshots are freed by the writer
+* once no reader is active
 * 
 * @author muppetlabs@fswindowseat.com
 */
@@ -25,13 +36,48 @@ public:
 		record
 	};
 
+	/**
+	* Read access to an options snapshot, i.e. the snapshot isn't freed as long as the reference exists.
+	* Wait-free, i.e. an increment and a decrement of the reader count
+	*/
+	class OptionsRef {
+
+	public:
+		OptionsRef(const OptionsStruct* options, std::atomic<int>* readers) : options(options), readers(readers) {}
+		OptionsRef(OptionsRef&& other) noexcept : options(other.options), readers(other.readers) { other.readers = nullptr; }
+		OptionsRef(const OptionsRef&) = delete;
+		OptionsRef& operator=(const OptionsRef&) = delete;
+		~OptionsRef() { if (readers != nullptr) readers->fetch_sub(1, std::memory_order_release); }
+
+		const OptionsStruct* operator->() const { return options; }
+		const OptionsStruct& operator*() const { return *options; }
+
+	private:
+		const OptionsStruct* options;
+		std::atomic<int>* readers;
+	};
+
 private:
-	ProcessorState processorState = stop;
-	int cursorPos = 0;
-	bool simConnect = false;
-	float replayRate = 0.0F;
+	std::atomic<ProcessorState> processorState{ stop };
+	std::atomic<int> cursorPos{ 0 };
+	std::atomic<bool> simConnect{ false };
+	std::atomic<float> replayRate{ 0.0F };
+	std::atomic<double> seekTimeSec{ -1.0 };	// Negative: no seek pending
+	std::atomic<SimMessagePump::Mode> pumpMode{ SimMessagePump::eventDriven };
+	std::atomic<int> pumpInterval{ 50 };
+	std::atomic<int> statusRefresh{ 100 };
+	std::atomic<bool> profiling{ false };
+	StatusSlot<ProcessorStatusStruct> statusSlot;
+
+	// Options: current snapshot and the number of readers holding a snapshot. Replaced snapshots are
+	// retired, and freed by the next writer (or the destructor) that finds no reader
+	std::atomic<const OptionsStruct*> options{ nullptr };
+	std::atomic<int> optionsReaders{ 0 };
+	std::vector<const OptionsStruct*> retiredOptions;
+
+	// Writers of the options and recorder stats (set once per recording)
 	std::mutex m;
-	OptionsStruct options = {320,false,false,false,false,0,0,0,0,"",0,0,0,0};
+	FDRRecorderStatsStruct recorderStats = {};
 
 public:
 	
@@ -47,11 +93,72 @@ public:
 	void SetReplayRate(float num);
 	float GetReplayRate();
 	
+	/**
+	* Requests a seek of the replay to the given time (in s). Handled with the next sim frame
+	*/
+	void RequestSeek(double seconds);
+
+	/**
+	* Returns and clears a pending seek request
+	*
+	* @param	seconds		Receives the requested replay time in s
+	* @return	bool		False, if no seek is pending
+	*/
+	bool GetSeekRequest(double& seconds);
+	
+	void SetRecorderStats(FDRRecorderStatsStruct stats);
+	FDRRecorderStatsStruct GetRecorderStats();
+
+	/**
+	* Latency/CPU policy of the processor loop, applied when the processor connects to the sim
+	*/
+	void SetPumpPolicy(SimMessagePump::Mode mode, int intervalMs);
+	SimMessagePump::Mode GetPumpMode();
+	int GetPumpInterval();
+
+	/**
+	* Publishes the status of the processor (processor thread only). Never blocks, a snapshot not
+	* pulled yet is replaced, i.e. the GUI isn't flooded with updates
+	*/
+	void PublishStatus(const ProcessorStatusStruct& status);
+
+	/**
+	* Takes the latest status of the processor (GUI thread only)
+	*
+	* @param	status		Receives the status
+	* @return	bool		False, if no status has been published since the last pull
+	*/
+	bool PullStatus(ProcessorStatusStruct& status);
+
+	/**
+	* Drops a status not pulled yet, e.g. of a processor stopped before a new one starts (GUI thread only)
+	*/
+	void ClearStatus();
+
+	/**
+	* Refresh interval of the GUI in ms, i.e. max. rate of status updates shown (default: 100 ms, set in the preferences)
+	*/
+	void SetStatusRefresh(int intervalMs);
+	int GetStatusRefresh();
+
+	/**
+	* Enables the frame profiler of the processor, applied with the next frame (see FrameProfiler)
+	*/
+	void SetProfiling(bool enabled);
+	bool GetProfiling();
+
 	void SetSimConnect(bool state);
 	bool GetSimConnect();
 
+	/**
+	* Publishes a new snapshot of the options
+	*/
 	void SetOptions(OptionsStruct options);
-	OptionsStruct GetOptions();
+
+	/**
+	* Returns the current snapshot of the options (immutable, valid as long as the caller holds the reference)
+	*/
+	OptionsRef GetOptions();
 	
 	int GetSimApi();
 
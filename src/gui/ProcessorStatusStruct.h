@@ -0,0 +1,25 @@
+#ifndef PROCESSORSTATUSSTRUCT_H
+#define PROCESSORSTATUSSTRUCT_H
+
+#include <cstdint>
+
+/**
+* Snapshot of the processor for the GUI, published by the processor thread (see StatusSlot)
+*/
+struct ProcessorStatusStruct
+{
+	uint64_t seq;			// Snapshot number
+	int processorState;		// ProcessorCom::ProcessorState
+	bool simConnect;		// Connected to the sim
+	int cursorPos;			// Record of the user track, or size of the recording
+	float replayRate;
+	double replayTimeSec;	// Time line of the replay (see ReplayClock)
+	uint32_t tracks;		// Tracks loaded
+	uint32_t activeTracks;	// Tracks with an AI object / the user aircraft, i.e. replayed
+	uint32_t waitingTracks;	// Tracks waiting for their AI object
+	double simFrameMs;		// Duration of the last sim frame
+	double frameMs;			// Processing time of the last frame
+	double maxFrameMs;		// Max. processing time of a frame
+};
+
+#endif
@@ -6,7 +6,7 @@ namespace ProcessorUtil
 	/**
 	* Converts values in Radians to Degrees
 	*/
-	double ProcessorUtil::toDegrees(double radians) {
+	double toDegrees(double radians) {
 		return radians * (180.0F / M_PI);
 	}
 
@@ -14,7 +14,7 @@ namespace ProcessorUtil
 	/**
 	* Converts values in Degress to Radians
 	*/
-	double ProcessorUtil::toRadians(double degrees) {
+	double toRadians(double degrees) {
 		return degrees * (M_PI / 180.0F);
 	}
 
@@ -22,7 +22,7 @@ namespace ProcessorUtil
 	/**
 	* Converts metres to feet
 	*/
-	double ProcessorUtil::toFeet(double metres) {
+	double toFeet(double metres) {
 		return metres * 3.28084F;
 	}
 
@@ -30,7 +30,7 @@ namespace ProcessorUtil
 	/**
 	* Converts feet to metres
 	*/
-	double ProcessorUtil::toMetres(double feet) {
+	double toMetres(double feet) {
 		return feet / 3.28084F;
 	}
 
@@ -38,7 +38,7 @@ namespace ProcessorUtil
 	/**
 	* Returns a file's number of lines
 	*/
-	int ProcessorUtil::fileLength(fs::path filePathName) {
+	int fileLength(fs::path filePathName) {
 		int rowCount = 0;
 		string line;
 
@@ -54,7 +54,7 @@ namespace ProcessorUtil
 	/**
 	* Returns the path to the executable
 	*/
-	wstring ProcessorUtil::getExePath() {
+	wstring getExePath() {
 		TCHAR buffer[MAX_PATH] = {0};
 
 		GetModuleFileName(NULL, buffer, MAX_PATH);
@@ -68,7 +68,7 @@ namespace ProcessorUtil
 	/**
 	* Returns a random number within a given range
 	*/
-	double ProcessorUtil::randRange(double lo, double hi) {
+	double randRange(double lo, double hi) {
 		return lo + static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / (hi - lo)));
 	}
 
@@ -76,7 +76,7 @@ namespace ProcessorUtil
 	/**
 	* Returns a sin value, based upon the corresponding wave length and amplitude
 	*/
-	float ProcessorUtil::getSinVal(float timeStmp, float waveLength, float amplitude) {
+	float getSinVal(float timeStmp, float waveLength, float amplitude) {
 		return amplitude * (float)sin(timeStmp / waveLength * M_PI);
 	}
 
@@ -84,7 +84,7 @@ namespace ProcessorUtil
 	/**
 	* Converts knots to metres per second
 	*/
-	float ProcessorUtil::ktsToMs(float kts) {
+	float ktsToMs(float kts) {
 		return kts * 0.51444444444F;
 	}
 
@@ -92,7 +92,7 @@ namespace ProcessorUtil
 	/**
 	* Returns the current date and time. Format dd/mm/yyyy hh:mm:ss
 	*/
-	std::string ProcessorUtil::getDateTime() {
+	std::string getDateTime() {
 		time_t     now = time(0);
 		struct tm  tstruct;
 		char       buf[80];
@@ -0,0 +1,105 @@
+#ifndef RecordRingBuffer_H
+#define RecordRingBuffer_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+/**
+* Lock-free single-producer/single-consumer ring buffer of fixed size records
+*
+* The producer (e.g. SimConnect dispatch) never blocks: if the buffer is full, the record is
+* rejected and counted as overflow. The capacity is rounded up to a power of two. Exactly one
+* thread may push and exactly one (other) thread may pop
+*
+* @author muppetlabs@fswindowseat.com
+*/
+template<typename T> class RecordRingBuffer {
+
+public:
+	RecordRingBuffer(size_t capacity = 4096) {
+		size_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+		buffer.resize(size);
+		mask = size - 1;
+	}
+
+private:
+	std::vector<T> buffer;
+	size_t mask = 0;
+
+	// Producer and consumer positions on separate cache lines, i.e. no false sharing
+	alignas(64) std::atomic<size_t> head{ 0 };
+	alignas(64) std::atomic<size_t> tail{ 0 };
+	alignas(64) std::atomic<uint64_t> pushCount{ 0 };
+	std::atomic<uint64_t> overflowCount{ 0 };
+	std::atomic<size_t> highWaterMark{ 0 };
+
+public:
+	/**
+	* Appends a record (producer only)
+	*
+	* @param	item		Record
+	* @return	bool		False, if the buffer is full (record is dropped and counted as overflow)
+	*/
+	bool TryPush(const T& item) {
+		size_t pos = head.load(std::memory_order_relaxed);
+		size_t fill = pos - tail.load(std::memory_order_acquire);
+		if (fill > mask) {
+			overflowCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		buffer[pos & mask] = item;
+		head.store(pos + 1, std::memory_order_release);
+
+		pushCount.store(pushCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		if (fill + 1 > highWaterMark.load(std::memory_order_relaxed))
+			highWaterMark.store(fill + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	* Removes the oldest record (consumer only)
+	*
+	* @param	item		Receives the record
+	* @return	bool		False, if the buffer is empty
+	*/
+	bool TryPop(T& item) {
+		size_t pos = tail.load(std::memory_order_relaxed);
+		if (pos == head.load(std::memory_order_acquire))
+			return false;
+
+		item = buffer[pos & mask];
+		tail.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	* Returns the number of records in the buffer (snapshot)
+	*/
+	size_t GetSize() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+	/**
+	* Returns the max. number of records in the buffer
+	*/
+	size_t GetCapacity() const { return mask + 1; }
+
+	/**
+	* Returns the number of records accepted by the buffer
+	*/
+	uint64_t GetPushCount() const { return pushCount.load(std::memory_order_relaxed); }
+
+	/**
+	* Returns the number of records rejected, because the buffer was full
+	*/
+	uint64_t GetOverflowCount() const { return overflowCount.load(std::memory_order_relaxed); }
+
+	/**
+	* Returns the max. number of records in the buffer at any time
+	*/
+	size_t GetHighWaterMark() const { return highWaterMark.load(std::memory_order_relaxed); }
+};
+#endif
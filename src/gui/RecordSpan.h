@@ -0,0 +1,33 @@
+#ifndef RecordSpan_H
+#define RecordSpan_H
+
+#include <cstddef>
+
+/**
+* Read-only view of a contiguous sequence of flight data records
+*
+* Non-owning, i.e. the view is only valid as long as the underlying memory
+* (vector or memory mapped file) remains unchanged
+*
+* @author muppetlabs@fswindowseat.com
+*/
+template<typename T> class RecordSpan {
+
+private:
+	const T* ptr = nullptr;
+	size_t count = 0;
+
+public:
+	RecordSpan() {}
+	RecordSpan(const T* ptr, size_t count) : ptr(ptr), count(count) {}
+
+	const T& operator[](size_t pos) const { return ptr[pos]; }
+	const T& front() const { return ptr[0]; }
+	const T& back() const { return ptr[count - 1]; }
+	const T* begin() const { return ptr; }
+	const T* end() const { return ptr + count; }
+	const T* data() const { return ptr; }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+};
+#endif
@@ -0,0 +1,182 @@
+#include "ReplayClock.h"
+#include <chrono>
+#include <cmath>
+
+/**
+* Constructor / Destructor
+*/
+ReplayClock::ReplayClock() {
+
+}
+
+ReplayClock::~ReplayClock() {
+
+}
+
+
+/**
+* Sets the source of the frame duration
+*/
+void ReplayClock::SetMode(Mode mode) {
+	this->mode = mode;
+	this->sourceStarted = false;
+}
+
+
+/**
+* Returns the source of the frame duration
+*/
+ReplayClock::Mode ReplayClock::GetMode() const {
+	return mode;
+}
+
+
+/**
+* Sets the time source of the wall mode
+*/
+void ReplayClock::SetTimeSource(std::function<double()> timeSource) {
+	this->timeSource = timeSource;
+	this->sourceStarted = false;
+}
+
+
+/**
+* Sets the duration of a frame of the fixed step mode
+*/
+void ReplayClock::SetFixedStep(double stepSec) {
+	if (stepSec > 0)
+		this->fixedStepSec = stepSec;
+}
+
+
+/**
+* Returns the duration of a frame of the fixed step mode
+*/
+double ReplayClock::GetFixedStep() const {
+	return fixedStepSec;
+}
+
+
+/**
+* Advances the clock by one frame
+*/
+void ReplayClock::Tick(double simFrameTimeSec, double simRate, double replayRate) {
+	switch (mode) {
+	case Mode::sim:
+		frameTimeSec = simFrameTimeSec;
+		break;
+	case Mode::wall: {
+		double sourceSec = timeSource ? timeSource() : std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		frameTimeSec = sourceStarted && sourceSec > prevSourceSec ? sourceSec - prevSourceSec : 0;
+		prevSourceSec = sourceSec;
+		sourceStarted = true;
+		break;
+	}
+	case Mode::fixedStep:
+		frameTimeSec = fixedStepSec;
+		break;
+	}
+
+	double stepSec = frameTimeSec * replayRate;
+	if (mode != Mode::fixedStep)
+		stepSec += this->PhaseLock(frameTimeSec, simRate, replayRate);
+
+	timeSec += stepSec;
+	stats.ticks++;
+}
+
+
+/**
+* Corrects the step of the frame against the zulu time of the sim
+*/
+double ReplayClock::PhaseLock(double frameTimeSec, double simRate, double replayRate) {
+	if (!zuluValid || simRate <= 0)
+		return 0;
+
+	// Anchor, i.e. zulu time and estimate are compared from here on
+	if (!zuluAnchored) {
+		zuluStartSec = zuluSec;
+		estimateSec = 0;
+		zuluAnchored = true;
+		return 0;
+	}
+
+	estimateSec += frameTimeSec * simRate;
+	double driftSec = (zuluSec - zuluStartSec) - estimateSec;
+
+	// Sim paused, zulu time changed or past midnight
+	if (std::abs(driftSec) > resyncDriftSec) {
+		zuluStartSec = zuluSec;
+		estimateSec = 0;
+		stats.resyncs++;
+		return 0;
+	}
+
+	stats.driftSec = driftSec;
+	if (std::abs(driftSec) > stats.maxDriftSec)
+		stats.maxDriftSec = std::abs(driftSec);
+
+	if (std::abs(driftSec) <= deadBandSec)
+		return 0;
+
+	// Correct a fraction of the drift, at most the slew of the frame
+	double correctionSec = driftSec * gain;
+	double maxCorrectionSec = frameTimeSec * simRate * maxSlew;
+	if (correctionSec > maxCorrectionSec)
+		correctionSec = maxCorrectionSec;
+	else if (correctionSec < -maxCorrectionSec)
+		correctionSec = -maxCorrectionSec;
+
+	estimateSec += correctionSec;
+	stats.corrections++;
+
+	// Zulu time runs forward at the sim rate, the replay at the replay rate
+	return correctionSec * replayRate / simRate;
+}
+
+
+/**
+* Sets the zulu time of the sim the clock is phase-locked to
+*/
+void ReplayClock::SetZuluTime(double zuluSec) {
+	this->zuluSec = zuluSec;
+	this->zuluValid = true;
+}
+
+
+/**
+* Moves the clock to the given replay time
+*/
+void ReplayClock::Seek(double timeSec) {
+	this->timeSec = timeSec;
+	this->zuluAnchored = false;
+}
+
+
+/**
+* Moves the clock to the start of the replay and resets the phase lock and the counters
+*/
+void ReplayClock::Reset() {
+	timeSec = 0;
+	frameTimeSec = 0;
+	sourceStarted = false;
+	zuluValid = false;
+	zuluAnchored = false;
+	stats = Stats();
+}
+
+
+/**
+* Returns the replay time in s
+*/
+double ReplayClock::GetTime() const {
+	return timeSec;
+}
+
+
+/**
+* Returns the duration of the last frame in s
+*/
+double ReplayClock::GetFrameTime() const {
+	return frameTimeSec;
+}
@@ -0,0 +1,143 @@
+#ifndef ReplayClock_H
+#define ReplayClock_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <functional>
+
+/**
+* Clock of the replay, i.e. the time line all co-processors read (see ReplayEngine)
+*
+* Ticks once per sim frame and advances the replay time by the duration of the frame times the replay
+* rate. The duration of a frame is taken from
+* (1) sim -> the frame rate reported by the sim (SIMCONNECT_RECV_EVENT_FRAME)
+* (2) wall -> the time source, e.g. the wall clock (default: steady clock)
+* (3) fixedStep -> a fixed step, independent of sim and wall clock, i.e. the replay is bit-reproducible
+*     (test mode, e.g. for benchmarks)
+*
+* In sim and wall mode, the clock is phase-locked to the zulu time of the sim: the drift between the
+* frame durations (at the sim rate) and the zulu time elapsed is corrected a fraction at a time, with
+* the correction per frame limited (slew), i.e. the replay time doesn't jump. Drift within the dead band
+* (resolution of the zulu time) is left alone, a drift beyond the max. (sim paused, zulu time changed or
+* past midnight) re-anchors the clock to the zulu time instead
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class ReplayClock {
+
+public:
+	enum class Mode {
+		sim,
+		wall,
+		fixedStep
+	};
+
+	struct Stats {
+		uint64_t ticks = 0;			// Frames
+		uint64_t corrections = 0;	// Frames corrected against the zulu time
+		uint64_t resyncs = 0;		// Clock re-anchored to the zulu time
+		double driftSec = 0;		// Drift of the last frame (zulu time - clock)
+		double maxDriftSec = 0;		// Max. absolute drift
+	};
+
+	ReplayClock();
+	~ReplayClock();
+
+private:
+	Mode mode = Mode::sim;
+	std::function<double()> timeSource;
+	double fixedStepSec = 1.0 / 60.0;
+
+	double timeSec = 0, frameTimeSec = 0, prevSourceSec = -1;
+	bool sourceStarted = false;
+
+	// Phase lock
+	double gain = 0.1, maxSlew = 0.1, deadBandSec = 0.0005, resyncDriftSec = 2.0;
+	double zuluSec = 0, zuluStartSec = 0, estimateSec = 0;
+	bool zuluValid = false, zuluAnchored = false;
+
+	/**
+	* Corrects the step of the frame against the zulu time of the sim
+	*/
+	double PhaseLock(double frameTimeSec, double simRate, double replayRate);
+
+public:
+	Stats stats;
+
+	/**
+	* Sets the source of the frame duration
+	*
+	* @param	mode		sim, wall or fixedStep (default: sim)
+	* @return	void
+	*/
+	void SetMode(Mode mode);
+
+	/**
+	* Returns the source of the frame duration
+	*/
+	Mode GetMode() const;
+
+	/**
+	* Sets the time source of the wall mode, e.g. a steady clock in s. The source is read once per tick
+	*
+	* @param	timeSource	Time in s, nullptr for the steady clock
+	* @return	void
+	*/
+	void SetTimeSource(std::function<double()> timeSource);
+
+	/**
+	* Sets the duration of a frame of the fixed step mode
+	*
+	* @param	stepSec		Duration in s (default: 1/60 s)
+	* @return	void
+	*/
+	void SetFixedStep(double stepSec);
+
+	/**
+	* Returns the duration of a frame of the fixed step mode
+	*/
+	double GetFixedStep() const;
+
+	/**
+	* Advances the clock by one frame
+	*
+	* @param	simFrameTimeSec		Duration of the frame as reported by the sim (sim mode)
+	* @param	simRate				Sim rate, i.e. zulu time elapsed per s
+	* @param	replayRate			Replay rate, negative while replaying backwards
+	* @return	void
+	*/
+	void Tick(double simFrameTimeSec, double simRate, double replayRate);
+
+	/**
+	* Sets the zulu time of the sim the clock is phase-locked to, e.g. with the sim data of the frame
+	*
+	* @param	zuluSec		Zulu time in s
+	* @return	void
+	*/
+	void SetZuluTime(double zuluSec);
+
+	/**
+	* Moves the clock to the given replay time. The phase lock is re-anchored with the next zulu time
+	*
+	* @param	timeSec		Replay time in s
+	* @return	void
+	*/
+	void Seek(double timeSec);
+
+	/**
+	* Moves the clock to the start of the replay and resets the phase lock and the counters
+	*/
+	void Reset();
+
+	/**
+	* Returns the replay time in s
+	*/
+	double GetTime() const;
+
+	/**
+	* Returns the duration of the last frame in s, i.e. excl. the replay rate and the correction
+	*/
+	double GetFrameTime() const;
+};
+#endif
@@ -0,0 +1,552 @@
+#include "ReplayEngine.h"
+#include "Processor.h"
+#include "ProcessorCom.h"
+
+/**
+* Constructor / Destructor
+*/
+template<typename Traits> ReplayEngine<Traits>::ReplayEngine(Processor* handler, Track* track) : records(track) {
+	this->cpu = handler;
+	this->cpuCom = handler->cpuCom;
+	this->track = track;
+	this->simAircraft = new SimModel();
+	this->keyframes = TrackKeyframes(cpu->GetKeyframeInterval(), &cpu->keyframeStats);
+	this->InitCoprocessor();
+}
+
+template<typename Traits> ReplayEngine<Traits>::~ReplayEngine() {
+	// Close sim models
+	delete simAircraft;
+	delete simFSA320;
+	delete simBBA332;
+	delete simBBA343;
+	delete simPAA388;
+	delete simFSB787;
+
+	// Close sound engine
+	if (initSound)
+		delete simSound;
+
+	activeSimObject = false;
+}
+
+
+/**
+* Initializes the coprocessor
+*/
+template<typename Traits> void ReplayEngine<Traits>::InitCoprocessor() {
+	// Assign flight model specific vars to data definitions
+	switch (track->GetSimApi()) {
+	case 320:
+		simFSA320 = new SimFSA320(cpu);
+		simAircraft->SetSimModelBehavior(simFSA320);
+		break;
+	case 332:
+		simBBA332 = new SimBBA332(cpu);
+		simAircraft->SetSimModelBehavior(simBBA332);
+		break;
+	case 343:
+		simBBA343 = new SimBBA343(cpu);
+		simAircraft->SetSimModelBehavior(simBBA343);
+		break;
+	case 388:
+		simPAA388 = new SimPAA388(cpu);
+		simAircraft->SetSimModelBehavior(simPAA388);
+		break;
+	case 787:
+		simFSB787 = new SimFSB787(cpu);
+		simAircraft->SetSimModelBehavior(simFSB787);
+		break;
+	case 999:
+		simFSA320 = new SimFSA320(cpu);
+		simAircraft->SetSimModelBehavior(simFSA320);
+		break;
+	default:
+		simFSA320 = new SimFSA320(cpu);
+		simAircraft->SetSimModelBehavior(simFSA320);
+	}
+
+	if (track->GetTrackType() == Track::TrackType::USER) {
+		this->SetSimObjectId(SIMCONNECT_OBJECT_ID_USER);
+		activeSimObject = true;
+	}
+	else if (track->GetTrackType() == Track::TrackType::AI)
+		simAircraft->CreateAiSimObject(this->track);
+
+	// Init ground altitude, i.e. the elevation of the departure until the sim reports the ground
+	if constexpr (Traits::clampToGround)
+		cpu->simObjects.Get(simAircraft->GetSimRequestId()).altGround = records.Get(ReplayRecord::alt, 0);
+}
+
+
+/**
+* Assigns the SimConnect object Id to corresponding Sim Model.
+* Triggers intialization of the model as soon as objectID has been set
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetSimObjectId(DWORD simObjectId) {
+	simAircraft->InitSimObject(simObjectId);
+	simAircraft->GetState(initialState);
+	activeSimObject = true;
+}
+
+
+/**
+* Returns the SimConnect object Id of the corresponding Sim Model.
+* Required for newly requested AI objects only.
+*/
+template<typename Traits> DWORD ReplayEngine<Traits>::GetSimObjectID() {
+	return simAircraft->GetSimObjectId();
+}
+
+
+/**
+* Returns the models's SimConnect request ID
+* Required for newly requested AI objects only.
+*/
+template<typename Traits> int ReplayEngine<Traits>::GetSimRequestID() {
+	return simAircraft->GetSimRequestId();
+}
+
+
+/**
+* Assigns a track to the coprocessor
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetTrack(Track* track) {
+	this->track = track;
+}
+
+
+/**
+* Returns track assigned to the coprocessor
+*/
+template<typename Traits> Track* ReplayEngine<Traits>::GetTrack() {
+	return this->track;
+}
+
+
+/**
+* Determines the position of the file cursor at the time of the replay clock
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetCursorPos() {
+	// Paused, i.e. the last update holds
+	if (cpuCom->GetReplayRate() == 0.0)
+		return;
+
+	// Update rate of the track, i.e. frames shorter than the min. update time add up
+	pendingFrameTimeSec += cpu->replayClock.GetFrameTime();
+	if (pendingFrameTimeSec < Traits::minUpdateSec) {
+		runUpdate = false;
+		return;
+	}
+	this->simFrameTimeSec = pendingFrameTimeSec;
+	pendingFrameTimeSec = 0;
+
+	// Check for end of AI/traffic track, i.e. the last record has been replayed
+	if (this->track->GetTrackType() == Track::TrackType::AI && activeSimObject && this->cursorPos == records.GetLastPos() && this->simElapsedTimeSec >= records.GetTime(this->cursorPos)) {
+		// Remove object if at end of track and velocity, i.e. moving
+		// Removal is left to the submission phase (SetAircraftPos)
+		if (records.Get(ReplayRecord::spd, this->cursorPos) >= 1)
+			removeSimObject = true;
+
+		activeSimObject = false;
+	}
+
+	// Sim elapsed time of the track, i.e. time line of the replay adjusted for the time offset of the track
+	this->simElapsedTimeSec = cpu->replayClock.GetTime() + this->track->GetTimeOffset();
+
+	// Determine cursor position
+	this->cursorPos = records.GetCursorPos(this->simElapsedTimeSec, cpuCom->GetReplayRate(), this->cursorPos);
+
+	// Only run update if new cursor position is different from the previous one, unless interpolated
+	runUpdate = Traits::interpolate || this->cursorPos != prevCursorPos;
+	prevCursorPos = this->cursorPos;
+
+	if (runUpdate) {
+		track->SetCursorPos(this->cursorPos);
+
+		if (this->track->GetTrackType() == Track::TrackType::USER)
+			cpuCom->SetCursorPos(this->cursorPos);
+	}
+}
+
+
+/**
+* Adjusts the replay rate at the start/end of the recording
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetHalfRate() {
+	// Adjust sim rate at start/end of recording
+	double timeSec = records.GetTime(this->cursorPos);
+	if (cpuCom->GetHalfRate() && (timeSec < runHalfRateSec || timeSec > (records.GetFlightTime() - runHalfRateSec))) {
+		if (cpuCom->GetReplayRate() != 0.5F)
+			cpuCom->SetReplayRate(0.5F);
+	}
+	else if (cpuCom->GetHalfRate()) {
+		if (cpuCom->GetReplayRate() != 1.0F)
+			cpuCom->SetReplayRate(1.0F);
+	}
+}
+
+
+/**
+* Moves the file cursor to the given position on the time line of the replay
+*/
+template<typename Traits> void ReplayEngine<Traits>::Seek(double seconds) {
+	this->simElapsedTimeSec = seconds + this->track->GetTimeOffset();
+
+	// Cursor remains at the first record, if the track hasn't started yet
+	this->cursorPos = this->simElapsedTimeSec > 0 ? records.GetCursorPos(this->simElapsedTimeSec, 1.0, 0) : 0;
+
+	track->SetCursorPos(this->cursorPos);
+
+	if (this->track->GetTrackType() == Track::TrackType::USER)
+		cpuCom->SetCursorPos(this->cursorPos);
+
+	// Next frame updates, even if the cursor position remains
+	runUpdate = true;
+	prevCursorPos = -1;
+
+	this->RestoreKeyframe();
+}
+
+
+/**
+* Moves the throttle position towards the throttle of the record and stops the engines
+* after landing and taxi, otherwise takes the throttle of the record
+*/
+template<typename Traits> bool ReplayEngine<Traits>::SetThrottle(int cursorPos, double frameTimeSec) {
+	if constexpr (!Traits::throttleRamp) {
+		this->thrtPos = records.Get(ReplayRecord::thr, cursorPos);
+		return true;
+	}
+
+	if (records.IsEngineShutdown(cursorPos) && !this->engineStopped) {
+		this->thrtPos = -99;
+		simAircraft->StopEngineProc(Traits::fileType);
+		this->engineStopped = true;
+	}
+	else if (!this->engineStopped) {
+		double n1ThrtVal = simAircraft->ConvertThrottle((float)records.Get(ReplayRecord::thr, cursorPos), Traits::fileType);
+
+		if (this->thrtPos < n1ThrtVal) {
+			this->thrtPos += (100 / 10) * frameTimeSec;
+
+			if (this->thrtPos > n1ThrtVal)
+				this->thrtPos = n1ThrtVal;
+		}
+		else if (this->thrtPos > n1ThrtVal) {
+			this->thrtPos -= (100 / 10) * frameTimeSec;
+
+			if (this->thrtPos < n1ThrtVal)
+				this->thrtPos = n1ThrtVal;
+		}
+		return true;
+	}
+	return false;
+}
+
+
+/**
+* Sets the spoilers of the record
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetSpoilers(int cursorPos) {
+	if (Traits::armSpoilers && cursorPos > records.GetCount() / 2 && records.Get(ReplayRecord::splr, cursorPos) == 0)
+		// Arm for landing
+		simAircraft->SetSpoiler(1, Traits::fileType);
+	else
+		simAircraft->SetSpoiler(records.Get(ReplayRecord::splr, cursorPos), Traits::fileType);
+}
+
+
+/**
+* Runs the procedures of the sim model and the engine for a record
+*/
+template<typename Traits> bool ReplayEngine<Traits>::RunProcedures(int cursorPos, double frameTimeSec) {
+	float timeSec = (float)records.GetTime(cursorPos);
+
+	if constexpr (Traits::apuStartSec >= 0)
+		simAircraft->StartAPUProc(timeSec, Traits::apuStartSec, Traits::fileType);
+	simAircraft->StartEngineProc(timeSec, Traits::engineStartSec, Traits::fileType);
+
+	bool setThrottle = this->SetThrottle(cursorPos, frameTimeSec);
+	this->SetSpoilers(cursorPos);
+	return setThrottle;
+}
+
+
+/**
+* Builds the keyframes of the track, i.e. runs the procedures from the first to the last record
+*/
+template<typename Traits> void ReplayEngine<Traits>::BuildKeyframes() {
+	int stride = records.GetDryRunStride();
+
+	keyframes.Clear();
+	simAircraft->SetState(initialState);
+	this->thrtPos = 0;
+	this->engineStopped = false;
+
+	for (int pos = 0; pos < records.GetCount(); pos += stride) {
+		TrackKeyframes::Keyframe keyframe = { records.GetTime(pos), pos, {}, this->thrtPos, this->engineStopped };
+		simAircraft->GetState(keyframe.modelState);
+		keyframes.Capture(keyframe);
+
+		int nextPos = pos + stride < records.GetCount() ? pos + stride : records.GetCount() - 1;
+		this->RunProcedures(pos, records.GetTime(nextPos) - records.GetTime(pos));
+	}
+	keyframes.SetBuilt();
+}
+
+
+/**
+* Restores the procedural state at the cursor position and brings the sim object in line
+*/
+template<typename Traits> void ReplayEngine<Traits>::RestoreKeyframe() {
+	// Sim object not placed yet, i.e. the procedures start with its first frame
+	SimModelState prevState;
+	if (!simAircraft->GetState(prevState))
+		return;
+	bool prevEngineStopped = this->engineStopped;
+
+	cpu->BeginDryRun();
+
+	// Built with the first seek, i.e. a replay from the start doesn't pay for it
+	if (!keyframes.IsBuilt())
+		this->BuildKeyframes();
+
+	const TrackKeyframes::Keyframe* keyframe = keyframes.Find(this->simElapsedTimeSec);
+	simAircraft->SetState(keyframe ? keyframe->modelState : initialState);
+	this->thrtPos = keyframe ? keyframe->thrtPos : 0;
+	this->engineStopped = keyframe && keyframe->engineStopped;
+
+	// Fast-forward to the record before the cursor, i.e. the next frame processes the cursor position
+	int stride = records.GetDryRunStride();
+	int startPos = keyframe ? keyframe->cursorPos : 0;
+	int endPos = this->cursorPos < records.GetCount() ? this->cursorPos : records.GetCount();
+	for (int pos = startPos; pos < endPos; pos += stride) {
+		int nextPos = pos + stride < endPos ? pos + stride : endPos;
+		this->RunProcedures(pos, records.GetTime(nextPos) - records.GetTime(pos));
+	}
+	if (endPos > startPos)
+		keyframes.AddSteps(endPos - startPos);
+
+	cpu->EndDryRun();
+
+	simAircraft->SyncState(prevState);
+
+	// Engines stopped after the restored state: run the start procedure again
+	if (prevEngineStopped && !this->engineStopped) {
+		SimModelState state;
+		simAircraft->GetState(state);
+		state.startEngineProcStep = 0;
+		simAircraft->SetState(state);
+	}
+	// Engines stopped before the restored state, i.e. skipped by the seek
+	else if (!prevEngineStopped && this->engineStopped)
+		simAircraft->StopEngineProc(Traits::fileType);
+}
+
+
+/**
+* Returns the time on the time line of the replay
+*/
+template<typename Traits> double ReplayEngine<Traits>::GetReplayTime() {
+	return this->simElapsedTimeSec - this->track->GetTimeOffset();
+}
+
+
+/**
+* Computes the frame of the track, i.e. cursor position, position and sim vars.
+* Doesn't call SimConnect, i.e. co-processors of different tracks may compute in parallel
+*/
+template<typename Traits> void ReplayEngine<Traits>::ComputeFrame() {
+	frameTimes = {};
+	{
+		FrameProfiler::ScopeTimer timer(this->Profile(frameTimes.cursorNs));
+		this->SetCursorPos();
+	}
+
+	if (!activeSimObject || !runUpdate)
+		return;
+
+	FrameProfiler::ScopeTimer timer(this->Profile(frameTimes.modelNs));
+
+	const SimObjectStruct& simObject = cpu->simObjects.Get(simAircraft->GetSimRequestId());
+
+	// Set position vars, interpolated between the records enclosing the sim elapsed time (sub-frame replay), if supported
+	this->posSet = records.GetPosition(this->cursorPos, this->simElapsedTimeSec);
+
+	// Determine altitude: ground altitude of the sim at departure/destination, otherwise in-flight altitude
+	if (Traits::clampToGround && records.IsOnGround(this->cursorPos)) {
+		posSet.alt = simObject.altGround + simObject.staticCGAlt;
+		absGroundAlt = 0;
+	}
+	else {
+		posSet.alt += simObject.staticCGAlt;
+		absGroundAlt = posSet.alt - simObject.altGround;
+	}
+
+	// Set attitude vars
+	posSet.pitch = posSet.pitch * Traits::pitchSign + simObject.staticCGPitch;
+	posSet.bank = posSet.bank * Traits::bankSign;
+
+	// Set simulation vars
+	if constexpr (Traits::setVelocity) {
+		simSet.velZ = posSet.spd;
+		records.GetVerticalSpeed(this->cursorPos, simSet.velY);
+	}
+}
+
+
+/**
+* Returns the aircraft's position and attitude, as computed by ComputeFrame
+*/
+template<typename Traits> const PosDataSet& ReplayEngine<Traits>::GetPosition() const {
+	return this->posSet;
+}
+
+
+/**
+* Returns the time of the stages of the current frame
+*/
+template<typename Traits> const FrameProfiler::TrackTimes& ReplayEngine<Traits>::GetFrameTimes() const {
+	return this->frameTimes;
+}
+
+
+/**
+* Returns the stage to time, nullptr if the frame profiler is disabled
+*/
+template<typename Traits> int64_t* ReplayEngine<Traits>::Profile(int64_t& stageNs) {
+	return cpu->frameProfiler.IsEnabled() ? &stageNs : nullptr;
+}
+
+
+/**
+* Sets the aircraft's lateral position, vertical position and attitude
+* in the sim
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetAircraftPos() {
+	FrameProfiler::ScopeTimer timer(this->Profile(frameTimes.submitNs));
+
+	// Replay rate follows the main/user track
+	if (this->track->GetTrackType() == Track::TrackType::USER)
+		this->SetHalfRate();
+
+	// Remove AI object at the end of its track
+	if (removeSimObject) {
+		simAircraft->RemoveAiSimObject();
+		removeSimObject = false;
+	}
+
+	if (activeSimObject && runUpdate) {
+		simAircraft->SetPosition(posSet, Traits::fileType);
+
+		if constexpr (Traits::setVelocity)
+			simAircraft->SetSimData(simSet, Traits::fileType);
+	}
+}
+
+
+/**
+* Sets the aircraft's flight systems, such as flight controls, propulsion and gear
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetAircraftSystems() {
+	if (!activeSimObject || !runUpdate)
+		return;
+
+	{
+		FrameProfiler::ScopeTimer timer(this->Profile(frameTimes.modelNs));
+
+		// Set system vars: Fuel (Distributes set amount of fuel over flight time)
+		simAircraft->SetFuel((float)records.GetTime(this->cursorPos), (float)records.GetFlightTime(), Traits::fileType);
+
+		// Set system vars: Propulsion & Spoilers (Stop engines after landing and taxi, otherwise set aircraft throttle)
+		if (this->RunProcedures(this->cursorPos, simFrameTimeSec))
+			simAircraft->SetThrottle(this->thrtPos, Traits::fileType);
+
+		// Set system vars: Flight Controls & Gear
+		simAircraft->SetAileron(records.Get(ReplayRecord::alr, this->cursorPos), Traits::fileType);
+		if constexpr (Traits::hasElevatorRudder) {
+			simAircraft->SetElevator(records.Get(ReplayRecord::elev, this->cursorPos), Traits::fileType);
+			simAircraft->SetRudder(records.Get(ReplayRecord::rudder, this->cursorPos), Traits::fileType);
+		}
+		simAircraft->SetFlaps(records.Get(ReplayRecord::flaps, this->cursorPos), Traits::fileType);
+		simAircraft->SetGear(records.Get(ReplayRecord::gear, this->cursorPos), Traits::fileType);
+		simAircraft->SetNoseWheel(records.Get(ReplayRecord::noseWhl, this->cursorPos), Traits::fileType);
+
+		// Set system vars: Lights
+		simAircraft->SetNavLights(records.GetLight(ReplayRecord::navL, this->cursorPos), Traits::fileType);
+		simAircraft->SetLogoLights(records.GetLight(ReplayRecord::logoL, this->cursorPos), Traits::fileType);
+		simAircraft->SetBeaconLights(records.GetLight(ReplayRecord::beacL, this->cursorPos), Traits::fileType);
+		simAircraft->SetStrobeLights(records.GetLight(ReplayRecord::strbL, this->cursorPos), Traits::fileType);
+		simAircraft->SetTaxiLights(records.GetLight(ReplayRecord::taxiL, this->cursorPos), Traits::fileType);
+		simAircraft->SetWingLights(records.GetLight(ReplayRecord::wngL, this->cursorPos), Traits::fileType);
+		simAircraft->SetLandingLights(records.GetLight(ReplayRecord::lndgL, this->cursorPos), Traits::fileType);
+	}
+
+	// Write the system vars of the frame
+	FrameProfiler::ScopeTimer timer(this->Profile(frameTimes.submitNs));
+	simAircraft->FlushSysData();
+}
+
+
+/**
+* Adjusts and plays the ambience sound stage (FMOD)
+*/
+template<typename Traits> void ReplayEngine<Traits>::SetSoundStage() {
+	FrameProfiler::ScopeTimer timer(this->Profile(frameTimes.soundNs));
+
+	if (activeSimObject && runUpdate && cpuCom->GetCustomSound() && track->GetTrackType() == Track::TrackType::USER) {
+		if (!initSound) {
+			simSound = new SimSoundEngine();
+
+			// Assign flight model specific vars to data definitions
+			switch (track->GetSimApi()) {
+			case 320:
+				simSound->InitSoundStage(L"A320NX.bank", L"A320NX.strings.bank");
+				break;
+			case 332:
+				simSound->InitSoundStage(L"A332RR.bank", L"A332RR.strings.bank");
+				break;
+			case 343:
+				simSound->InitSoundStage(L"A343.bank", L"A343.strings.bank");
+				break;
+			case 388:
+				simSound->InitSoundStage(L"A388.bank", L"A388.strings.bank");
+				break;
+			case 787:
+				simSound->InitSoundStage(L"B781.bank", L"B781.strings.bank");
+				break;
+			default:
+				simSound->InitSoundStage(L"A320NX.bank", L"A320NX.strings.bank");
+			}
+
+			if (cpuCom->GetBeepStartEnd())
+				simSound->PlayStartReplaySound();
+
+			initSound = true;
+		}
+
+		FTDISFileStruct sndProcRec = records.GetSoundRecord(this->cursorPos);
+		const SimObjectStruct& simObject = cpu->simObjects.Get(simAircraft->GetSimRequestId());
+		sndProcRec.thr = (float)thrtPos;
+		sndProcRec.flap = (float)(simObject.flapsLeadingPrc + simObject.flapsTrailingPrc);
+		sndProcRec.alt = absGroundAlt;
+
+		if (Traits::engineSound && simElapsedTimeSec >= Traits::engineStartSec)
+			simSound->PlayEngineSound(sndProcRec);
+
+		simSound->PlayCabinSound(sndProcRec);
+		simSound->PlaySystemSound(sndProcRec);
+		simSound->PlayControlSound(sndProcRec);
+		simSound->SystemUpdate();
+	}
+	else if (runUpdate && !cpuCom->GetCustomSound() && initSound) {
+		delete simSound;
+		initSound = false;
+	}
+}
+
+
+// Replay engines of the file formats (see CoprocessorFDR, CoprocessorFTDIS)
+template class ReplayEngine<FDRRecordTraits>;
+template class ReplayEngine<FTDISRecordTraits>;
@@ -0,0 +1,244 @@
+#ifndef ReplayEngine_H
+#define ReplayEngine_H
+
+// Includes
+#include "PosDataSet.h"
+#include "SimDataSet.h"
+#include "Track.h"
+#include "ReplayRecordTraits.h"
+#include "SimSoundEngine.h"
+#include "TrackKeyframes.h"
+#include "FrameProfiler.h"
+#include "SimModel.h"
+#include "SimFSA320.cpp"
+#include "SimFSB787.cpp"
+#include "SimBBA332.cpp"
+#include "SimBBA343.cpp"
+#include "SimPAA388.cpp"
+
+// Forward declarations to avoid circular include.
+class Processor;  // #include "Processor.h" in .cpp file
+class ProcessorCom; // #include "ProcessorCom.h" in.cpp file
+
+/**
+* Replay engine of a track
+*
+* Replays the records of a track in MS FS2020 using the SimConnect API, i.e. moves the file cursor,
+* places the aircraft and sets its systems, runs the procedures of the sim model, plays the sound stage
+* and handles the lifecycle of the AI object. The file format is a compile-time policy (Traits, see
+* ReplayRecordTraits.h): the traits provide the field accessors of the records, the update rate, the
+* sign conventions and the ground altitude rule, i.e. the per-frame path has no virtual dispatch.
+* All tracks read the time line of the replay clock (see ReplayClock), i.e. tracks don't drift apart.
+* Instantiated for FDRRecordTraits (CoprocessorFDR) and FTDISRecordTraits (CoprocessorFTDIS)
+*
+* @author muppetlabs@fswindowseat.com
+*/
+template<typename Traits> class ReplayEngine {
+
+public:
+	ReplayEngine(Processor* handler, Track* track);
+	~ReplayEngine();
+
+protected:
+	Processor* cpu = nullptr;
+	ProcessorCom* cpuCom = nullptr;
+	Track* track = nullptr;
+	Traits records;
+	SimModel* simAircraft = nullptr;
+	SimSoundEngine* simSound = nullptr;
+
+	SimFSA320* simFSA320 = nullptr;
+	SimBBA332* simBBA332 = nullptr;
+	SimBBA343* simBBA343 = nullptr;
+	SimPAA388* simPAA388 = nullptr;
+	SimFSB787* simFSB787 = nullptr;
+
+	TrackKeyframes keyframes;
+
+	FrameProfiler::TrackTimes frameTimes;
+
+	SimModelState initialState = {};
+
+	PosDataSet posSet = {};
+
+	SimDataSet simSet = {};
+
+	int runHalfRateSec = 1200, cursorPos = 0, prevCursorPos = -1;
+
+	double simElapsedTimeSec = 0, simFrameTimeSec = 0, pendingFrameTimeSec = 0, thrtPos = 0, absGroundAlt = 0;
+
+	bool engineStopped = false, initSound = false, runUpdate = false, activeSimObject = false, removeSimObject = false;
+
+private:
+	/**
+	* Initializes the coprocessor
+	*/
+	void InitCoprocessor();
+
+	/**
+	* Adjusts the replay rate at the start/end of the recording (half rate option).
+	* Writes to the shared processor state, i.e. runs in the submission phase
+	*/
+	void SetHalfRate();
+
+	/**
+	* Moves the throttle position towards the throttle of the record (throttle ramp policy) and stops
+	* the engines after landing and taxi, otherwise takes the throttle of the record. Returns true, if
+	* the throttle is to be set
+	*/
+	bool SetThrottle(int cursorPos, double frameTimeSec);
+
+	/**
+	* Sets the spoilers of the record, armed for landing in the second half of the track (arm spoilers policy)
+	*/
+	void SetSpoilers(int cursorPos);
+
+	/**
+	* Runs the procedures of the sim model and the engine for a record, i.e. the APU and engine start
+	* procedures, the throttle and the spoilers. Returns true, if the throttle is to be set
+	*/
+	bool RunProcedures(int cursorPos, double frameTimeSec);
+
+	/**
+	* Builds the keyframes of the track, i.e. runs the procedures from the first to the last record
+	* and takes a snapshot every keyframe interval. Has to be called during a dry run
+	*/
+	void BuildKeyframes();
+
+	/**
+	* Restores the procedural state at the cursor position, i.e. from the last keyframe before the
+	* cursor position and fast-forwarded from there, and brings the sim object in line
+	*/
+	void RestoreKeyframe();
+
+	/**
+	* Returns the stage to time, nullptr if the frame profiler is disabled (see FrameProfiler::ScopeTimer)
+	*/
+	int64_t* Profile(int64_t& stageNs);
+
+public:
+
+	/**
+	* Assigns the SimConnect object Id to corresponding Sim Model.
+	* Required for newly requested AI objects only.
+	*
+	* @param	Sim Object ID	DWORD
+	* @return	void
+	*/
+	void SetSimObjectId(DWORD simObjectId);
+
+	/**
+	* Returns the SimConnect object Id of the corresponding Sim Model.
+	* Required for newly requested AI objects only.
+	*
+	* @param	void
+	* @return	Sim Object ID	DWORD
+	*/
+	DWORD GetSimObjectID();
+
+	/**
+	* Returns the models's SimConnect request ID
+	* Required for newly requested AI objects only.
+	*
+	* @param	void
+	* @return	Sim Object Request ID	int
+	*/
+	int GetSimRequestID();
+
+	/**
+	* Assigns a track to the coprocessor
+	*
+	* @param	track	Track (pointer)
+	* @return	void
+	*/
+	void SetTrack(Track* track);
+
+	/**
+	* Returns track assigned to the coprocessor
+	*
+	* @param	void
+	* @return	track	Track (pointer)
+	*/
+	Track* GetTrack();
+
+	/**
+	* Determines the position of the file cursor at the time of the replay clock. The cursor
+	* points to the record of the flight data file to be read/processed
+	*
+	* @param	void
+	* @return   void
+	*/
+	void SetCursorPos();
+
+	/**
+	* Moves the file cursor to the given position on the time line of the replay. The
+	* time offset of the track is applied, i.e. all tracks seek to the same moment.
+	* The procedural state of the sim model is restored from the keyframes of the track
+	*
+	* @param	seconds		Replay time in s
+	* @return   void
+	*/
+	void Seek(double seconds);
+
+	/**
+	* Returns the time on the time line of the replay, i.e. the sim elapsed time of the track
+	* without its time offset (see ReplayClock)
+	*
+	* @param	void
+	* @return   double	Replay time in s
+	*/
+	double GetReplayTime();
+
+	/**
+	* Computes the frame of the track, i.e. determines the cursor position and the aircraft's
+	* position. Doesn't call SimConnect, i.e. safe to run in parallel to the co-processors
+	* of other tracks. Call SetAircraftPos et al. to submit the frame
+	*
+	* @param	void
+	* @return   void
+	*/
+	void ComputeFrame();
+
+	/**
+	* Returns the aircraft's position and attitude, as computed by ComputeFrame
+	*
+	* @param	void
+	* @return   PosDataSet	Position and attitude
+	*/
+	const PosDataSet& GetPosition() const;
+
+	/**
+	* Returns the time of the stages of the current frame, i.e. cursor search, model update, submission and
+	* sound, if the frame profiler is enabled (see FrameProfiler)
+	*
+	* @param	void
+	* @return   TrackTimes	Stages in ns
+	*/
+	const FrameProfiler::TrackTimes& GetFrameTimes() const;
+
+	/**
+	* Sets the aircraft's lateral position, vertical position and attitude
+	* in the sim, as computed by ComputeFrame
+	*
+	* @param	void
+	* @return   void
+	*/
+	void SetAircraftPos();
+
+	/**
+	* Sets the aircraft's flight systems, such as flight controls, propulsion and gear
+	*
+	* @param	void
+	* @return   void
+	*/
+	void SetAircraftSystems();
+
+	/**
+	* Adjusts and plays the ambience sound stage (FMOD)
+	*
+	* @param	void
+	* @return   void
+	*/
+	void SetSoundStage();
+};
+#endif
@@ -0,0 +1,316 @@
+#ifndef ReplayRecordTraits_H
+#define ReplayRecordTraits_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cmath>
+#include "PosDataSet.h"
+#include "FTDISFileStruct.h"
+#include "Track.h"
+#include "FDRFile.h"
+#include "FTDISFile.h"
+#include "TrackInterpolation.h"
+
+/**
+* Channels and lights of a record, independent of the file format (see ReplayEngine)
+*/
+namespace ReplayRecord
+{
+	enum Channel {
+		alt, spd, thr, alr, elev, rudder, flaps, splr, gear, noseWhl
+	};
+
+	enum Light {
+		navL, logoL, beacL, strbL, taxiL, wngL, lndgL
+	};
+}
+
+
+/**
+* Record traits of the .fdr files, i.e. the policies of the replay engine (ReplayEngine) for
+* the tracks recorded by the FDR
+*
+* Records are recorded at the sim frame rate, i.e. at a variable rate. The replay interpolates between
+* the records every frame (sub-frame replay). The recorded altitude is the sim's, i.e. there is no
+* ground altitude rule, and the recorded throttle is set as is
+*
+* @author muppetlabs@fswindowseat.com
+*/
+struct FDRRecordTraits {
+
+	static constexpr Track::FileType fileType = Track::FileType::FDR;
+
+	static constexpr double minUpdateSec = 0;			// Min. replay time between two updates, i.e. max. update rate (0: every frame)
+	static constexpr bool interpolate = true;			// Position interpolated every frame, otherwise updated with a new record only
+	static constexpr bool clampToGround = false;		// Ground altitude rule, i.e. placed on the ground of the sim at departure/destination
+	static constexpr bool setVelocity = false;			// Velocity of the record set, i.e. the sim moves the aircraft between updates
+	static constexpr bool throttleRamp = false;			// Throttle moved towards the throttle of the record, incl. engine stop after landing
+	static constexpr bool armSpoilers = false;			// Spoilers armed for landing in the second half of the track
+	static constexpr bool hasElevatorRudder = true;		// Elevator and rudder recorded
+	static constexpr bool engineSound = false;			// Engine sound played by the sound stage rather than the sim
+	static constexpr double pitchSign = 1;				// Sign convention of the recorded pitch
+	static constexpr double bankSign = 1;				// Sign convention of the recorded bank
+	static constexpr float apuStartSec = 10;			// Start of the APU start procedure (< 0: none)
+	static constexpr float engineStartSec = 70;			// Start of the engine start procedure
+
+	FDRRecordTraits(Track* track) {
+		this->fdrFile = track->GetFDRFile();
+		this->columns = fdrFile->GetColumns();
+		this->timeIndex = fdrFile->GetTimeIndex();
+	}
+
+	FDRFile* fdrFile;
+	const FDRTrackColumns* columns;
+	const FDRTimeIndex* timeIndex;
+
+	/**
+	* Returns the number of records
+	*/
+	int GetCount() const { return (int)columns->GetSize(); }
+
+	/**
+	* Returns the last record, i.e. the max. cursor position
+	*/
+	int GetLastPos() const { return fdrFile->GetSize(); }
+
+	/**
+	* Returns the time stamp (in s) of a record
+	*/
+	double GetTime(int pos) const { return columns->GetTime(pos); }
+
+	/**
+	* Returns the time stamp (in s) of the last record
+	*/
+	double GetFlightTime() const { return columns->GetTime(columns->GetSize() - 1); }
+
+	/**
+	* Returns the number of records a dry run steps at a time (see TrackKeyframes)
+	*/
+	int GetDryRunStride() const { return 1; }
+
+	/**
+	* Returns the cursor position for the given time (time index lookup), i.e. the first record at
+	* or after the time running forward and the last record at or before the time running backwards
+	*
+	* @param	seconds		Time in s
+	* @param	replayRate	Replay rate, i.e. direction of the replay
+	* @param	cursorPos	Current cursor position, returned if the track hasn't started yet
+	* @return	int			Cursor position
+	*/
+	int GetCursorPos(double seconds, double replayRate, int cursorPos) const {
+		if (replayRate > 0 && seconds > 0) {
+			cursorPos = (int)timeIndex->LowerBound(seconds);
+			if (cursorPos > fdrFile->GetSize())
+				cursorPos = fdrFile->GetSize();
+		}
+		else if (replayRate < 0 && seconds > 0)
+			cursorPos = (int)timeIndex->Floor(seconds);
+		return cursorPos;
+	}
+
+	/**
+	* Returns the position at the given time, interpolated between the records enclosing the time
+	*/
+	PosDataSet GetPosition(int pos, double seconds) const { return TrackInterpolation::getPosition(*columns, pos, seconds); }
+
+	/**
+	* Returns true, if the aircraft is on the ground of the departure/destination at a record. Not
+	* applicable (see clampToGround)
+	*/
+	bool IsOnGround(int pos) const { return false; }
+
+	/**
+	* Returns the vertical speed at a record. Not applicable (see setVelocity)
+	*/
+	bool GetVerticalSpeed(int pos, double& velY) const { return false; }
+
+	/**
+	* Returns true, if the record is the engine shutdown after landing. Not applicable (see throttleRamp)
+	*/
+	bool IsEngineShutdown(int pos) const { return false; }
+
+	/**
+	* Returns the value of a channel for a record
+	*/
+	double Get(ReplayRecord::Channel channel, int pos) const {
+		switch (channel) {
+		case ReplayRecord::alt: return columns->Get(FDRTrackColumns::alt, pos);
+		case ReplayRecord::spd: return columns->Get(FDRTrackColumns::spd, pos);
+		case ReplayRecord::thr: return columns->Get(FDRTrackColumns::thr1, pos);
+		case ReplayRecord::alr: return columns->Get(FDRTrackColumns::alr, pos);
+		case ReplayRecord::elev: return columns->Get(FDRTrackColumns::elev, pos);
+		case ReplayRecord::rudder: return columns->Get(FDRTrackColumns::rudder, pos);
+		case ReplayRecord::flaps: return columns->Get(FDRTrackColumns::flaps, pos);
+		case ReplayRecord::splr: return columns->Get(FDRTrackColumns::splr, pos);
+		case ReplayRecord::gear: return columns->Get(FDRTrackColumns::gearPos, pos);
+		case ReplayRecord::noseWhl: return columns->Get(FDRTrackColumns::gearAngle, pos);
+		}
+		return 0;
+	}
+
+	/**
+	* Returns the state of a light for a record
+	*/
+	int GetLight(ReplayRecord::Light light, int pos) const {
+		switch (light) {
+		case ReplayRecord::navL: return columns->GetLight(FDRTrackColumns::navL, pos);
+		case ReplayRecord::logoL: return columns->GetLight(FDRTrackColumns::logoL, pos);
+		case ReplayRecord::beacL: return columns->GetLight(FDRTrackColumns::beacL, pos);
+		case ReplayRecord::strbL: return columns->GetLight(FDRTrackColumns::strbL, pos);
+		case ReplayRecord::taxiL: return columns->GetLight(FDRTrackColumns::taxiL, pos);
+		case ReplayRecord::wngL: return columns->GetLight(FDRTrackColumns::wngL, pos);
+		case ReplayRecord::lndgL: return columns->GetLight(FDRTrackColumns::lndgL, pos);
+		}
+		return 0;
+	}
+
+	/**
+	* Returns the sound record of a record, i.e. the channels the sound stage (FMOD) plays by
+	*/
+	FTDISFileStruct GetSoundRecord(int pos) const {
+		FTDISFileStruct sndProcRec = {};
+		sndProcRec.spd = columns->Get(FDRTrackColumns::spd, pos);
+		sndProcRec.splr = columns->Get(FDRTrackColumns::splr, pos);
+		sndProcRec.gear = columns->Get(FDRTrackColumns::gearPos, pos);
+		sndProcRec.fltTime = columns->GetTime(pos);
+		return sndProcRec;
+	}
+};
+
+
+/**
+* Record traits of the .ftd files, i.e. the policies of the replay engine (ReplayEngine) for
+* the tracks prepared by the Flight Tracking Data Integration System (FTDIS)
+*
+* Records are sampled at a fixed rate (100 Hz), i.e. the record number is a function of time. The
+* replay places the aircraft with every new record, at ~200 FPS at most, the sim moves it in between
+* (velocity). Pitch and bank are recorded with the opposite sign, the altitude at departure and
+* destination is the elevation of the airport rather than the ground of the sim
+*
+* @author muppetlabs@fswindowseat.com
+*/
+struct FTDISRecordTraits {
+
+	static constexpr Track::FileType fileType = Track::FileType::FTDIS;
+
+	static constexpr double minUpdateSec = 0.005;
+	static constexpr bool interpolate = false;
+	static constexpr bool clampToGround = true;
+	static constexpr bool setVelocity = true;
+	static constexpr bool throttleRamp = true;
+	static constexpr bool armSpoilers = true;
+	static constexpr bool hasElevatorRudder = false;
+	static constexpr bool engineSound = true;
+	static constexpr double pitchSign = -1;
+	static constexpr double bankSign = -1;
+	static constexpr float apuStartSec = -1;
+	static constexpr float engineStartSec = 35;
+
+	static constexpr double targetPeriod = 0.01;		// Sample rate of the records (in s)
+	static constexpr double groundWindowSec = 1800;		// Ground altitude rule applies within 30 min of departure/destination
+
+	FTDISRecordTraits(Track* track) {
+		this->ftdisFile = track->GetFTDISFile();
+		this->records = ftdisFile->GetRecords();
+	}
+
+	FTDISFile* ftdisFile;
+	RecordSpan<FTDISFileStruct> records;
+
+	int GetCount() const { return (int)records.size(); }
+
+	int GetLastPos() const { return ftdisFile->size; }
+
+	double GetTime(int pos) const { return pos * targetPeriod; }
+
+	double GetFlightTime() const { return ftdisFile->flightTime; }
+
+	/**
+	* Returns the number of records a dry run steps at a time, i.e. 10 Hz rather than record by record
+	*/
+	int GetDryRunStride() const {
+		int stride = (int)std::round(0.1 / targetPeriod);
+		return stride < 1 ? 1 : stride;
+	}
+
+	/**
+	* Returns the cursor position for the given time, i.e. the nearest record (fixed sample rate)
+	*/
+	int GetCursorPos(double seconds, double replayRate, int cursorPos) const {
+		cursorPos = (int)std::round(seconds / targetPeriod);
+		if (cursorPos < 0)
+			cursorPos = 0;
+		else if (cursorPos > ftdisFile->size)
+			cursorPos = ftdisFile->size;
+		return cursorPos;
+	}
+
+	/**
+	* Returns the position of a record
+	*/
+	PosDataSet GetPosition(int pos, double seconds) const {
+		const FTDISFileStruct& record = records[pos];
+		return { record.lat, record.lon, record.alt, record.hdg, record.pitch, record.bank, record.spd };
+	}
+
+	/**
+	* Returns true, if the aircraft is on the ground of the departure/destination at a record, i.e.
+	* the altitude of the record is the elevation of the airport
+	*/
+	bool IsOnGround(int pos) const {
+		const FTDISFileStruct& record = records[pos];
+		if (record.fltTime < groundWindowSec)
+			return record.alt == ftdisFile->depElev;
+		else if (record.fltTime > ftdisFile->flightTime - groundWindowSec)
+			return record.alt == ftdisFile->destElev;
+		return false;
+	}
+
+	/**
+	* Returns the vertical speed at a record, i.e. the change in altitude over the last second
+	*/
+	bool GetVerticalSpeed(int pos, double& velY) const {
+		int cursorOffSet = (int)std::round(1 / targetPeriod);
+		if (pos < cursorOffSet)
+			return false;
+		velY = records[pos].alt - records[pos - cursorOffSet + 1].alt;
+		return true;
+	}
+
+	/**
+	* Returns true, if the record is the engine shutdown after landing and taxi
+	*/
+	bool IsEngineShutdown(int pos) const { return records[pos].fltPhase == 5 && records[pos].thr == -99; }
+
+	double Get(ReplayRecord::Channel channel, int pos) const {
+		const FTDISFileStruct& record = records[pos];
+		switch (channel) {
+		case ReplayRecord::alt: return record.alt;
+		case ReplayRecord::spd: return record.spd;
+		case ReplayRecord::thr: return record.thr;
+		case ReplayRecord::alr: return record.alr;
+		case ReplayRecord::flaps: return record.flap;
+		case ReplayRecord::splr: return record.splr;
+		case ReplayRecord::gear: return record.gear;
+		case ReplayRecord::noseWhl: return record.noseWhl;
+		default: return 0;
+		}
+	}
+
+	int GetLight(ReplayRecord::Light light, int pos) const {
+		const FTDISFileStruct& record = records[pos];
+		switch (light) {
+		case ReplayRecord::navL: return record.navL;
+		case ReplayRecord::logoL: return record.logoL;
+		case ReplayRecord::beacL: return record.beacL;
+		case ReplayRecord::strbL: return record.strbL;
+		case ReplayRecord::taxiL: return record.taxiL;
+		case ReplayRecord::wngL: return record.wngL;
+		case ReplayRecord::lndgL: return record.lndgL;
+		}
+		return 0;
+	}
+
+	FTDISFileStruct GetSoundRecord(int pos) const { return records[pos]; }
+};
+#endif
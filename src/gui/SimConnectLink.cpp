@@ -0,0 +1,107 @@
+#include "SimConnectLink.h"
+
+/**
+* Constructor / Destructor
+*/
+SimConnectLink::SimConnectLink() {
+
+}
+
+SimConnectLink::~SimConnectLink() {
+	this->Close();
+}
+
+
+/**
+* Opens the connection to the sim. SimConnect signals the event of the message source on new messages
+*/
+bool SimConnectLink::Open(const char* name, DispatchProc dispatchProc, void* context) {
+	if (FAILED(SimConnect_Open(&hSimConnect, name, NULL, 0, messageSource.GetEventHandle(), 0))) {
+		hSimConnect = NULL;
+		return false;
+	}
+
+	messageSource.Attach(hSimConnect, dispatchProc, context);
+	return true;
+}
+
+
+/**
+* Closes the connection to the sim
+*/
+HRESULT SimConnectLink::Close() {
+	if (!hSimConnect)
+		return S_OK;
+
+	HRESULT hr = SimConnect_Close(hSimConnect);
+	messageSource.Detach();
+	hSimConnect = NULL;
+	return hr;
+}
+
+
+/**
+* Returns the message source delivering the responses of the sim
+*/
+SimMessageSource* SimConnectLink::GetMessageSource() {
+	return &this->messageSource;
+}
+
+
+/**
+* SimConnect API
+*/
+HRESULT SimConnectLink::AddToDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId, const char* datumName, const char* unitsName, SIMCONNECT_DATATYPE datumType, float epsilon, DWORD datumId) {
+	callCount++;
+	return SimConnect_AddToDataDefinition(hSimConnect, defineId, datumName, unitsName, datumType, epsilon, datumId);
+}
+
+HRESULT SimConnectLink::ClearDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId) {
+	callCount++;
+	return SimConnect_ClearDataDefinition(hSimConnect, defineId);
+}
+
+HRESULT SimConnectLink::RequestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID requestId, SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags, DWORD origin, DWORD interval, DWORD limit) {
+	callCount++;
+	return SimConnect_RequestDataOnSimObject(hSimConnect, requestId, defineId, objectId, period, flags, origin, interval, limit);
+}
+
+HRESULT SimConnectLink::SetDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_SET_FLAG flags, DWORD arrayCount, DWORD unitSize, void* dataSet) {
+	callCount++;
+	return SimConnect_SetDataOnSimObject(hSimConnect, defineId, objectId, flags, arrayCount, unitSize, dataSet);
+}
+
+HRESULT SimConnectLink::SubscribeToSystemEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* systemEventName) {
+	callCount++;
+	return SimConnect_SubscribeToSystemEvent(hSimConnect, eventId, systemEventName);
+}
+
+HRESULT SimConnectLink::MapClientEventToSimEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* eventName) {
+	callCount++;
+	return SimConnect_MapClientEventToSimEvent(hSimConnect, eventId, eventName);
+}
+
+HRESULT SimConnectLink::TransmitClientEvent(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data, SIMCONNECT_NOTIFICATION_GROUP_ID groupId, SIMCONNECT_EVENT_FLAG flags) {
+	callCount++;
+	return SimConnect_TransmitClientEvent(hSimConnect, objectId, eventId, data, groupId, flags);
+}
+
+HRESULT SimConnectLink::AICreateNonATCAircraft(const char* containerTitle, const char* tailNumber, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	callCount++;
+	return SimConnect_AICreateNonATCAircraft(hSimConnect, containerTitle, tailNumber, initPos, requestId);
+}
+
+HRESULT SimConnectLink::AICreateSimulatedObject(const char* containerTitle, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	callCount++;
+	return SimConnect_AICreateSimulatedObject(hSimConnect, containerTitle, initPos, requestId);
+}
+
+HRESULT SimConnectLink::AIReleaseControl(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	callCount++;
+	return SimConnect_AIReleaseControl(hSimConnect, objectId, requestId);
+}
+
+HRESULT SimConnectLink::AIRemoveObject(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId) {
+	callCount++;
+	return SimConnect_AIRemoveObject(hSimConnect, objectId, requestId);
+}
@@ -0,0 +1,46 @@
+#ifndef SimConnectLink_H
+#define SimConnectLink_H
+#define _WINSOCKAPI_ 
+
+#include <windows.h>
+#include "SimConnect.h"
+#include "ISimLink.h"
+#include "SimConnectMessageSource.h"
+
+/**
+* SimConnect link
+*
+* Forwards all calls to the SimConnect API of the sim. The connection signals the event of its
+* message source on new messages, i.e. the processor loop waits instead of polling
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class SimConnectLink : public ISimLink
+{
+
+public:
+	SimConnectLink();
+	~SimConnectLink();
+
+private:
+	HANDLE hSimConnect = NULL;
+	SimConnectMessageSource messageSource;
+
+public:
+	bool Open(const char* name, DispatchProc dispatchProc, void* context);
+	HRESULT Close();
+	SimMessageSource* GetMessageSource();
+
+	HRESULT AddToDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId, const char* datumName, const char* unitsName, SIMCONNECT_DATATYPE datumType = SIMCONNECT_DATATYPE_FLOAT64, float epsilon = 0, DWORD datumId = SIMCONNECT_UNUSED);
+	HRESULT ClearDataDefinition(SIMCONNECT_DATA_DEFINITION_ID defineId);
+	HRESULT RequestDataOnSimObject(SIMCONNECT_DATA_REQUEST_ID requestId, SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_PERIOD period, SIMCONNECT_DATA_REQUEST_FLAG flags = 0, DWORD origin = 0, DWORD interval = 0, DWORD limit = 0);
+	HRESULT SetDataOnSimObject(SIMCONNECT_DATA_DEFINITION_ID defineId, SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_SET_FLAG flags, DWORD arrayCount, DWORD unitSize, void* dataSet);
+	HRESULT SubscribeToSystemEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* systemEventName);
+	HRESULT MapClientEventToSimEvent(SIMCONNECT_CLIENT_EVENT_ID eventId, const char* eventName = "");
+	HRESULT TransmitClientEvent(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data, SIMCONNECT_NOTIFICATION_GROUP_ID groupId, SIMCONNECT_EVENT_FLAG flags);
+	HRESULT AICreateNonATCAircraft(const char* containerTitle, const char* tailNumber, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AICreateSimulatedObject(const char* containerTitle, SIMCONNECT_DATA_INITPOSITION initPos, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AIReleaseControl(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId);
+	HRESULT AIRemoveObject(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_DATA_REQUEST_ID requestId);
+};
+#endif
@@ -0,0 +1,71 @@
+#include "SimConnectMessageSource.h"
+
+/**
+* Constructor / Destructor
+*/
+SimConnectMessageSource::SimConnectMessageSource() {
+	// Auto-reset event, i.e. reset as soon as a waiting thread is released
+	hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+}
+
+SimConnectMessageSource::~SimConnectMessageSource() {
+	if (hEvent)
+		CloseHandle(hEvent);
+}
+
+
+/**
+* Returns the event handle to be passed to SimConnect_Open
+*/
+HANDLE SimConnectMessageSource::GetEventHandle() {
+	return this->hEvent;
+}
+
+
+/**
+* Attaches the source to an open SimConnect connection
+*/
+void SimConnectMessageSource::Attach(HANDLE hSimConnect, DispatchProc dispatchProc, void* context) {
+	this->hSimConnect = hSimConnect;
+	this->dispatchProc = dispatchProc;
+	this->context = context;
+}
+
+
+/**
+* Detaches the source from the SimConnect connection
+*/
+void SimConnectMessageSource::Detach() {
+	this->hSimConnect = NULL;
+}
+
+
+/**
+* Blocks until SimConnect signals a message, the source is woken up or the timeout expires
+*/
+bool SimConnectMessageSource::WaitForMessages(uint32_t timeoutMs) {
+	// No event handle: fall back to polling
+	if (!hEvent) {
+		Sleep(timeoutMs > 0 ? 1 : 0);
+		return true;
+	}
+	return WaitForSingleObject(hEvent, timeoutMs) == WAIT_OBJECT_0;
+}
+
+
+/**
+* Handles all pending SimConnect messages
+*/
+void SimConnectMessageSource::DispatchMessages() {
+	if (hSimConnect && dispatchProc)
+		SimConnect_CallDispatch(hSimConnect, dispatchProc, context);
+}
+
+
+/**
+* Interrupts a pending WaitForMessages call
+*/
+void SimConnectMessageSource::Wake() {
+	if (hEvent)
+		SetEvent(hEvent);
+}
@@ -0,0 +1,56 @@
+#ifndef SimConnectMessageSource_H
+#define SimConnectMessageSource_H
+#define _WINSOCKAPI_ 
+
+#include <windows.h>
+#include "SimConnect.h"
+#include "SimMessageSource.h"
+
+/**
+* SimConnect message source
+*
+* Waits on the Win32 event SimConnect signals whenever a message arrives, i.e. the processor
+* thread doesn't consume any CPU while the sim is idle and wakes up without timer granularity.
+* The event handle has to be passed to SimConnect_Open
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class SimConnectMessageSource : public SimMessageSource
+{
+
+public:
+	SimConnectMessageSource();
+	~SimConnectMessageSource();
+
+private:
+	HANDLE hEvent = NULL;
+	HANDLE hSimConnect = NULL;
+	DispatchProc dispatchProc = nullptr;
+	void* context = nullptr;
+
+public:
+	/**
+	* Returns the event handle to be passed to SimConnect_Open
+	*/
+	HANDLE GetEventHandle();
+
+	/**
+	* Attaches the source to an open SimConnect connection
+	*
+	* @param	hSimConnect		SimConnect handle
+	* @param	dispatchProc	Callback handling the messages
+	* @param	context			Context passed to the callback
+	* @return	void
+	*/
+	void Attach(HANDLE hSimConnect, DispatchProc dispatchProc, void* context);
+
+	/**
+	* Detaches the source from the SimConnect connection, e.g. after the connection has been closed
+	*/
+	void Detach();
+
+	bool WaitForMessages(uint32_t timeoutMs);
+	void DispatchMessages();
+	void Wake();
+};
+#endif
@@ -0,0 +1,146 @@
+#include "SimDataBatch.h"
+#include "ISimLink.h"
+#include <cmath>
+#include <cstring>
+
+/**
+* Constructor / Destructor
+*/
+SimDataBatch::SimDataBatch(ISimLink* link, SIMCONNECT_DATA_DEFINITION_ID defineId, Stats* stats) {
+	this->simLink = link;
+	this->defineId = defineId;
+	this->stats = stats;
+}
+
+SimDataBatch::~SimDataBatch() {
+
+}
+
+
+/**
+* Returns the field of a datum ID
+*/
+SimDataBatch::Field* SimDataBatch::Find(DWORD datumId) {
+	for (Field& field : fields)
+		if (field.datumId == datumId)
+			return &field;
+	return nullptr;
+}
+
+
+/**
+* Adds a sim variable to the composite data definition
+*/
+HRESULT SimDataBatch::AddField(DWORD datumId, const char* datumName, const char* unitsName, double epsilon) {
+	if (this->Find(datumId))
+		return E_FAIL;
+
+	HRESULT hr = simLink->AddToDataDefinition(defineId, datumName, unitsName, SIMCONNECT_DATATYPE_FLOAT64, 0, datumId);
+	if (SUCCEEDED(hr))
+		fields.push_back({ datumId, epsilon, 0.0, 0.0, false, false });
+	return hr;
+}
+
+
+/**
+* Sets the value of a field for the next flush
+*/
+void SimDataBatch::Set(DWORD datumId, double value) {
+	Field* field = this->Find(datumId);
+	if (!field)
+		return;
+
+	if (stats)
+		stats->fieldWrites++;
+
+	// Drop values within the epsilon of the value in the sim, incl. a change earlier in the frame
+	if (field->sent && std::fabs(value - field->sentValue) <= field->epsilon) {
+		if (field->dirty) {
+			field->dirty = false;
+			dirtyCount--;
+		}
+		if (stats)
+			stats->suppressedWrites++;
+		return;
+	}
+
+	if (!field->dirty) {
+		field->dirty = true;
+		dirtyCount++;
+	}
+	field->value = value;
+}
+
+
+/**
+* Transmits an absolute client event, unless the event data equals the data last transmitted
+*/
+HRESULT SimDataBatch::Transmit(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data) {
+	if (stats)
+		stats->eventWrites++;
+
+	Event* sentEvent = nullptr;
+	for (Event& event : events) {
+		if (event.eventId == eventId) {
+			sentEvent = &event;
+			break;
+		}
+	}
+
+	if (sentEvent && sentEvent->data == data) {
+		if (stats)
+			stats->suppressedEvents++;
+		return S_FALSE;
+	}
+
+	HRESULT hr = simLink->TransmitClientEvent(objectId, eventId, data, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+	if (SUCCEEDED(hr)) {
+		if (sentEvent)
+			sentEvent->data = data;
+		else
+			events.push_back({ eventId, data });
+	}
+	return hr;
+}
+
+
+/**
+* Writes the changed fields of the frame to the sim object
+*/
+HRESULT SimDataBatch::Flush(SIMCONNECT_OBJECT_ID objectId) {
+	if (stats)
+		stats->frames++;
+
+	if (dirtyCount == 0)
+		return S_FALSE;
+
+	// Tagged format, i.e. datum ID followed by the value, for the changed fields only
+	buffer.resize(dirtyCount * (sizeof(DWORD) + sizeof(double)));
+	size_t pos = 0;
+	for (Field& field : fields) {
+		if (!field.dirty)
+			continue;
+
+		memcpy(&buffer[pos], &field.datumId, sizeof(DWORD));
+		memcpy(&buffer[pos + sizeof(DWORD)], &field.value, sizeof(double));
+		pos += sizeof(DWORD) + sizeof(double);
+	}
+
+	HRESULT hr = simLink->SetDataOnSimObject(defineId, objectId, SIMCONNECT_DATA_SET_FLAG_TAGGED, 0, (DWORD)buffer.size(), buffer.data());
+	if (stats)
+		stats->setDataCalls++;
+
+	// Fields stay dirty if the write failed, i.e. they are written with the next flush
+	if (SUCCEEDED(hr)) {
+		for (Field& field : fields) {
+			if (!field.dirty)
+				continue;
+
+			field.sentValue = field.value;
+			field.sent = true;
+			field.dirty = false;
+		}
+		dirtyCount = 0;
+	}
+	return hr;
+}
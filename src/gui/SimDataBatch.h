@@ -0,0 +1,124 @@
+#ifndef SimDataBatch_H
+#define SimDataBatch_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <vector>
+#include "SimConnect.h"
+
+// Forward declarations to avoid circular include.
+class ISimLink; // #include "ISimLink.h" in .cpp file
+
+/**
+* Command buffer of the system data writes to a sim object
+*
+* Collects the values the sim model sets during a frame (throttle, flight controls, fuel, lights, etc.)
+* in one composite data definition and writes the changed fields with a single SetDataOnSimObject call
+* in tagged format when the frame is flushed. Each field is identified by its datum ID and has an epsilon,
+* values within the epsilon of the value last written to the sim are dropped. Absolute client events
+* (e.g. AILERON_SET) are transmitted right away, unless the event data hasn't changed
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class SimDataBatch {
+
+public:
+	/**
+	* Write counters, shared by the batches of all sim objects
+	*/
+	struct Stats {
+		uint64_t fieldWrites = 0;		// Fields set by the sim models
+		uint64_t suppressedWrites = 0;	// Fields dropped, i.e. unchanged within the epsilon
+		uint64_t setDataCalls = 0;		// SetDataOnSimObject calls of the flushes
+		uint64_t eventWrites = 0;		// Absolute client events requested by the sim models
+		uint64_t suppressedEvents = 0;	// Client events dropped, i.e. unchanged event data
+		uint64_t frames = 0;			// Frames flushed
+
+		/**
+		* Returns the number of SimConnect calls saved, compared to one call per field and event
+		*/
+		uint64_t GetCallsSaved() const {
+			return fieldWrites - setDataCalls + suppressedEvents;
+		}
+	};
+
+	/**
+	* Constructor
+	*
+	* @param	link		Link to the sim
+	* @param	defineId	ID of the composite data definition
+	* @param	stats		Write counters (optional)
+	*/
+	SimDataBatch(ISimLink* link, SIMCONNECT_DATA_DEFINITION_ID defineId, Stats* stats = nullptr);
+	~SimDataBatch();
+
+private:
+	struct Field {
+		DWORD datumId;
+		double epsilon;
+		double value;
+		double sentValue;
+		bool dirty;
+		bool sent;
+	};
+
+	struct Event {
+		SIMCONNECT_CLIENT_EVENT_ID eventId;
+		DWORD data;
+	};
+
+	ISimLink* simLink = nullptr;
+	SIMCONNECT_DATA_DEFINITION_ID defineId = 0;
+	Stats* stats = nullptr;
+	std::vector<Field> fields;
+	std::vector<Event> events;
+	std::vector<BYTE> buffer;
+	size_t dirtyCount = 0;
+
+	/**
+	* Returns the field of a datum ID, nullptr if the field hasn't been added
+	*/
+	Field* Find(DWORD datumId);
+
+public:
+	/**
+	* Adds a sim variable to the composite data definition
+	*
+	* @param	datumId		Datum ID of the field, e.g. Processor::THROTTLE_1
+	* @param	datumName	Name of the sim variable
+	* @param	unitsName	Units of the sim variable
+	* @param	epsilon		Changes up to the epsilon aren't written to the sim
+	* @return	HRESULT
+	*/
+	HRESULT AddField(DWORD datumId, const char* datumName, const char* unitsName, double epsilon = 0);
+
+	/**
+	* Sets the value of a field for the next flush. The last value set per frame is written
+	*
+	* @param	datumId		Datum ID of the field
+	* @param	value		Value
+	* @return	void
+	*/
+	void Set(DWORD datumId, double value);
+
+	/**
+	* Transmits an absolute client event, i.e. an event setting a state, unless the event
+	* data equals the data last transmitted
+	*
+	* @param	objectId	SimConnect object ID
+	* @param	eventId		Client event ID
+	* @param	data		Event data
+	* @return	HRESULT		S_FALSE if suppressed
+	*/
+	HRESULT Transmit(SIMCONNECT_OBJECT_ID objectId, SIMCONNECT_CLIENT_EVENT_ID eventId, DWORD data);
+
+	/**
+	* Writes the changed fields of the frame to the sim object with one SetDataOnSimObject call
+	*
+	* @param	objectId	SimConnect object ID
+	* @return	HRESULT		S_FALSE if there was nothing to write
+	*/
+	HRESULT Flush(SIMCONNECT_OBJECT_ID objectId);
+};
+#endif
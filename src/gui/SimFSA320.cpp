@@ -23,11 +23,12 @@ class SimFSA320 : public SimModelBehavior
 {
 private:
 	Processor* cpu = nullptr;
+	SimDataBatch* sysWrites = nullptr;
 	FDRFile* fdrFile = nullptr;
 	FTDISFile* ftdisFile = nullptr;
 
 	bool revEngaged = false, splrEngaged = false, splrArmed = false, navL = false, beaconL = false, strobeL = false, landingL = false, taxiL = false,
-		wingL = false, gear = true, lockPosition = false;
+		wingL = false, gear = true, lockPosition = false, requestSlot = false;
 
 	int startAPUProcStep, startEngineProcStep, gearStat, signNoSmk, signSeat, signAtt, trackModelFct, simObjectId = -1, simRequestId = 0;
 
@@ -65,15 +66,10 @@ public:
 	}
 
 	~SimFSA320() {
-		// Unlock position and attitudes
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-
-		lockPosition = false;
-
-		// Delete AI model
+		// Hand the AI object back to the pool, i.e. position and attitudes stay locked while it idles
 		this->PerformRemoveAiSimObject();
+
+		delete sysWrites;
 	}
 
 
@@ -110,122 +106,124 @@ public:
 		this->acEngineMax = 95.0F;
 
 		// Define dedicated SimConnect request ID for this simObject
-		this->simRequestId = cpu->reqIndex;
-		cpu->reqIndex++;
+		this->simRequestId = cpu->AddRequestSlot();
+		this->requestSlot = true;
 
 		// Map client events
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, "FREEZE_LATITUDE_LONGITUDE_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, "FREEZE_ALTITUDE_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, "FREEZE_ATTITUDE_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, "FREEZE_LATITUDE_LONGITUDE_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, "FREEZE_ALTITUDE_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, "FREEZE_ATTITUDE_SET");
 
 		// Assign flight postion and attitude vars to data definitions
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LATITUDE", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LONGITUDE", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE ALTITUDE", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE HEADING DEGREES TRUE", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE PITCH DEGREES", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE BANK DEGREES", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "AIRSPEED INDICATED", "knot");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LATITUDE", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LONGITUDE", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE ALTITUDE", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE HEADING DEGREES TRUE", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE PITCH DEGREES", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE BANK DEGREES", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "AIRSPEED INDICATED", "knot");
 
 		// Assign simulation vars to data definitions
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:3", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:4", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:1", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:2", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:3", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:4", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "AILERON POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ELEVATOR POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "RUDDER POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FLAPS HANDLE INDEX", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT NAV", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LOGO", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT BEACON", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT STROBE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT TAXI", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT WING", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LANDING", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:3", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:4", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:1", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:2", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:3", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:4", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "AILERON POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ELEVATOR POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "RUDDER POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FLAPS HANDLE INDEX", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR HANDLE POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT NAV", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LOGO", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT BEACON", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT STROBE", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT TAXI", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT WING", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LANDING", "number");
 
 		// Assign simulation vars to data definitions
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Z", "knot");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Y", "m/s");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "LEADING EDGE FLAPS RIGHT PERCENT", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "TRAILING EDGE FLAPS RIGHT PERCENT", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "ZULU TIME", "seconds");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "GROUND ALTITUDE", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "PLANE ALT ABOVE GROUND MINUS CG", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC CG TO GROUND", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC PITCH", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:1", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:0", "degree");
-
-		// System Controls: Assign system vars and map client events
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->THROTTLE_1 + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->THROTTLE_2 + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ENG1_N1 + this->simRequestId, "ENG N1 RPM:1", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ENG2_N1 + this->simRequestId, "ENG N1 RPM:2", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ALR + this->simRequestId, "AILERON POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ELEV + this->simRequestId, "ELEVATOR POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->RUDDER + this->simRequestId, "RUDDER POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FLAPS + this->simRequestId, "FLAPS HANDLE INDEX", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->GEAR_POS + this->simRequestId, "GEAR HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->GEAR_ANGLE + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FUEL_CTR + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FUEL_LEFT + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FUEL_RIGHT + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->MASTER_BATTERY + this->simRequestId, "ELECTRICAL MASTER BATTERY", "Bool");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_AILERON_SET + this->simRequestId, "AILERON_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FLAPS_SET + this->simRequestId, "FLAPS_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, "SPOILERS_ARM_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_SPOILERS_SET + this->simRequestId, "SPOILERS_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, "GEAR_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, "TOGGLE_MASTER_BATTERY");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Z", "knot");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Y", "m/s");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "LEADING EDGE FLAPS RIGHT PERCENT", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "TRAILING EDGE FLAPS RIGHT PERCENT", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "ZULU TIME", "seconds");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "GROUND ALTITUDE", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "PLANE ALT ABOVE GROUND MINUS CG", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC CG TO GROUND", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC PITCH", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:1", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:0", "degree");
+
+		// System Controls: Assign system vars (composite data definition, written once per frame) and map client events
+		delete this->sysWrites;
+		this->sysWrites = new SimDataBatch(cpu->simLink, (UINT)cpu->SYS_WRITE_SET + this->simRequestId, &cpu->writeStats);
+		cpu->hr = this->sysWrites->AddField(cpu->THROTTLE_1, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent", 0.01);
+		cpu->hr = this->sysWrites->AddField(cpu->THROTTLE_2, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent", 0.01);
+		cpu->hr = this->sysWrites->AddField(cpu->ENG1_N1, "ENG N1 RPM:1", "number", 0.01);
+		cpu->hr = this->sysWrites->AddField(cpu->ENG2_N1, "ENG N1 RPM:2", "number", 0.01);
+		cpu->hr = this->sysWrites->AddField(cpu->ALR, "AILERON POSITION", "position", 0.0001);
+		cpu->hr = this->sysWrites->AddField(cpu->ELEV, "ELEVATOR POSITION", "position", 0.0001);
+		cpu->hr = this->sysWrites->AddField(cpu->RUDDER, "RUDDER POSITION", "position", 0.0001);
+		cpu->hr = this->sysWrites->AddField(cpu->FLAPS, "FLAPS HANDLE INDEX", "number", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->SPOILER, "SPOILERS HANDLE POSITION", "position", 0.001);
+		cpu->hr = this->sysWrites->AddField(cpu->GEAR_POS, "GEAR HANDLE POSITION", "position", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->GEAR_ANGLE, "GEAR CENTER STEER ANGLE", "number", 0.01);
+		cpu->hr = this->sysWrites->AddField(cpu->FUEL_CTR, "FUEL TANK CENTER QUANTITY", "gallons", 0.1);
+		cpu->hr = this->sysWrites->AddField(cpu->FUEL_LEFT, "FUEL TANK LEFT MAIN QUANTITY", "gallons", 0.1);
+		cpu->hr = this->sysWrites->AddField(cpu->FUEL_RIGHT, "FUEL TANK RIGHT MAIN QUANTITY", "gallons", 0.1);
+		cpu->hr = this->sysWrites->AddField(cpu->MASTER_BATTERY, "ELECTRICAL MASTER BATTERY", "Bool", 0);
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_AILERON_SET + this->simRequestId, "AILERON_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FLAPS_SET + this->simRequestId, "FLAPS_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, "SPOILERS_ARM_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_SPOILERS_SET + this->simRequestId, "SPOILERS_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_GEAR_SET + this->simRequestId, "GEAR_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, "TOGGLE_MASTER_BATTERY");
 
 		// Light Controls: Assign light vars and map client events
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_NAV_LIGHTS + this->simRequestId, "TOGGLE_NAV_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_LOGO_LIGHTS + this->simRequestId, "TOGGLE_LOGO_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_BEACON_LIGHTS + this->simRequestId, "TOGGLE_BEACON_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_STROBES_SET + this->simRequestId, "STROBES_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_TAXI_LIGHTS + this->simRequestId, "TOGGLE_TAXI_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_WING_LIGHTS + this->simRequestId, "TOGGLE_WING_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, "LANDING_LIGHTS_SET");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->NAV_LIGHT + this->simRequestId, "LIGHT NAV", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->LOGO_LIGHT + this->simRequestId, "LIGHT LOGO", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->BEACON_LIGHT + this->simRequestId, "LIGHT BEACON", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->STROBE_LIGHT + this->simRequestId, "LIGHT STROBE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->TAXI_LIGHT + this->simRequestId, "LIGHT TAXI", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->WING_LIGHT + this->simRequestId, "LIGHT WING", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->LNDG_LIGHT + this->simRequestId, "LIGHT LANDING", "number");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_NAV_LIGHTS + this->simRequestId, "TOGGLE_NAV_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_LOGO_LIGHTS + this->simRequestId, "TOGGLE_LOGO_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_BEACON_LIGHTS + this->simRequestId, "TOGGLE_BEACON_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_STROBES_SET + this->simRequestId, "STROBES_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_TAXI_LIGHTS + this->simRequestId, "TOGGLE_TAXI_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_WING_LIGHTS + this->simRequestId, "TOGGLE_WING_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, "LANDING_LIGHTS_SET");
+		cpu->hr = this->sysWrites->AddField(cpu->NAV_LIGHT, "LIGHT NAV", "number", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->LOGO_LIGHT, "LIGHT LOGO", "number", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->BEACON_LIGHT, "LIGHT BEACON", "number", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->STROBE_LIGHT, "LIGHT STROBE", "number", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->TAXI_LIGHT, "LIGHT TAXI", "number", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->WING_LIGHT, "LIGHT WING", "number", 0);
+		cpu->hr = this->sysWrites->AddField(cpu->LNDG_LIGHT, "LIGHT LANDING", "number", 0);
 
 		// Engine Controls: Map client events to sim events
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_STARTER1 + this->simRequestId, "TOGGLE_STARTER1");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_STARTER2 + this->simRequestId, "TOGGLE_STARTER2");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_ENGINE_AUTO_START + this->simRequestId, "ENGINE_AUTO_START");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_ENGINE_AUTO_SHUTDOWN + this->simRequestId, "ENGINE_AUTO_SHUTDOWN");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_APU_STARTER + this->simRequestId, "APU_STARTER");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, "APU_GENERATOR_SWITCH_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, "BLEED_AIR_SOURCE_CONTROL_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_STARTER1 + this->simRequestId, "TOGGLE_STARTER1");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_STARTER2 + this->simRequestId, "TOGGLE_STARTER2");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_ENGINE_AUTO_START + this->simRequestId, "ENGINE_AUTO_START");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_ENGINE_AUTO_SHUTDOWN + this->simRequestId, "ENGINE_AUTO_SHUTDOWN");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_APU_STARTER + this->simRequestId, "APU_STARTER");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, "APU_GENERATOR_SWITCH_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, "BLEED_AIR_SOURCE_CONTROL_SET");
 			
 		// Add object specific data requests to SimConnect Dispatch
-		cpu->hr = SimConnect_RequestDataOnSimObject(cpu->hSimConnect, (UINT)cpu->REQ_POS_DATA + this->simRequestId, (UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
-		cpu->hr = SimConnect_RequestDataOnSimObject(cpu->hSimConnect, (UINT)cpu->REQ_SYS_DATA + this->simRequestId, (UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
-		cpu->hr = SimConnect_RequestDataOnSimObject(cpu->hSimConnect, (UINT)cpu->REQ_SIM_DATA + this->simRequestId, (UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
+		cpu->hr = cpu->simLink->RequestDataOnSimObject((UINT)cpu->REQ_POS_DATA + this->simRequestId, (UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
+		cpu->hr = cpu->simLink->RequestDataOnSimObject((UINT)cpu->REQ_SYS_DATA + this->simRequestId, (UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
+		cpu->hr = cpu->simLink->RequestDataOnSimObject((UINT)cpu->REQ_SIM_DATA + this->simRequestId, (UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
 
 		//Initialize object for positioning 
 		if (!this->lockPosition) {
 			// Lock position and attitudes
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 
 			this->lockPosition = true;
 		}
@@ -246,18 +244,18 @@ public:
 		if (track->GetFileType() == Track::FileType::FDR) {
 			fdrFile = track->GetFDRFile();
 
-			initPos.Altitude = fdrFile->fileData.front().alt;
-			initPos.Latitude = fdrFile->fileData.front().lat;
-			initPos.Longitude = fdrFile->fileData.front().lon;
-			initPos.Heading = fdrFile->fileData.front().hdg;
+			initPos.Altitude = fdrFile->GetRecords().front().alt;
+			initPos.Latitude = fdrFile->GetRecords().front().lat;
+			initPos.Longitude = fdrFile->GetRecords().front().lon;
+			initPos.Heading = fdrFile->GetRecords().front().hdg;
 		}
 		else if (track->GetFileType() == Track::FileType::FTDIS) {
 			ftdisFile = track->GetFTDISFile();
 
-			initPos.Altitude = ftdisFile->fileData.front().alt;
-			initPos.Latitude = ftdisFile->fileData.front().lat;
-			initPos.Longitude = ftdisFile->fileData.front().lon;
-			initPos.Heading = ftdisFile->fileData.front().hdg;
+			initPos.Altitude = ftdisFile->GetRecords().front().alt;
+			initPos.Latitude = ftdisFile->GetRecords().front().lat;
+			initPos.Longitude = ftdisFile->GetRecords().front().lon;
+			initPos.Heading = ftdisFile->GetRecords().front().hdg;
 		}
 
 		// Default position and attitude vars
@@ -266,19 +264,28 @@ public:
 		initPos.OnGround = 1;
 		initPos.Airspeed = 1;
 
-		// Request new AI object at initial position
-		cpu->hr = SimConnect_AICreateNonATCAircraft(cpu->hSimConnect, track->GetSimCfgUuid().c_str(), "AI999", initPos, (UINT)cpu->REQ_AI_AC + this->simRequestId);
+		// Request AI object at initial position, created or taken from the pool
+		cpu->hr = cpu->RequestAiObject(track, initPos);
 	}
 
 
 	/**
-	* Removes Ai object from sim
+	* Releases Ai object to the pool, i.e. the object is reused or removed from sim
 	*
 	* @param	void
 	* @return   void
 	*/
 	void PerformRemoveAiSimObject() {
-		cpu->hr = SimConnect_AIRemoveObject(cpu->hSimConnect, this->simObjectId, this->simRequestId);
+		// Hand the AI object back to the pool, i.e. it is reused or removed
+		cpu->hr = cpu->ReleaseAiObject(this->simObjectId, this->simRequestId);
+		if (SUCCEEDED(cpu->hr))
+			this->simObjectId = -1;
+
+		// Release the request slot, i.e. it is reused by the next sim object (the track gets a new slot, if activated again)
+		if (this->requestSlot) {
+			cpu->RemoveRequestSlot(this->simRequestId);
+			this->requestSlot = false;
+		}
 	}
 
 
@@ -346,7 +353,7 @@ public:
 	*/
 	void PerformSetPosition(PosDataSet posDataSet, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(posDataSet), &posDataSet);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(posDataSet), &posDataSet);
 	}
 
 
@@ -359,7 +366,7 @@ public:
 	*/
 	void PerformSetSysData(SysDataSet sysDataSet, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(sysDataSet), &sysDataSet);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(sysDataSet), &sysDataSet);
 	}
 
 
@@ -372,7 +379,19 @@ public:
 	*/
 	void PerformSetSimData(SimDataSet simDataSet, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(simDataSet), &simDataSet);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(simDataSet), &simDataSet);
+	}
+
+
+	/**
+	* Writes the system vars set during the frame to the sim (see SimDataBatch)
+	*
+	* @param	void
+	* @return   void
+	*/
+	void PerformFlushSysData() {
+		if (this->simObjectId != -1 && this->sysWrites)
+			cpu->hr = this->sysWrites->Flush(this->simObjectId);
 	}
 
 
@@ -390,9 +409,9 @@ public:
 			fuel[1] = fuelStartL - ((1 - (flightTime - timeStmp) / flightTime) * (fuelStartL - fuelEndL));
 			fuel[2] = fuelStartR - ((1 - (flightTime - timeStmp) / flightTime) * (fuelStartR - fuelEndR));
 
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->FUEL_CTR + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[0]), &fuel[0]);
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->FUEL_LEFT + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[1]), &fuel[1]);
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->FUEL_RIGHT + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[2]), &fuel[2]);
+			this->sysWrites->Set(cpu->FUEL_CTR, fuel[0]);
+			this->sysWrites->Set(cpu->FUEL_LEFT, fuel[1]);
+			this->sysWrites->Set(cpu->FUEL_RIGHT, fuel[2]);
 		}
 	}
 
@@ -412,20 +431,20 @@ public:
 		if (this->simObjectId != -1 && this->lockPosition) {
 			// Start APU
 			if (startAPUProcStep == 0) {
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_APU_STARTER + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_APU_STARTER + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 				startAPUTime = timeStmp;
 				startAPUProcStep = 1;
 			}
 
 			// Wait for APU to start up and turn on generators and APU bleed
 			if (startAPUProcStep == 1 && (timeStmp - startAPUTime) > apuGenDelay) {
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 				startAPUProcStep = 3;
 			}
 
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->MASTER_BATTERY + this->simRequestId, simObjectId, 0, 0, sizeof(battery), &battery);
+			this->sysWrites->Set(cpu->MASTER_BATTERY, battery);
 		}
 	}
 
@@ -446,13 +465,13 @@ public:
 
 				// Engine no. 2: Start starter 2 to give engine 2 a head start for auto engine start (the best I can do at the moment)
 				if (startEngineProcStep == 0) {
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TOGGLE_STARTER2 + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TOGGLE_STARTER2 + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					startEngineProcStep = 1;
 				}
 
 				// Engine no. 1: Run auto engine start procedure
 				if (timeStmp >= startTime + (stepDelay * startEngineProcStep) + (enginePreStartDelay * 1) && startEngineProcStep == 1) {
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_ENGINE_AUTO_START + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_ENGINE_AUTO_START + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					startEngineProcStep = 2;
 				}
 			}
@@ -467,7 +486,70 @@ public:
 	* @return   void
 	*/
 	void PerformStopEngineProc(Track::FileType fileType) {
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_ENGINE_AUTO_SHUTDOWN + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+		cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_ENGINE_AUTO_SHUTDOWN + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+	}
+
+
+	/**
+	* Returns the procedural state of the sim model, e.g. the steps of the APU and engine start procedures
+	*
+	* @param	state		Procedural state (out)
+	* @return	bool		False, if the sim object hasn't been placed yet, i.e. the procedures haven't run
+	*/
+	bool PerformGetState(SimModelState& state) {
+		state = { startAPUProcStep, startAPUTime, startEngineProcStep, gearStat, revEngaged, splrEngaged, splrArmed };
+		return this->simObjectId != -1 && this->lockPosition;
+	}
+
+
+	/**
+	* Restores the procedural state of the sim model
+	*
+	* @param	state		Procedural state, e.g. of a keyframe
+	* @return	void
+	*/
+	void PerformSetState(const SimModelState& state) {
+		startAPUProcStep = state.startAPUProcStep;
+		startAPUTime = state.startAPUTime;
+		startEngineProcStep = state.startEngineProcStep;
+		gearStat = state.gearStat;
+		revEngaged = state.revEngaged;
+		splrEngaged = state.splrEngaged;
+		splrArmed = state.splrArmed;
+	}
+
+
+	/**
+	* Brings the systems of the sim object in line with the state restored
+	*
+	* @param	prevState	Procedural state in effect in the sim before the restore
+	* @return	void
+	*/
+	void PerformSyncState(const SimModelState& prevState) {
+		if (this->simObjectId != -1 && this->lockPosition) {
+			// APU started after the restored state: run the start procedure again, otherwise let it catch up
+			if (startAPUProcStep < prevState.startAPUProcStep) {
+				// Turn off generators, turned on again by the APU start procedure
+				if (prevState.startAPUProcStep == 3)
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				startAPUProcStep = 0;
+			}
+			else {
+				startAPUProcStep = prevState.startAPUProcStep;
+				startAPUTime = prevState.startAPUTime;
+			}
+
+			// Engines started after the restored state: shut down and run the start procedure again, otherwise let it catch up
+			if (startEngineProcStep < prevState.startEngineProcStep) {
+				this->PerformStopEngineProc(Track::FileType::FDR);
+				startEngineProcStep = 0;
+			}
+			else
+				startEngineProcStep = prevState.startEngineProcStep;
+
+			// Spoilers as per the restored state, i.e. values set during the dry run are overwritten
+			this->sysWrites->Set(cpu->SPOILER, splrEngaged ? 1.0 : 0.0);
+		}
 	}
 
 
@@ -502,11 +584,11 @@ public:
 		double throttle = throttleVal;
 
 		if (this->simObjectId != -1 && this->lockPosition) {
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->THROTTLE_1 + this->simRequestId, simObjectId, 0, 0, sizeof(throttle), &throttle);
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->THROTTLE_2 + this->simRequestId, simObjectId, 0, 0, sizeof(throttle), &throttle);
+			this->sysWrites->Set(cpu->THROTTLE_1, throttle);
+			this->sysWrites->Set(cpu->THROTTLE_2, throttle);
 
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->ENG1_N1 + this->simRequestId, simObjectId, 0, 0, sizeof(throttle), &throttle);
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->ENG2_N1 + this->simRequestId, simObjectId, 0, 0, sizeof(throttle), &throttle);
+			this->sysWrites->Set(cpu->ENG1_N1, throttle);
+			this->sysWrites->Set(cpu->ENG2_N1, throttle);
 		}
 	}
 
@@ -559,7 +641,7 @@ public:
 			if (fileType == Track::FileType::FTDIS)
 				ailerons *= fsAlrRng;
 
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_AILERON_SET + this->simRequestId, (DWORD)ailerons, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = this->sysWrites->Transmit(simObjectId, (UINT)cpu->KEY_AILERON_SET + this->simRequestId, (DWORD)ailerons);
 		}
 	}
 
@@ -573,7 +655,7 @@ public:
 	*/
 	void PerformSetElevator(double degrees, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->ELEV + this->simRequestId, simObjectId, 0, 0, sizeof(degrees), &degrees);
+			this->sysWrites->Set(cpu->ELEV, degrees);
 	}
 
 
@@ -598,7 +680,7 @@ public:
 	*/
 	void PerformSetRudder(double degrees, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->RUDDER + this->simRequestId, simObjectId, 0, 0, sizeof(degrees), &degrees);
+			this->sysWrites->Set(cpu->RUDDER, degrees);
 	}
 
 
@@ -638,11 +720,11 @@ public:
 					flapIndex = 0.0;
 				}
 
-				cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->FLAPS + this->simRequestId, simObjectId, 0, 0, sizeof(flapIndex), &flapIndex);
+				this->sysWrites->Set(cpu->FLAPS, flapIndex);
 			}
 			else if (fileType == Track::FileType::FDR) {
 				DWORD flapsDeg = stage * (fsFlpsRng/5);
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_FLAPS_SET + this->simRequestId, flapsDeg, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = this->sysWrites->Transmit(simObjectId, (UINT)cpu->KEY_FLAPS_SET + this->simRequestId, flapsDeg);
 
 			}
 		}
@@ -666,30 +748,30 @@ public:
 					// Disengage
 					if (splrEngaged) {
 						spoiler = 0.0;
-						cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
+						this->sysWrites->Set(cpu->SPOILER, spoiler);
 					}
 				}
 				else if ((int)spoilerSet == 2 && !splrEngaged) {
 					spoiler = 1.0;
 					// Ensure spoiler are disarmed
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					Sleep(1);
 					// Extend spoiler
-					cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
+					this->sysWrites->Set(cpu->SPOILER, spoiler);
 					//spoiler = 16383;
-					//hr = SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					//hr = simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					splrEngaged = true;
 					splrArmed = false;
 				}
 				else if ((int)spoilerSet == 0 && splrEngaged) {
 					spoiler = 0.0;
-					cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
-					//hr = SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					this->sysWrites->Set(cpu->SPOILER, spoiler);
+					//hr = simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					splrEngaged = false;
 				}
 			}
 			else if (fileType == Track::FileType::FDR)
-				cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoilerSet), &spoilerSet);
+				this->sysWrites->Set(cpu->SPOILER, spoilerSet);
 			
 		}
 	}
@@ -707,9 +789,9 @@ public:
 
 		if (this->simObjectId != -1 && this->lockPosition) {
 			if (gearPos == 1 && gearPos != simData.gearPos)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 			else if (gearPos == 0 && gearPos != simData.gearPos)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 
 		}
 	}
@@ -724,7 +806,7 @@ public:
 	*/
 	void PerformSetNoseWheel(double noseWheelDegrees, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->GEAR_ANGLE + this->simRequestId, simObjectId, 0, 0, sizeof(noseWheelDegrees), &noseWheelDegrees);
+			this->sysWrites->Set(cpu->GEAR_ANGLE, noseWheelDegrees);
 	}
 
 
@@ -756,7 +838,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 		
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->NAV_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			this->sysWrites->Set(cpu->NAV_LIGHT, state);
 		}
 	}
 
@@ -773,7 +855,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 							
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->LOGO_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);		
+			this->sysWrites->Set(cpu->LOGO_LIGHT, state);		
 		}
 	}
 
@@ -790,7 +872,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->BEACON_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			this->sysWrites->Set(cpu->BEACON_LIGHT, state);
 		}
 	}
 
@@ -807,7 +889,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->STROBE_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			this->sysWrites->Set(cpu->STROBE_LIGHT, state);
 		}
 	}
 
@@ -822,7 +904,7 @@ public:
 	void PerformSetTaxiLights(int lightSwitch, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition) {
 			double state = lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->TAXI_LIGHT + this->simRequestId, simObjectId, 0, 0, sizeof(state), &state);
+			this->sysWrites->Set(cpu->TAXI_LIGHT, state);
 		}
 	}
 
@@ -839,7 +921,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->WING_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			this->sysWrites->Set(cpu->WING_LIGHT, state);
 		}
 	}
 
@@ -856,9 +938,9 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			if (lightSwitch == 1 && lightSwitch != simData.lndgL)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 			else if (lightSwitch == 0 && lightSwitch != simData.lndgL)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 		}
 	}
 
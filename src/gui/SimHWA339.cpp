@@ -27,7 +27,7 @@ private:
 	FTDISFile *ftdisFile = nullptr;
 
 	bool revEngaged = false, splrEngaged = false, splrArmed = false, navL = false, beaconL = false, strobeL = false, landingL = false, taxiL = false,
-		wingL = false, gear = true, lockPosition = false, isAi = false;
+		wingL = false, gear = true, lockPosition = false, isAi = false, requestSlot = false;
 
 	int startAPUProcStep, startEngineProcStep, gearStat, signNoSmk, signSeat, signAtt, trackModelFct, simObjectId = -1, simRequestId = 0;
 
@@ -66,9 +66,9 @@ public:
 
 	~SimHWA339() {
 		// Unlock position and attitudes
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+		cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+		cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+		cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 
 		lockPosition = false;
 
@@ -110,122 +110,122 @@ public:
 		this->acEngineMax = 95.0F;
 
 		// Define dedicated SimConnect request ID for this simObject
-		this->simRequestId = cpu->reqIndex;
-		cpu->reqIndex++;
+		this->simRequestId = cpu->AddRequestSlot();
+		this->requestSlot = true;
 
 		// Map client events
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, "FREEZE_LATITUDE_LONGITUDE_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, "FREEZE_ALTITUDE_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, "FREEZE_ATTITUDE_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, "FREEZE_LATITUDE_LONGITUDE_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, "FREEZE_ALTITUDE_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, "FREEZE_ATTITUDE_SET");
 
 		// Assign flight position and attitude vars to data definitions
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LATITUDE", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LONGITUDE", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE ALTITUDE", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE HEADING DEGREES TRUE", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE PITCH DEGREES", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE BANK DEGREES", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, "AIRSPEED INDICATED", "knot");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LATITUDE", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE LONGITUDE", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE ALTITUDE", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE HEADING DEGREES TRUE", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE PITCH DEGREES", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "PLANE BANK DEGREES", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->POS_DATA_SET + this->simRequestId, "AIRSPEED INDICATED", "knot");
 
 		// Assign simulation vars to data definitions
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:3", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:4", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:1", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:2", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:3", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:4", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "AILERON POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "ELEVATOR POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "RUDDER POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FLAPS HANDLE INDEX", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT NAV", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LOGO", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT BEACON", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT STROBE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT TAXI", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT WING", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LANDING", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:1", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:2", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:3", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GENERAL ENG THROTTLE LEVER POSITION:4", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:1", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:2", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:3", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ENG N1 RPM:4", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "AILERON POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "ELEVATOR POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "RUDDER POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FLAPS HANDLE INDEX", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR HANDLE POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT NAV", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LOGO", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT BEACON", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT STROBE", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT TAXI", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT WING", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SYS_DATA_SET + this->simRequestId, "LIGHT LANDING", "number");
 
 		// Assign simulation vars to data definitions
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Z", "knot");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Y", "m/s");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "LEADING EDGE FLAPS RIGHT PERCENT", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "TRAILING EDGE FLAPS RIGHT PERCENT", "percent");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "ZULU TIME", "seconds");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "GROUND ALTITUDE", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "PLANE ALT ABOVE GROUND MINUS CG", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC CG TO GROUND", "meter");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC PITCH", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:1", "degree");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:0", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Z", "knot");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "VELOCITY BODY Y", "m/s");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "LEADING EDGE FLAPS RIGHT PERCENT", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "TRAILING EDGE FLAPS RIGHT PERCENT", "percent");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "ZULU TIME", "seconds");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "GROUND ALTITUDE", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "PLANE ALT ABOVE GROUND MINUS CG", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC CG TO GROUND", "meter");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "STATIC PITCH", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:1", "degree");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SIM_DATA_SET + this->simRequestId, "CAMERA GAMEPLAY PITCH YAW:0", "degree");
 
 		// System Controls: Assign system vars and map client events
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ENG1_N1 + this->simRequestId, "ENG N1 RPM:1", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ENG2_N1 + this->simRequestId, "ENG N1 RPM:2", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ALR + this->simRequestId, "AILERON POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->ELEV + this->simRequestId, "ELEVATOR POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->RUDDER + this->simRequestId, "RUDDER POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FLAPS + this->simRequestId, "A32NX_FLAPS_HANDLE_INDEX", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->GEAR_POS + this->simRequestId, "GEAR HANDLE POSITION", "position");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->GEAR_ANGLE + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FUEL_CTR + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FUEL_LEFT + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->FUEL_RIGHT + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->MASTER_BATTERY + this->simRequestId, "ELECTRICAL MASTER BATTERY", "Bool");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_AILERON_SET + this->simRequestId, "AILERON_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_FLAPS_SET + this->simRequestId, "FLAPS_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, "SPOILERS_ARM_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_SPOILERS_SET + this->simRequestId, "SPOILERS_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, "GEAR_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, "TOGGLE_MASTER_BATTERY");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->ENG1_N1 + this->simRequestId, "ENG N1 RPM:1", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->ENG2_N1 + this->simRequestId, "ENG N1 RPM:2", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->ALR + this->simRequestId, "AILERON POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->ELEV + this->simRequestId, "ELEVATOR POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->RUDDER + this->simRequestId, "RUDDER POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->FLAPS + this->simRequestId, "A32NX_FLAPS_HANDLE_INDEX", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->SPOILER + this->simRequestId, "SPOILERS HANDLE POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->GEAR_POS + this->simRequestId, "GEAR HANDLE POSITION", "position");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->GEAR_ANGLE + this->simRequestId, "GEAR CENTER STEER ANGLE", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->FUEL_CTR + this->simRequestId, "FUEL TANK CENTER QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->FUEL_LEFT + this->simRequestId, "FUEL TANK LEFT MAIN QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->FUEL_RIGHT + this->simRequestId, "FUEL TANK RIGHT MAIN QUANTITY", "gallons");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->MASTER_BATTERY + this->simRequestId, "ELECTRICAL MASTER BATTERY", "Bool");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_AILERON_SET + this->simRequestId, "AILERON_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_FLAPS_SET + this->simRequestId, "FLAPS_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, "SPOILERS_ARM_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_SPOILERS_SET + this->simRequestId, "SPOILERS_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_GEAR_SET + this->simRequestId, "GEAR_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, "TOGGLE_MASTER_BATTERY");
 
 		// Light Controls: Assign light vars and map client events
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_NAV_LIGHTS + this->simRequestId, "TOGGLE_NAV_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_LOGO_LIGHTS + this->simRequestId, "TOGGLE_LOGO_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_BEACON_LIGHTS + this->simRequestId, "TOGGLE_BEACON_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_STROBES_SET + this->simRequestId, "STROBES_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_TAXI_LIGHTS + this->simRequestId, "TOGGLE_TAXI_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_WING_LIGHTS + this->simRequestId, "TOGGLE_WING_LIGHTS");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, "LANDING_LIGHTS_SET");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->NAV_LIGHT + this->simRequestId, "LIGHT NAV", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->LOGO_LIGHT + this->simRequestId, "LIGHT LOGO", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->BEACON_LIGHT + this->simRequestId, "LIGHT BEACON", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->STROBE_LIGHT + this->simRequestId, "LIGHT STROBE", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->TAXI_LIGHT + this->simRequestId, "LIGHT TAXI", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->WING_LIGHT + this->simRequestId, "LIGHT WING", "number");
-		cpu->hr = SimConnect_AddToDataDefinition(cpu->hSimConnect, (UINT)cpu->LNDG_LIGHT + this->simRequestId, "LIGHT LANDING", "number");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_NAV_LIGHTS + this->simRequestId, "TOGGLE_NAV_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_LOGO_LIGHTS + this->simRequestId, "TOGGLE_LOGO_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_BEACON_LIGHTS + this->simRequestId, "TOGGLE_BEACON_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_STROBES_SET + this->simRequestId, "STROBES_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_TAXI_LIGHTS + this->simRequestId, "TOGGLE_TAXI_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_WING_LIGHTS + this->simRequestId, "TOGGLE_WING_LIGHTS");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, "LANDING_LIGHTS_SET");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->NAV_LIGHT + this->simRequestId, "LIGHT NAV", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->LOGO_LIGHT + this->simRequestId, "LIGHT LOGO", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->BEACON_LIGHT + this->simRequestId, "LIGHT BEACON", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->STROBE_LIGHT + this->simRequestId, "LIGHT STROBE", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->TAXI_LIGHT + this->simRequestId, "LIGHT TAXI", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->WING_LIGHT + this->simRequestId, "LIGHT WING", "number");
+		cpu->hr = cpu->simLink->AddToDataDefinition((UINT)cpu->LNDG_LIGHT + this->simRequestId, "LIGHT LANDING", "number");
 
 		// Engine Controls: Map client events to sim events
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_THROTTLE_1 + this->simRequestId, "THROTTLE1_AXIS_SET_EX1");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_THROTTLE_2 + this->simRequestId, "THROTTLE2_AXIS_SET_EX1");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE1 + this->simRequestId, "TURBINE_IGNITION_SWITCH_SET1");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE2 + this->simRequestId, "TURBINE_IGNITION_SWITCH_SET2");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_STARTER + this->simRequestId, "FUELSYSTEM_VALVE_OPEN");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_TOGGLE_FUEL + this->simRequestId, "FUELSYSTEM_VALVE_CLOSE");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_APU_STARTER + this->simRequestId, "APU_STARTER");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, "APU_GENERATOR_SWITCH_SET");
-		cpu->hr = SimConnect_MapClientEventToSimEvent(cpu->hSimConnect, (UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, "BLEED_AIR_SOURCE_CONTROL_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_THROTTLE_1 + this->simRequestId, "THROTTLE1_AXIS_SET_EX1");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_THROTTLE_2 + this->simRequestId, "THROTTLE2_AXIS_SET_EX1");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE1 + this->simRequestId, "TURBINE_IGNITION_SWITCH_SET1");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE2 + this->simRequestId, "TURBINE_IGNITION_SWITCH_SET2");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_STARTER + this->simRequestId, "FUELSYSTEM_VALVE_OPEN");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_TOGGLE_FUEL + this->simRequestId, "FUELSYSTEM_VALVE_CLOSE");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_APU_STARTER + this->simRequestId, "APU_STARTER");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, "APU_GENERATOR_SWITCH_SET");
+		cpu->hr = cpu->simLink->MapClientEventToSimEvent((UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, "BLEED_AIR_SOURCE_CONTROL_SET");
 
 		// Add object specific data requests to SimConnect Dispatch
-		cpu->hr = SimConnect_RequestDataOnSimObject(cpu->hSimConnect, (UINT)cpu->REQ_POS_DATA + this->simRequestId, (UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
-		cpu->hr = SimConnect_RequestDataOnSimObject(cpu->hSimConnect, (UINT)cpu->REQ_SYS_DATA + this->simRequestId, (UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
-		cpu->hr = SimConnect_RequestDataOnSimObject(cpu->hSimConnect, (UINT)cpu->REQ_SIM_DATA + this->simRequestId, (UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
+		cpu->hr = cpu->simLink->RequestDataOnSimObject((UINT)cpu->REQ_POS_DATA + this->simRequestId, (UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
+		cpu->hr = cpu->simLink->RequestDataOnSimObject((UINT)cpu->REQ_SYS_DATA + this->simRequestId, (UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
+		cpu->hr = cpu->simLink->RequestDataOnSimObject((UINT)cpu->REQ_SIM_DATA + this->simRequestId, (UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, SIMCONNECT_PERIOD_SIM_FRAME);
 
 		//Initialize object for positioning 
 		if (!this->lockPosition) {
 			// Lock position and attitudes
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, this->simObjectId, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_LATITUDE_LONGITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_ALTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(this->simObjectId, (UINT)cpu->KEY_FREEZE_ATTITUDE_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 
 			this->lockPosition = true;
 		}
@@ -246,17 +246,17 @@ public:
 		if (track->GetFileType() == Track::FileType::FDR) {
 			fdrFile = track->GetFDRFile();
 
-			initPos.Altitude = fdrFile->fileData.front().alt;
-			initPos.Latitude = fdrFile->fileData.front().lat;
-			initPos.Longitude = fdrFile->fileData.front().lon;
-			initPos.Heading = fdrFile->fileData.front().hdg;
+			initPos.Altitude = fdrFile->GetRecords().front().alt;
+			initPos.Latitude = fdrFile->GetRecords().front().lat;
+			initPos.Longitude = fdrFile->GetRecords().front().lon;
+			initPos.Heading = fdrFile->GetRecords().front().hdg;
 		} else if (track->GetFileType() == Track::FileType::FTDIS) {
 			ftdisFile = track->GetFTDISFile();
 
-			initPos.Altitude = ftdisFile->fileData.front().alt;
-			initPos.Latitude = ftdisFile->fileData.front().lat;
-			initPos.Longitude = ftdisFile->fileData.front().lon;
-			initPos.Heading = ftdisFile->fileData.front().hdg;
+			initPos.Altitude = ftdisFile->GetRecords().front().alt;
+			initPos.Latitude = ftdisFile->GetRecords().front().lat;
+			initPos.Longitude = ftdisFile->GetRecords().front().lon;
+			initPos.Heading = ftdisFile->GetRecords().front().hdg;
 		}
 
 		// Default position and attitude vars
@@ -266,7 +266,7 @@ public:
 		initPos.Airspeed = 1;
 
 		// Request new AI object at initial position
-		cpu->hr = SimConnect_AICreateNonATCAircraft(cpu->hSimConnect, track->GetSimCfgUuid().c_str(), "AI999", initPos, (UINT)cpu->REQ_AI_AC + this->simRequestId);
+		cpu->hr = cpu->simLink->AICreateNonATCAircraft(track->GetSimCfgUuid().c_str(), "AI999", initPos, (UINT)cpu->REQ_AI_AC + this->simRequestId);
 
 		this->isAi = true;
 	}
@@ -280,7 +280,13 @@ public:
 	*/
 	void PerformRemoveAiSimObject() {
 		if (this->isAi)
-			cpu->hr = SimConnect_AIRemoveObject(cpu->hSimConnect, this->simObjectId, this->simRequestId);
+			cpu->hr = cpu->simLink->AIRemoveObject(this->simObjectId, this->simRequestId);
+
+		// Release the request slot, i.e. it is reused by the next sim object (the track gets a new slot, if activated again)
+		if (this->requestSlot) {
+			cpu->RemoveRequestSlot(this->simRequestId);
+			this->requestSlot = false;
+		}
 	}
 
 
@@ -353,7 +359,7 @@ public:
 			//if (this->isAi)
 			//	posDataSet.alt -= 0.25;
 
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(posDataSet), &posDataSet);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->POS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(posDataSet), &posDataSet);
 		}
 	}
 
@@ -367,7 +373,7 @@ public:
 	*/
 	void PerformSetSysData(SysDataSet sysDataSet, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(sysDataSet), &sysDataSet);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SYS_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(sysDataSet), &sysDataSet);
 	}
 
 
@@ -380,7 +386,7 @@ public:
 	*/
 	void PerformSetSimData(SimDataSet simDataSet, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(simDataSet), &simDataSet);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SIM_DATA_SET + this->simRequestId, this->simObjectId, 0, 0, sizeof(simDataSet), &simDataSet);
 	}
 
 
@@ -398,9 +404,9 @@ public:
 			fuel[1] = fuelStartL - ((1 - (flightTime - timeStmp) / flightTime) * (fuelStartL - fuelEndL));
 			fuel[2] = fuelStartR - ((1 - (flightTime - timeStmp) / flightTime) * (fuelStartR - fuelEndR));
 
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->FUEL_CTR + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[0]), &fuel[0]);
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->FUEL_LEFT + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[1]), &fuel[1]);
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->FUEL_RIGHT + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[2]), &fuel[2]);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->FUEL_CTR + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[0]), &fuel[0]);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->FUEL_LEFT + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[1]), &fuel[1]);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->FUEL_RIGHT + this->simRequestId, simObjectId, 0, 0, sizeof(fuel[2]), &fuel[2]);
 		}
 	}
 
@@ -420,20 +426,20 @@ public:
 		if (this->simObjectId != -1 && this->lockPosition) {
 			// Start APU
 			if (startAPUProcStep == 0) {
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_APU_STARTER + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TOGGLE_MASTER_BATTERY + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_APU_STARTER + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 				startAPUTime = timeStmp;
 				startAPUProcStep = 1;
 			}
 
 			// Wait for APU to start up and turn on generators and APU bleed
 			if (startAPUProcStep == 1 && (timeStmp - startAPUTime) > apuGenDelay) {
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_APU_GENERATOR_SWITCH_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_BLEED_AIR_SOURCE_CONTROL_SET + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 				startAPUProcStep = 3;
 			}
 
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->MASTER_BATTERY + this->simRequestId, simObjectId, 0, 0, sizeof(battery), &battery);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->MASTER_BATTERY + this->simRequestId, simObjectId, 0, 0, sizeof(battery), &battery);
 		}
 	}
 
@@ -454,27 +460,27 @@ public:
 				
 				// Set Master Ignition Switch to Ignition
 				if (startEngineProcStep == 0) {
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE1 + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE2 + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE1 + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE2 + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					startEngineProcStep = 1;
 				}
 
 				// Start Engine no. 2:
 				if (timeStmp >= startTime + (stepDelay * startEngineProcStep) && startEngineProcStep == 1) {
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TOGGLE_STARTER + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TOGGLE_STARTER + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					startEngineProcStep = 2;
 				}
 						
 				// Start Engine no. 1:
 				if (timeStmp >= startTime + (stepDelay * startEngineProcStep) + enginePostStartDelay && startEngineProcStep == 2) {
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TOGGLE_STARTER + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TOGGLE_STARTER + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					startEngineProcStep = 3;
 				}
 
 				// Set Master Ignition Switch to Normal
 				if (timeStmp >= startTime + (stepDelay * startEngineProcStep) + (enginePostStartDelay * 2) && startEngineProcStep == 3) {
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE1 + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE2 + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE1 + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TURBINE_IGNITION_SWITCH_TOGGLE2 + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					startEngineProcStep = 4;
 				}
 			}
@@ -490,8 +496,8 @@ public:
 	*/
 	void PerformStopEngineProc(Track::FileType fileType) {
 		// Cut Fuel Cutoff / Engine Starter Switches: Engine 1 and 2
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TOGGLE_FUEL + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-		cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_TOGGLE_FUEL + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+		cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TOGGLE_FUEL + this->simRequestId, 2, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+		cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_TOGGLE_FUEL + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 	}
 
 
@@ -529,12 +535,12 @@ public:
 			//throttlePos = (throttleVal * throttleRng) - throttleRng;
 			throttlePos = 0;
 			// Set throttles engines 1 + 2
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_THROTTLE_1 + this->simRequestId, throttlePos, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_THROTTLE_2 + this->simRequestId, throttlePos, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_THROTTLE_1 + this->simRequestId, throttlePos, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_THROTTLE_2 + this->simRequestId, throttlePos, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 			
 			// Set N1 values engines 1 +2 
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->ENG1_N1 + this->simRequestId, simObjectId, 0, 0, sizeof(throttleVal), &throttleVal);
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->ENG2_N1 + this->simRequestId, simObjectId, 0, 0, sizeof(throttleVal), &throttleVal);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->ENG1_N1 + this->simRequestId, simObjectId, 0, 0, sizeof(throttleVal), &throttleVal);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->ENG2_N1 + this->simRequestId, simObjectId, 0, 0, sizeof(throttleVal), &throttleVal);
 		}
 	}
 
@@ -586,7 +592,7 @@ public:
 			if (fileType == Track::FileType::FTDIS)
 				ailerons *= fsAlrRng;
 
-			cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_AILERON_SET + this->simRequestId, (DWORD)ailerons, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+			cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_AILERON_SET + this->simRequestId, (DWORD)ailerons, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 		}
 	}
 
@@ -600,7 +606,7 @@ public:
 	*/
 	void PerformSetElevator(double degrees, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->ELEV + this->simRequestId, simObjectId, 0, 0, sizeof(degrees), &degrees);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->ELEV + this->simRequestId, simObjectId, 0, 0, sizeof(degrees), &degrees);
 	}
 
 
@@ -625,7 +631,7 @@ public:
 	*/
 	void PerformSetRudder(double degrees, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->RUDDER + this->simRequestId, simObjectId, 0, 0, sizeof(degrees), &degrees);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->RUDDER + this->simRequestId, simObjectId, 0, 0, sizeof(degrees), &degrees);
 	}
 
 
@@ -667,7 +673,7 @@ public:
 			} else if (fileType == Track::FileType::FDR) {
 				flapsDeg = stage * (fsFlpsRng / 4);
 			}
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_FLAPS_SET + this->simRequestId, flapsDeg, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_FLAPS_SET + this->simRequestId, flapsDeg, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 		}
 	}
 
@@ -689,27 +695,27 @@ public:
 					// Disengage
 					if (splrEngaged) {
 						spoiler = 0.0;
-						cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
+						cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
 					}
 				} else if ((int)spoilerSet == 2 && !splrEngaged) {
 					spoiler = 1.0;
 					// Ensure spoiler are disarmed
-					cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_SPOILERS_ARM_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					Sleep(1);
 					// Extend spoiler
-					cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
+					cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
 					//spoiler = 16383;
-					//hr = SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					//hr = simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					splrEngaged = true;
 					splrArmed = false;
 				} else if ((int)spoilerSet == 0 && splrEngaged) {
 					spoiler = 0.0;
-					cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
-					//hr = SimConnect_TransmitClientEvent(hSimConnect, SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+					cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoiler), &spoiler);
+					//hr = simLink->TransmitClientEvent(SIMCONNECT_OBJECT_ID_USER, KEY_SPOILERS_SET, spoiler, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 					splrEngaged = false;
 				}
 			} else if (fileType == Track::FileType::FDR)
-				cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoilerSet), &spoilerSet);
+				cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->SPOILER + this->simRequestId, simObjectId, 0, 0, sizeof(spoilerSet), &spoilerSet);
 
 		}
 	}
@@ -727,9 +733,9 @@ public:
 
 		if (this->simObjectId != -1 && this->lockPosition) {
 			if (gearPos == 1 && gearPos != simData.gearPos)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 			else if (gearPos == 0 && gearPos != simData.gearPos)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_GEAR_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 
 		}
 	}
@@ -744,7 +750,7 @@ public:
 	*/
 	void PerformSetNoseWheel(double noseWheelDegrees, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition)
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->GEAR_ANGLE + this->simRequestId, simObjectId, 0, 0, sizeof(noseWheelDegrees), &noseWheelDegrees);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->GEAR_ANGLE + this->simRequestId, simObjectId, 0, 0, sizeof(noseWheelDegrees), &noseWheelDegrees);
 	}
 
 
@@ -776,7 +782,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->NAV_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->NAV_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
 		}
 	}
 
@@ -793,7 +799,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->LOGO_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->LOGO_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
 		}
 	}
 
@@ -810,7 +816,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->BEACON_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->BEACON_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
 		}
 	}
 
@@ -827,7 +833,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->STROBE_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->STROBE_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
 		}
 	}
 
@@ -842,7 +848,7 @@ public:
 	void PerformSetTaxiLights(int lightSwitch, Track::FileType fileType) {
 		if (this->simObjectId != -1 && this->lockPosition) {
 			double state = lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->TAXI_LIGHT + this->simRequestId, simObjectId, 0, 0, sizeof(state), &state);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->TAXI_LIGHT + this->simRequestId, simObjectId, 0, 0, sizeof(state), &state);
 		}
 	}
 
@@ -859,7 +865,7 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			double state = (double)lightSwitch;
-			cpu->hr = SimConnect_SetDataOnSimObject(cpu->hSimConnect, (UINT)cpu->WING_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
+			cpu->hr = cpu->simLink->SetDataOnSimObject((UINT)cpu->WING_LIGHT + this->simRequestId, this->simObjectId, 0, 0, sizeof(state), &state);
 		}
 	}
 
@@ -876,9 +882,9 @@ public:
 			FDRFileStruct simData = cpu->GetSimDataRec(this->simRequestId);
 
 			if (lightSwitch == 1 && lightSwitch != simData.lndgL)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 1, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 			else if (lightSwitch == 0 && lightSwitch != simData.lndgL)
-				cpu->hr = SimConnect_TransmitClientEvent(cpu->hSimConnect, simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
+				cpu->hr = cpu->simLink->TransmitClientEvent(simObjectId, (UINT)cpu->KEY_LANDING_LIGHTS_SET + this->simRequestId, 0, SIMCONNECT_GROUP_PRIORITY_HIGHEST, SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY);
 		}
 	}
 
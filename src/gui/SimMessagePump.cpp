@@ -0,0 +1,96 @@
+#include "SimMessagePump.h"
+#include <thread>
+#include <chrono>
+
+/**
+* Constructor / Destructor
+*/
+SimMessagePump::SimMessagePump(SimMessageSource* source, Mode mode, uint32_t intervalMs) {
+	this->source = source;
+	this->SetPolicy(mode, intervalMs);
+}
+
+SimMessagePump::~SimMessagePump() {
+
+}
+
+
+/**
+* Waits for messages and dispatches them
+*/
+bool SimMessagePump::Pump() {
+	bool signaled = true;
+
+	switch (mode) {
+	case eventDriven:
+		signaled = source->WaitForMessages(intervalMs);
+		if (signaled)
+			source->DispatchMessages();
+		break;
+	case polling:
+		source->DispatchMessages();
+		std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+		break;
+	case spinning:
+		source->DispatchMessages();
+		std::this_thread::yield();
+		break;
+	}
+
+	if (signaled)
+		wakeCount++;
+	else
+		timeoutCount++;
+
+	return signaled;
+}
+
+
+/**
+* Waits for messages according to the policy, without dispatching them
+*/
+bool SimMessagePump::Wait() {
+	switch (mode) {
+	case polling:
+		std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+		return source->WaitForMessages(0);
+	case spinning:
+		std::this_thread::yield();
+		return source->WaitForMessages(0);
+	default:
+		return source->WaitForMessages(intervalMs);
+	}
+}
+
+
+/**
+* Interrupts a pending wait
+*/
+void SimMessagePump::Wake() {
+	source->Wake();
+}
+
+
+/**
+* Sets the latency/CPU policy
+*/
+void SimMessagePump::SetPolicy(Mode mode, uint32_t intervalMs) {
+	this->mode = mode;
+	this->intervalMs = intervalMs > 0 ? intervalMs : 1;
+}
+
+
+/**
+* Returns the number of iterations with messages dispatched
+*/
+uint64_t SimMessagePump::GetWakeCount() {
+	return this->wakeCount;
+}
+
+
+/**
+* Returns the number of iterations without messages
+*/
+uint64_t SimMessagePump::GetTimeoutCount() {
+	return this->timeoutCount;
+}
@@ -0,0 +1,77 @@
+#ifndef SimMessagePump_H
+#define SimMessagePump_H
+
+#include <cstdint>
+#include "SimMessageSource.h"
+
+/**
+* Message pump of the processor loop
+*
+* Waits for and dispatches the messages of a message source according to a latency/CPU policy:
+* (1) eventDriven -> sleeps until a message arrives (no CPU while idle, no timer granularity). The
+*     wait is bounded by the interval, i.e. the loop checks for stop requests at least that often
+* (2) polling -> dispatches, then sleeps for the interval (legacy behaviour)
+* (3) spinning -> dispatches continuously (lowest latency, occupies a core)
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class SimMessagePump {
+
+public:
+	enum Mode {
+		eventDriven,
+		polling,
+		spinning
+	};
+
+	SimMessagePump(SimMessageSource* source, Mode mode = eventDriven, uint32_t intervalMs = 50);
+	~SimMessagePump();
+
+private:
+	SimMessageSource* source = nullptr;
+	Mode mode = eventDriven;
+	uint32_t intervalMs = 50;
+	uint64_t wakeCount = 0, timeoutCount = 0;
+
+public:
+	/**
+	* Waits for messages and dispatches them (one iteration of the processor loop)
+	*
+	* @param	void
+	* @return	bool		True, if messages have been dispatched
+	*/
+	bool Pump();
+
+	/**
+	* Waits for messages according to the policy, without dispatching them, e.g. to time the dispatch on its own
+	*
+	* @param	void
+	* @return	bool		True, if messages are pending
+	*/
+	bool Wait();
+
+	/**
+	* Interrupts a pending wait, e.g. on a stop request. Thread safe
+	*/
+	void Wake();
+
+	/**
+	* Sets the latency/CPU policy
+	*
+	* @param	mode		Mode, e.g. eventDriven
+	* @param	intervalMs	Max. wait (eventDriven) or sleep (polling) per iteration in ms
+	* @return	void
+	*/
+	void SetPolicy(Mode mode, uint32_t intervalMs);
+
+	/**
+	* Returns the number of iterations with messages dispatched
+	*/
+	uint64_t GetWakeCount();
+
+	/**
+	* Returns the number of iterations without messages (wait timed out)
+	*/
+	uint64_t GetTimeoutCount();
+};
+#endif
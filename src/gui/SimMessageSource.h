@@ -0,0 +1,45 @@
+#ifndef SimMessageSource_H
+#define SimMessageSource_H
+
+#include <cstdint>
+
+/**
+* Source of sim messages for the processor loop
+*
+* Definition of a waitable message source, i.e. the processor thread sleeps until messages
+* arrive instead of polling. Implemented by the SimConnect connection (Windows event handle)
+* and by a local stand-in, which allows to drive the processor loop without a sim
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class SimMessageSource
+{
+
+public:
+	virtual ~SimMessageSource() {}
+
+	/**
+	* Blocks until messages are pending, the source is woken up or the timeout expires
+	*
+	* @param	timeoutMs	Max. wait time in ms (0 -> don't wait)
+	* @return	bool		True, if messages may be pending
+	*/
+	virtual bool WaitForMessages(uint32_t timeoutMs) = 0;
+
+	/**
+	* Handles all pending messages
+	*
+	* @param	void
+	* @return	void
+	*/
+	virtual void DispatchMessages() = 0;
+
+	/**
+	* Interrupts a pending WaitForMessages call, e.g. to handle a stop request immediately
+	*
+	* @param	void
+	* @return	void
+	*/
+	virtual void Wake() = 0;
+};
+#endif
@@ -96,6 +96,14 @@ void SimModel::SetSimData(SimDataSet simDataSet, Track::FileType fileType) {
 }
 
 
+/**
+* Writes the system vars set during the frame to the sim
+*/
+void SimModel::FlushSysData() {
+	this->behavior->PerformFlushSysData();
+}
+
+
 /**
 * Calculates and sets the aircraft's fuel parameters
 */
@@ -128,6 +136,30 @@ void SimModel::StopEngineProc(Track::FileType fileType) {
 }
 
 
+/**
+* Returns the procedural state of the sim model
+*/
+bool SimModel::GetState(SimModelState& state) {
+	return this->behavior->PerformGetState(state);
+}
+
+
+/**
+* Restores the procedural state of the sim model
+*/
+void SimModel::SetState(const SimModelState& state) {
+	this->behavior->PerformSetState(state);
+}
+
+
+/**
+* Brings the systems of the sim object in line with the state restored
+*/
+void SimModel::SyncState(const SimModelState& prevState) {
+	this->behavior->PerformSyncState(prevState);
+}
+
+
 /**
 * Converts the throttle value specified in the FTDIS input .fd file to the
 * corresponding value within the aircraft's throttle range
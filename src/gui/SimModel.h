@@ -6,6 +6,7 @@
 #include "PosDataSet.h"
 #include "SimDataSet.h"
 #include "SysDataSet.h"
+#include "SimModelState.h"
 #include "Track.h"
 #include "SimConnect.h"
 #include "SimModelBehavior.cpp"
@@ -118,6 +119,15 @@ public:
 	*/
 	void SetSimData(SimDataSet simDataSet, Track::FileType fileType);
 
+	/**
+	* Writes the system vars set during the frame to the sim, i.e. the throttle, flight controls,
+	* fuel and lights set since the last flush, with a single call
+	* 
+	* @param	void
+	* @return   void
+	*/
+	void FlushSysData();
+
 	/**
 	* Calculates and Sets the aircraft's fuel parameters
 	*
@@ -155,6 +165,30 @@ public:
 	*/
 	void StopEngineProc(Track::FileType fileType);
 
+	/**
+	* Returns the procedural state of the sim model, e.g. the steps of the APU and engine start procedures
+	*
+	* @param	state		Procedural state (out)
+	* @return	bool		False, if the sim object hasn't been placed yet
+	*/
+	bool GetState(SimModelState& state);
+
+	/**
+	* Restores the procedural state of the sim model
+	*
+	* @param	state		Procedural state
+	* @return	void
+	*/
+	void SetState(const SimModelState& state);
+
+	/**
+	* Brings the systems of the sim object in line with the state restored
+	*
+	* @param	prevState	Procedural state in effect in the sim before the restore
+	* @return	void
+	*/
+	void SyncState(const SimModelState& prevState);
+
 	/**
 	* Converts the throttle value specified in the FTDIS input .fd file to the
 	* corresponding value within the aircraft's throttle range
@@ -6,6 +6,7 @@
 #include "PosDataSet.h"
 #include "SimDataSet.h"
 #include "SysDataSet.h"
+#include "SimModelState.h"
 #include "Track.h"
 #include "SimConnect.h"
 
@@ -114,6 +115,14 @@ public:
 	*/
 	virtual void PerformSetSimData(SimDataSet simDataSet, Track::FileType fileType) = 0;
 
+	/**
+	* Writes the system vars set during the frame to the sim
+	*
+	* @param	void
+	* @return   void
+	*/
+	virtual void PerformFlushSysData() = 0;
+
 	/**
 	* Calculates and sets the aircraft's fuel parameters
 	*
@@ -151,6 +160,31 @@ public:
 	*/
 	virtual void PerformStopEngineProc(Track::FileType fileType) = 0;
 
+	/**
+	* Returns the procedural state of the sim model, e.g. the steps of the APU and engine start procedures
+	*
+	* @param	state		Procedural state (out)
+	* @return	bool		False, if the sim object hasn't been placed yet, i.e. the procedures haven't run
+	*/
+	virtual bool PerformGetState(SimModelState& state) = 0;
+
+	/**
+	* Restores the procedural state of the sim model. Doesn't call SimConnect (see PerformSyncState)
+	*
+	* @param	state		Procedural state, e.g. of a keyframe
+	* @return	void
+	*/
+	virtual void PerformSetState(const SimModelState& state) = 0;
+
+	/**
+	* Brings the systems of the sim object in line with the state restored, i.e. shuts down what
+	* has been started after the restored state and lets the procedures start it again
+	*
+	* @param	prevState	Procedural state in effect in the sim before the restore
+	* @return	void
+	*/
+	virtual void PerformSyncState(const SimModelState& prevState) = 0;
+
 	/**
 	* Converts the throttle value specified in the FTDIS input .fd file to the
 	* corresponding value within the aircraft's throttle range
@@ -0,0 +1,19 @@
+#ifndef SIMMODELSTATE_H
+#define SIMMODELSTATE_H
+
+/**
+* Procedural state of a sim model, i.e. the state derived from the replay so far
+* rather than from the current record (see TrackKeyframes)
+*/
+struct SimModelState
+{
+	int startAPUProcStep;
+	float startAPUTime;
+	int startEngineProcStep;
+	int gearStat;
+	bool revEngaged;
+	bool splrEngaged;
+	bool splrArmed;
+};
+
+#endif
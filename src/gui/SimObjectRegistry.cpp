@@ -0,0 +1,68 @@
+#include "SimObjectRegistry.h"
+#include <algorithm>
+
+/**
+* Constructor / Destructor
+*/
+SimObjectRegistry::SimObjectRegistry() {
+
+}
+
+SimObjectRegistry::~SimObjectRegistry() {
+
+}
+
+
+/**
+* Adds the state of a sim object
+*/
+SimObjectRegistry::Handle SimObjectRegistry::Add() {
+	if (!freeHandles.empty()) {
+		Handle handle = freeHandles.back();
+		freeHandles.pop_back();
+		states[handle] = {};
+		return handle;
+	}
+
+	states.push_back({});
+	return (Handle)(states.size() - 1);
+}
+
+
+/**
+* Removes the state of a sim object
+*/
+void SimObjectRegistry::Remove(Handle handle) {
+	if (handle >= states.size() || std::find(freeHandles.begin(), freeHandles.end(), handle) != freeHandles.end())
+		return;
+
+	states[handle] = {};
+	freeHandles.push_back(handle);
+}
+
+
+/**
+* Returns the state of a sim object
+*/
+SimObjectStruct& SimObjectRegistry::Get(Handle handle) {
+	if (handle >= states.size())
+		states.resize((size_t)handle + 1, {});
+	return states[handle];
+}
+
+
+/**
+* Returns the number of states
+*/
+size_t SimObjectRegistry::GetSize() const {
+	return states.size();
+}
+
+
+/**
+* Removes all states
+*/
+void SimObjectRegistry::Clear() {
+	states.clear();
+	freeHandles.clear();
+}
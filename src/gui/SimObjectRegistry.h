@@ -0,0 +1,68 @@
+#ifndef SimObjectRegistry_H
+#define SimObjectRegistry_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <deque>
+#include <vector>
+#include "SimObjectStruct.h"
+
+/**
+* Registry of the sim object states
+*
+* Holds the state of every sim object the processor requests data for (user aircraft and AI
+* objects), addressed by handle, i.e. the request slot of the object (see Processor::AddRequestSlot).
+* Handles of removed objects are reused, i.e. the registry grows to the max. number of objects alive
+* at a time. States are stored contiguously per object and never move, i.e. handles and references
+* stay valid while objects are added
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class SimObjectRegistry {
+
+public:
+	typedef UINT Handle;
+
+	SimObjectRegistry();
+	~SimObjectRegistry();
+
+private:
+	std::deque<SimObjectStruct> states;
+	std::vector<Handle> freeHandles;
+
+public:
+	/**
+	* Adds the state of a sim object. The handle of a removed state is reused first (last removed, first reused)
+	*
+	* @param	void
+	* @return	Handle		Handle of the new state
+	*/
+	Handle Add();
+
+	/**
+	* Removes the state of a sim object, i.e. its handle is reused by the next Add
+	*
+	* @param	handle		Handle of the state
+	* @return	void
+	*/
+	void Remove(Handle handle);
+
+	/**
+	* Returns the state of a sim object. Unknown handles are added, i.e. return an empty state
+	*
+	* @param	handle		Handle of the state
+	* @return	SimObjectStruct&
+	*/
+	SimObjectStruct& Get(Handle handle);
+
+	/**
+	* Returns the number of states, incl. removed states
+	*/
+	size_t GetSize() const;
+
+	/**
+	* Removes all states, i.e. invalidates all handles
+	*/
+	void Clear();
+};
+#endif
@@ -0,0 +1,22 @@
+#ifndef SIMOBJECTSTRUCT_H
+#define SIMOBJECTSTRUCT_H
+
+#include "FDRFileStruct.h"
+
+/**
+* State of a sim object, as received from the sim. The fields read by the co-processors every frame
+* (ground and CG offsets, flaps, zulu time) are packed into the first cache line, followed by the latest record
+*/
+struct alignas(64) SimObjectStruct
+{
+	double altGround;
+	double absAltGround;
+	double staticCGAlt;
+	double staticCGPitch;
+	double flapsLeadingPrc;
+	double flapsTrailingPrc;
+	double zulu;
+	FDRFileStruct record;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "SimRequestRouter.h"
+
+/**
+* Constructor / Destructor
+*/
+SimRequestRouter::SimRequestRouter(DWORD baseId) {
+	this->baseId = baseId;
+}
+
+SimRequestRouter::~SimRequestRouter() {
+
+}
+
+
+/**
+* Registers the route of a request
+*/
+void SimRequestRouter::Register(DWORD requestId, Handler handler, UINT slot) {
+	if (requestId < baseId)
+		return;
+
+	size_t index = requestId - baseId;
+	if (index >= routes.size())
+		routes.resize(index + 1, { none, 0 });
+	routes[index] = { handler, slot };
+}
+
+
+/**
+* Removes all routes
+*/
+void SimRequestRouter::Clear() {
+	routes.clear();
+}
+
+
+/**
+* Returns the route of a request
+*/
+SimRequestRouter::Route SimRequestRouter::Find(DWORD requestId) const {
+	size_t index = (size_t)requestId - baseId;
+
+	if (requestId < baseId || index >= routes.size())
+		return { none, 0 };
+	return routes[index];
+}
+
+
+/**
+* Returns the number of registered routes
+*/
+size_t SimRequestRouter::GetSize() const {
+	size_t count = 0;
+	for (auto& route : routes)
+		if (route.handler != none)
+			count++;
+	return count;
+}
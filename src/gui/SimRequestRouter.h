@@ -0,0 +1,70 @@
+#ifndef SimRequestRouter_H
+#define SimRequestRouter_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <vector>
+
+/**
+* Routing table of SimConnect data requests
+*
+* Maps the request ID of a SIMCONNECT_RECV_ID_SIMOBJECT_DATA response to the handler of its data
+* set (position, system or sim data) and to the slot of the sim object, i.e. the index into the
+* per-object data of the processor. The table is a flat array indexed by the request ID relative to
+* the base ID, i.e. a lookup costs the same regardless of the number of registered requests
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class SimRequestRouter {
+
+public:
+	enum Handler : uint8_t {
+		none = 0,
+		posData,
+		sysData,
+		simData
+	};
+
+	struct Route {
+		Handler handler;
+		UINT slot;
+	};
+
+	SimRequestRouter(DWORD baseId = 0);
+	~SimRequestRouter();
+
+private:
+	DWORD baseId = 0;
+	std::vector<Route> routes;
+
+public:
+	/**
+	* Registers the route of a request. Request IDs below the base ID are ignored
+	*
+	* @param	requestId	SimConnect request ID
+	* @param	handler		Handler of the data set
+	* @param	slot		Slot of the sim object
+	* @return	void
+	*/
+	void Register(DWORD requestId, Handler handler, UINT slot);
+
+	/**
+	* Removes all routes
+	*/
+	void Clear();
+
+	/**
+	* Returns the route of a request, handler none if the request isn't registered
+	*
+	* @param	requestId	SimConnect request ID
+	* @return	Route
+	*/
+	Route Find(DWORD requestId) const;
+
+	/**
+	* Returns the number of registered routes
+	*/
+	size_t GetSize() const;
+};
+#endif
@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <strsafe.h>
 #include <string>
+#include <algorithm>
 #include <locale.h>
 #include "ProcessorUtil.h"
 #include "FTDISFileStruct.h"
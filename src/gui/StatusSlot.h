@@ -0,0 +1,75 @@
+#ifndef StatusSlot_H
+#define StatusSlot_H
+
+#include <cstdint>
+#include <atomic>
+
+/**
+* Lock-free single-producer/single-consumer slot of the latest snapshot (triple buffer)
+*
+* The producer (e.g. the processor thread) publishes a snapshot as often as it likes and never blocks,
+* the consumer (e.g. a GUI timer) pulls the latest one at its own rate. Snapshots published in between
+* are replaced, i.e. coalesced, not queued. Producer and consumer each own one buffer, the third one is
+* handed over by an atomic exchange. Exactly one thread may publish and exactly one (other) thread may pull
+*
+* @author muppetlabs@fswindowseat.com
+*/
+template<typename T> class StatusSlot {
+
+public:
+	StatusSlot() {}
+
+private:
+	// Index of the buffer handed over, flagged while it holds a snapshot not pulled yet
+	static constexpr uint8_t indexMask = 3;
+	static constexpr uint8_t newSnapshot = 4;
+
+	T buffer[3] = {};
+
+	// Producer and consumer buffers on separate cache lines, i.e. no false sharing
+	alignas(64) std::atomic<uint8_t> middle{ 1 };
+	alignas(64) uint8_t back = 0;
+	std::atomic<uint64_t> publishCount{ 0 };
+	alignas(64) uint8_t front = 2;
+	std::atomic<uint64_t> pullCount{ 0 };
+
+public:
+	/**
+	* Publishes a snapshot, replaces the previous one if not pulled yet (producer only)
+	*
+	* @param	item		Snapshot
+	* @return	void
+	*/
+	void Publish(const T& item) {
+		buffer[back] = item;
+		back = middle.exchange(back | newSnapshot, std::memory_order_acq_rel) & indexMask;
+		publishCount.store(publishCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/**
+	* Takes the latest snapshot (consumer only)
+	*
+	* @param	item		Receives the snapshot
+	* @return	bool		False, if no snapshot has been published since the last pull
+	*/
+	bool TryPull(T& item) {
+		if (!(middle.load(std::memory_order_relaxed) & newSnapshot))
+			return false;
+
+		front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+		item = buffer[front];
+		pullCount.store(pullCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	* Returns the number of snapshots published
+	*/
+	uint64_t GetPublishCount() const { return publishCount.load(std::memory_order_relaxed); }
+
+	/**
+	* Returns the number of snapshots pulled, i.e. published - pulled snapshots have been coalesced
+	*/
+	uint64_t GetPullCount() const { return pullCount.load(std::memory_order_relaxed); }
+};
+#endif
@@ -84,6 +84,22 @@ double Track::GetTimeOffset() {
 }
 
 
+double Track::GetStartTime() {
+	if (fileType == Track::FileType::FDR && fdrFile && fdrFile->GetSize() > 0)
+		return fdrFile->GetRecords()[0].fltTime - this->timeOffset;
+	return -this->timeOffset;
+}
+
+double Track::GetEndTime() {
+	if (fileType == Track::FileType::FDR && fdrFile)
+		return fdrFile->GetFlightTime() - this->timeOffset;
+	// FTDIS records are replayed at 100 Hz (see FTDISRecordTraits)
+	else if (fileType == Track::FileType::FTDIS && ftdisFile)
+		return ftdisFile->size * 0.01 - this->timeOffset;
+	return -this->timeOffset;
+}
+
+
 void Track::SetCursorPos(int cursorPos) {
 	this->cursorPos = cursorPos;
 }
@@ -76,6 +76,12 @@ public:
 	void SetTimeOffset(double offSet);
 	double GetTimeOffset();
 
+	/**
+	* Returns the first/last record of the track on the time line of the replay, i.e. incl. the time offset (in s)
+	*/
+	double GetStartTime();
+	double GetEndTime();
+
 	void SetCursorPos(int cursorPos);
 	int GetCursorPos();
 	
@@ -0,0 +1,149 @@
+#include "TrackActivationScheduler.h"
+#include "Track.h"
+#include <limits>
+
+/**
+* Constructor / Destructor
+*/
+TrackActivationScheduler::TrackActivationScheduler() {
+
+}
+
+TrackActivationScheduler::~TrackActivationScheduler() {
+
+}
+
+
+/**
+* Rebuilds both heaps for the given time
+*/
+void TrackActivationScheduler::Rebuild(double timeSec) {
+	dormant = MinHeap();
+	active = MinHeap();
+
+	for (UINT track = 0; track < tracks.size(); track++) {
+		TrackWindow& window = tracks[track];
+		if (!window.scheduled)
+			continue;
+
+		bool inWindow = window.startSec - leadTimeSec <= timeSec && timeSec <= window.endSec;
+
+		// Active tracks outside of their window are retired with the next update
+		if (window.active)
+			active.push({ inWindow ? window.endSec : -std::numeric_limits<double>::infinity(), track });
+
+		// Tracks not active (anymore) are activated again, unless past their last record
+		if ((!window.active || !inWindow) && timeSec <= window.endSec)
+			dormant.push({ window.startSec - leadTimeSec, track });
+	}
+}
+
+
+/**
+* Removes all tracks and schedules the AI tracks given
+*/
+void TrackActivationScheduler::Reset(const std::vector<Track*>& trackList) {
+	tracks.clear();
+	activeCount = 0;
+	timeSec = 0;
+
+	for (Track* track : trackList) {
+		bool scheduled = track->GetTrackType() == Track::TrackType::AI;
+		tracks.push_back({ track->GetStartTime(), track->GetEndTime(), scheduled, false });
+	}
+
+	this->Rebuild(timeSec);
+}
+
+
+/**
+* Sets the time an AI object is spawned before the first record of its track
+*/
+void TrackActivationScheduler::SetLeadTime(double leadTimeSec) {
+	this->leadTimeSec = leadTimeSec > 0 ? leadTimeSec : 0;
+	this->Rebuild(timeSec);
+}
+
+
+/**
+* Returns the time an AI object is spawned before the first record of its track
+*/
+double TrackActivationScheduler::GetLeadTime() const {
+	return leadTimeSec;
+}
+
+
+/**
+* Advances the scheduler to the given time and returns the tracks to retire and to activate
+*/
+void TrackActivationScheduler::Update(double timeSec, std::vector<UINT>& retire, std::vector<UINT>& activate) {
+	retire.clear();
+	activate.clear();
+
+	// Heaps are ordered by time running forward, i.e. rebuild if running backwards (O(n log n), rare)
+	if (timeSec < this->timeSec)
+		this->Rebuild(timeSec);
+	this->timeSec = timeSec;
+
+	// Retire first, i.e. AI objects are removed before new ones are spawned
+	while (!active.empty() && active.top().first < timeSec) {
+		UINT track = active.top().second;
+		active.pop();
+
+		tracks[track].active = false;
+		activeCount--;
+		stats.retired++;
+		retire.push_back(track);
+	}
+
+	while (!dormant.empty() && dormant.top().first <= timeSec) {
+		UINT track = dormant.top().second;
+		dormant.pop();
+
+		// Skipped, e.g. by a seek beyond the last record
+		TrackWindow& window = tracks[track];
+		if (window.active || window.endSec < timeSec)
+			continue;
+
+		window.active = true;
+		activeCount++;
+		stats.activated++;
+		active.push({ window.endSec, track });
+		activate.push_back(track);
+	}
+
+	if (activeCount > stats.peakActive)
+		stats.peakActive = activeCount;
+}
+
+
+/**
+* Returns true, if the track is scheduled and currently active
+*/
+bool TrackActivationScheduler::IsActive(UINT track) const {
+	return track < tracks.size() && tracks[track].scheduled && tracks[track].active;
+}
+
+
+/**
+* Returns true, if the track is scheduled, i.e. an AI track
+*/
+bool TrackActivationScheduler::IsScheduled(UINT track) const {
+	return track < tracks.size() && tracks[track].scheduled;
+}
+
+
+/**
+* Returns the number of tracks
+*/
+size_t TrackActivationScheduler::GetSize() const {
+	return tracks.size();
+}
+
+
+/**
+* Returns the number of tracks currently active
+*/
+size_t TrackActivationScheduler::GetActiveCount() const {
+	return activeCount;
+}
@@ -0,0 +1,116 @@
+#ifndef TrackActivationScheduler_H
+#define TrackActivationScheduler_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Forward declarations to avoid circular include.
+class Track; // #include "Track.h" in .cpp file
+
+/**
+* Activation scheduler of the AI tracks
+*
+* Keeps the dormant AI tracks in a min-heap keyed by their start on the time line of the replay, i.e.
+* incl. the time offset of the track, and the active AI tracks in a min-heap keyed by their end. A track
+* is activated the lead time before its first record, i.e. its AI object is spawned in time to be placed
+* in the sim, and retired after its last record. The sim only holds the AI objects of the tracks currently
+* active, independent of the total number of tracks of the scenario.
+*
+* Time running backwards (reverse replay rate, seek) rebuilds both heaps from the state of the tracks
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class TrackActivationScheduler {
+
+public:
+	struct Stats {
+		uint64_t activated = 0;		// Tracks activated, i.e. AI objects spawned
+		uint64_t retired = 0;		// Tracks retired, i.e. AI objects removed
+		size_t peakActive = 0;		// Max. number of tracks active at the same time
+	};
+
+	TrackActivationScheduler();
+	~TrackActivationScheduler();
+
+private:
+	struct TrackWindow {
+		double startSec;
+		double endSec;
+		bool scheduled;
+		bool active;
+	};
+
+	typedef std::pair<double, UINT> Entry;
+	typedef std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> MinHeap;
+
+	std::vector<TrackWindow> tracks;
+	MinHeap dormant;
+	MinHeap active;
+	size_t activeCount = 0;
+	double leadTimeSec = 10.0, timeSec = 0;
+
+	/**
+	* Rebuilds both heaps for the given time, i.e. after the time has run backwards
+	*/
+	void Rebuild(double timeSec);
+
+public:
+	Stats stats;
+
+	/**
+	* Removes all tracks and schedules the AI tracks given. All AI tracks are dormant, USER tracks aren't scheduled
+	*
+	* @param	trackList	Tracks of the replay
+	* @return	void
+	*/
+	void Reset(const std::vector<Track*>& trackList);
+
+	/**
+	* Sets the time an AI object is spawned before the first record of its track
+	*
+	* @param	leadTimeSec		Lead time in s
+	* @return	void
+	*/
+	void SetLeadTime(double leadTimeSec);
+
+	/**
+	* Returns the time an AI object is spawned before the first record of its track
+	*/
+	double GetLeadTime() const;
+
+	/**
+	* Advances the scheduler to the given time on the time line of the replay and returns the tracks
+	* to retire and to activate
+	*
+	* @param	timeSec		Replay time in s
+	* @param	retire		Tracks to retire, i.e. to remove the AI object of (out)
+	* @param	activate	Tracks to activate, i.e. to spawn the AI object of (out)
+	* @return	void
+	*/
+	void Update(double timeSec, std::vector<UINT>& retire, std::vector<UINT>& activate);
+
+	/**
+	* Returns true, if the track is scheduled and currently active
+	*/
+	bool IsActive(UINT track) const;
+
+	/**
+	* Returns true, if the track is scheduled, i.e. an AI track
+	*/
+	bool IsScheduled(UINT track) const;
+
+	/**
+	* Returns the number of tracks
+	*/
+	size_t GetSize() const;
+
+	/**
+	* Returns the number of tracks currently active
+	*/
+	size_t GetActiveCount() const;
+};
+#endif
@@ -0,0 +1,137 @@
+#define _USE_MATH_DEFINES
+#include "TrackInterpolation.h"
+#include <cmath>
+
+namespace TrackInterpolation
+{
+	/**
+	* Interpolates between two positions along the great circle
+	*/
+	void greatCircle(double lat0, double lon0, double lat1, double lon1, double t, double& lat, double& lon) {
+		const double rad = M_PI / 180.0;
+
+		// Unit vectors of both positions
+		double x0 = cos(lat0 * rad) * cos(lon0 * rad), y0 = cos(lat0 * rad) * sin(lon0 * rad), z0 = sin(lat0 * rad);
+		double x1 = cos(lat1 * rad) * cos(lon1 * rad), y1 = cos(lat1 * rad) * sin(lon1 * rad), z1 = sin(lat1 * rad);
+
+		// Central angle (atan2 is accurate for the small angles between two records)
+		double cx = y0 * z1 - z0 * y1, cy = z0 * x1 - x0 * z1, cz = x0 * y1 - y0 * x1;
+		double omega = atan2(sqrt(cx * cx + cy * cy + cz * cz), x0 * x1 + y0 * y1 + z0 * z1);
+
+		double w0 = 1 - t, w1 = t;
+		if (omega > 1e-12) {
+			w0 = sin((1 - t) * omega) / sin(omega);
+			w1 = sin(t * omega) / sin(omega);
+		}
+
+		double x = w0 * x0 + w1 * x1, y = w0 * y0 + w1 * y1, z = w0 * z0 + w1 * z1;
+		lat = atan2(z, sqrt(x * x + y * y)) / rad;
+		lon = atan2(y, x) / rad;
+	}
+
+
+	/**
+	* Cubic Hermite interpolation between two values
+	*/
+	double hermite(double p0, double p1, double m0, double m1, double t) {
+		double t2 = t * t, t3 = t2 * t;
+		return (2 * t3 - 3 * t2 + 1) * p0 + (t3 - 2 * t2 + t) * m0 + (-2 * t3 + 3 * t2) * p1 + (t3 - t2) * m1;
+	}
+
+
+	/**
+	* Interpolates between two angles along the shortest arc
+	*/
+	double shortestArc(double a0, double a1, double t, double lo) {
+		double delta = fmod(a1 - a0, 360.0);
+		if (delta >= 180.0)
+			delta -= 360.0;
+		else if (delta < -180.0)
+			delta += 360.0;
+
+		double angle = fmod(a0 + t * delta - lo, 360.0);
+		if (angle < 0)
+			angle += 360.0;
+		return angle + lo;
+	}
+
+
+	/**
+	* Returns the slope (per s) of a channel at a record. Zero at local extrema, limited
+	* otherwise (Fritsch-Carlson), i.e. the interpolated curve doesn't overshoot
+	*/
+	static double getSlope(const std::vector<double>& values, const std::vector<float>& times, size_t pos) {
+		bool hasLeft = pos > 0 && times[pos] > times[pos - 1];
+		bool hasRight = pos + 1 < values.size() && times[pos + 1] > times[pos];
+		double left = hasLeft ? (values[pos] - values[pos - 1]) / (times[pos] - times[pos - 1]) : 0;
+		double right = hasRight ? (values[pos + 1] - values[pos]) / (times[pos + 1] - times[pos]) : 0;
+
+		if (!hasLeft)
+			return right;
+		if (!hasRight)
+			return left;
+		if (left * right <= 0)
+			return 0;
+
+		double slope = (left + right) / 2;
+		double limit = 3 * fmin(fabs(left), fabs(right));
+		return slope > 0 ? fmin(slope, limit) : fmax(slope, -limit);
+	}
+
+
+	/**
+	* Monotone cubic Hermite interpolation of a channel between two records
+	*/
+	static double getCubic(const FDRTrackColumns& columns, FDRTrackColumns::Channel channel, size_t pos, double h, double t) {
+		const std::vector<double>& values = columns.GetChannel(channel);
+		return hermite(values[pos], values[pos + 1], getSlope(values, columns.GetTimes(), pos) * h, getSlope(values, columns.GetTimes(), pos + 1) * h, t);
+	}
+
+
+	/**
+	* Returns the interpolated position of a track at the given time
+	*/
+	PosDataSet getPosition(const FDRTrackColumns& columns, size_t pos, double seconds) {
+		PosDataSet posSet = {};
+		size_t size = columns.GetSize();
+		if (size == 0)
+			return posSet;
+
+		// Find the records enclosing the given time, starting at the cursor (usually no more than one step)
+		if (pos >= size)
+			pos = size - 1;
+		while (pos + 1 < size && columns.GetTime(pos + 1) <= seconds)
+			pos++;
+		while (pos > 0 && columns.GetTime(pos) > seconds)
+			pos--;
+
+		double h = pos + 1 < size ? columns.GetTime(pos + 1) - columns.GetTime(pos) : 0;
+		double t = h > 0 ? (seconds - columns.GetTime(pos)) / h : 0;
+
+		// Before the first / after the last record or duplicate time stamps: no interpolation
+		if (t <= 0 || h <= 0) {
+			posSet.lat = columns.Get(FDRTrackColumns::lat, pos);
+			posSet.lon = columns.Get(FDRTrackColumns::lon, pos);
+			posSet.alt = columns.Get(FDRTrackColumns::alt, pos);
+			posSet.spd = columns.Get(FDRTrackColumns::spd, pos);
+			posSet.hdg = columns.Get(FDRTrackColumns::hdg, pos);
+			posSet.pitch = columns.Get(FDRTrackColumns::pitch, pos);
+			posSet.bank = columns.Get(FDRTrackColumns::bank, pos);
+			return posSet;
+		}
+		if (t > 1)
+			t = 1;
+
+		greatCircle(columns.Get(FDRTrackColumns::lat, pos), columns.Get(FDRTrackColumns::lon, pos),
+			columns.Get(FDRTrackColumns::lat, pos + 1), columns.Get(FDRTrackColumns::lon, pos + 1), t, posSet.lat, posSet.lon);
+
+		posSet.alt = getCubic(columns, FDRTrackColumns::alt, pos, h, t);
+		posSet.spd = getCubic(columns, FDRTrackColumns::spd, pos, h, t);
+
+		posSet.hdg = shortestArc(columns.Get(FDRTrackColumns::hdg, pos), columns.Get(FDRTrackColumns::hdg, pos + 1), t, 0);
+		posSet.pitch = shortestArc(columns.Get(FDRTrackColumns::pitch, pos), columns.Get(FDRTrackColumns::pitch, pos + 1), t, -180);
+		posSet.bank = shortestArc(columns.Get(FDRTrackColumns::bank, pos), columns.Get(FDRTrackColumns::bank, pos + 1), t, -180);
+
+		return posSet;
+	}
+}
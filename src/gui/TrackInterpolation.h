@@ -0,0 +1,69 @@
+#ifndef TrackInterpolation_H
+#define TrackInterpolation_H
+
+#include <cstddef>
+#include "PosDataSet.h"
+#include "FDRTrackColumns.h"
+
+/**
+* Custom defined name space to collect the functions required to interpolate the position of an
+* aircraft between two records of a track (sub-frame replay)
+*
+* Replay time rarely matches the time stamp of a record, e.g. at half rate or if sim and recording
+* frame rates differ. Instead of snapping to the nearest record, the position is interpolated:
+* (1) lat/lon -> great-circle (spherical linear interpolation)
+* (2) alt/spd -> monotone cubic Hermite, i.e. smooth without overshooting the recorded values (e.g. below ground)
+* (3) hdg/pitch/bank -> shortest arc, i.e. no spin at the 0/360 (hdg) or -180/180 (bank) boundary
+*
+* @author muppetlabs@fswindowseat.com
+*/
+namespace TrackInterpolation
+{
+	/**
+	* Interpolates between two positions along the great circle
+	*
+	* @param	lat0		Latitude of the first position in degrees
+	* @param	lon0		Longitude of the first position in degrees
+	* @param	lat1		Latitude of the second position in degrees
+	* @param	lon1		Longitude of the second position in degrees
+	* @param	t			Fraction 0 (first position) - 1 (second position)
+	* @param	lat			Receives the interpolated latitude in degrees
+	* @param	lon			Receives the interpolated longitude in degrees (-180 - 180)
+	* @return	void
+	*/
+	void greatCircle(double lat0, double lon0, double lat1, double lon1, double t, double& lat, double& lon);
+
+	/**
+	* Cubic Hermite interpolation between two values
+	*
+	* @param	p0			First value
+	* @param	p1			Second value
+	* @param	m0			Slope at the first value (per interval)
+	* @param	m1			Slope at the second value (per interval)
+	* @param	t			Fraction 0 (first value) - 1 (second value)
+	* @return	double		Interpolated value
+	*/
+	double hermite(double p0, double p1, double m0, double m1, double t);
+
+	/**
+	* Interpolates between two angles along the shortest arc
+	*
+	* @param	a0			First angle in degrees
+	* @param	a1			Second angle in degrees
+	* @param	t			Fraction 0 (first angle) - 1 (second angle)
+	* @param	lo			Lower end of the range of the result, e.g. 0 (hdg) or -180 (bank). Range is [lo, lo + 360)
+	* @return	double		Interpolated angle in degrees
+	*/
+	double shortestArc(double a0, double a1, double t, double lo);
+
+	/**
+	* Returns the interpolated position of a track at the given time
+	*
+	* @param	columns		Address of the columns of the track
+	* @param	pos			Record near the given time, e.g. the file cursor
+	* @param	seconds		Time in s. Clamped to the first/last record of the track
+	* @return	PosDataSet	Interpolated position (lat, lon, alt, spd, hdg, pitch, bank)
+	*/
+	PosDataSet getPosition(const FDRTrackColumns& columns, size_t pos, double seconds);
+}
+#endif
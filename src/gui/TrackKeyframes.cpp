@@ -0,0 +1,96 @@
+#include "TrackKeyframes.h"
+#include <algorithm>
+
+/**
+* Constructor / Destructor
+*/
+TrackKeyframes::TrackKeyframes(double intervalSec, Stats* stats) {
+	this->intervalSec = intervalSec > 0 ? intervalSec : 30.0;
+	this->stats = stats;
+}
+
+TrackKeyframes::~TrackKeyframes() {
+
+}
+
+
+/**
+* Removes all keyframes
+*/
+void TrackKeyframes::Clear() {
+	keyframes.clear();
+	built = false;
+}
+
+
+/**
+* Takes a snapshot, if due
+*/
+bool TrackKeyframes::Capture(const Keyframe& keyframe) {
+	if (!keyframes.empty() && keyframe.timeSec < keyframes.back().timeSec + intervalSec)
+		return false;
+
+	keyframes.push_back(keyframe);
+	if (stats)
+		stats->keyframes++;
+	return true;
+}
+
+
+/**
+* Marks the keyframes as complete
+*/
+void TrackKeyframes::SetBuilt() {
+	built = true;
+	if (stats)
+		stats->builds++;
+}
+
+
+/**
+* Returns true, if the keyframes are complete
+*/
+bool TrackKeyframes::IsBuilt() const {
+	return built;
+}
+
+
+/**
+* Returns the last keyframe at or before the given time
+*/
+const TrackKeyframes::Keyframe* TrackKeyframes::Find(double timeSec) {
+	// Keyframes are in time order, i.e. binary search
+	auto next = std::upper_bound(keyframes.begin(), keyframes.end(), timeSec,
+		[](double time, const Keyframe& keyframe) { return time < keyframe.timeSec; });
+	if (next == keyframes.begin())
+		return nullptr;
+
+	if (stats)
+		stats->restores++;
+	return &*(next - 1);
+}
+
+
+/**
+* Counts the records fast-forwarded after a restore
+*/
+void TrackKeyframes::AddSteps(uint64_t steps) {
+	if (stats)
+		stats->steps += steps;
+}
+
+
+/**
+* Returns the time between two keyframes in s
+*/
+double TrackKeyframes::GetInterval() const {
+	return intervalSec;
+}
+
+
+/**
+* Returns the number of keyframes
+*/
+size_t TrackKeyframes::GetSize() const {
+	return keyframes.size();
+}
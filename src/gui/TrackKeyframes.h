@@ -0,0 +1,111 @@
+#ifndef TrackKeyframes_H
+#define TrackKeyframes_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <vector>
+#include "SimModelState.h"
+
+/**
+* Keyframes of a track
+*
+* Snapshots of the state derived from the replay so far, i.e. the procedural state of the sim model
+* (APU and engine start procedures, spoilers) and of the co-processor (throttle ramp), taken every
+* keyframe interval. The keyframes are built with a dry run of the whole track (see Processor::BeginDryRun),
+* a seek restores the last keyframe before the seek position and fast-forwards from there, i.e. the cost
+* of a seek is bounded by the keyframe interval rather than by the position in the track
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class TrackKeyframes {
+
+public:
+	struct Keyframe {
+		double timeSec;				// Time of the snapshot, i.e. time of the record at the cursor position
+		int cursorPos;				// Record to process next, i.e. the fast-forward starts here
+		SimModelState modelState;	// Procedural state of the sim model
+		double thrtPos;				// Throttle position of the throttle ramp (FTDIS)
+		bool engineStopped;			// Engines stopped after landing (FTDIS)
+	};
+
+	/**
+	* Keyframe counters, shared by the keyframes of all tracks
+	*/
+	struct Stats {
+		uint64_t builds = 0;		// Tracks swept by a dry run
+		uint64_t keyframes = 0;		// Keyframes taken
+		uint64_t restores = 0;		// Seeks started from a keyframe
+		uint64_t steps = 0;			// Records fast-forwarded from the keyframe to the seek position
+	};
+
+	/**
+	* Constructor
+	*
+	* @param	intervalSec		Time between two keyframes in s
+	* @param	stats			Keyframe counters (optional)
+	*/
+	TrackKeyframes(double intervalSec = 30.0, Stats* stats = nullptr);
+	~TrackKeyframes();
+
+private:
+	std::vector<Keyframe> keyframes;
+	double intervalSec = 30.0;
+	bool built = false;
+	Stats* stats = nullptr;
+
+public:
+	/**
+	* Removes all keyframes
+	*
+	* @param	void
+	* @return	void
+	*/
+	void Clear();
+
+	/**
+	* Takes a snapshot, if due, i.e. the first snapshot or at least the keyframe interval after the last one.
+	* Snapshots are taken in time order
+	*
+	* @param	keyframe	Snapshot
+	* @return	bool		True, if the snapshot has been taken
+	*/
+	bool Capture(const Keyframe& keyframe);
+
+	/**
+	* Marks the keyframes as complete, i.e. the dry run reached the end of the track
+	*/
+	void SetBuilt();
+
+	/**
+	* Returns true, if the keyframes are complete
+	*/
+	bool IsBuilt() const;
+
+	/**
+	* Returns the last keyframe at or before the given time, nullptr if there is none
+	*
+	* @param	timeSec		Time in s
+	* @return	Keyframe*
+	*/
+	const Keyframe* Find(double timeSec);
+
+	/**
+	* Counts the records fast-forwarded after a restore
+	*
+	* @param	steps		Number of records
+	* @return	void
+	*/
+	void AddSteps(uint64_t steps);
+
+	/**
+	* Returns the time between two keyframes in s
+	*/
+	double GetInterval() const;
+
+	/**
+	* Returns the number of keyframes
+	*/
+	size_t GetSize() const;
+};
+#endif
@@ -0,0 +1,263 @@
+#define _USE_MATH_DEFINES
+#include "TrafficLodScheduler.h"
+#include <cmath>
+
+/**
+* Constructor / Destructor
+*/
+TrafficLodScheduler::TrafficLodScheduler(double nearbyNm, double midRangeNm) {
+	this->nearbyNm = nearbyNm;
+	this->midRangeNm = midRangeNm;
+	this->cellLatDeg = nearbyNm / 60.0;
+}
+
+TrafficLodScheduler::~TrafficLodScheduler() {
+
+}
+
+
+/**
+* Returns the grid cell of a position
+*/
+int64_t TrafficLodScheduler::GetCell(double lat, double lon) const {
+	int64_t row = (int64_t)std::floor(lat / cellLatDeg);
+	int64_t col = (int64_t)std::floor((WrapLon(lon) + 180.0) / cellLonDeg);
+	return this->GetCell(row, col);
+}
+
+
+/**
+* Returns the grid cell of a row and a column
+*/
+int64_t TrafficLodScheduler::GetCell(int64_t row, int64_t col) const {
+	col %= colCount;
+	if (col < 0)
+		col += colCount;
+	return (int64_t)(((uint64_t)row << 32) ^ ((uint64_t)col & 0xFFFFFFFF));
+}
+
+
+/**
+* Returns the longitude in [-180, 180) degrees
+*/
+double TrafficLodScheduler::WrapLon(double lon) {
+	lon = std::fmod(lon + 180.0, 360.0);
+	if (lon < 0)
+		lon += 360.0;
+	return lon - 180.0;
+}
+
+
+/**
+* Places all tracks in the grid again
+*/
+void TrafficLodScheduler::Rebuild(double lat) {
+	// Cell width in degrees of longitude at the reference latitude, i.e. the cells are square. The columns
+	// divide the globe evenly, i.e. the last column ends at the antimeridian
+	double cosLat = std::cos(lat * M_PI / 180.0);
+	if (cosLat < 0.01)
+		cosLat = 0.01;
+
+	refLat = lat;
+	colCount = (int64_t)std::ceil(360.0 / (nearbyNm / (60.0 * cosLat)));
+	cellLonDeg = 360.0 / colCount;
+	gridInit = true;
+
+	grid.clear();
+	for (UINT track = 0; track < tracks.size(); track++) {
+		if (!tracks[track].inGrid)
+			continue;
+
+		tracks[track].cell = this->GetCell(tracks[track].lat, tracks[track].lon);
+		grid[tracks[track].cell].push_back(track);
+	}
+}
+
+
+/**
+* Removes a track from its grid cell
+*/
+void TrafficLodScheduler::RemoveFromCell(UINT track) {
+	auto cell = grid.find(tracks[track].cell);
+	if (cell == grid.end())
+		return;
+
+	std::vector<UINT>& cellTracks = cell->second;
+	for (size_t i = 0; i < cellTracks.size(); i++) {
+		if (cellTracks[i] == track) {
+			cellTracks[i] = cellTracks.back();
+			cellTracks.pop_back();
+			break;
+		}
+	}
+	if (cellTracks.empty())
+		grid.erase(cell);
+}
+
+
+/**
+* Removes all tracks and resizes the scheduler to the given number of tracks
+*/
+void TrafficLodScheduler::Reset(size_t trackCount) {
+	grid.clear();
+	classified.clear();
+	tracks.assign(trackCount, { 0, distant, false, 0.0, 0.0, 0.0 });
+	timeSec = 0;
+	gridInit = false;
+
+	// Stagger the updates of distant tracks over the update period
+	for (UINT track = 0; track < tracks.size(); track++)
+		tracks[track].nextUpdateSec = distantPeriodSec * std::fmod(track * 0.618034, 1.0);
+}
+
+
+/**
+* Sets the update rates of mid-range and distant tracks
+*/
+void TrafficLodScheduler::SetRates(double midRangeHz, double distantHz) {
+	if (midRangeHz > 0)
+		midRangePeriodSec = 1.0 / midRangeHz;
+	if (distantHz > 0)
+		distantPeriodSec = 1.0 / distantHz;
+}
+
+
+/**
+* Sets the position of a track
+*/
+void TrafficLodScheduler::SetPosition(UINT track, double lat, double lon) {
+	if (track >= tracks.size())
+		return;
+
+	TrackLod& trackLod = tracks[track];
+	trackLod.lat = lat;
+	trackLod.lon = lon;
+
+	// Tracks are placed in the grid with the first classification (see Rebuild)
+	if (!gridInit) {
+		trackLod.inGrid = true;
+		return;
+	}
+
+	int64_t cell = this->GetCell(lat, lon);
+	if (trackLod.inGrid && cell == trackLod.cell)
+		return;
+
+	if (trackLod.inGrid)
+		this->RemoveFromCell(track);
+
+	trackLod.cell = cell;
+	trackLod.inGrid = true;
+	grid[cell].push_back(track);
+}
+
+
+/**
+* Classifies the tracks around the user aircraft and advances the scheduler's clock by one frame
+*/
+void TrafficLodScheduler::Classify(double lat, double lon, double hdg, double frameTimeSec) {
+	timeSec += frameTimeSec;
+
+	// Cells get distorted away from the reference latitude
+	if (!gridInit || std::fabs(lat - refLat) > 1.0)
+		this->Rebuild(lat);
+
+	// Tracks classified in the previous frame are distant, unless classified again
+	for (UINT track : classified)
+		tracks[track].level = distant;
+	classified.clear();
+
+	// Cells within the mid-range radius, i.e. (ring - 1) * cell size <= mid-range radius. The cell width
+	// (nm) depends on the current latitude, i.e. the cells are narrower towards the poles than at refLat
+	double cosLat = std::cos(lat * M_PI / 180.0);
+	double cellLonNm = cellLonDeg * 60.0 * std::fmax(cosLat, 0.0);
+	int64_t rows = (int64_t)(midRangeNm / nearbyNm) + 1;
+	int64_t cols = cellLonNm > 0 ? (int64_t)std::fmin(midRangeNm / cellLonNm + 1.0, (double)colCount) : colCount;
+	int64_t userRow = (int64_t)std::floor(lat / cellLatDeg);
+	int64_t userCol = (int64_t)std::floor((WrapLon(lon) + 180.0) / cellLonDeg);
+
+	// Every column once, i.e. the columns around the user aircraft overlap after wrapping around the globe
+	int64_t firstCol = userCol - cols, lastCol = userCol + cols;
+	if (lastCol - firstCol >= colCount)
+		lastCol = firstCol + colCount - 1;
+
+	for (int64_t row = userRow - rows; row <= userRow + rows; row++) {
+		for (int64_t col = firstCol; col <= lastCol; col++) {
+			auto cell = grid.find(this->GetCell(row, col));
+			if (cell == grid.end())
+				continue;
+
+			for (UINT track : cell->second) {
+				TrackLod& trackLod = tracks[track];
+
+				// Distance (nm) and relative bearing (degrees), flat earth approximation
+				double northNm = (trackLod.lat - lat) * 60.0;
+				double eastNm = WrapLon(trackLod.lon - lon) * 60.0 * cosLat;
+				double distNm = std::sqrt(northNm * northNm + eastNm * eastNm);
+
+				Level level = distNm <= nearbyNm ? nearby : (distNm <= midRangeNm ? midRange : distant);
+				if (level == distant)
+					continue;
+
+				double relBearing = std::fmod(std::atan2(eastNm, northNm) * 180.0 / M_PI - hdg + 540.0, 360.0) - 180.0;
+				if (std::fabs(relBearing) > fieldOfViewDeg / 2)
+					level = (Level)(level + 1);
+
+				trackLod.level = level;
+				classified.push_back(track);
+			}
+		}
+	}
+}
+
+
+/**
+* Returns the update of a track for the current frame, and schedules its next update
+*/
+TrafficLodScheduler::Update TrafficLodScheduler::Schedule(UINT track) {
+	if (track >= tracks.size()) {
+		stats.full++;
+		return full;
+	}
+
+	TrackLod& trackLod = tracks[track];
+	if (trackLod.level == nearby) {
+		stats.full++;
+		return full;
+	}
+
+	// Fixed period, i.e. the update rate doesn't depend on the frame rate of the sim
+	double periodSec = trackLod.level == midRange ? midRangePeriodSec : distantPeriodSec;
+
+	// Track moved closer, i.e. the update scheduled at the lower rate is too late
+	if (trackLod.nextUpdateSec > timeSec + periodSec)
+		trackLod.nextUpdateSec = timeSec;
+
+	if (timeSec < trackLod.nextUpdateSec) {
+		stats.skipped++;
+		return skip;
+	}
+
+	trackLod.nextUpdateSec += periodSec;
+	if (trackLod.nextUpdateSec <= timeSec)
+		trackLod.nextUpdateSec = timeSec + periodSec;
+
+	stats.position++;
+	return position;
+}
+
+
+/**
+* Returns the level of detail of a track
+*/
+TrafficLodScheduler::Level TrafficLodScheduler::GetLevel(UINT track) const {
+	return track < tracks.size() ? tracks[track].level : distant;
+}
+
+
+/**
+* Returns the number of tracks
+*/
+size_t TrafficLodScheduler::GetSize() const {
+	return tracks.size();
+}
@@ -0,0 +1,154 @@
+#ifndef TrafficLodScheduler_H
+#define TrafficLodScheduler_H
+#define _WINSOCKAPI_
+
+#include <windows.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Level of detail scheduler of the AI traffic
+*
+* Determines how often the sim object of an AI track is updated, based on its distance to the user
+* aircraft and whether it is in front of the user aircraft, i.e. likely on screen. Nearby aircraft are
+* updated every frame incl. their systems, mid-range aircraft at 10 Hz and distant aircraft at 1 Hz,
+* both position only. Off screen aircraft drop one level.
+*
+* The tracks are kept in a spatial grid with a cell size of the nearby radius. Only the tracks in the
+* cells around the user aircraft are classified by distance, all other tracks are distant, i.e. the cost
+* of a frame depends on the number of tracks close to the user aircraft rather than the total number of
+* tracks. A track only changes cells when it moves across a cell boundary. The columns wrap around at the
+* antimeridian
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class TrafficLodScheduler {
+
+public:
+	enum Level : uint8_t {
+		nearby = 0,
+		midRange,
+		distant
+	};
+
+	enum Update : uint8_t {
+		skip = 0,
+		position,
+		full
+	};
+
+	struct Stats {
+		uint64_t full = 0;			// Updates incl. systems
+		uint64_t position = 0;		// Position only updates
+		uint64_t skipped = 0;		// Frames skipped
+	};
+
+	TrafficLodScheduler(double nearbyNm = 5.0, double midRangeNm = 20.0);
+	~TrafficLodScheduler();
+
+private:
+	struct TrackLod {
+		int64_t cell;
+		Level level;
+		bool inGrid;
+		double nextUpdateSec;
+		double lat;
+		double lon;
+	};
+
+	std::vector<TrackLod> tracks;
+	std::unordered_map<int64_t, std::vector<UINT>> grid;
+	std::vector<UINT> classified;
+
+	double nearbyNm = 5.0, midRangeNm = 20.0, fieldOfViewDeg = 120.0;
+	double midRangePeriodSec = 0.1, distantPeriodSec = 1.0;
+	double refLat = 0, cellLonDeg = 0, cellLatDeg = 0, timeSec = 0;
+	int64_t colCount = 1;
+	bool gridInit = false;
+
+	/**
+	* Returns the grid cell of a position
+	*/
+	int64_t GetCell(double lat, double lon) const;
+
+	/**
+	* Returns the grid cell of a row and a column, the column wraps around at the antimeridian
+	*/
+	int64_t GetCell(int64_t row, int64_t col) const;
+
+	/**
+	* Returns the longitude in [-180, 180) degrees
+	*/
+	static double WrapLon(double lon);
+
+	/**
+	* Places all tracks in the grid again, i.e. after the reference latitude has changed
+	*/
+	void Rebuild(double lat);
+
+	/**
+	* Removes a track from its grid cell
+	*/
+	void RemoveFromCell(UINT track);
+
+public:
+	Stats stats;
+
+	/**
+	* Removes all tracks and resizes the scheduler to the given number of tracks. All tracks are distant
+	*
+	* @param	trackCount	Number of tracks
+	* @return	void
+	*/
+	void Reset(size_t trackCount);
+
+	/**
+	* Sets the update rates of mid-range and distant tracks
+	*
+	* @param	midRangeHz	Updates per second of mid-range tracks
+	* @param	distantHz	Updates per second of distant tracks
+	* @return	void
+	*/
+	void SetRates(double midRangeHz, double distantHz);
+
+	/**
+	* Sets the position of a track, moves the track to another grid cell if required
+	*
+	* @param	track	Track index
+	* @param	lat		Latitude in degrees
+	* @param	lon		Longitude in degrees
+	* @return	void
+	*/
+	void SetPosition(UINT track, double lat, double lon);
+
+	/**
+	* Classifies the tracks around the user aircraft and advances the scheduler's clock by one frame
+	*
+	* @param	lat				Latitude of the user aircraft in degrees
+	* @param	lon				Longitude of the user aircraft in degrees
+	* @param	hdg				True heading of the user aircraft in degrees
+	* @param	frameTimeSec	Duration of the frame in s
+	* @return	void
+	*/
+	void Classify(double lat, double lon, double hdg, double frameTimeSec);
+
+	/**
+	* Returns the update of a track for the current frame, and schedules its next update
+	*
+	* @param	track	Track index
+	* @return	Update	Skip, position only or full update
+	*/
+	Update Schedule(UINT track);
+
+	/**
+	* Returns the level of detail of a track
+	*/
+	Level GetLevel(UINT track) const;
+
+	/**
+	* Returns the number of tracks
+	*/
+	size_t GetSize() const;
+};
+#endif
@@ -0,0 +1,136 @@
+#include "WorkStealingPool.h"
+
+/**
+* Constructor / Destructor
+*/
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	// One queue per worker plus the queue of the calling thread (last)
+	for (unsigned i = 0; i < threads; i++)
+		queues.push_back(std::make_unique<Queue>());
+
+	for (unsigned i = 0; i + 1 < threads; i++)
+		workers.emplace_back(&WorkStealingPool::WorkerLoop, this, (size_t)i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		stop = true;
+	}
+	workCond.notify_all();
+
+	for (auto& worker : workers)
+		worker.join();
+}
+
+
+/**
+* Worker thread, waits for a loop and runs its chunks
+*/
+void WorkStealingPool::WorkerLoop(size_t queueIndex) {
+	unsigned long long seenGeneration = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m);
+			workCond.wait(lock, [&] { return stop || generation != seenGeneration; });
+			if (stop)
+				return;
+			seenGeneration = generation;
+		}
+
+		while (this->RunChunk(queueIndex));
+	}
+}
+
+
+/**
+* Takes a chunk from the own queue or steals one from another queue and runs it
+*/
+bool WorkStealingPool::RunChunk(size_t queueIndex) {
+	Range range = { 0, 0 };
+	bool found = false;
+
+	// Own queue first (front), then steal from the others (back)
+	for (size_t i = 0; i < queues.size() && !found; i++) {
+		Queue& queue = *queues[(queueIndex + i) % queues.size()];
+		std::lock_guard<std::mutex> lockGuard(queue.m);
+		if (queue.ranges.empty())
+			continue;
+
+		if (i == 0) {
+			range = queue.ranges.front();
+			queue.ranges.pop_front();
+		}
+		else {
+			range = queue.ranges.back();
+			queue.ranges.pop_back();
+		}
+		found = true;
+	}
+
+	if (!found)
+		return false;
+
+	for (size_t i = range.begin; i < range.end; i++)
+		(*job)(i);
+
+	// Wake the calling thread once the last iteration has completed
+	if (pending.fetch_sub(range.end - range.begin, std::memory_order_acq_rel) == range.end - range.begin) {
+		std::lock_guard<std::mutex> lockGuard(m);
+		doneCond.notify_all();
+	}
+	return true;
+}
+
+
+/**
+* Runs fn(i) for i in [0, count) and returns once all iterations have completed
+*/
+void WorkStealingPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t)>& fn) {
+	if (grain == 0)
+		grain = 1;
+
+	if (workers.empty() || count <= grain) {
+		for (size_t i = 0; i < count; i++)
+			fn(i);
+		return;
+	}
+
+	job = &fn;
+	pending.store(count, std::memory_order_release);
+
+	// Deal chunks round robin, i.e. every thread starts with its own share of the loop
+	size_t queueIndex = 0;
+	for (size_t begin = 0; begin < count; begin += grain) {
+		Queue& queue = *queues[queueIndex];
+		std::lock_guard<std::mutex> lockGuard(queue.m);
+		queue.ranges.push_back({ begin, begin + grain < count ? begin + grain : count });
+		queueIndex = (queueIndex + 1) % queues.size();
+	}
+
+	{
+		std::lock_guard<std::mutex> lockGuard(m);
+		generation++;
+	}
+	workCond.notify_all();
+
+	// Take part in the loop, then wait for chunks still running on the workers
+	while (this->RunChunk(queues.size() - 1));
+
+	std::unique_lock<std::mutex> lock(m);
+	doneCond.wait(lock, [&] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+
+/**
+* Returns the number of threads incl. the calling thread
+*/
+unsigned WorkStealingPool::GetThreadCount() const {
+	return (unsigned)queues.size();
+}
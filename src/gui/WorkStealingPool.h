@@ -0,0 +1,88 @@
+#ifndef WorkStealingPool_H
+#define WorkStealingPool_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+* Work stealing thread pool
+*
+* Runs the iterations of a parallel loop on a fixed set of worker threads. The iterations are split
+* into chunks, which are dealt round robin to one queue per worker plus one queue of the calling thread.
+* Each thread takes chunks from the front of its own queue and, once empty, steals from the back of the
+* other queues, i.e. uneven chunks (e.g. tracks at different stages of the replay) don't leave threads idle.
+* The calling thread takes part in the loop and returns once all iterations have completed
+*
+* @author muppetlabs@fswindowseat.com
+*/
+class WorkStealingPool {
+
+public:
+	/**
+	* Constructor
+	*
+	* @param	threads		Number of threads incl. the calling thread, 0 for the number of cores
+	*/
+	WorkStealingPool(unsigned threads = 0);
+	~WorkStealingPool();
+
+private:
+	struct Range {
+		size_t begin;
+		size_t end;
+	};
+
+	struct Queue {
+		std::mutex m;
+		std::deque<Range> ranges;
+	};
+
+	std::vector<std::thread> workers;
+	std::vector<std::unique_ptr<Queue>> queues;
+
+	std::mutex m;
+	std::condition_variable workCond, doneCond;
+	const std::function<void(size_t)>* job = nullptr;
+	std::atomic<size_t> pending{ 0 };
+	unsigned long long generation = 0;
+	bool stop = false;
+
+private:
+	/**
+	* Worker thread, waits for a loop and runs its chunks
+	*/
+	void WorkerLoop(size_t queueIndex);
+
+	/**
+	* Takes a chunk from the own queue or steals one from another queue and runs it
+	*
+	* @param	queueIndex	Queue of the thread
+	* @return	bool		False if all queues are empty
+	*/
+	bool RunChunk(size_t queueIndex);
+
+public:
+	/**
+	* Runs fn(i) for i in [0, count) and returns once all iterations have completed. Runs inline
+	* if the pool has no workers or the count doesn't exceed the chunk size. Iterations must not
+	* depend on each other, the order of execution is undefined
+	*
+	* @param	count	Number of iterations
+	* @param	grain	Number of iterations per chunk
+	* @param	fn		Loop body
+	* @return	void
+	*/
+	void ParallelFor(size_t count, size_t grain, const std::function<void(size_t)>& fn);
+
+	/**
+	* Returns the number of threads incl. the calling thread
+	*/
+	unsigned GetThreadCount() const;
+};
+#endif
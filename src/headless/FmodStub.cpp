@@ -0,0 +1,58 @@
+#include "fmod_studio.hpp"
+
+/**
+* Stand-in of the FMOD Studio library for the headless build on Linux
+*
+* The sound system fails to initialize, i.e. the sound engine stays silent (see SimSoundEngine)
+*/
+namespace FMOD {
+	namespace Studio {
+		FMOD_RESULT System::create(System** system, unsigned int headerVersion) {
+			return FMOD_ERR_INTERNAL;
+		}
+
+		FMOD_RESULT System::initialize(int maxChannels, FMOD_STUDIO_INITFLAGS studioFlags, FMOD_INITFLAGS flags, void* extraDriverData) {
+			return FMOD_ERR_INTERNAL;
+		}
+
+		FMOD_RESULT System::release() {
+			return FMOD_OK;
+		}
+
+		FMOD_RESULT System::update() {
+			return FMOD_OK;
+		}
+
+		FMOD_RESULT System::loadBankFile(const char* fileName, FMOD_STUDIO_LOAD_BANK_FLAGS flags, Bank** bank) {
+			return FMOD_ERR_INTERNAL;
+		}
+
+		FMOD_RESULT System::getEvent(const char* pathOrId, EventDescription** description) const {
+			return FMOD_ERR_INTERNAL;
+		}
+
+		FMOD_RESULT Bank::unload() {
+			return FMOD_OK;
+		}
+
+		FMOD_RESULT EventDescription::createInstance(EventInstance** instance) const {
+			return FMOD_ERR_INTERNAL;
+		}
+
+		FMOD_RESULT EventInstance::release() {
+			return FMOD_OK;
+		}
+
+		FMOD_RESULT EventInstance::setParameterByName(const char* name, float value, bool ignoreSeekSpeed) {
+			return FMOD_OK;
+		}
+
+		FMOD_RESULT EventInstance::start() {
+			return FMOD_OK;
+		}
+
+		FMOD_RESULT EventInstance::stop(FMOD_STUDIO_STOP_MODE mode) {
+			return FMOD_OK;
+		}
+	}
+}
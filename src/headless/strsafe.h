@@ -0,0 +1,6 @@
+#ifndef HEADLESS_STRSAFE_H
+#define HEADLESS_STRSAFE_H
+
+// Stand-in of the Windows header for the headless build, see windows.h
+#include <windows.h>
+#endif
@@ -0,0 +1,6 @@
+#ifndef HEADLESS_TCHAR_H
+#define HEADLESS_TCHAR_H
+
+// Stand-in of the Windows header for the headless build, see windows.h
+#include <windows.h>
+#endif
@@ -0,0 +1,78 @@
+#ifndef HEADLESS_WINDOWS_H
+#define HEADLESS_WINDOWS_H
+
+/**
+* Minimal stand-in of the Windows API for the headless build on Linux (see CMakeLists.txt)
+*
+* Declares the types and macros used by the SimConnect and FMOD headers and by the headless
+* sources. The event and file mapping calls are not functional, i.e. the SimConnect link fails
+* to open and the local link (see LocalSimLink) is the only sim link on Linux
+*
+* @author muppetlabs@fswindowseat.com
+*/
+#include <cstdint>
+#include <cstddef>
+#include <cwchar>
+#include <ctime>
+#include <thread>
+#include <chrono>
+
+#define __stdcall
+#define __cdecl
+#define CALLBACK
+#define WINAPI
+
+typedef unsigned long DWORD;
+typedef void* HANDLE;
+typedef long HRESULT;
+typedef int BOOL;
+typedef unsigned int UINT;
+typedef unsigned char BYTE;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef wchar_t TCHAR;
+typedef unsigned short WORD;
+typedef long LONG;
+typedef unsigned long long ULONGLONG;
+typedef void* HWND;
+typedef void* HMODULE;
+typedef void* LPVOID;
+typedef const char* LPCSTR;
+typedef const wchar_t* LPCWSTR;
+typedef DWORD* LPDWORD;
+typedef struct _GUID { unsigned long Data1; unsigned short Data2; unsigned short Data3; unsigned char Data4[8]; } GUID;
+typedef struct tagRECT { LONG left, top, right, bottom; } RECT;
+typedef union { struct { DWORD LowPart; LONG HighPart; }; long long QuadPart; } LARGE_INTEGER;
+
+#define TRUE 1
+#define FALSE 0
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#define S_OK ((HRESULT)0)
+#define S_FALSE ((HRESULT)1)
+#define E_FAIL ((HRESULT)(int)0x80004005)
+#define MAX_PATH 260
+#define INFINITE 0xFFFFFFFF
+#define WAIT_OBJECT_0 0
+#define WAIT_TIMEOUT 258
+
+inline void Sleep(DWORD ms) {
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// Events aren't available, i.e. a wait returns right away (see SimConnectMessageSource)
+inline HANDLE CreateEvent(void*, BOOL, BOOL, const void*) { return nullptr; }
+inline BOOL CloseHandle(HANDLE) { return TRUE; }
+inline BOOL SetEvent(HANDLE) { return TRUE; }
+inline DWORD WaitForSingleObject(HANDLE, DWORD) { return WAIT_TIMEOUT; }
+
+inline DWORD GetModuleFileName(HMODULE, TCHAR* fileName, DWORD size) {
+	if (size > 0)
+		fileName[0] = 0;
+	return 0;
+}
+
+inline int localtime_s(struct tm* result, const time_t* time) {
+	return localtime_r(time, result) ? 0 : 1;
+}
+#endif
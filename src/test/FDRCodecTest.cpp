@@ -0,0 +1,200 @@
+#include "Test.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "FDRCodec.h"
+#include "FDRFile.h"
+#include "FDRFileFormat.h"
+
+/**
+* Lossless compression codec and v2 container (chunks, legacy v1 files)
+*/
+namespace
+{
+	std::vector<FDRFileStruct> CreateFlight(int size) {
+		std::vector<FDRFileStruct> records(size);
+		for (int n = 0; n < size; n++) {
+			FDRFileStruct& rec = records[n];
+			std::memset(&rec, 0, sizeof(rec));
+			rec.lat = 47.26 + n * 1.0e-5;
+			rec.lon = -179.99 + n * 2.0e-5;
+			rec.alt = 1900.0 + std::sin(n * 0.01) * 300.0;
+			rec.hdg = std::fmod(n * 0.37, 360.0);
+			rec.thr1 = n % 50 < 25 ? 0.85 : 0.0;
+			rec.gearPos = n < size / 2 ? 1.0 : 0.0;
+			rec.navL = 1;
+			rec.lndgL = n / 100 % 2;
+			rec.fltTime = n / 20.0F;
+		}
+		return records;
+	}
+
+	// Edge cases of the XOR and delta-of-delta encodings, one per record and channel
+	std::vector<FDRFileStruct> CreateEdgeCases() {
+		const double doubles[] = { 0.0, -0.0, std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::quiet_NaN(),
+			std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::denorm_min(),
+			std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), 1.0, -1.0, 0.1, -0.0, 0.0 };
+		const float floats[] = { 0.0F, -0.0F, 0.01F, std::numeric_limits<float>::quiet_NaN(), 0.03F, std::numeric_limits<float>::infinity(),
+			0.05F, 1.0e-7F, 0.07F, -0.0F, 3.4e38F, 0.1F, 0.11F, 0.12F };
+		const int ints[] = { 0, 0, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), -1, -1, -1, 1, 0, 0, 7, 7, 7, 7 };
+		const size_t count = sizeof(doubles) / sizeof(doubles[0]);
+
+		std::vector<FDRFileStruct> records(count);
+		for (size_t n = 0; n < count; n++) {
+			FDRFileStruct& rec = records[n];
+			std::memset(&rec, 0, sizeof(rec));
+			double* channels = &rec.lat;
+			for (int k = 0; k < 25; k++)
+				channels[k] = doubles[(n + k) % count];
+			int* lights = &rec.navL;
+			for (int k = 0; k < 8; k++)
+				lights[k] = ints[(n + k) % count];
+			rec.fltTime = floats[n];
+		}
+		return records;
+	}
+
+	// Compares the fields of the native schema bit by bit, i.e. -0.0 != 0.0 and NaN payloads must match
+	bool IsBitExact(const FDRFileStruct& a, const FDRFileStruct& b) {
+		for (const FDRFieldStruct& field : FDRFileFormat::getSchema()) {
+			if (std::memcmp((const char*)&a + field.offset, (const char*)&b + field.offset, field.size) != 0)
+				return false;
+		}
+		return true;
+	}
+
+	std::vector<FDRFileStruct> RoundTrip(const std::vector<FDRFileStruct>& records) {
+		const std::vector<FDRFieldStruct>& schema = FDRFileFormat::getSchema();
+		std::vector<uint8_t> chunk;
+		FDRCodec::encodeChunk((const char*)records.data(), sizeof(FDRFileStruct), (uint32_t)records.size(), schema, chunk);
+
+		std::vector<FDRFileStruct> decoded(records.size());
+		std::memset(decoded.data(), 0, decoded.size() * sizeof(FDRFileStruct));
+		if (!FDRCodec::decodeChunk((const char*)chunk.data(), chunk.size(), sizeof(FDRFileStruct), (uint32_t)records.size(), schema, (char*)decoded.data()))
+			decoded.clear();
+		return decoded;
+	}
+
+	std::string GetTempFileName(const char* name) {
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+}
+
+
+TEST_CASE(FDRCodec, LosslessRoundTripIsBitExact) {
+	std::vector<FDRFileStruct> records = CreateFlight(5000);
+	std::vector<FDRFileStruct> decoded = RoundTrip(records);
+
+	CHECK(decoded.size() == records.size());
+	for (size_t n = 0; n < decoded.size(); n++)
+		CHECK(IsBitExact(records[n], decoded[n]));
+}
+
+TEST_CASE(FDRCodec, EdgeCaseValuesAreBitExact) {
+	// Signed zeros, NaNs, infinities and denormals (XOR), time stamps that aren't multiples of 0.01 (XOR fallback)
+	std::vector<FDRFileStruct> records = CreateEdgeCases();
+	std::vector<FDRFileStruct> decoded = RoundTrip(records);
+
+	CHECK(decoded.size() == records.size());
+	for (size_t n = 0; n < decoded.size(); n++)
+		CHECK(IsBitExact(records[n], decoded[n]));
+	CHECK(std::signbit(decoded[1].fltTime));
+	CHECK(std::isnan(decoded[3].fltTime));
+}
+
+TEST_CASE(FDRCodec, SingleRecordChunkIsBitExact) {
+	std::vector<FDRFileStruct> records = CreateEdgeCases();
+	records.resize(1);
+	std::vector<FDRFileStruct> decoded = RoundTrip(records);
+
+	CHECK(decoded.size() == 1);
+	CHECK(IsBitExact(records[0], decoded[0]));
+}
+
+TEST_CASE(FDRCodec, CorruptChunkIsRejected) {
+	std::vector<FDRFileStruct> records = CreateFlight(100);
+	const std::vector<FDRFieldStruct>& schema = FDRFileFormat::getSchema();
+	std::vector<uint8_t> chunk;
+	FDRCodec::encodeChunk((const char*)records.data(), sizeof(FDRFileStruct), (uint32_t)records.size(), schema, chunk);
+
+	std::vector<FDRFileStruct> decoded(records.size());
+	CHECK(!FDRCodec::decodeChunk((const char*)chunk.data(), chunk.size() / 2, sizeof(FDRFileStruct), (uint32_t)records.size(), schema, (char*)decoded.data()));
+}
+
+TEST_CASE(FDRCodec, ChunksAreReadAtRandom) {
+	// Record count isn't a multiple of the chunk size, i.e. the last chunk is partial
+	std::vector<FDRFileStruct> records = CreateFlight(1050);
+	std::ostringstream os;
+	CHECK(FDRFileFormat::writeFile(os, FDRFileFormat::createHeader(), RecordSpan<FDRFileStruct>(records.data(), records.size()), FDRFileFormat::lossless, nullptr, 100));
+	std::string file = os.str();
+
+	FDRFileHeader header = {};
+	const FDRFileStruct* mapped = nullptr;
+	std::vector<FDRFileStruct> converted;
+	CHECK(FDRFileFormat::parse(file.data(), file.size(), header, mapped, converted));
+	CHECK(header.codec == FDRFileFormat::lossless);
+	CHECK(header.recordCount == records.size());
+
+	std::vector<FDRChunkStruct> chunks = FDRFileFormat::getChunkTable(file.data(), file.size(), header);
+	CHECK(chunks.size() == 11);
+	CHECK(chunks.back().recordCount == 50);
+
+	// Last chunk first, then the chunks on both sides of each boundary
+	const uint64_t order[] = { 10, 0, 1, 5, 4, 9, 10 };
+	for (uint64_t chunk : order) {
+		std::vector<FDRFileStruct> chunkRecords;
+		CHECK(FDRFileFormat::readChunk(file.data(), file.size(), header, chunk, chunkRecords));
+		CHECK(chunkRecords.size() == chunks[chunk].recordCount);
+		for (size_t n = 0; n < chunkRecords.size(); n++)
+			CHECK(IsBitExact(chunkRecords[n], records[chunk * 100 + n]));
+		CHECK(chunks[chunk].firstTime == records[chunk * 100].fltTime);
+		CHECK(chunks[chunk].lastTime == records[chunk * 100 + chunkRecords.size() - 1].fltTime);
+	}
+
+	CHECK(converted.size() == records.size());
+	for (size_t n = 0; n < converted.size(); n++)
+		CHECK(IsBitExact(converted[n], records[n]));
+}
+
+TEST_CASE(FDRCodec, LegacyFileIsLoadedAndSavedAsV2) {
+	std::string legacyFile = GetTempFileName("fdr-test-v1.fdr"), v2File = GetTempFileName("fdr-test-v2.fdr");
+	std::vector<FDRFileStruct> records = CreateFlight(300);
+
+	// v1: size_t record count | records
+	{
+		std::ofstream os(legacyFile, std::ios::out | std::ios::binary | std::ios::trunc);
+		size_t count = records.size();
+		os.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		os.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FDRFileStruct));
+	}
+
+	FDRFile legacy;
+	CHECK(legacy.LoadFile(legacyFile));
+	CHECK(legacy.GetRecords().size() == records.size());
+	for (size_t n = 0; n < records.size(); n++)
+		CHECK(IsBitExact(legacy.GetRecords()[n], records[n]));
+	CHECK(legacy.SaveFile(v2File, FDRFileFormat::lossless));
+
+	std::ifstream is(v2File, std::ios::in | std::ios::binary);
+	std::string file((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+	FDRFileHeader header = {};
+	const FDRFileStruct* mapped = nullptr;
+	std::vector<FDRFileStruct> converted;
+	CHECK(FDRFileFormat::parse(file.data(), file.size(), header, mapped, converted));
+	CHECK(header.version == FDRFileFormat::version);
+	CHECK(std::memcmp(header.magic, FDRFileFormat::magic, sizeof(header.magic)) == 0);
+
+	FDRFile reloaded;
+	CHECK(reloaded.LoadFile(v2File));
+	CHECK(reloaded.GetRecords().size() == records.size());
+	for (size_t n = 0; n < records.size(); n++)
+		CHECK(IsBitExact(reloaded.GetRecords()[n], records[n]));
+
+	std::filesystem::remove(legacyFile);
+	std::filesystem::remove(v2File);
+}
@@ -0,0 +1,108 @@
+#include "Test.h"
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include "FDRFile.h"
+
+/**
+* Loading, streaming and saving of .fdr files
+*/
+namespace
+{
+	FDRFileStruct CreateRecord(int n) {
+		FDRFileStruct rec = {};
+		rec.lat = 47.26 + n * 1.0e-5;
+		rec.lon = 11.34 + n * 2.0e-5;
+		rec.alt = 1900.0 + n;
+		rec.fltTime = n / 20.0F;
+		return rec;
+	}
+
+	std::string GetTempFileName(const char* name) {
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+}
+
+
+TEST_CASE(FDRFile, ContinuedRecordingIsStreamedToDisk) {
+	std::string first = GetTempFileName("fdr-test-stream-1.fdr"), second = GetTempFileName("fdr-test-stream-2.fdr");
+	FDRFile fdrFile;
+
+	CHECK(fdrFile.OpenStream(first));
+	for (int n = 0; n < 1000; n++)
+		CHECK(fdrFile.AddRecord(CreateRecord(n)));
+	CHECK(fdrFile.CloseStream());
+	CHECK(fdrFile.GetRecords().size() == 1000);
+
+	// Replay stopped at record 600, the recording continues from there
+	fdrFile.Truncate(600);
+	CHECK(fdrFile.OpenStream(second, true));
+	CHECK(fdrFile.IsStreaming());
+	CHECK(fdrFile.GetSize() == 599);
+	CHECK(fdrFile.GetRecords().size() == 0);
+	for (int n = 2000; n < 2100; n++)
+		CHECK(fdrFile.AddRecord(CreateRecord(n)));
+	CHECK(fdrFile.CloseStream());
+
+	RecordSpan<FDRFileStruct> records = fdrFile.GetRecords();
+	CHECK(records.size() == 700);
+	CHECK(records[599].alt == CreateRecord(599).alt);
+	CHECK(records[600].alt == CreateRecord(2000).alt);
+	CHECK(records[699].alt == CreateRecord(2099).alt);
+	CHECK(!std::filesystem::exists(first));
+}
+
+TEST_CASE(FDRFile, SaveReplacesFileMappedByAnotherTrack) {
+	std::string fileName = GetTempFileName("fdr-test-mapped.fdr");
+	FDRFile original, replacement;
+	for (int n = 0; n < 1000; n++)
+		original.AddRecord(CreateRecord(n));
+	for (int n = 0; n < 10; n++)
+		replacement.AddRecord(CreateRecord(5000 + n));
+	CHECK(original.SaveFile(fileName));
+
+	// Track replaying the file, i.e. reading the mapping while the file is overwritten
+	FDRFile track;
+	CHECK(track.LoadFile(fileName));
+	CHECK(replacement.SaveFile(fileName));
+
+	RecordSpan<FDRFileStruct> records = track.GetRecords();
+	CHECK(records.size() == 1000);
+	CHECK(records[999].alt == CreateRecord(999).alt);
+	CHECK(!std::filesystem::exists(fileName + ".tmp"));
+
+	// Loading the file again maps the new content
+	FDRFile reloaded;
+	CHECK(reloaded.LoadFile(fileName));
+	CHECK(reloaded.GetRecords().size() == 10);
+	CHECK(reloaded.GetRecords()[0].alt == CreateRecord(5000).alt);
+	std::filesystem::remove(fileName);
+}
+
+TEST_CASE(FDRFile, ArchiveStaysWithinErrorBudget) {
+	std::string fileName = GetTempFileName("fdr-test-archive.fdr");
+	FDRFile original;
+	for (int n = 0; n < 5000; n++) {
+		FDRFileStruct rec = CreateRecord(n);
+		rec.hdg = std::fmod(n * 0.037, 360.0);
+		rec.pitch = std::sin(n * 0.01) * 5.0;
+		original.AddRecord(rec);
+	}
+
+	std::vector<FDRDeviationStruct> deviations;
+	CHECK(original.SaveFile(fileName, FDRFileFormat::quantized, nullptr, &deviations));
+	CHECK(!deviations.empty());
+	for (auto& deviation : deviations)
+		CHECK(!deviation.exceeded);
+	CHECK(!std::filesystem::exists(fileName + ".tmp"));
+
+	// Saved file reports its error budget and verifies against the original records
+	FDRFile archive;
+	CHECK(archive.LoadFile(fileName));
+	CHECK(archive.GetRecords().size() == 5000);
+	CHECK(archive.GetQuantProfile().GetMaxError("lat") > 0.0);
+	CHECK(original.VerifyFile(fileName, deviations));
+	for (auto& deviation : deviations)
+		CHECK(!deviation.exceeded);
+	std::filesystem::remove(fileName);
+}
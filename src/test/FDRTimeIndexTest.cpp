@@ -0,0 +1,47 @@
+#include "Test.h"
+#include <vector>
+#include "FDRTimeIndex.h"
+
+/**
+* Time index of an .fdr track, i.e. skip table and search
+*/
+namespace
+{
+	std::vector<float> CreateTimes(size_t count) {
+		std::vector<float> times(count);
+		for (size_t n = 0; n < count; n++)
+			times[n] = n * 0.05F;
+		return times;
+	}
+}
+
+
+TEST_CASE(FDRTimeIndex, AssignsSkipTableOfTheTrack) {
+	std::vector<float> times = CreateTimes(5000);
+	std::vector<FDRIndexStruct> entries = FDRTimeIndex::CreateEntries(times.data(), times.size(), sizeof(float), 256);
+
+	FDRTimeIndex index;
+	CHECK(index.Assign(times, entries, 256));
+	CHECK(index.LowerBound(100.0) == 2000);
+	CHECK(index.Floor(100.02) == 2000);
+}
+
+TEST_CASE(FDRTimeIndex, RejectsSkipTableWithStaleTimes) {
+	std::vector<float> times = CreateTimes(5000);
+	std::vector<FDRIndexStruct> entries = FDRTimeIndex::CreateEntries(times.data(), times.size(), sizeof(float), 256);
+
+	// Still increasing, but no longer the time stamps of the records, e.g. index of a previous version of the file
+	for (auto& entry : entries)
+		entry.time += 30.0F;
+
+	FDRTimeIndex index;
+	CHECK(!index.Assign(times, entries, 256));
+
+	entries = FDRTimeIndex::CreateEntries(times.data(), times.size(), sizeof(float), 256);
+	entries[7].time = entries[7].time + 0.01F;
+	CHECK(!index.Assign(times, entries, 256));
+
+	// Rebuilt from the time column instead
+	index.Build(times, 256);
+	CHECK(index.LowerBound(100.0) == 2000);
+}
@@ -0,0 +1,246 @@
+#include "Test.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "Processor.h"
+#include "ProcessorCom.h"
+#include "Track.h"
+#include "FDRFile.h"
+#include "LocalSimLink.h"
+
+/**
+* Record and replay of the processor against the local sim link, i.e. without a sim
+*/
+namespace
+{
+	/**
+	* Returns a synthetic flight, i.e. a climbing and turning aircraft with one record per sim frame
+	*/
+	std::vector<FDRFileStruct> CreateFlight(int count) {
+		std::vector<FDRFileStruct> flight(count);
+		for (int n = 0; n < count; n++) {
+			FDRFileStruct& rec = flight[n];
+			rec = {};
+			rec.lat = 47.26 + n * 1.0e-5;
+			rec.lon = 11.34 + n * 2.0e-5;
+			rec.alt = 1900.0 + n * 0.5;
+			rec.spd = 160.0;
+			rec.hdg = std::fmod(60.0 + n * 0.05, 360.0);
+			rec.pitch = -5.0;
+			rec.bank = 10.0 * std::sin(n / 60.0);
+			rec.thr1 = rec.thr2 = 0.9;
+			rec.engN1E1 = rec.engN1E2 = 88.0;
+			rec.gearPos = n < 60 ? 1.0 : 0.0;
+			rec.fuelCtr = rec.fuelLeft = rec.fuelRight = 0.8;
+			rec.navL = rec.beacL = rec.strbL = 1;
+			rec.fltTime = n / 60.0F;
+		}
+		return flight;
+	}
+
+	/**
+	* Steps the local link and pumps its messages frame by frame, until the link quits, the frames are done
+	* or the cursor of the user track reaches the end position
+	*/
+	int RunFrames(ProcessorCom* cpuCom, Processor* processor, LocalSimLink* link, int frames, int endPos) {
+		SimMessageSource* source = link->GetMessageSource();
+		int frame = 0;
+
+		while (frame < frames && cpuCom->GetSimConnect()) {
+			link->Step(1);
+			if (source->WaitForMessages(0))
+				source->DispatchMessages();
+			frame++;
+
+			if (endPos > 0 && cpuCom->GetCursorPos() >= endPos)
+				break;
+		}
+		return frame;
+	}
+
+	/**
+	* Records the flight replayed by the local link as the user aircraft
+	*/
+	void Record(const std::vector<FDRFileStruct>& flight, FDRFile& fdrFile) {
+		ProcessorCom cpuCom;
+		LocalSimLink* link = new LocalSimLink(60.0, false);
+		link->SetFrames(flight);
+
+		Processor* processor = new Processor(nullptr, &cpuCom, &fdrFile);
+		processor->SetSimLink(link);
+		cpuCom.SetProcessorState(ProcessorCom::ProcessorState::record);
+		CHECK(processor->OpenSimLink());
+
+		RunFrames(&cpuCom, processor, link, (int)flight.size() + 60, 0);
+		processor->Shutdown();
+		delete processor;
+	}
+
+	/**
+	* Result of a replay, as seen by the sim
+	*/
+	struct ReplayResult {
+		int cursorPos = 0;
+		uint64_t setDataCount = 0;
+		size_t objectCount = 0;
+		double aiLat = 0, aiLon = 0, aiAlt = 0;
+	};
+
+	/**
+	* Replays a file as the user aircraft and as one AI track on a fixed clock
+	*/
+	ReplayResult Replay(FDRFile* fdrFile, int frames) {
+		ProcessorCom cpuCom;
+		vector<Track*> tracks;
+		for (int n = 0; n < 2; n++) {
+			Track* track = new Track(n == 0 ? Track::TrackType::USER : Track::TrackType::AI);
+			track->SetTrackId(n);
+			track->SetFileName("flight.fdr");
+			track->SetSimApi(320);
+			track->SetFileType(Track::FileType::FDR);
+			track->SetFile(fdrFile);
+			tracks.push_back(track);
+		}
+
+		// Flight as canned frames of the user aircraft, i.e. the AI track flies along
+		RecordSpan<FDRFileStruct> records = fdrFile->GetRecords();
+		LocalSimLink* link = new LocalSimLink(60.0, false);
+		link->SetFrames(std::vector<FDRFileStruct>(records.data(), records.data() + records.size()), true);
+
+		Processor* processor = new Processor(nullptr, &cpuCom, tracks);
+		processor->SetSimLink(link);
+		processor->SetComputeThreads(2);
+		processor->replayClock.SetMode(ReplayClock::Mode::fixedStep);
+		processor->replayClock.SetFixedStep(1.0 / 60.0);
+		cpuCom.SetProcessorState(ProcessorCom::ProcessorState::replay);
+		cpuCom.SetReplayRate(1.0F);
+		CHECK(processor->OpenSimLink());
+
+		ReplayResult result;
+		RunFrames(&cpuCom, processor, link, frames, 0);
+		result.cursorPos = cpuCom.GetCursorPos();
+		result.setDataCount = link->GetSetDataCount();
+		result.objectCount = link->GetObjectCount();
+
+		// First AI object, i.e. the AI track
+		result.aiLat = link->GetValue(1, "PLANE LATITUDE");
+		result.aiLon = link->GetValue(1, "PLANE LONGITUDE");
+		result.aiAlt = link->GetValue(1, "PLANE ALTITUDE");
+
+		processor->Shutdown();
+		delete processor;
+		for (auto& track : tracks)
+			delete track;
+		return result;
+	}
+
+	bool SameRecords(FDRFile& a, FDRFile& b) {
+		RecordSpan<FDRFileStruct> recordsA = a.GetRecords(), recordsB = b.GetRecords();
+		return recordsA.size() == recordsB.size() && std::memcmp(recordsA.data(), recordsB.data(), recordsA.size() * sizeof(FDRFileStruct)) == 0;
+	}
+}
+
+
+TEST_CASE(LocalSimLink, RecordsEveryFrameOfTheUserAircraft) {
+	std::vector<FDRFileStruct> flight = CreateFlight(600);
+	FDRFile fdrFile;
+	Record(flight, fdrFile);
+
+	// The first sim frame requests the data of the user aircraft, i.e. the recording starts with the second frame
+	RecordSpan<FDRFileStruct> records = fdrFile.GetRecords();
+	CHECK(records.size() == flight.size() - 1);
+	for (size_t n = 0; n < records.size() && n + 1 < flight.size(); n++) {
+		CHECK(records[n].lat == flight[n + 1].lat);
+		CHECK(records[n].lon == flight[n + 1].lon);
+		CHECK(records[n].alt == flight[n + 1].alt);
+		CHECK(records[n].hdg == flight[n + 1].hdg);
+		CHECK(records[n].gearPos == flight[n + 1].gearPos);
+	}
+}
+
+TEST_CASE(LocalSimLink, RecordingIsDeterministic) {
+	std::vector<FDRFileStruct> flight = CreateFlight(600);
+	FDRFile first, second;
+	Record(flight, first);
+	Record(flight, second);
+	CHECK(first.GetSize() > 0);
+	CHECK(SameRecords(first, second));
+}
+
+TEST_CASE(LocalSimLink, RecordingSurvivesSaveAndLoad) {
+	std::vector<FDRFileStruct> flight = CreateFlight(600);
+	FDRFile recorded;
+	Record(flight, recorded);
+
+	std::string fileName = (std::filesystem::temp_directory_path() / "fdr-test-record.fdr").string();
+	CHECK(recorded.SaveFile(fileName));
+
+	FDRFile loaded;
+	CHECK(loaded.LoadFile(fileName));
+	CHECK(SameRecords(recorded, loaded));
+	std::filesystem::remove(fileName);
+}
+
+TEST_CASE(LocalSimLink, ReplayIsDeterministic) {
+	std::vector<FDRFileStruct> flight = CreateFlight(600);
+	FDRFile fdrFile;
+	Record(flight, fdrFile);
+
+	ReplayResult first = Replay(&fdrFile, 300);
+	ReplayResult second = Replay(&fdrFile, 300);
+
+	// The AI track is replayed, i.e. its AI object is created and moved along the recording
+	CHECK(first.objectCount == 2);
+	CHECK(first.setDataCount > 0);
+	CHECK(first.cursorPos > 0);
+	CHECK(std::fabs(first.aiLat - flight[0].lat) < 0.01 && first.aiLat != flight[0].lat);
+	CHECK(std::fabs(first.aiLon - flight[0].lon) < 0.02);
+
+	CHECK(first.cursorPos == second.cursorPos);
+	CHECK(first.setDataCount == second.setDataCount);
+	CHECK(first.aiLat == second.aiLat);
+	CHECK(first.aiLon == second.aiLon);
+	CHECK(first.aiAlt == second.aiAlt);
+}
+
+TEST_CASE(LocalSimLink, ReplayEndsWithTheUserTrack) {
+	std::vector<FDRFileStruct> flight = CreateFlight(300);
+	FDRFile fdrFile;
+	Record(flight, fdrFile);
+
+	ReplayResult result = Replay(&fdrFile, 2000);
+	CHECK(result.cursorPos >= fdrFile.GetSize() - 1);
+}
+
+TEST_CASE(LocalSimLink, RequestSlotsAreReused) {
+	ProcessorCom cpuCom;
+	FDRFile fdrFile;
+	LocalSimLink* link = new LocalSimLink(60.0, false);
+	link->SetFrames(CreateFlight(60));
+
+	Processor* processor = new Processor(nullptr, &cpuCom, &fdrFile);
+	processor->SetSimLink(link);
+	cpuCom.SetProcessorState(ProcessorCom::ProcessorState::record);
+	CHECK(processor->OpenSimLink());
+	size_t definitionCount = link->GetDefinitionCount();
+
+	// Sim objects come and go, i.e. the slots (and the IDs derived from them) must not grow
+	UINT first = processor->AddRequestSlot();
+	for (int n = 0; n < 5000; n++) {
+		UINT slot = processor->AddRequestSlot();
+		processor->RequestRecordData(slot, 1);
+		CHECK(link->GetDefinitionCount() > definitionCount);
+		processor->RemoveRequestSlot(slot);
+		CHECK(slot == first + 1);
+	}
+	CHECK(link->GetDefinitionCount() == definitionCount);
+	CHECK(processor->simObjects.GetSize() == first + 2);
+
+	processor->RemoveRequestSlot(first);
+	CHECK(processor->AddRequestSlot() == first);
+
+	processor->Shutdown();
+	delete processor;
+}
@@ -0,0 +1,58 @@
+#include "Test.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include "ProcessorCom.h"
+
+/**
+* Options snapshots of the Com handler, read while they are replaced
+*/
+TEST_CASE(ProcessorCom, HeldSnapshotSurvivesReplacement) {
+	ProcessorCom com;
+	OptionsStruct options = *com.GetOptions();
+	options.destName = "EDDF";
+	com.SetOptions(options);
+
+	{
+		ProcessorCom::OptionsRef held = com.GetOptions();
+		for (int n = 0; n < 10; n++) {
+			options.destName = "LOWI " + std::to_string(n);
+			com.SetOptions(options);
+		}
+		CHECK(held->destName == "EDDF");
+		CHECK(com.GetDestName() == "LOWI 9");
+	}
+
+	// No reader left, i.e. the retired snapshots are freed with the next replacement
+	options.halfRate = true;
+	com.SetOptions(options);
+	CHECK(com.GetHalfRate());
+	CHECK(com.GetOptions()->destName == "LOWI 9");
+}
+
+TEST_CASE(ProcessorCom, ReadersSeeCompleteSnapshots) {
+	ProcessorCom com;
+	std::atomic<bool> stop{ false };
+	std::atomic<int> torn{ 0 };
+	OptionsStruct options = *com.GetOptions();
+	options.destName = "0";
+	com.SetOptions(options);
+
+	// Every snapshot has depHH == fltHH, i.e. a reader never sees fields of two snapshots
+	std::thread reader([&com, &stop, &torn]() {
+		while (!stop.load(std::memory_order_acquire)) {
+			ProcessorCom::OptionsRef options = com.GetOptions();
+			if (options->depHH != options->fltHH || options->destName != std::to_string(options->depHH))
+				torn.fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	for (int n = 1; n < 20000; n++) {
+		options.depHH = options.fltHH = n;
+		options.destName = std::to_string(n);
+		com.SetOptions(options);
+	}
+	stop.store(true, std::memory_order_release);
+	reader.join();
+	CHECK(torn.load() == 0);
+}
@@ -0,0 +1,123 @@
+#include "Test.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "SimMessagePump.h"
+#include "LocalMessageSource.h"
+
+/**
+* Message pump of the processor loop, driven by the local message source
+*/
+TEST_CASE(SimMessagePump, DispatchesPendingMessagesInOrder) {
+	LocalMessageSource source;
+	SimMessagePump pump(&source, SimMessagePump::eventDriven, 1000);
+	std::vector<int> handled;
+
+	for (int n = 0; n < 3; n++)
+		source.Post([&handled, n] { handled.push_back(n); });
+	CHECK(source.GetPendingCount() == 3);
+
+	CHECK(pump.Pump());
+	CHECK(handled == std::vector<int>({ 0, 1, 2 }));
+	CHECK(source.GetPendingCount() == 0);
+	CHECK(pump.GetWakeCount() == 1);
+	CHECK(pump.GetTimeoutCount() == 0);
+}
+
+TEST_CASE(SimMessagePump, MessagesPostedByAMessageRunNextIteration) {
+	LocalMessageSource source;
+	SimMessagePump pump(&source, SimMessagePump::eventDriven, 1000);
+	std::vector<int> handled;
+
+	source.Post([&] {
+		handled.push_back(1);
+		source.Post([&] { handled.push_back(2); });
+	});
+
+	CHECK(pump.Pump());
+	CHECK(handled == std::vector<int>({ 1 }));
+	CHECK(pump.Pump());
+	CHECK(handled == std::vector<int>({ 1, 2 }));
+}
+
+TEST_CASE(SimMessagePump, TimesOutWithoutMessages) {
+	LocalMessageSource source;
+	SimMessagePump pump(&source, SimMessagePump::eventDriven, 10);
+
+	auto tStart = std::chrono::steady_clock::now();
+	CHECK(!pump.Pump());
+	CHECK(std::chrono::steady_clock::now() - tStart >= std::chrono::milliseconds(10));
+	CHECK(pump.GetWakeCount() == 0);
+	CHECK(pump.GetTimeoutCount() == 1);
+}
+
+TEST_CASE(SimMessagePump, WakesUpOnMessageFromAnotherThread) {
+	LocalMessageSource source;
+	SimMessagePump pump(&source, SimMessagePump::eventDriven, 10000);
+	std::atomic<bool> handled{ false };
+
+	std::thread sender([&] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		source.Post([&] { handled = true; });
+	});
+
+	auto tStart = std::chrono::steady_clock::now();
+	CHECK(pump.Pump());
+	sender.join();
+	CHECK(handled);
+	CHECK(std::chrono::steady_clock::now() - tStart < std::chrono::seconds(5));
+}
+
+TEST_CASE(SimMessagePump, StopRequestEndsLoopWithoutWaitingForTimeout) {
+	LocalMessageSource source;
+	SimMessagePump pump(&source, SimMessagePump::eventDriven, 10000);
+	std::atomic<bool> stop{ false };
+	std::atomic<int> frames{ 0 };
+
+	// Processor loop, i.e. pumps until stopped
+	std::thread loop([&] {
+		while (!stop)
+			pump.Pump();
+	});
+
+	for (int n = 0; n < 5; n++)
+		source.Post([&] { frames++; });
+	while (frames < 5)
+		std::this_thread::yield();
+
+	auto tStop = std::chrono::steady_clock::now();
+	stop = true;
+	pump.Wake();
+	loop.join();
+
+	CHECK(frames == 5);
+	CHECK(std::chrono::steady_clock::now() - tStop < std::chrono::seconds(5));
+}
+
+TEST_CASE(SimMessagePump, PollingDispatchesWithoutWaiting) {
+	LocalMessageSource source;
+	SimMessagePump pump(&source, SimMessagePump::polling, 1);
+	int handled = 0;
+
+	CHECK(pump.Pump());
+	source.Post([&] { handled++; });
+	CHECK(pump.Pump());
+	CHECK(handled == 1);
+	CHECK(pump.GetWakeCount() == 2);
+}
+
+TEST_CASE(SimMessagePump, WaitReportsPendingMessagesWithoutDispatching) {
+	const SimMessagePump::Mode modes[] = { SimMessagePump::eventDriven, SimMessagePump::polling, SimMessagePump::spinning };
+	for (SimMessagePump::Mode mode : modes) {
+		LocalMessageSource source;
+		SimMessagePump pump(&source, mode, 1);
+		int handled = 0;
+
+		CHECK(!pump.Wait());
+		source.Post([&handled] { handled++; });
+		CHECK(pump.Wait());
+		CHECK(handled == 0);
+		CHECK(source.GetPendingCount() == 1);
+	}
+}
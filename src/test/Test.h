@@ -0,0 +1,57 @@
+#ifndef Test_H
+#define Test_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+* Minimal test harness of the headless build (see CMakeLists.txt)
+*
+* Test cases register themselves per suite (TEST_CASE) and are run by suite, i.e. fdr-tests <suite>.
+* A failed check (CHECK) ends its test case, the following test cases still run
+*
+* @author muppetlabs@fswindowseat.com
+*/
+namespace Test
+{
+	struct Case {
+		std::string suite;
+		std::string name;
+		std::function<void()> run;
+	};
+
+	/**
+	* Returns the registered test cases
+	*/
+	std::vector<Case>& GetCases();
+
+	/**
+	* Registers a test case, i.e. a static instance per test case
+	*/
+	struct Registration {
+		Registration(const char* suite, const char* name, std::function<void()> run) {
+			GetCases().push_back({ suite, name, run });
+		}
+	};
+
+	/**
+	* Ends the running test case as failed
+	*
+	* @param	file		Source file of the check
+	* @param	line		Line of the check
+	* @param	expression	Expression checked
+	* @return	void
+	*/
+	void Fail(const char* file, int line, const char* expression);
+}
+
+#define TEST_CASE(suite, name) \
+	static void suite##_##name(); \
+	static Test::Registration suite##_##name##_registration(#suite, #name, suite##_##name); \
+	static void suite##_##name()
+
+#define CHECK(expression) \
+	do { if (!(expression)) Test::Fail(__FILE__, __LINE__, #expression); } while (0)
+
+#endif
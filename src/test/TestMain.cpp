@@ -0,0 +1,61 @@
+#include "Test.h"
+#include <iostream>
+#include <stdexcept>
+
+namespace Test
+{
+	/**
+	* Failure of a check, ends the running test case
+	*/
+	struct Failure : std::runtime_error {
+		using std::runtime_error::runtime_error;
+	};
+
+
+	/**
+	* Returns the registered test cases
+	*/
+	std::vector<Case>& GetCases() {
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+
+	/**
+	* Ends the running test case as failed
+	*/
+	void Fail(const char* file, int line, const char* expression) {
+		throw Failure(std::string(file) + ":" + std::to_string(line) + ": CHECK(" + expression + ") failed");
+	}
+}
+
+
+/**
+* Runs the test cases of a suite, or of all suites without argument
+*/
+int main(int argc, char* argv[]) {
+	std::string suite = argc > 1 ? argv[1] : "";
+	int run = 0, failed = 0;
+
+	for (auto& testCase : Test::GetCases()) {
+		if (!suite.empty() && testCase.suite != suite)
+			continue;
+
+		run++;
+		try {
+			testCase.run();
+			std::cout << "ok      " << testCase.suite << "." << testCase.name << std::endl;
+		}
+		catch (const std::exception& e) {
+			failed++;
+			std::cout << "FAILED  " << testCase.suite << "." << testCase.name << ": " << e.what() << std::endl;
+		}
+	}
+
+	std::cout << run - failed << "/" << run << " passed" << std::endl;
+	if (run == 0) {
+		std::cerr << "fdr-tests: no test cases for " << suite << std::endl;
+		return 1;
+	}
+	return failed > 0 ? 1 : 0;
+}
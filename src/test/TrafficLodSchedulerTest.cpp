@@ -0,0 +1,55 @@
+#define _USE_MATH_DEFINES
+#include "Test.h"
+#include <cmath>
+#include "TrafficLodScheduler.h"
+
+/**
+* Level of detail of the AI traffic around the user aircraft
+*/
+namespace
+{
+	// Classifies one track at the given position, the user aircraft heads north
+	TrafficLodScheduler::Level Classify(double userLat, double userLon, double lat, double lon) {
+		TrafficLodScheduler scheduler(5.0, 20.0);
+		scheduler.Reset(1);
+		scheduler.SetPosition(0, lat, lon);
+		scheduler.Classify(userLat, userLon, 0.0, 1.0 / 60.0);
+		scheduler.SetPosition(0, lat, lon);
+		scheduler.Classify(userLat, userLon, 0.0, 1.0 / 60.0);
+		return scheduler.GetLevel(0);
+	}
+}
+
+
+TEST_CASE(TrafficLodScheduler, ClassifiesByDistance) {
+	CHECK(Classify(47.0, 11.0, 47.05, 11.0) == TrafficLodScheduler::nearby);
+	CHECK(Classify(47.0, 11.0, 47.2, 11.0) == TrafficLodScheduler::midRange);
+	CHECK(Classify(47.0, 11.0, 47.5, 11.0) == TrafficLodScheduler::distant);
+
+	// Behind the user aircraft, i.e. off screen
+	CHECK(Classify(47.0, 11.0, 46.95, 11.0) == TrafficLodScheduler::midRange);
+}
+
+TEST_CASE(TrafficLodScheduler, WrapsAroundTheAntimeridian) {
+	// 3 nm apart across the antimeridian, both ways and with longitudes outside [-180, 180)
+	CHECK(Classify(10.0, 179.98, 10.05, -179.99) == TrafficLodScheduler::nearby);
+	CHECK(Classify(10.0, -179.99, 10.05, 179.98) == TrafficLodScheduler::nearby);
+	CHECK(Classify(10.0, 180.01, 10.05, -179.99) == TrafficLodScheduler::nearby);
+	CHECK(Classify(10.0, 179.9, 10.2, -179.9) == TrafficLodScheduler::midRange);
+}
+
+TEST_CASE(TrafficLodScheduler, CoversTheMidRangeAwayFromTheReferenceLatitude) {
+	// Grid built at 86 N (302 columns), the user aircraft flies on to 86.99 N, i.e. the cells are a quarter
+	// narrower (nm) than at 86 N. The user aircraft is at the east edge of its cell
+	TrafficLodScheduler scheduler(5.0, 20.0);
+	scheduler.Reset(1);
+	scheduler.SetPosition(0, 86.99, 0.0);
+	scheduler.Classify(86.0, 0.0, 90.0, 1.0 / 60.0);
+
+	// 19.9 nm east of the user aircraft, i.e. 6 cells
+	double userLon = -180.0 + 152 * 360.0 / 302 - 1.0e-6;
+	double lon = userLon + 19.9 / (60.0 * std::cos(86.99 * M_PI / 180.0));
+	scheduler.SetPosition(0, 86.99, lon);
+	scheduler.Classify(86.99, userLon, 90.0, 1.0 / 60.0);
+	CHECK(scheduler.GetLevel(0) == TrafficLodScheduler::midRange);
+}